@@ -0,0 +1,139 @@
+/*
+hash_index_bench - Cost of secondary index maintenance on HASH writes
+
+Writes N user hashes (email, age, city, name) three times: with no
+index, with an EXACT index on email, and with EXACT(email) +
+NUMERIC(age). Then updates every age and deletes every key. Reports
+writes/sec per phase and the overhead relative to no index, followed
+by indexed lookups vs. a client-side scan.
+
+Usage: hash_index_bench [keys=200000]
+*/
+
+#include "../include/StorageEngine.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct PhaseTimes {
+    double insert_s = 0;
+    double update_s = 0;
+    double delete_s = 0;
+};
+
+double since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+PhaseTimes runWrites(StorageEngine& engine, size_t keys) {
+    std::mt19937_64 rng(11);
+    std::uniform_int_distribution<int> age(18, 90);
+    PhaseTimes times;
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < keys; i++) {
+        std::string key = "user:" + std::to_string(i);
+        engine.hset(key, "email", "user" + std::to_string(i) + "@example.com");
+        engine.hset(key, "age", std::to_string(age(rng)));
+        engine.hset(key, "city", "city" + std::to_string(i % 100));
+        engine.hset(key, "name", "name" + std::to_string(i));
+    }
+    times.insert_s = since(start);
+
+    start = Clock::now();
+    for (size_t i = 0; i < keys; i++) {
+        engine.hset("user:" + std::to_string(i), "age", std::to_string(age(rng)));
+    }
+    times.update_s = since(start);
+
+    start = Clock::now();
+    for (size_t i = 0; i < keys; i++) engine.remove("user:" + std::to_string(i));
+    times.delete_s = since(start);
+
+    return times;
+}
+
+void report(const char* label, const PhaseTimes& times, const PhaseTimes& base, size_t keys) {
+    auto overhead = [](double t, double b) { return (t / b - 1.0) * 100.0; };
+
+    std::cout << std::left << std::setw(22) << label << std::right << std::fixed << std::setprecision(0)
+              << std::setw(10) << keys * 4 / times.insert_s << " hset/s (" << std::showpos
+              << overhead(times.insert_s, base.insert_s) << "%)" << std::noshowpos
+              << std::setw(10) << keys / times.update_s << " upd/s (" << std::showpos
+              << overhead(times.update_s, base.update_s) << "%)" << std::noshowpos
+              << std::setw(10) << keys / times.delete_s << " del/s (" << std::showpos
+              << overhead(times.delete_s, base.delete_s) << "%)" << std::noshowpos << "\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    size_t keys = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+    if (keys == 0) {
+        std::cerr << "usage: hash_index_bench [keys]\n";
+        return 1;
+    }
+
+    std::cout << "Writing " << keys << " hashes x 4 fields, then 1 update + DEL per key\n\n";
+
+    PhaseTimes base;
+    {
+        StorageEngine engine;
+        base = runWrites(engine, keys);
+        report("no index", base, base, keys);
+    }
+    {
+        StorageEngine engine;
+        engine.hindexCreate("by_email", "user:", "email", HashIndexKind::EXACT);
+        report("EXACT(email)", runWrites(engine, keys), base, keys);
+    }
+    {
+        StorageEngine engine;
+        engine.hindexCreate("by_email", "user:", "email", HashIndexKind::EXACT);
+        engine.hindexCreate("by_age", "user:", "age", HashIndexKind::NUMERIC);
+        report("EXACT + NUMERIC(age)", runWrites(engine, keys), base, keys);
+    }
+
+    // Read side: indexed lookup vs. scanning every hash
+    StorageEngine engine;
+    engine.hindexCreate("by_email", "user:", "email", HashIndexKind::EXACT);
+    for (size_t i = 0; i < keys; i++) {
+        engine.hset("user:" + std::to_string(i), "email", "user" + std::to_string(i) + "@example.com");
+    }
+
+    std::mt19937_64 rng(5);
+    std::uniform_int_distribution<size_t> pick(0, keys - 1);
+    const size_t lookups = 100000;
+    size_t found = 0;
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < lookups; i++) {
+        found += engine.hindexLookup("by_email", "user" + std::to_string(pick(rng)) + "@example.com").size();
+    }
+    double indexed_s = since(start);
+
+    const size_t scans = 5;
+    size_t scanned = 0;
+    start = Clock::now();
+    for (size_t i = 0; i < scans; i++) {
+        std::string wanted = "user" + std::to_string(pick(rng)) + "@example.com";
+        for (const auto& key : engine.keys()) {
+            if (engine.hget(key, "email") == wanted) scanned++;
+        }
+    }
+    double scan_s = since(start);
+
+    std::cout << "\nHINDEX.LOOKUP: " << static_cast<size_t>(lookups / indexed_s) << " lookups/sec ("
+              << found << "/" << lookups << " found)\n";
+    std::cout << "Client scan:   " << std::setprecision(1) << scans / scan_s << " lookups/sec ("
+              << scanned << "/" << scans << " found)\n";
+    return 0;
+}
@@ -0,0 +1,148 @@
+/*
+hugepage_bench - Random-key GET with and without huge page backing
+
+Fills a StorageEngine, then does random GETs and reports:
+- ns per GET
+- dTLB load misses per GET (perf_event_open; "n/a" if not permitted)
+- huge page coverage of the keyspace arena
+
+Usage: hugepage_bench [keys=2000000] [lookups=5000000]
+*/
+
+#include "../include/StorageEngine.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// dTLB read-miss counter for the calling thread (-1 if unavailable)
+class DtlbCounter {
+public:
+    DtlbCounter() {
+#ifdef __linux__
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_DTLB |
+                      (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+    ~DtlbCounter() {
+#ifdef __linux__
+        if (fd_ >= 0) close(fd_);
+#endif
+    }
+
+    bool available() const { return fd_ >= 0; }
+
+    void start() {
+#ifdef __linux__
+        if (fd_ < 0) return;
+        ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    long long stop() {
+        long long count = -1;
+#ifdef __linux__
+        if (fd_ < 0) return -1;
+        ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd_, &count, sizeof(count)) != sizeof(count)) count = -1;
+#endif
+        return count;
+    }
+
+private:
+    int fd_ = -1;
+};
+
+const char* modeName(HugePageMode mode) {
+    switch (mode) {
+        case HugePageMode::OFF:         return "off (4 KB pages)";
+        case HugePageMode::TRANSPARENT: return "transparent (THP)";
+        case HugePageMode::EXPLICIT:    return "explicit (hugetlbfs)";
+    }
+    return "?";
+}
+
+void run(HugePageMode mode, size_t keys, size_t lookups) {
+    StorageOptions options;
+    options.huge_pages = mode;
+    StorageEngine engine(options);
+
+    for (size_t i = 0; i < keys; i++) {
+        engine.set("key:" + std::to_string(i), "v" + std::to_string(i));
+    }
+
+    // Pre-generate keys so string building stays out of the timed loop
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<size_t> pick(0, keys - 1);
+    std::vector<std::string> probes;
+    probes.reserve(lookups);
+    for (size_t i = 0; i < lookups; i++) {
+        probes.push_back("key:" + std::to_string(pick(rng)));
+    }
+
+    DtlbCounter tlb;
+    size_t hits = 0;
+
+    tlb.start();
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& key : probes) {
+        if (engine.get(key)) hits++;
+    }
+    auto end = std::chrono::steady_clock::now();
+    long long misses = tlb.stop();
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count() / lookups;
+    auto stats = engine.hugePageStats();
+
+    std::cout << std::left << std::setw(22) << modeName(mode)
+              << std::right << std::fixed << std::setprecision(1)
+              << std::setw(9) << ns << " ns/get   dTLB misses/get: ";
+    if (misses >= 0) {
+        std::cout << std::setprecision(3) << static_cast<double>(misses) / lookups;
+    } else {
+        std::cout << "n/a";
+    }
+    std::cout << "   huge page coverage: " << std::setprecision(1)
+              << stats.coverage() * 100.0 << "% of "
+              << stats.mapped_bytes / (1024 * 1024) << " MB"
+              << "   (hits " << hits << ")\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    size_t keys = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+    size_t lookups = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 5000000;
+    if (keys == 0 || lookups == 0) {
+        std::cerr << "usage: hugepage_bench [keys] [lookups]\n";
+        return 1;
+    }
+
+    std::cout << "Random GET over " << keys << " keys, " << lookups << " lookups\n";
+    run(HugePageMode::OFF, keys, lookups);
+    run(HugePageMode::TRANSPARENT, keys, lookups);
+    run(HugePageMode::EXPLICIT, keys, lookups);
+    return 0;
+}
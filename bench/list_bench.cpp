@@ -0,0 +1,98 @@
+/*
+list_bench - Native list commands on a large list
+
+Builds an N-element capped log and measures:
+- LTRIM to the newest 1000 vs. the client-side way (LRANGE + DEL +
+  RPUSH of the survivors)
+- LPOS of a missing element (full scan) and LINDEX in the middle
+- LPUSH + RPOP queue throughput
+
+Usage: list_bench [elements=1000000]
+*/
+
+#include "../include/StorageEngine.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void fill(StorageEngine& engine, const std::string& key, size_t elements) {
+    std::vector<std::string> batch;
+    batch.reserve(1000);
+    for (size_t i = 0; i < elements; i++) {
+        batch.push_back("event:" + std::to_string(i) + ":payload");
+        if (batch.size() == batch.capacity()) {
+            engine.rpush(key, batch);
+            batch.clear();
+        }
+    }
+    engine.rpush(key, batch);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    size_t elements = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    if (elements < 1000) {
+        std::cerr << "usage: list_bench [elements >= 1000]\n";
+        return 1;
+    }
+
+    StorageEngine engine;
+
+    fill(engine, "log", elements);
+    auto start = Clock::now();
+    engine.ltrim("log", -1000, -1);
+    double native_s = since(start);
+
+    fill(engine, "log2", elements);
+    start = Clock::now();
+    auto survivors = engine.lrange("log2", -1000, -1);
+    engine.remove("log2");
+    engine.rpush("log2", survivors);
+    double client_s = since(start);
+
+    std::cout << "LTRIM " << elements << " -> 1000:        " << native_s * 1e6 << " us (llen "
+              << engine.llen("log") << ")\n";
+    std::cout << "LRANGE + DEL + RPUSH:          " << client_s * 1e6 << " us (llen "
+              << engine.llen("log2") << ")\n";
+
+    fill(engine, "big", elements);
+    const size_t scans = 20;
+    size_t found = 0;
+    start = Clock::now();
+    for (size_t i = 0; i < scans; i++) found += engine.lpos("big", "event:missing:payload").size();
+    double lpos_s = since(start);
+    std::cout << "LPOS (miss, full scan):        " << lpos_s / scans * 1e3 << " ms, "
+              << static_cast<size_t>(elements * scans / lpos_s / 1e6) << " M elements/sec (" << found
+              << " found)\n";
+
+    const size_t lookups = 10000;
+    size_t bytes = 0;
+    start = Clock::now();
+    for (size_t i = 0; i < lookups; i++) {
+        bytes += engine.lindex("big", static_cast<int>(elements / 2 + i % 100)).value_or("").size();
+    }
+    double lindex_s = since(start);
+    std::cout << "LINDEX (middle):               " << lindex_s / lookups * 1e6 << " us/op (" << bytes
+              << " bytes)\n";
+
+    const size_t ops = 1000000;
+    start = Clock::now();
+    for (size_t i = 0; i < ops; i++) {
+        engine.lpush("queue", {"job"});
+        engine.rpop("queue");
+    }
+    double queue_s = since(start);
+    std::cout << "LPUSH + RPOP:                  " << static_cast<size_t>(ops / queue_s) << " pairs/sec\n";
+    return 0;
+}
@@ -0,0 +1,88 @@
+/*
+nearcache_bench - NearCache vs direct ThreadSafeStore reads
+
+Loads K config-style keys, then reads them (zipf-ish: 90% of reads go
+to the hottest 10% of keys) through the plain store and through a
+NearCache, reporting ns/op. A background writer updates random keys
+at a fixed rate so invalidations and re-fills are part of the cost;
+the NearCache hit rate and mean served age are printed too.
+
+Usage: nearcache_bench [keys=10000] [reads=5000000] [writes_per_sec=1000]
+*/
+
+#include "../include/NearCache.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+template <typename Read>
+static double nsPerRead(const std::vector<std::string>& keys, size_t reads, Read read) {
+    std::mt19937_64 rng(42);
+    size_t hot = std::max<size_t>(1, keys.size() / 10);
+    std::uniform_int_distribution<size_t> hot_pick(0, hot - 1);
+    std::uniform_int_distribution<size_t> any_pick(0, keys.size() - 1);
+    std::uniform_int_distribution<int> percent(0, 99);
+
+    // Pre-draw the key sequence so RNG cost stays out of the timing
+    std::vector<const std::string*> sequence(reads);
+    for (auto& key : sequence) key = &keys[percent(rng) < 90 ? hot_pick(rng) : any_pick(rng)];
+
+    size_t found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const std::string* key : sequence) found += read(*key).has_value();
+    auto end = std::chrono::steady_clock::now();
+
+    if (found == 0) std::cerr << "(no values found)\n";
+    return std::chrono::duration<double, std::nano>(end - start).count() / reads;
+}
+
+int main(int argc, char** argv) {
+    size_t key_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000;
+    size_t reads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 5000000;
+    size_t writes_per_sec = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1000;
+    if (key_count == 0 || reads == 0) {
+        std::cerr << "usage: nearcache_bench [keys] [reads] [writes_per_sec]\n";
+        return 1;
+    }
+
+    ThreadSafeStore store;
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < key_count; i++) {
+        keys.push_back("config:" + std::to_string(i));
+        store.set(keys.back(), "value-" + std::to_string(i));
+    }
+
+    NearCache cache(store);
+
+    std::atomic<bool> stop{false};
+    std::thread writer([&] {
+        if (writes_per_sec == 0) return;
+        std::mt19937_64 rng(7);
+        std::uniform_int_distribution<size_t> pick(0, key_count - 1);
+        auto interval = std::chrono::nanoseconds(1000000000 / writes_per_sec);
+        while (!stop.load(std::memory_order_relaxed)) {
+            store.set(keys[pick(rng)], "updated");
+            std::this_thread::sleep_for(interval);
+        }
+    });
+
+    double direct = nsPerRead(keys, reads, [&](const std::string& key) { return store.get(key); });
+    double near = nsPerRead(keys, reads, [&](const std::string& key) { return cache.get(key); });
+
+    stop = true;
+    writer.join();
+
+    auto stats = cache.stats();
+    std::cout << "keys=" << key_count << " reads=" << reads << " writes/s=" << writes_per_sec << "\n";
+    std::cout << "ThreadSafeStore::get  " << direct << " ns/op\n";
+    std::cout << "NearCache::get        " << near << " ns/op  (" << direct / near << "x)\n";
+    std::cout << "hit rate " << stats.hitRate() * 100 << "%, invalidations " << stats.invalidations
+              << ", raced fills " << stats.raced_fills << ", mean served age " << stats.mean_hit_age_ms << " ms\n";
+    return 0;
+}
@@ -0,0 +1,218 @@
+/*
+net_bench - NetServer CPU per request: epoll vs io_uring
+
+Opens C loopback connections to a NetServer and drives them from one
+client thread: every connection keeps one GET in flight and sends the
+next as soon as the reply lands, R times. Per backend it reports
+throughput, server event-loop CPU per request and loop syscalls per
+request (the number io_uring's batching is meant to cut).
+
+The client runs in a forked process so the two sides' descriptors come
+out of separate RLIMIT_NOFILE budgets (10K connections = 10K fds on
+each side). On a single-CPU host client and server share the core, so
+throughput is a lower bound; CPU per request is the figure to compare.
+
+Usage: net_bench [connections=10000] [requests_per_connection=20]
+*/
+
+#include "../include/NetServer.h"
+#include <arpa/inet.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+struct ClientResult {
+    uint64_t completed = 0;
+    uint64_t connected = 0;
+    double seconds = 0;
+};
+
+static void raiseFdLimit() {
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+static bool readAll(int fd, void* buf, size_t n) {
+    auto* p = static_cast<char*>(buf);
+    while (n) {
+        ssize_t got = read(fd, p, n);
+        if (got <= 0) return false;
+        p += got;
+        n -= static_cast<size_t>(got);
+    }
+    return true;
+}
+
+// Client process: per round, connect, report, wait for "go", run, report
+static void clientMain(int from_parent, int to_parent, size_t connections, size_t per_connection, size_t reply_bytes) {
+    raiseFdLimit();
+
+    const std::string key = "bench:key";
+    std::string frame(12, '\0');
+    uint32_t word = static_cast<uint32_t>(8 + key.size());
+    std::memcpy(&frame[0], &word, 4);
+    word = static_cast<uint32_t>(ShmOp::GET);
+    std::memcpy(&frame[4], &word, 4);
+    word = static_cast<uint32_t>(key.size());
+    std::memcpy(&frame[8], &word, 4);
+    frame += key;
+
+    uint16_t port;
+    while (readAll(from_parent, &port, sizeof(port)) && port != 0) {
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        int ep = epoll_create1(0);
+        std::vector<int> fds;
+        for (size_t i = 0; i < connections; i++) {
+            int fd = socket(AF_INET, SOCK_STREAM, 0);
+            if (fd < 0) break;
+            if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+                close(fd);
+                break;
+            }
+            int one = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            epoll_event ev{};
+            ev.events = EPOLLIN;
+            ev.data.u32 = static_cast<uint32_t>(fds.size());
+            epoll_ctl(ep, EPOLL_CTL_ADD, fd, &ev);
+            fds.push_back(fd);
+        }
+
+        ClientResult result;
+        result.connected = fds.size();
+        write(to_parent, &result, sizeof(result));
+        char go;
+        readAll(from_parent, &go, 1);
+
+        // Replies have a fixed size, so counting bytes is enough
+        std::vector<size_t> pending(fds.size(), 0);
+        std::vector<size_t> remaining(fds.size(), per_connection);
+        std::vector<epoll_event> events(1024);
+        std::vector<char> buffer(64 * 1024);
+        size_t active = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < fds.size(); i++) {
+            if (remaining[i] == 0) continue;
+            write(fds[i], frame.data(), frame.size());
+            pending[i] = reply_bytes;
+            active++;
+        }
+        while (active) {
+            int ready = epoll_wait(ep, events.data(), static_cast<int>(events.size()), 1000);
+            if (ready <= 0) break;  // Stalled: report what completed
+            for (int e = 0; e < ready; e++) {
+                uint32_t i = events[e].data.u32;
+                ssize_t n = read(fds[i], buffer.data(), buffer.size());
+                if (n <= 0) {
+                    active--;
+                    epoll_ctl(ep, EPOLL_CTL_DEL, fds[i], nullptr);
+                    continue;
+                }
+                pending[i] -= std::min(pending[i], static_cast<size_t>(n));
+                if (pending[i] != 0) continue;
+
+                result.completed++;
+                if (--remaining[i] == 0) {
+                    active--;
+                    continue;
+                }
+                write(fds[i], frame.data(), frame.size());
+                pending[i] = reply_bytes;
+            }
+        }
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        for (int fd : fds) close(fd);
+        close(ep);
+        write(to_parent, &result, sizeof(result));
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t connections = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000;
+    size_t per_connection = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20;
+    if (connections == 0 || per_connection == 0) {
+        std::cerr << "usage: net_bench [connections] [requests_per_connection]\n";
+        return 1;
+    }
+
+    const size_t value_bytes = 32;
+    const size_t reply_bytes = 8 + value_bytes;
+
+    // Fork before any thread exists
+    int down[2];
+    int up[2];
+    if (pipe(down) != 0 || pipe(up) != 0) return 1;
+    pid_t child = fork();
+    if (child == 0) {
+        close(down[1]);
+        close(up[0]);
+        clientMain(down[0], up[1], connections, per_connection, reply_bytes);
+        _exit(0);
+    }
+    close(down[0]);
+    close(up[1]);
+    raiseFdLimit();
+
+    ThreadSafeStore store;
+    store.set("bench:key", std::string(value_bytes, 'x'));
+
+    std::cout << "connections=" << connections << " requests/connection=" << per_connection
+              << " io_uring " << (NetServer::ioUringSupported() ? "available" : "unavailable") << "\n";
+
+    for (NetBackend backend : {NetBackend::EPOLL, NetBackend::IO_URING}) {
+        NetServerOptions options;
+        options.backend = backend;
+        NetServer server(store, options);
+        if (!server.start()) {
+            std::cerr << "server failed to start\n";
+            continue;
+        }
+        const char* name = server.backend() == NetBackend::IO_URING ? "io_uring" : "epoll   ";
+
+        uint16_t port = server.port();
+        write(down[1], &port, sizeof(port));
+        ClientResult result;
+        if (!readAll(up[0], &result, sizeof(result))) break;
+        while (server.stats().accepted < result.connected) usleep(1000);
+
+        NetServerStats before = server.stats();
+        char go = 'g';
+        write(down[1], &go, 1);
+        if (!readAll(up[0], &result, sizeof(result))) break;
+        NetServerStats after = server.stats();
+        server.stop();
+
+        double requests = static_cast<double>(after.requests - before.requests);
+        if (requests == 0) requests = 1;
+        std::cout << name << "  " << result.connected << " conns  " << result.completed / result.seconds / 1000
+                  << " Kops/s  server CPU " << (after.cpu_seconds - before.cpu_seconds) * 1e9 / requests
+                  << " ns/op  syscalls/op " << (after.loop_syscalls - before.loop_syscalls) / requests;
+        if (after.buffer_stalls) std::cout << "  buffer stalls " << after.buffer_stalls;
+        std::cout << "\n";
+    }
+
+    uint16_t done = 0;
+    write(down[1], &done, sizeof(done));
+    waitpid(child, nullptr, 0);
+    return 0;
+}
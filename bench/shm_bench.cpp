@@ -0,0 +1,201 @@
+/*
+shm_bench - GET round trip: shared memory vs Unix socket vs loopback TCP
+
+The tree has no network server, so the socket side is a minimal one
+built here: a thread per connection reading `u32 length | key` and
+answering `u32 length | value` from the same ThreadSafeStore. That is
+the transport cost alone (no protocol parsing), which favours the
+sockets. One client thread issues GETs back to back on each transport;
+mean / p50 / p99 round trips are reported in µs.
+
+On a single-CPU host every round trip is two context switches
+whatever the transport (spinning is off), so the gap narrows; the
+sub-µs shared-memory numbers need client and dispatcher on separate
+cores.
+
+Usage: shm_bench [requests=200000] [value_bytes=32]
+*/
+
+#include "../include/ShmTransport.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+static bool readAll(int fd, void* buf, size_t n) {
+    auto* p = static_cast<char*>(buf);
+    while (n) {
+        ssize_t got = read(fd, p, n);
+        if (got <= 0) return false;
+        p += got;
+        n -= static_cast<size_t>(got);
+    }
+    return true;
+}
+
+static bool writeAll(int fd, const void* buf, size_t n) {
+    auto* p = static_cast<const char*>(buf);
+    while (n) {
+        ssize_t put = write(fd, p, n);
+        if (put <= 0) return false;
+        p += put;
+        n -= static_cast<size_t>(put);
+    }
+    return true;
+}
+
+// Serve `u32 length | key` → `u32 length | value` until the peer hangs up
+static void serveConnection(ThreadSafeStore& store, int fd) {
+    std::string key;
+    while (true) {
+        uint32_t length;
+        if (!readAll(fd, &length, sizeof(length))) break;
+        key.resize(length);
+        if (!readAll(fd, key.data(), length)) break;
+
+        auto value = store.get(key);
+        std::string reply(sizeof(uint32_t), '\0');
+        uint32_t size = value ? static_cast<uint32_t>(value->size()) : UINT32_MAX;
+        std::memcpy(reply.data(), &size, sizeof(size));
+        if (value) reply += *value;
+        if (!writeAll(fd, reply.data(), reply.size())) break;
+    }
+    close(fd);
+}
+
+static bool socketGet(int fd, const std::string& key, std::string& value) {
+    std::string frame(sizeof(uint32_t), '\0');
+    uint32_t length = static_cast<uint32_t>(key.size());
+    std::memcpy(frame.data(), &length, sizeof(length));
+    frame += key;
+    if (!writeAll(fd, frame.data(), frame.size()) || !readAll(fd, &length, sizeof(length))) return false;
+    if (length == UINT32_MAX) return false;
+    value.resize(length);
+    return readAll(fd, value.data(), length);
+}
+
+struct Latency {
+    double mean_us = 0;
+    double p50_us = 0;
+    double p99_us = 0;
+};
+
+template <typename Get>
+static Latency measure(size_t requests, Get get) {
+    std::vector<double> samples;
+    samples.reserve(requests);
+    for (size_t i = 0; i < requests; i++) {
+        auto start = std::chrono::steady_clock::now();
+        get();
+        auto end = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+    }
+
+    Latency latency;
+    for (double s : samples) latency.mean_us += s;
+    latency.mean_us /= static_cast<double>(samples.size());
+    std::sort(samples.begin(), samples.end());
+    latency.p50_us = samples[samples.size() / 2];
+    latency.p99_us = samples[samples.size() * 99 / 100];
+    return latency;
+}
+
+static void report(const char* name, const Latency& latency) {
+    std::cout << name << "  mean " << latency.mean_us << " µs  p50 " << latency.p50_us << " µs  p99 "
+              << latency.p99_us << " µs\n";
+}
+
+// Connected client socket, with the server side handed to a serving thread
+static int connectPair(ThreadSafeStore& store, int domain, std::thread& server) {
+    int listener = socket(domain, SOCK_STREAM, 0);
+    sockaddr_storage addr{};
+    socklen_t addr_len;
+    if (domain == AF_UNIX) {
+        auto* un = reinterpret_cast<sockaddr_un*>(&addr);
+        un->sun_family = AF_UNIX;
+        // Abstract namespace: nothing to unlink
+        std::string name = "kv-shm-bench-" + std::to_string(getpid());
+        std::memcpy(un->sun_path + 1, name.data(), name.size());
+        addr_len = static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + 1 + name.size());
+    } else {
+        auto* in = reinterpret_cast<sockaddr_in*>(&addr);
+        in->sin_family = AF_INET;
+        in->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        in->sin_port = 0;
+        addr_len = sizeof(sockaddr_in);
+    }
+    if (listener < 0 || bind(listener, reinterpret_cast<sockaddr*>(&addr), addr_len) != 0 ||
+        listen(listener, 1) != 0 || getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &addr_len) != 0) {
+        return -1;
+    }
+
+    int client = socket(domain, SOCK_STREAM, 0);
+    if (client < 0 || connect(client, reinterpret_cast<sockaddr*>(&addr), addr_len) != 0) return -1;
+    int conn = accept(listener, nullptr, nullptr);
+    close(listener);
+    if (conn < 0) return -1;
+
+    if (domain == AF_INET) {
+        int one = 1;
+        setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        setsockopt(conn, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+    server = std::thread(serveConnection, std::ref(store), conn);
+    return client;
+}
+
+int main(int argc, char** argv) {
+    size_t requests = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+    size_t value_bytes = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 32;
+    if (requests == 0) {
+        std::cerr << "usage: shm_bench [requests] [value_bytes]\n";
+        return 1;
+    }
+
+    ThreadSafeStore store;
+    const std::string key = "bench:key";
+    store.set(key, std::string(value_bytes, 'x'));
+
+    std::cout << "requests=" << requests << " value_bytes=" << value_bytes
+              << " cpus=" << std::thread::hardware_concurrency() << "\n";
+
+    {
+        ShmServer server(store);
+        ShmClient client(server.fd());
+        if (!client.connected()) {
+            std::cerr << "shared memory transport unavailable\n";
+            return 1;
+        }
+        report("shared memory", measure(requests, [&] { client.get(key); }));
+        auto stats = server.stats();
+        std::cout << "  dispatcher sleeps " << stats.sleeps << ", wakeups " << stats.wakeups << "\n";
+    }
+
+    for (int domain : {AF_UNIX, AF_INET}) {
+        std::thread server;
+        int fd = connectPair(store, domain, server);
+        if (fd < 0) {
+            std::cerr << (domain == AF_UNIX ? "unix" : "tcp") << " socket setup failed\n";
+            continue;
+        }
+        std::string value;
+        report(domain == AF_UNIX ? "unix socket  " : "loopback tcp ",
+               measure(requests, [&] { socketGet(fd, key, value); }));
+        close(fd);
+        server.join();
+    }
+    return 0;
+}
@@ -0,0 +1,131 @@
+/*
+vector_bench - VSIM recall vs. throughput on synthetic embeddings
+
+Builds an HNSW vector set from N clustered random vectors (like real
+embeddings, which are far from uniform), computes the exact top-10
+for each query by brute force, then sweeps the search ef and reports
+recall@10 and queries/sec for FP32 and Q8 storage.
+
+Usage: vector_bench [vectors=20000] [dim=128] [queries=200]
+       KV_VECTOR_KERNEL=scalar|avx2 vector_bench ...  (force a kernel)
+*/
+
+#include "../include/VectorKernels.h"
+#include "../include/VectorSetType.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+constexpr size_t kTopK = 10;
+
+using Matrix = std::vector<std::vector<float>>;
+
+// `count` points scattered around `centers` random cluster centers
+Matrix clustered(std::mt19937_64& rng, const Matrix& centers, size_t count) {
+    std::normal_distribution<float> noise(0.0f, 0.35f);
+    std::uniform_int_distribution<size_t> pick(0, centers.size() - 1);
+
+    Matrix points(count);
+    for (auto& point : points) {
+        point = centers[pick(rng)];
+        for (float& x : point) x += noise(rng);
+    }
+    return points;
+}
+
+std::vector<float> normalized(std::vector<float> v) {
+    double norm = 0;
+    for (float x : v) norm += static_cast<double>(x) * x;
+    norm = std::sqrt(norm);
+    for (float& x : v) x = static_cast<float>(x / norm);
+    return v;
+}
+
+// Exact top-k by cosine similarity (full scan)
+std::vector<std::unordered_set<std::string>> groundTruth(const Matrix& data, const Matrix& queries) {
+    Matrix unit_data(data.size());
+    for (size_t i = 0; i < data.size(); i++) unit_data[i] = normalized(data[i]);
+
+    std::vector<std::unordered_set<std::string>> truth;
+    std::vector<std::pair<float, size_t>> scored(data.size());
+    for (const auto& query : queries) {
+        auto unit_query = normalized(query);
+        for (size_t i = 0; i < data.size(); i++) {
+            scored[i] = {-dotF32(unit_query.data(), unit_data[i].data(), query.size()), i};
+        }
+        std::partial_sort(scored.begin(), scored.begin() + kTopK, scored.end());
+
+        std::unordered_set<std::string> ids;
+        for (size_t i = 0; i < kTopK; i++) ids.insert("v:" + std::to_string(scored[i].second));
+        truth.push_back(std::move(ids));
+    }
+    return truth;
+}
+
+void run(const char* label, VectorQuant quant, const Matrix& data, const Matrix& queries,
+         const std::vector<std::unordered_set<std::string>>& truth) {
+    RedisVectorSet set(data[0].size(), quant);
+
+    auto build_start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < data.size(); i++) set.add("v:" + std::to_string(i), data[i]);
+    double build_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - build_start).count();
+
+    std::cout << label << ": built " << set.size() << " vectors in " << build_s << " s ("
+              << static_cast<size_t>(set.size() / build_s) << " adds/sec)\n";
+
+    for (size_t ef : {10, 20, 40, 80, 160, 320}) {
+        size_t hits = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t q = 0; q < queries.size(); q++) {
+            for (const auto& match : set.search(queries[q], kTopK, ef)) {
+                hits += truth[q].count(match.element);
+            }
+        }
+        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "  ef=" << ef << "\trecall@10=" << static_cast<double>(hits) / (queries.size() * kTopK)
+                  << "\t" << static_cast<size_t>(queries.size() / secs) << " queries/sec\n";
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    size_t vectors = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000;
+    size_t dim = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 128;
+    size_t queries = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 200;
+    if (vectors < kTopK || dim == 0 || queries == 0) {
+        std::cerr << "usage: vector_bench [vectors] [dim] [queries]\n";
+        return 1;
+    }
+
+    std::mt19937_64 rng(7);
+    std::normal_distribution<float> gaussian(0.0f, 1.0f);
+    Matrix centers(std::max<size_t>(1, vectors / 200), std::vector<float>(dim));
+    for (auto& center : centers) {
+        for (float& x : center) x = gaussian(rng);
+    }
+
+    Matrix data = clustered(rng, centers, vectors);
+    Matrix query_set = clustered(rng, centers, queries);
+
+    std::cout << "Kernel: " << vectorKernelName() << ", " << vectors << " x " << dim
+              << ", " << queries << " queries\n";
+
+    auto truth_start = std::chrono::steady_clock::now();
+    auto truth = groundTruth(data, query_set);
+    double truth_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - truth_start).count();
+    std::cout << "Brute force: " << static_cast<size_t>(queries / truth_s) << " queries/sec\n";
+
+    run("FP32", VectorQuant::FP32, data, query_set, truth);
+    run("Q8", VectorQuant::Q8, data, query_set, truth);
+    return 0;
+}
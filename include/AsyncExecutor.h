@@ -0,0 +1,107 @@
+#ifndef ASYNCEXECUTOR_H
+#define ASYNCEXECUTOR_H
+
+/*
+AsyncExecutor - Background worker that batches submitted operations
+
+Used by ThreadSafeStore to offer non-blocking *_async commands:
+- Callers enqueue a task and return immediately (no lock taken)
+- A single worker drains everything queued so far as ONE batch
+- The batch runner applies the whole batch under one lock acquisition
+- Completions (callbacks) run after the lock is released
+
+Why batch?
+- Under contention, N callers = N lock handoffs
+- With batching, N queued ops = 1 lock handoff
+- Reactor threads only pay for a queue push
+
+C++20 callers also get AsyncAwaiter (below): co_await on a store
+command suspends the coroutine instead of parking a thread on a
+std::future, and the worker resumes it from the completion callback.
+*/
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct AsyncTask {
+    std::function<void()> apply;     // Runs while the batch holds the store lock
+    std::function<void()> complete;  // Runs after the lock is released (optional)
+};
+
+class AsyncExecutor {
+public:
+    using Batch = std::vector<AsyncTask>;
+    using BatchRunner = std::function<void(Batch&)>;
+
+    // runner: applies a batch (e.g. takes the store lock, calls every apply)
+    // max_batch: upper bound on tasks drained per lock acquisition
+    explicit AsyncExecutor(BatchRunner runner, size_t max_batch = 256);
+    ~AsyncExecutor();
+
+    AsyncExecutor(const AsyncExecutor&) = delete;
+    AsyncExecutor& operator=(const AsyncExecutor&) = delete;
+
+    // Enqueue a task (never blocks on the store lock)
+    void submit(AsyncTask task);
+
+    // Number of tasks waiting to be applied
+    size_t pending() const;
+
+    // Number of batches applied so far (for metrics/tests)
+    size_t batchesRun() const;
+
+private:
+    void run();
+
+    BatchRunner runner_;
+    size_t max_batch_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    Batch queue_;
+    size_t batches_run_ = 0;
+    bool stopping_ = false;
+
+    std::thread worker_;  // Declared last: started after all state is ready
+};
+
+#if defined(__cpp_impl_coroutine)
+#include <coroutine>
+#include <optional>
+#include <utility>
+
+// co_await adapter over a callback-style async command. `start` is given
+// the completion callback and must queue the command; the coroutine is
+// resumed on the async worker, after the store lock is released
+template <typename T>
+class AsyncAwaiter {
+public:
+    using Start = std::function<void(std::function<void(T)>)>;
+
+    explicit AsyncAwaiter(Start start) : start_(std::move(start)) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        // The worker may resume (and destroy) the frame holding *this before
+        // start() returns, so nothing of *this is used after queueing
+        Start start = std::move(start_);
+        start([this, handle](T value) {
+            result_.emplace(std::move(value));
+            handle.resume();
+        });
+    }
+
+    T await_resume() { return std::move(*result_); }
+
+private:
+    Start start_;
+    std::optional<T> result_;
+};
+#endif
+
+#endif // ASYNCEXECUTOR_H
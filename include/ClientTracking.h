@@ -0,0 +1,158 @@
+#ifndef CLIENTTRACKING_H
+#define CLIENTTRACKING_H
+
+/*
+ClientTracking.h - Server-assisted client-side caching (CLIENT TRACKING)
+
+A client that caches values locally must learn when they change. With
+tracking on, the store remembers what each client read and tells it
+when any of those keys is modified, so a local copy is valid exactly
+until its invalidation arrives:
+
+    CLIENT TRACKING ON                  → id 7 (calling thread = client 7)
+    GET config:flags                    table: config:flags → {7}
+    (another client) SET config:flags … → client 7 gets "config:flags",
+                                           the table entry is dropped
+
+Modes (like Redis):
+- Default:  the invalidation table maps key → clients that read it.
+            One message per key per read; it must be read again to be
+            tracked again.
+- BCAST:    no per-key state; the client subscribes to prefixes and gets
+            every modified key under them (empty list = all keys).
+- NOLOOP:   don't notify a client about its own writes.
+
+Bounded memory: the table holds at most `max_keys` keys; past that,
+random keys are evicted and their clients invalidated right away (a
+spurious invalidation only costs a re-read; a lost one would serve
+stale data). FLUSHDB / FLUSHALL / SWAPDB invalidate everything (a null
+key).
+
+Locking: reads by tracking clients happen on every reader thread, so
+the table is split into kStripes stripes by key hash, each with its own
+mutex; the client registry (clients, BCAST prefixes) changes only on
+enable/disable and sits behind a shared_mutex that readers share.
+
+A "client" is whatever thread the store's commands run on: the thread
+that calls enable() is bound to the new client, others can bind().
+Callbacks run on the WRITING thread before the write returns, with the
+store lock held - they must be quick and must not call into the store.
+*/
+
+#include "DenseTable.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Key that is no longer valid; null = everything (flush)
+using InvalidationCallback = std::function<void(const std::string* key)>;
+
+struct TrackingOptions {
+    bool bcast = false;
+    std::vector<std::string> prefixes;  // BCAST only; empty = every key
+    bool noloop = false;
+};
+
+struct TrackingStats {
+    size_t clients = 0;
+    size_t keys = 0;              // Invalidation table size
+    size_t max_keys = 0;
+    size_t prefixes = 0;          // Distinct BCAST prefixes
+    uint64_t invalidations = 0;   // Messages delivered
+    uint64_t evicted_keys = 0;    // Dropped to stay under max_keys
+};
+
+class ClientTracking {
+public:
+    static constexpr size_t kDefaultMaxKeys = 1000000;
+
+    explicit ClientTracking(size_t max_keys = kDefaultMaxKeys);
+
+    ClientTracking(const ClientTracking&) = delete;
+    ClientTracking& operator=(const ClientTracking&) = delete;
+
+    // CLIENT TRACKING ON - returns the client id and binds the calling thread to it
+    uint64_t enable(TrackingOptions options, InvalidationCallback callback);
+
+    // CLIENT TRACKING OFF
+    bool disable(uint64_t client);
+
+    // Commands issued by the calling thread now belong to `client` (0 =
+    // none); returns the previous binding so callers can restore it
+    uint64_t bind(uint64_t client);
+
+    // Any client tracking at all (the engine's fast path)
+    bool enabled() const { return clients_count_.load(std::memory_order_relaxed) != 0; }
+
+    // tracking-table-max-keys; shrinking evicts right away
+    void setMaxKeys(size_t max_keys);
+
+    TrackingStats stats() const;
+
+    // ---- Hooks for StorageEngine ----
+
+    // Key looked up by a read command on the calling thread
+    void keyRead(const std::string& key);
+
+    // signalModifiedKey: written, deleted, expired or evicted
+    void keyModified(const std::string& key);
+
+    // Whole keyspace replaced or emptied
+    void flushed();
+
+private:
+    static constexpr size_t kStripes = 16;
+
+    struct Client {
+        TrackingOptions options;
+        std::shared_ptr<const InvalidationCallback> callback;  // Outlives disable() mid-delivery
+    };
+
+    struct Delivery {
+        std::shared_ptr<const InvalidationCallback> callback;
+        std::string key;
+        bool all = false;  // Flush: callback gets null
+    };
+
+    // One slice of the invalidation table (key → clients)
+    struct Stripe {
+        std::mutex mutex;
+        DenseTable<std::pair<std::string, std::vector<uint64_t>>> table;
+    };
+
+    uint64_t boundClient() const;
+    Stripe& stripeOf(const std::string& key) { return stripes_[std::hash<std::string>{}(key) % kStripes]; }
+
+    // Remove key from the stripe, queue its clients' messages (caller
+    // holds the stripe's mutex and clients_mutex_ shared)
+    void invalidateLocked(Stripe& stripe, const std::string& key, uint64_t writer, std::vector<Delivery>& out);
+    // Evict random keys of `stripe` while the whole table is over max_keys_
+    void evictLocked(Stripe& stripe, std::vector<Delivery>& out);
+    void deliver(std::vector<Delivery>& out);
+
+    const uint64_t id_;  // Keys the per-thread client binding
+
+    // Registry: written by enable/disable, shared by everything else
+    mutable std::shared_mutex clients_mutex_;
+    std::unordered_map<uint64_t, Client> clients_;
+    std::vector<std::pair<std::string, std::vector<uint64_t>>> prefixes_;  // BCAST prefix → clients
+    uint64_t next_client_ = 1;
+
+    std::array<Stripe, kStripes> stripes_;
+    std::atomic<size_t> keys_{0};  // Entries over all stripes
+    std::atomic<size_t> max_keys_;
+    std::atomic<uint64_t> invalidations_{0};
+    std::atomic<uint64_t> evicted_keys_{0};
+    std::atomic<size_t> clients_count_{0};
+};
+
+#endif // CLIENTTRACKING_H
@@ -0,0 +1,223 @@
+#ifndef DENSETABLE_H
+#define DENSETABLE_H
+
+/*
+DenseTable.h - Dense hash table behind SET and HASH values
+
+std::unordered_set/map can't pick a uniformly random element in
+O(1): buckets are uneven and mostly empty after deletions, so
+SRANDMEMBER / SPOP / HRANDFIELD would need a walk.
+
+Here the elements live in ONE contiguous vector and a separate
+open-addressing index maps key → position:
+
+    entries_: [ "a", "b", "c" ]          dense, insertion order until deletes
+    hashes_:  [ h(a), h(b), h(c) ]       cached, so rehash/erase never re-hashes keys
+    slots_:   [ 0, 2, 0, 3, 1, 0, 0, 0 ] position + 1 (0 = empty), linear probing
+
+- Random element: entries_[uniform(0, size - 1)] - O(1), exactly uniform
+- Erase: backward-shift the probe chain (no tombstones), then move the
+  last entry into the hole (swap-remove), fixing its one slot
+- ~12 bytes of index per element (vs ~40 for a node-based map) and
+  iteration is a linear scan
+
+The interface mirrors the parts of unordered_set/map the engine uses
+(find/insert/try_emplace/operator[]/erase/count/iteration). Keys of
+stored entries must not be modified through iterators.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+template <typename Entry>
+class DenseTable {
+public:
+    using value_type = Entry;
+    using iterator = typename std::vector<Entry>::iterator;
+    using const_iterator = typename std::vector<Entry>::const_iterator;
+
+    DenseTable() = default;
+
+    template <typename It>
+    DenseTable(It first, It last) {
+        for (; first != last; ++first) insert(*first);
+    }
+
+    size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+
+    iterator begin() { return entries_.begin(); }
+    iterator end() { return entries_.end(); }
+    const_iterator begin() const { return entries_.begin(); }
+    const_iterator end() const { return entries_.end(); }
+
+    // Element by dense position (0 .. size-1), for random sampling
+    const Entry& at(size_t index) const { return entries_[index]; }
+
+    iterator find(std::string_view key) {
+        size_t slot = findSlot(key, hashOf(key));
+        return slot == kNotFound || slots_[slot] == 0 ? end() : begin() + (slots_[slot] - 1);
+    }
+
+    const_iterator find(std::string_view key) const {
+        size_t slot = findSlot(key, hashOf(key));
+        return slot == kNotFound || slots_[slot] == 0 ? end() : begin() + (slots_[slot] - 1);
+    }
+
+    size_t count(std::string_view key) const { return find(key) != end() ? 1 : 0; }
+
+    std::pair<iterator, bool> insert(Entry entry) {
+        std::string_view key = keyOf(entry);
+        size_t hash = hashOf(key);
+        reserveOneMore();
+
+        size_t slot = findSlot(key, hash);
+        if (slots_[slot] != 0) return {begin() + (slots_[slot] - 1), false};
+        return {place(slot, hash, std::move(entry)), true};
+    }
+
+    // Map-style (Entry = pair<string, V>): constructs V only if key is new
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const std::string& key, Args&&... args) {
+        size_t hash = hashOf(key);
+        reserveOneMore();
+
+        size_t slot = findSlot(key, hash);
+        if (slots_[slot] != 0) return {begin() + (slots_[slot] - 1), false};
+        return {place(slot, hash, Entry(key, typename Entry::second_type(std::forward<Args>(args)...))), true};
+    }
+
+    auto& operator[](const std::string& key) { return try_emplace(key).first->second; }
+
+    size_t erase(std::string_view key) {
+        size_t slot = findSlot(key, hashOf(key));
+        if (slot == kNotFound || slots_[slot] == 0) return 0;
+        eraseSlot(slot);
+        return 1;
+    }
+
+    // Returns an iterator to the same position, which now holds the
+    // former last element (so erase-while-iterating loops still work)
+    iterator erase(const_iterator it) {
+        size_t index = static_cast<size_t>(it - entries_.cbegin());
+        eraseSlot(slotOf(index));
+        return begin() + index;
+    }
+
+    void clear() {
+        entries_.clear();
+        hashes_.clear();
+        slots_.clear();
+    }
+
+    void reserve(size_t n) {
+        if (n * 4 > slots_.size() * 3) rehash(capacityFor(n));
+        entries_.reserve(n);
+        hashes_.reserve(n);
+    }
+
+private:
+    static constexpr size_t kNotFound = static_cast<size_t>(-1);
+
+    static std::string_view keyOf(const std::string& entry) { return entry; }
+
+    template <typename V>
+    static std::string_view keyOf(const std::pair<std::string, V>& entry) { return entry.first; }
+
+    static size_t hashOf(std::string_view key) { return std::hash<std::string_view>()(key); }
+
+    // Smallest power of two keeping the load factor <= 0.75
+    static size_t capacityFor(size_t n) {
+        size_t capacity = 8;
+        while (n * 4 > capacity * 3) capacity *= 2;
+        return capacity;
+    }
+
+    // Slot holding key, or the empty slot ending its probe chain
+    size_t findSlot(std::string_view key, size_t hash) const {
+        if (slots_.empty()) return kNotFound;
+
+        size_t mask = slots_.size() - 1;
+        for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+            uint32_t stored = slots_[slot];
+            if (stored == 0) return slot;
+            if (hashes_[stored - 1] == hash && keyOf(entries_[stored - 1]) == key) return slot;
+        }
+    }
+
+    // Slot pointing at a known dense position
+    size_t slotOf(size_t index) const {
+        size_t mask = slots_.size() - 1;
+        size_t slot = hashes_[index] & mask;
+        while (slots_[slot] != index + 1) slot = (slot + 1) & mask;
+        return slot;
+    }
+
+    void reserveOneMore() {
+        if ((entries_.size() + 1) * 4 > slots_.size() * 3) rehash(capacityFor(entries_.size() + 1) * 2);
+    }
+
+    iterator place(size_t slot, size_t hash, Entry entry) {
+        entries_.push_back(std::move(entry));
+        hashes_.push_back(hash);
+        slots_[slot] = static_cast<uint32_t>(entries_.size());
+        return end() - 1;
+    }
+
+    void rehash(size_t capacity) {
+        slots_.assign(capacity, 0);
+        size_t mask = capacity - 1;
+        for (size_t i = 0; i < hashes_.size(); i++) {
+            size_t slot = hashes_[i] & mask;
+            while (slots_[slot] != 0) slot = (slot + 1) & mask;
+            slots_[slot] = static_cast<uint32_t>(i + 1);
+        }
+    }
+
+    void eraseSlot(size_t slot) {
+        size_t index = slots_[slot] - 1;
+        size_t mask = slots_.size() - 1;
+
+        // Backward shift: pull later chain members into the hole
+        slots_[slot] = 0;
+        for (size_t next = (slot + 1) & mask; slots_[next] != 0; next = (next + 1) & mask) {
+            size_t home = hashes_[slots_[next] - 1] & mask;
+            if (((next - home) & mask) >= ((next - slot) & mask)) {
+                slots_[slot] = slots_[next];
+                slots_[next] = 0;
+                slot = next;
+            }
+        }
+
+        // Swap-remove keeps entries_ dense
+        size_t last = entries_.size() - 1;
+        if (index != last) {
+            slots_[slotOf(last)] = static_cast<uint32_t>(index + 1);
+            entries_[index] = std::move(entries_[last]);
+            hashes_[index] = hashes_[last];
+        }
+        entries_.pop_back();
+        hashes_.pop_back();
+
+        // Give memory back after mass deletes
+        if (slots_.size() > 16 && entries_.size() * 8 < slots_.size()) {
+            entries_.shrink_to_fit();
+            hashes_.shrink_to_fit();
+            rehash(capacityFor(entries_.size()) * 2);
+        }
+    }
+
+    std::vector<Entry> entries_;
+    std::vector<size_t> hashes_;
+    std::vector<uint32_t> slots_;
+};
+
+using DenseSet = DenseTable<std::string>;
+using DenseHash = DenseTable<std::pair<std::string, std::string>>;
+
+#endif // DENSETABLE_H
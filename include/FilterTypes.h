@@ -0,0 +1,119 @@
+#ifndef FILTERTYPES_H
+#define FILTERTYPES_H
+
+/*
+FilterTypes.h - Probabilistic membership filters (BF.* / CF.*)
+
+"Have we seen this ID?" without storing the IDs:
+- SET of 1B ids   : tens of GB
+- Bloom, 1% error : ~1.2 GB (≈ 9.6 bits per id)
+
+1. ScalableBloomFilter (BF.ADD / BF.EXISTS / BF.MADD / BF.MEXISTS)
+   - Blocked Bloom: every item maps to ONE 64-byte block (a cache
+     line) and sets k bits inside it → one cache miss per probe
+   - Layers are sized for the blocked layout (a bit bigger than a
+     classic Bloom filter for the same error rate)
+   - Probe = build an 8-word mask, then (block & mask) == mask:
+     eight independent 64-bit ops (AVX2 when available, otherwise
+     the compiler vectorizes the plain loop)
+   - Scalable: when a layer is full a new one is added with
+     `expansion`x capacity and half the error rate, so the total
+     error stays bounded by ~2x the requested rate
+   - Batch checks hash everything first and prefetch all blocks,
+     overlapping the cache misses
+
+2. CuckooFilter (CF.ADD / CF.EXISTS / CF.DEL)
+   - Supports DELETE (Bloom can't)
+   - Buckets of 4 x 16-bit fingerprints = one uint64_t; a bucket is
+     searched with SWAR (SIMD within a register) bit tricks
+   - Each item has two candidate buckets; inserts relocate
+     ("kick") existing fingerprints when both are full
+   - ~0.01% false positives per table (16-bit fingerprints, 4-way
+     buckets); a full table gets a bigger sibling instead of failing
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class ScalableBloomFilter {
+public:
+    static constexpr double kDefaultErrorRate = 0.01;
+    static constexpr size_t kDefaultCapacity = 100;
+
+    ScalableBloomFilter(double error_rate = kDefaultErrorRate,
+                        size_t capacity = kDefaultCapacity,
+                        unsigned expansion = 2);
+
+    // Returns true if the item was (probably) not present before
+    bool add(const std::string& item);
+
+    bool contains(const std::string& item) const;
+
+    // Batch forms: hash all items, prefetch all blocks, then probe
+    std::vector<bool> addMany(const std::vector<std::string>& items);
+    std::vector<bool> containsMany(const std::vector<std::string>& items) const;
+
+    size_t count() const { return count_; }       // Items added
+    size_t layers() const { return layers_.size(); }
+    size_t bytes() const;                          // Filter memory
+    double errorRate() const { return error_rate_; }
+
+private:
+    struct alignas(64) Block {
+        uint64_t words[8];
+    };
+
+    struct Layer {
+        std::vector<Block> blocks;
+        unsigned hashes;   // k bits per item
+        size_t capacity;
+        size_t count = 0;
+    };
+
+    void addLayer(size_t capacity, double error_rate);
+
+    std::vector<Layer> layers_;
+    double error_rate_;
+    unsigned expansion_;
+    size_t count_ = 0;
+    double next_error_;    // Error rate for the next layer
+};
+
+class CuckooFilter {
+public:
+    static constexpr size_t kDefaultCapacity = 1024;
+    static constexpr size_t kSlotsPerBucket = 4;
+    static constexpr int kMaxKicks = 500;
+
+    explicit CuckooFilter(size_t capacity = kDefaultCapacity, unsigned expansion = 2);
+
+    // Always inserts (duplicates allowed, like CF.ADD)
+    bool add(const std::string& item);
+
+    bool contains(const std::string& item) const;
+    std::vector<bool> containsMany(const std::vector<std::string>& items) const;
+
+    // Removes one copy; false if not found
+    bool remove(const std::string& item);
+
+    size_t count() const { return count_; }
+    size_t bytes() const;
+
+private:
+    // One bucket = 4 x 16-bit fingerprints packed in a word (0 = empty)
+    struct Table {
+        std::vector<uint64_t> buckets;
+        size_t mask;  // buckets.size() - 1 (power of two)
+    };
+
+    void addTable(size_t capacity);
+    static bool insertInto(Table& table, uint64_t hash, uint16_t fp);
+
+    std::vector<Table> tables_;   // Grows by adding tables (scalable)
+    unsigned expansion_;
+    size_t count_ = 0;
+};
+
+#endif // FILTERTYPES_H
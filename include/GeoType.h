@@ -0,0 +1,117 @@
+#ifndef GEOTYPE_H
+#define GEOTYPE_H
+
+/*
+GeoType.h - Geospatial index (GEOADD / GEOSEARCH / GEODIST)
+
+Each member's position is encoded as a 52-bit geohash:
+- longitude and latitude are each quantized to 26 bits
+- the bits are interleaved, so nearby points share hash prefixes
+- a prefix of 2*s bits is a grid cell; all points in the cell form
+  ONE contiguous range in the sorted index
+
+Search (radius or box):
+1. Pick the finest grid step whose cells are at least as big as the
+   search radius, so the query area fits in the 3x3 cells around
+   the center
+2. Range-scan those 9 cells in the ordered index (lower_bound)
+3. Filter candidates by exact distance in a branch-free loop over
+   struct-of-arrays data (vectorizes: only mul/add/compare, using
+   sin/cos precomputed at GEOADD time)
+
+Index layout: sorted chunks of up to 128 points, each chunk stored
+as parallel arrays (hash[], sin_lat[], ...) and indexed by its first
+(hash, member) in a std::map. A cell scan reads contiguous memory and
+the distance filter runs straight over the chunk arrays.
+*/
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+struct GeoMember {
+    double longitude;
+    double latitude;
+    std::string member;
+};
+
+struct GeoSearchQuery {
+    std::optional<std::string> from_member;  // FROMMEMBER (else FROMLONLAT)
+    double longitude = 0;
+    double latitude = 0;
+    double radius = 0;                       // BYRADIUS when > 0
+    double width = 0;                        // BYBOX when width/height > 0
+    double height = 0;
+    std::string unit = "m";                  // m | km | mi | ft
+    size_t count = 0;                        // 0 = no limit
+    bool ascending = true;                   // Sort by distance
+};
+
+struct GeoResult {
+    std::string member;
+    double distance;                         // In the query's unit
+    double longitude;
+    double latitude;
+};
+
+class RedisGeo {
+public:
+    static constexpr int kStepBits = 26;     // Bits per axis (52 total)
+
+    // Meters per unit, nullopt for unknown units
+    static std::optional<double> unitToMeters(const std::string& unit);
+
+    // Valid coordinates (Redis/EPSG:900913 latitude limits)
+    static bool validCoordinates(double longitude, double latitude);
+
+    // Returns true if the member is new (false = position updated)
+    bool add(double longitude, double latitude, const std::string& member);
+    bool remove(const std::string& member);
+
+    std::optional<std::pair<double, double>> position(const std::string& member) const;
+    std::optional<double> distance(const std::string& a, const std::string& b) const;  // Meters
+    std::optional<uint64_t> hash(const std::string& member) const;
+
+    // nullopt if the query is invalid (unknown unit/member, no shape)
+    std::optional<std::vector<GeoResult>> search(const GeoSearchQuery& query) const;
+
+    size_t size() const { return members_.size(); }
+
+private:
+    static constexpr size_t kChunkPoints = 128;
+
+    using IndexKey = std::pair<uint64_t, std::string>;  // (geohash, member)
+
+    // Sorted run of points as parallel arrays (struct-of-arrays)
+    struct Chunk {
+        std::vector<uint64_t> hash;
+        std::vector<std::string> member;
+        std::vector<double> longitude, latitude;
+        std::vector<double> sin_lat, cos_lat, sin_lon, cos_lon;  // For the filter
+
+        size_t size() const { return hash.size(); }
+        IndexKey key(size_t i) const { return IndexKey{hash[i], member[i]}; }
+        size_t find(uint64_t h, const std::string& m) const;    // Index or size()
+        void insert(size_t pos, uint64_t h, const std::string& m, double lon, double lat);
+        void erase(size_t pos);
+        Chunk splitHalf();                                       // Moves upper half out
+    };
+
+    using ChunkMap = std::map<IndexKey, Chunk>;               // First key → chunk
+
+    // Chunk that holds (or would hold) `key`
+    ChunkMap::iterator chunkFor(const IndexKey& key);
+    ChunkMap::const_iterator chunkFor(const IndexKey& key) const;
+
+    void insertPoint(uint64_t h, const std::string& member, double lon, double lat);
+    void erasePoint(uint64_t h, const std::string& member);
+
+    ChunkMap chunks_;
+    std::unordered_map<std::string, uint64_t> members_;  // member → geohash
+};
+
+#endif // GEOTYPE_H
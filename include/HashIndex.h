@@ -0,0 +1,127 @@
+#ifndef HASHINDEX_H
+#define HASHINDEX_H
+
+/*
+HashIndex.h - Secondary indexes over HASH fields
+
+Without them, "find the user with this email" means either scanning
+every hash or keeping hand-written SET index keys in sync (two writes
+per update, drift whenever one of them fails).
+
+Here an index is declared once and the engine maintains it inside
+HSET / HDEL / DEL / expiry:
+
+    HINDEX.CREATE users_by_email PREFIX user: FIELD email EXACT
+    HINDEX.CREATE users_by_age   PREFIX user: FIELD age   NUMERIC
+    HINDEX.LOOKUP users_by_email alice@example.com   → [user:42]
+    HINDEX.RANGE  users_by_age 18 30                  → keys by age
+
+Index kinds:
+- EXACT:   value → set of keys (hash map, O(1) lookup)
+- NUMERIC: ordered set of (number, key), O(log n + k) range scans;
+           values that don't parse as numbers are simply not indexed
+
+Write cost: a field write does one hash lookup (field → indexes) and
+nothing else when the field isn't indexed; an indexed field costs one
+erase + one insert per covering index. No indexes → one branch.
+
+Concurrency: the catalog changes only under the store's exclusive lock
+(writers, eviction, cleanupExpired). HINDEX.LOOKUP / RANGE iterate it
+under the shared lock, so reads never unindex: an expired key or field
+keeps its entries until a writer or cleanupExpired reclaims it, and
+the engine re-checks each hit against the live hash instead.
+*/
+
+#include "DenseTable.h"
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+enum class HashIndexKind {
+    EXACT,
+    NUMERIC
+};
+
+struct HashIndexInfo {
+    std::string name;
+    std::string prefix;         // Keys covered (empty = all hashes)
+    std::string field;
+    HashIndexKind kind;
+    size_t entries;             // Indexed (key, value) pairs
+};
+
+class HashIndex {
+public:
+    HashIndex(std::string prefix, std::string field, HashIndexKind kind)
+        : prefix_(std::move(prefix)), field_(std::move(field)), kind_(kind) {}
+
+    const std::string& prefix() const { return prefix_; }
+    const std::string& field() const { return field_; }
+    HashIndexKind kind() const { return kind_; }
+    size_t entries() const { return entries_; }
+
+    bool covers(const std::string& key) const { return key.compare(0, prefix_.size(), prefix_) == 0; }
+
+    void insert(const std::string& key, const std::string& value);
+    void erase(const std::string& key, const std::string& value);
+    void clear();
+
+    // EXACT: keys whose field equals value (nullptr if none)
+    const std::unordered_set<std::string>* lookup(const std::string& value) const;
+
+    // NUMERIC: keys with min <= field <= max in ascending value order;
+    // stops when visit returns false
+    void forEachInRange(double min, double max,
+                        const std::function<bool(const std::string& key)>& visit) const;
+
+    // Whole-string decimal number (NaN rejected)
+    static std::optional<double> parseNumber(const std::string& value);
+
+private:
+    std::string prefix_;
+    std::string field_;
+    HashIndexKind kind_;
+    size_t entries_ = 0;
+
+    std::unordered_map<std::string, std::unordered_set<std::string>> exact_;
+    std::set<std::pair<double, std::string>> numeric_;
+};
+
+// All indexes of one keyspace, routed by field name
+class HashIndexCatalog {
+public:
+    using Hash = DenseHash;
+
+    bool empty() const { return indexes_.empty(); }
+
+    // False if the name is taken
+    bool create(const std::string& name, HashIndex index);
+    bool drop(const std::string& name);
+    const HashIndex* find(const std::string& name) const;
+    std::vector<HashIndexInfo> list() const;
+
+    // One field of `key` changed; null = field absent before / after
+    void fieldChanged(const std::string& key, const std::string& field,
+                      const std::string* old_value, const std::string* new_value);
+
+    // Whole hash appeared / disappeared (load, DEL, expiry, overwrite)
+    void hashAdded(const std::string& key, const Hash& hash);
+    void hashRemoved(const std::string& key, const Hash& hash);
+
+    // FLUSHDB: drop all entries, keep the definitions
+    void clearEntries();
+
+private:
+    std::map<std::string, std::unique_ptr<HashIndex>> indexes_;       // name → index
+    std::unordered_map<std::string, std::vector<HashIndex*>> by_field_; // field → indexes
+};
+
+#endif // HASHINDEX_H
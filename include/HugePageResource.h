@@ -0,0 +1,111 @@
+#ifndef HUGEPAGERESOURCE_H
+#define HUGEPAGERESOURCE_H
+
+/*
+HugePageResource - 2 MB page backed memory for the keyspace
+
+Random-key GETs over a big keyspace touch a different 4 KB page
+almost every time, so the TLB (a few thousand entries) misses a lot.
+One 2 MB huge page covers 512 normal pages → far fewer TLB misses.
+
+Modes:
+- OFF       : plain heap (default)
+- TRANSPARENT: 2 MB aligned mmap + madvise(MADV_HUGEPAGE); the kernel
+               backs it with huge pages when it can (THP "madvise" mode)
+- EXPLICIT  : mmap(MAP_HUGETLB) from the hugetlbfs pool
+               (needs vm.nr_hugepages > 0; falls back to TRANSPARENT)
+
+Layout:
+- Small requests are rounded up to a power-of-two size class and
+  bump-allocated from 2 MB aligned regions. A freed block goes on its
+  class's free list and is handed out again before the bump pointer
+  moves, so the arena is bounded by the peak live size per class, not
+  by everything ever allocated (the pool resource on top returns
+  whole chunks and its oversize blocks - rehashed bucket arrays - here)
+- Large requests (bucket arrays) get their own aligned mapping
+  and are unmapped on deallocate
+
+NUMA:
+- Given a node, every region is mbind()'ed to it before first touch,
+  so the table lands on that node whichever thread writes it
+  (a node with mode OFF still maps regions, just without huge pages)
+
+Used as the upstream of a std::pmr pool for StorageEngine's table.
+*/
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+enum class HugePageMode {
+    OFF,
+    TRANSPARENT,
+    EXPLICIT
+};
+
+// Huge page coverage of the arena (read from /proc/self/smaps)
+struct HugePageStats {
+    size_t mapped_bytes = 0;  // Bytes mmap'ed by the arena
+    size_t huge_bytes = 0;    // Of those, bytes currently on huge pages
+    double coverage() const {
+        return mapped_bytes ? static_cast<double>(huge_bytes) / mapped_bytes : 0.0;
+    }
+};
+
+class HugePageResource : public std::pmr::memory_resource {
+public:
+    static constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+
+    // numa_node: OS node id to place regions on (-1 = first-touch policy)
+    explicit HugePageResource(HugePageMode mode = HugePageMode::TRANSPARENT,
+                              int numa_node = -1);
+    ~HugePageResource() override;
+
+    HugePageResource(const HugePageResource&) = delete;
+    HugePageResource& operator=(const HugePageResource&) = delete;
+
+    // Mode actually in use (EXPLICIT degrades to TRANSPARENT if the
+    // hugetlbfs pool is empty)
+    HugePageMode mode() const { return mode_; }
+    int numaNode() const { return numa_node_; }
+
+    HugePageStats stats() const;
+
+private:
+    struct Region {
+        char* base;
+        size_t size;
+    };
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    static constexpr size_t kMinBlock = 16;  // Smallest class; also the free-list alignment
+    static constexpr size_t kSizeClasses = 16;  // 16 B ... 512 KB
+
+    // Free list of a small size class; the next pointer lives in the block
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    // Map `size` bytes (multiple of 2 MB) at 2 MB alignment
+    char* mapRegion(size_t size);
+    void unmapRegion(char* base, size_t size);
+
+    // Regions come from mmap (huge pages or a NUMA binding need it)
+    bool mmapped() const { return mode_ != HugePageMode::OFF || numa_node_ >= 0; }
+
+    HugePageMode mode_;
+    int numa_node_;
+
+    mutable std::mutex mutex_;
+    std::vector<Region> regions_;  // Every live mapping (for stats)
+    char* bump_ = nullptr;         // Next free byte in current small-object region
+    char* bump_end_ = nullptr;
+    std::array<FreeBlock*, kSizeClasses> free_{};  // Freed small blocks by class
+};
+
+#endif // HUGEPAGERESOURCE_H
@@ -0,0 +1,114 @@
+#ifndef JSONTYPE_H
+#define JSONTYPE_H
+
+/*
+JsonType.h - JSON document type (JSON.GET / JSON.SET / ...)
+
+Storing JSON as a STRING means every field update is
+GET → parse → modify → serialize → SET of the WHOLE document
+(100 KB moved twice to change one number).
+
+Here the document is parsed once into a tree and updated in place:
+- JSON.SET key $.user.name '"bob"'   → replaces one node
+- JSON.NUMINCRBY key $.visits 1      → touches one number
+- JSON.ARRAPPEND key $.tags '"new"'  → vector push_back
+
+Tree layout (JsonValue is one std::variant, 40 bytes):
+- null / bool / int64 / double stored inline
+- strings own their bytes
+- arrays are std::vector<JsonValue>
+- objects are std::vector<pair<key, JsonValue>>: insertion order is
+  preserved (like RedisJSON) and small objects scan faster than a map
+
+Paths (subset of JSONPath): $ (root), .key, ['key'], [index],
+negative indices count from the end. "." is accepted as root too.
+
+Parser: single-pass recursive descent. String bodies are scanned
+8 bytes at a time (SWAR) for '"', '\' and control characters,
+numbers go through std::from_chars.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+struct JsonValue;
+
+using JsonArray = std::vector<JsonValue>;
+using JsonObject = std::vector<std::pair<std::string, JsonValue>>;
+
+struct JsonValue {
+    std::variant<std::nullptr_t, bool, int64_t, double, std::string, JsonArray, JsonObject> data = nullptr;
+
+    // nullopt on malformed JSON (or nesting deeper than kMaxDepth)
+    static std::optional<JsonValue> parse(std::string_view text);
+    static constexpr int kMaxDepth = 512;
+
+    std::string dump() const;
+    void dump(std::string& out) const;
+
+    // "null" | "boolean" | "integer" | "number" | "string" | "array" | "object"
+    std::string typeName() const;
+
+    // Approximate bytes held by this subtree (nodes, strings, member keys)
+    size_t footprint() const;
+
+    // Values in this subtree, itself included
+    size_t nodeCount() const;
+};
+
+class RedisJson {
+public:
+    explicit RedisJson(JsonValue root)
+        : root_(std::move(root)), bytes_(root_.footprint()), nodes_(root_.nodeCount()) {}
+
+    // JSON.GET - serialized value at path
+    std::optional<std::string> get(const std::string& path) const;
+
+    // JSON.SET - replace the value at path, or add a new member when
+    // the parent is an object; false if the parent doesn't exist
+    bool set(const std::string& path, JsonValue value);
+
+    // JSON.DEL - returns 1 if removed (root can't be deleted here;
+    // the engine deletes the key instead)
+    size_t del(const std::string& path);
+
+    // JSON.NUMINCRBY - new value serialized, nullopt if not a number
+    std::optional<std::string> numIncrBy(const std::string& path, double increment);
+
+    // JSON.ARRAPPEND - new array length, nullopt if not an array
+    std::optional<size_t> arrAppend(const std::string& path, std::vector<JsonValue> values);
+
+    // JSON.TYPE
+    std::optional<std::string> type(const std::string& path) const;
+
+    static bool isRootPath(const std::string& path);
+
+    // Running footprint of the document: each mutation adjusts it by the
+    // subtrees it adds or drops, so MEMORY USAGE never walks the whole tree
+    size_t bytes() const { return bytes_; }
+
+    // Running count of values in the document (lazy free sizes its
+    // destruction by it: every node may own an allocation)
+    size_t nodes() const { return nodes_; }
+
+private:
+    using PathStep = std::variant<std::string, int64_t>;  // key or index
+
+    static std::optional<std::vector<PathStep>> parsePath(const std::string& path);
+
+    // Walks `steps` from the root, nullptr if any step is missing
+    JsonValue* resolve(const std::vector<PathStep>& steps);
+    const JsonValue* resolve(const std::vector<PathStep>& steps) const;
+
+    JsonValue root_;
+    size_t bytes_;
+    size_t nodes_;
+};
+
+#endif // JSONTYPE_H
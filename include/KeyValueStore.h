@@ -27,14 +27,38 @@ private:
     StorageEngine storage_;  //composition over inheritance
     
 public:
+    explicit KeyValueStore(const StorageOptions& options = StorageOptions())
+        : storage_(options) {}
+    
     // ========== STRING COMMANDS ==========
     
     // SET key value [EX seconds]
     bool set(const std::string& key, const std::string& value, int ttl = 0);
     
+    // SET key value [NX | XX] [GET] [EX | PX | EXAT | PXAT | KEEPTTL]
+    SetResult set(const std::string& key, const std::string& value, const SetOptions& options);
+    
     // GET key
     std::optional<std::string> get(const std::string& key) const;
     
+    // APPEND key value - returns the new length
+    size_t append(const std::string& key, const std::string& value);
+    
+    // SETRANGE key offset value - returns the new length
+    size_t setrange(const std::string& key, size_t offset, const std::string& value);
+    
+    // GETRANGE key start end - copies only the requested range
+    std::string getrange(const std::string& key, long start, long end) const;
+    
+    // STRLEN key
+    size_t strlen(const std::string& key) const;
+    
+    // GETEX key [EX seconds | PERSIST]
+    std::optional<std::string> getex(const std::string& key, int ttl = 0, bool persist = false);
+    
+    // GETDEL key
+    std::optional<std::string> getdel(const std::string& key);
+    
     // ========== LIST COMMANDS ==========
     
     // LPUSH key value [value ...]
@@ -55,6 +79,28 @@ public:
     // LLEN key
     size_t llen(const std::string& key) const;
     
+    // LINDEX key index
+    std::optional<std::string> lindex(const std::string& key, int index) const;
+    
+    // LSET key index value
+    bool lset(const std::string& key, int index, const std::string& value);
+    
+    // LINSERT key BEFORE|AFTER pivot value (-1 = no pivot, 0 = no key)
+    long linsert(const std::string& key, ListInsert where, const std::string& pivot, const std::string& value);
+    
+    // LTRIM key start stop
+    bool ltrim(const std::string& key, int start, int stop);
+    
+    // LREM key count value
+    size_t lrem(const std::string& key, int count, const std::string& value);
+    
+    // LPOS key value [RANK r] [COUNT n] [MAXLEN len]
+    std::vector<size_t> lpos(const std::string& key, const std::string& value, int rank = 1, size_t count = 1,
+                             size_t maxlen = 0) const;
+    
+    // LMOVE source destination LEFT|RIGHT LEFT|RIGHT
+    std::optional<std::string> lmove(const std::string& source, const std::string& destination, ListEnd from, ListEnd to);
+    
     // ========== SET COMMANDS ==========
     
     // SADD key member [member ...]
@@ -72,6 +118,15 @@ public:
     // SCARD key
     size_t scard(const std::string& key) const;
     
+    // SMISMEMBER key member1 [member2 ...]
+    std::vector<bool> smismember(const std::string& key, const std::vector<std::string>& members) const;
+    
+    // SRANDMEMBER key [count] - negative count allows repeats
+    std::vector<std::string> srandmember(const std::string& key, long count = 1) const;
+    
+    // SPOP key [count]
+    std::vector<std::string> spop(const std::string& key, size_t count = 1);
+    
     // ========== HASH COMMANDS ==========
     
     // HSET key field value
@@ -92,11 +147,270 @@ public:
     // HLEN key
     size_t hlen(const std::string& key) const;
     
+    // HEXPIRE key seconds FIELDS field [field ...]
+    std::vector<int> hexpire(const std::string& key, int seconds, const std::vector<std::string>& fields);
+    
+    // HTTL key FIELDS field [field ...]
+    std::vector<int> httl(const std::string& key, const std::vector<std::string>& fields) const;
+    
+    // HPERSIST key FIELDS field [field ...]
+    std::vector<int> hpersist(const std::string& key, const std::vector<std::string>& fields);
+    
+    // HSET key field1 value1 [field2 value2 ...] - number of new fields
+    size_t hset(const std::string& key, const std::vector<std::pair<std::string, std::string>>& fields);
+    
+    // HMGET key field1 [field2 ...]
+    std::vector<std::optional<std::string>> hmget(const std::string& key, const std::vector<std::string>& fields) const;
+    
+    // HRANDFIELD key [count] WITHVALUES
+    std::vector<std::pair<std::string, std::string>> hrandfield(const std::string& key, long count = 1) const;
+    
+    // ========== STREAM COMMANDS ==========
+    
+    // XADD key [MAXLEN n] id field value [field value ...]
+    std::optional<std::string> xadd(const std::string& key, const std::string& id,
+                                    const StreamFields& fields, size_t maxlen = 0);
+    
+    // XRANGE key start end [COUNT n]
+    std::vector<StreamEntry> xrange(const std::string& key, const std::string& start,
+                                    const std::string& end, size_t count = 0) const;
+    
+    // XREAD [COUNT n] STREAMS key [key ...] id [id ...]
+    std::vector<std::pair<std::string, std::vector<StreamEntry>>> xread(
+        const std::vector<std::pair<std::string, std::string>>& streams, size_t count = 0) const;
+    
+    // Last entry ID of a stream ("0-0" if missing)
+    std::string streamLastId(const std::string& key) const;
+    
+    // XLEN key
+    size_t xlen(const std::string& key) const;
+    
+    // XTRIM key MAXLEN n
+    size_t xtrim(const std::string& key, size_t maxlen);
+    
+    // XGROUP CREATE key group id [MKSTREAM]
+    bool xgroupCreate(const std::string& key, const std::string& group,
+                      const std::string& id, bool mkstream = false);
+    
+    // XREADGROUP GROUP group consumer [COUNT n] STREAMS key id
+    std::optional<std::vector<StreamEntry>> xreadgroup(const std::string& key, const std::string& group,
+                                                       const std::string& consumer,
+                                                       const std::string& id, size_t count = 0);
+    
+    // XACK key group id [id ...]
+    size_t xack(const std::string& key, const std::string& group, const std::vector<std::string>& ids);
+    
+    // XPENDING key group [COUNT n]
+    std::vector<StreamPendingInfo> xpending(const std::string& key, const std::string& group, size_t count = 0) const;
+    
+    // ========== GEO COMMANDS ==========
+    
+    // GEOADD key lon lat member [lon lat member ...]
+    size_t geoadd(const std::string& key, const std::vector<GeoMember>& members);
+    
+    // GEOPOS key member [member ...]
+    std::vector<std::optional<std::pair<double, double>>> geopos(const std::string& key,
+                                                                 const std::vector<std::string>& members) const;
+    
+    // GEODIST key member1 member2 [unit]
+    std::optional<double> geodist(const std::string& key, const std::string& member1,
+                                  const std::string& member2, const std::string& unit = "m") const;
+    
+    // GEOSEARCH key ...
+    std::vector<GeoResult> geosearch(const std::string& key, const GeoSearchQuery& query) const;
+    
+    // ========== BLOOM / CUCKOO FILTER COMMANDS ==========
+    
+    // BF.RESERVE key error_rate capacity [EXPANSION n]
+    bool bfreserve(const std::string& key, double error_rate, size_t capacity, unsigned expansion = 2);
+    
+    // BF.ADD key item
+    bool bfadd(const std::string& key, const std::string& item);
+    
+    // BF.MADD key item [item ...]
+    std::vector<bool> bfmadd(const std::string& key, const std::vector<std::string>& items);
+    
+    // BF.EXISTS key item
+    bool bfexists(const std::string& key, const std::string& item) const;
+    
+    // BF.MEXISTS key item [item ...]
+    std::vector<bool> bfmexists(const std::string& key, const std::vector<std::string>& items) const;
+    
+    // CF.RESERVE key capacity [EXPANSION n]
+    bool cfreserve(const std::string& key, size_t capacity, unsigned expansion = 2);
+    
+    // CF.ADD key item
+    bool cfadd(const std::string& key, const std::string& item);
+    
+    // CF.EXISTS key item
+    bool cfexists(const std::string& key, const std::string& item) const;
+    
+    // CF.MEXISTS key item [item ...]
+    std::vector<bool> cfmexists(const std::string& key, const std::vector<std::string>& items) const;
+    
+    // CF.DEL key item
+    bool cfdel(const std::string& key, const std::string& item);
+    
+    // ========== COUNT-MIN / TOP-K SKETCH COMMANDS ==========
+    
+    // CMS.INITBYDIM key width depth
+    bool cmsInitByDim(const std::string& key, size_t width, size_t depth);
+    
+    // CMS.INITBYPROB key error probability
+    bool cmsInitByProb(const std::string& key, double error, double probability);
+    
+    // CMS.INCRBY key item increment [item increment ...]
+    std::vector<uint64_t> cmsIncrBy(const std::string& key, const std::vector<std::pair<std::string, uint64_t>>& increments);
+    
+    // CMS.QUERY key item [item ...]
+    std::vector<uint64_t> cmsQuery(const std::string& key, const std::vector<std::string>& items) const;
+    
+    // CMS.MERGE dest numkeys src [src ...] [WEIGHTS w ...]
+    bool cmsMerge(const std::string& dest, const std::vector<std::string>& sources, const std::vector<uint64_t>& weights = {});
+    
+    // TOPK.RESERVE key k [width depth decay]
+    bool topkReserve(const std::string& key, size_t k, size_t width = 0, size_t depth = 0, double decay = TopKSketch::kDefaultDecay);
+    
+    // TOPK.ADD key item [item ...]
+    std::vector<std::optional<std::string>> topkAdd(const std::string& key, const std::vector<std::string>& items);
+    
+    // TOPK.INCRBY key item increment [item increment ...]
+    std::vector<std::optional<std::string>> topkIncrBy(const std::string& key, const std::vector<std::pair<std::string, uint64_t>>& increments);
+    
+    // TOPK.QUERY key item [item ...]
+    std::vector<bool> topkQuery(const std::string& key, const std::vector<std::string>& items) const;
+    
+    // TOPK.LIST key WITHCOUNT
+    std::vector<std::pair<std::string, uint32_t>> topkList(const std::string& key) const;
+    
+    // Merge the sources' heavy hitters into dest
+    bool topkMerge(const std::string& dest, const std::vector<std::string>& sources);
+    
+    // ========== T-DIGEST COMMANDS ==========
+    
+    // TDIGEST.CREATE key [COMPRESSION c]
+    bool tdigestCreate(const std::string& key, double compression = TDigest::kDefaultCompression);
+    
+    // TDIGEST.ADD key value [value ...]
+    bool tdigestAdd(const std::string& key, const std::vector<double>& values);
+    
+    // TDIGEST.QUANTILE key q [q ...]
+    std::vector<double> tdigestQuantile(const std::string& key, const std::vector<double>& quantiles) const;
+    
+    // TDIGEST.CDF key value [value ...]
+    std::vector<double> tdigestCdf(const std::string& key, const std::vector<double>& values) const;
+    
+    // TDIGEST.MERGE dest numkeys src [src ...] [COMPRESSION c]
+    bool tdigestMerge(const std::string& dest, const std::vector<std::string>& sources, double compression = 0);
+    
+    // ========== TIME SERIES COMMANDS ==========
+    
+    // TS.CREATE key [RETENTION ms]
+    bool tsCreate(const std::string& key, int64_t retention_ms = 0);
+    
+    // TS.ADD key timestamp value
+    bool tsAdd(const std::string& key, int64_t timestamp, double value);
+    
+    // TS.MADD key timestamp value [timestamp value ...]
+    size_t tsMadd(const std::string& key, const std::vector<TimeSeriesSample>& samples);
+    
+    // TS.GET key
+    std::optional<TimeSeriesSample> tsGet(const std::string& key) const;
+    
+    // TS.RANGE key from to [AGGREGATION type bucket_ms]
+    std::vector<TimeSeriesSample> tsRange(const std::string& key, int64_t from, int64_t to, TimeSeriesAggregation aggregation = TimeSeriesAggregation::NONE, int64_t bucket_ms = 0) const;
+    
+    // TS.INFO key
+    std::optional<TimeSeriesInfo> tsInfo(const std::string& key) const;
+    
+    // ========== JSON COMMANDS ==========
+    
+    // JSON.SET key path json
+    bool jsonSet(const std::string& key, const std::string& path, const std::string& json);
+    
+    // JSON.GET key [path]
+    std::optional<std::string> jsonGet(const std::string& key, const std::string& path = "$") const;
+    
+    // JSON.DEL key [path]
+    size_t jsonDel(const std::string& key, const std::string& path = "$");
+    
+    // JSON.NUMINCRBY key path value
+    std::optional<std::string> jsonNumIncrBy(const std::string& key, const std::string& path, double increment);
+    
+    // JSON.ARRAPPEND key path json [json ...]
+    std::optional<size_t> jsonArrAppend(const std::string& key, const std::string& path, const std::vector<std::string>& values);
+    
+    // JSON.TYPE key [path]
+    std::optional<std::string> jsonType(const std::string& key, const std::string& path = "$") const;
+    
+    // ========== VECTOR SET COMMANDS ==========
+    
+    // VADD - the first add fixes dim / quantization / graph parameters
+    bool vadd(const std::string& key, const std::string& element, const std::vector<float>& vector,
+              VectorQuant quant = VectorQuant::Q8, size_t m = RedisVectorSet::kDefaultM,
+              size_t ef_construction = RedisVectorSet::kDefaultEfConstruction);
+    
+    // VSIM key VALUES ... - k most similar, best first
+    std::vector<VectorMatch> vsim(const std::string& key, const std::vector<float>& query, size_t k = 10, size_t ef = 0) const;
+    
+    // VSIM key ELE element - neighbors of an existing element
+    std::vector<VectorMatch> vsimElement(const std::string& key, const std::string& element, size_t k = 10, size_t ef = 0) const;
+    
+    // VCARD
+    size_t vcard(const std::string& key) const;
+    
+    // VDIM
+    size_t vdim(const std::string& key) const;
+    
+    // VEMB
+    std::optional<std::vector<float>> vemb(const std::string& key, const std::string& element) const;
+    
+    // ========== HASH INDEX COMMANDS ==========
+    
+    // HINDEX.CREATE - declarative index, maintained by HSET/HDEL/DEL/expiry
+    bool hindexCreate(const std::string& name, const std::string& prefix, const std::string& field,
+                      HashIndexKind kind);
+    
+    // HINDEX.DROP
+    bool hindexDrop(const std::string& name);
+    
+    // HINDEX.LOOKUP - keys whose field equals value
+    std::vector<std::string> hindexLookup(const std::string& name, const std::string& value) const;
+    
+    // HINDEX.RANGE - keys by ascending numeric value
+    std::vector<std::string> hindexRange(const std::string& name, double min, double max, size_t limit = 0) const;
+    
+    // HINDEX.LIST
+    std::vector<HashIndexInfo> hindexList() const;
+    
+    // ========== QUOTA COMMANDS ==========
+    
+    // QUOTA.SET name PREFIX prefix BUDGET bytes - per-tenant budget (empty prefix = whole database)
+    bool setQuota(const std::string& name, const std::string& prefix, size_t budget);
+    
+    // QUOTA.DROP name
+    bool dropQuota(const std::string& name);
+    
+    // QUOTA.INFO - usage, hits/misses, evictions per namespace
+    std::vector<NamespaceStats> quotaStats() const;
+    
     // ========== GENERAL COMMANDS ==========
     
     // DEL key (renamed from remove for Redis compatibility)
     bool del(const std::string& key);
     
+    // UNLINK key - big values are freed in the background
+    bool unlink(const std::string& key);
+    
+    // RENAME key newkey
+    bool rename(const std::string& key, const std::string& newkey);
+    
+    // COPY source destination [REPLACE] - copy-on-write, O(1)
+    bool copy(const std::string& source, const std::string& destination, bool replace = false);
+    
+    // MOVE key db - into another store (logical database)
+    bool move(const std::string& key, KeyValueStore& destination);
+    
     // EXISTS key
     bool exists(const std::string& key) const;
     
@@ -109,14 +423,32 @@ public:
     // TTL key
     int ttl(const std::string& key) const;
     
+    // PTTL key
+    long long pttl(const std::string& key) const;
+    
     // KEYS - get all keys
     std::vector<std::string> keys() const;
     
     // DBSIZE
     size_t size() const;
     
-    // FLUSHDB
-    void clear();
+    // FLUSHDB [ASYNC]
+    void clear(bool async = false);
+    
+    // Remove expired keys and hash fields, returns keys removed
+    size_t cleanupExpired();
+    
+    // One bounded active expiry slice (see StorageEngine::activeExpireSlice)
+    ExpireSlice activeExpireSlice(size_t samples);
+    
+    // Huge page coverage of the keyspace arena
+    HugePageStats hugePageStats() const;
+    
+    // Lazy free queue depth and totals
+    LazyFreeStats lazyFreeStats() const;
+    
+    // INFO keyspace
+    KeyspaceStats keyspaceStats() const;
     
     // Internal: access storage for persistence/thread-safety layers
     StorageEngine& getStorage() { return storage_; }
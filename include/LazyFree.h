@@ -0,0 +1,82 @@
+#ifndef LAZYFREE_H
+#define LAZYFREE_H
+
+/*
+LazyFree - Background destruction of big values
+
+Freeing a 5M-member set is 5M frees; flushing a 20 GB keyspace is
+hundreds of millions. Done inline, that runs under the store's
+exclusive lock and every client waits.
+
+With lazy free the command only DETACHES the value (a move, O(1))
+and hands it over; a background thread runs the destructor:
+
+    UNLINK big:set     → erase the key, queue the RedisValue
+    FLUSHDB ASYNC      → swap in an empty table, queue the old one
+    SET over a big hash→ queue the replaced value
+
+Small values are not worth the handoff (Redis uses the same rule,
+LAZYFREE_THRESHOLD = 64 allocations); the engine decides per value.
+
+The thread starts on first use, so stores that never free anything
+big (e.g. one per NUMA shard) don't each carry an idle thread.
+*/
+
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+struct LazyFreeStats {
+    size_t pending = 0;  // Objects queued, not yet destroyed (queue depth)
+    size_t freed = 0;    // Objects destroyed by the background thread
+};
+
+class LazyFree {
+public:
+    LazyFree() = default;
+    ~LazyFree();  // Destroys everything still queued
+
+    LazyFree(const LazyFree&) = delete;
+    LazyFree& operator=(const LazyFree&) = delete;
+
+    // Take ownership; the destructor runs on the background thread
+    template <typename T>
+    void release(T&& object) {
+        push(std::make_unique<Holder<std::decay_t<T>>>(std::forward<T>(object)));
+    }
+
+    // Block until everything queued so far is destroyed
+    void drain();
+
+    LazyFreeStats stats() const;
+
+private:
+    struct Garbage {
+        virtual ~Garbage() = default;
+    };
+
+    template <typename T>
+    struct Holder : Garbage {
+        explicit Holder(T&& value) : object(std::move(value)) {}
+        T object;
+    };
+
+    void push(std::unique_ptr<Garbage> garbage);
+    void run();
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::condition_variable idle_;
+    std::vector<std::unique_ptr<Garbage>> queue_;
+    size_t in_flight_ = 0;   // Taken off the queue, being destroyed
+    size_t freed_ = 0;
+    bool stopping_ = false;
+
+    std::thread worker_;  // Started by the first push()
+};
+
+#endif // LAZYFREE_H
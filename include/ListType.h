@@ -0,0 +1,124 @@
+#ifndef LISTTYPE_H
+#define LISTTYPE_H
+
+/*
+ListType.h - LIST as a quicklist of packed chunks
+
+A flat std::vector<std::string> makes LPUSH/LPOP O(n) and every
+element a separate allocation. Like Redis' quicklist, the list is a
+deque of chunks, each holding up to ~8 KB of elements packed into
+ONE byte buffer:
+
+    chunk: bytes   = "alicebobcarol"
+           offsets = [0, 5, 8, 13]      element i = bytes[offsets[i], offsets[i+1])
+           first   = 0                  elements popped from the front (O(1) LPOP),
+                                        compacted away once it is half the chunk
+
+Costs:
+- LPUSH / RPUSH / LPOP / RPOP: O(1) amortized (+ one chunk memmove
+  for LPUSH, bounded by the chunk size)
+- LINDEX / LSET / LINSERT: walk chunk counts from the nearer end,
+  then index inside one chunk
+- LTRIM: whole chunks are dropped (two frees each, no per-element
+  work); only the two boundary chunks are touched element-wise
+- LPOS / LREM: element lengths fall out of the offsets array, which
+  is scanned 4 at a time with SSE2; only elements of the right
+  length are compared byte-wise
+
+Indices passed to QuickList are already normalized (0-based, in
+range); the engine handles negative indices and clamping.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// LMOVE wherefrom / whereto
+enum class ListEnd {
+    LEFT,
+    RIGHT
+};
+
+// LINSERT BEFORE | AFTER pivot
+enum class ListInsert {
+    BEFORE,
+    AFTER
+};
+
+class QuickList {
+public:
+    static constexpr size_t kChunkBytes = 8192;    // Payload target per chunk
+    static constexpr size_t kChunkEntries = 1024;  // Caps the offsets array
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t chunkCount() const { return chunks_.size(); }
+
+    void pushFront(std::string_view value);
+    void pushBack(std::string_view value);
+    std::optional<std::string> popFront();
+    std::optional<std::string> popBack();
+
+    std::string at(size_t index) const;
+    void set(size_t index, std::string_view value);
+
+    // New element at `index` (0 = front, size() = back)
+    void insert(size_t index, std::string_view value);
+
+    // Elements [start, stop] (inclusive, stop < size())
+    std::vector<std::string> range(size_t start, size_t stop) const;
+
+    // Keep only [start, stop]; start > stop empties the list
+    void trim(size_t start, size_t stop);
+
+    // LREM: count > 0 from the head, < 0 from the tail, 0 = all
+    size_t remove(std::string_view value, long count);
+
+    // LPOS: positions of matches; rank 1 = first from the head,
+    // -1 = first from the tail; count 0 = all; maxlen 0 = whole list
+    std::vector<size_t> positions(std::string_view value, long rank, size_t count, size_t maxlen) const;
+
+    // First index equal to value, scanning from the head
+    std::optional<size_t> find(std::string_view value) const;
+
+private:
+    struct Chunk {
+        std::string bytes;
+        std::vector<uint32_t> offsets{0};  // stored entries + 1
+        uint32_t first = 0;                // Dead prefix left by front pops
+
+        size_t size() const { return offsets.size() - 1 - first; }
+        size_t payload() const { return offsets.back() - offsets[first]; }
+        std::string_view at(size_t i) const;
+
+        void compact();
+        void clear();  // Empty, dead prefix included
+        void append(std::string_view value);
+        void insert(size_t i, std::string_view value);
+        void replace(size_t i, std::string_view value);
+        void erase(size_t from, size_t to);  // [from, to)
+        void eraseAt(const std::vector<uint32_t>& sorted);  // Rebuilds once
+
+        // Logical indices of elements equal to value
+        void matches(std::string_view value, std::vector<uint32_t>& out) const;
+    };
+
+    bool fits(const Chunk& chunk, std::string_view value) const {
+        // An empty chunk takes anything (oversized elements get their own)
+        return chunk.size() == 0 ||
+               (chunk.size() < kChunkEntries && chunk.payload() + value.size() <= kChunkBytes);
+    }
+
+    // (chunk index, index inside chunk) of element `index`
+    std::pair<size_t, size_t> locate(size_t index) const;
+
+    std::deque<Chunk> chunks_;
+    size_t size_ = 0;
+};
+
+#endif // LISTTYPE_H
@@ -0,0 +1,142 @@
+#ifndef NEARCACHE_H
+#define NEARCACHE_H
+
+/*
+NearCache - L1 cache in front of a ThreadSafeStore
+
+Config and feature-flag keys are read thousands of times per second and
+change a few times a day. Each read still takes the store lock, hashes
+into the keyspace and copies the value. NearCache keeps recent answers
+in local memory:
+
+    NearCache cache(store);
+    cache.get("config:flags");      miss → store GET, cached
+    cache.get("config:flags");      hit  → one local map probe
+    (anyone) SET config:flags ...   → store invalidates, entry dropped
+
+Correctness comes from client tracking (ClientTracking.h): every miss is
+a tracked read, so the store reports the key's next modification,
+expiry or eviction. Invalidations arrive before the write returns.
+
+A fill races an invalidation when the key changes between the store
+read and the local insert. Every fill snapshots an invalidation counter
+first, and is dropped if it moved meanwhile.
+
+Bounded: capped by entry count and bytes, evicting by CLOCK (second
+chance - an approximated LRU whose hit path only sets a flag, instead
+of relinking a list node). Entries also expire after `ttl`, and never
+outlive the key's own TTL or the hash field's TTL. Expiry is checked
+against a coarse clock (CLOCK_MONOTONIC_COARSE, a few ms resolution):
+reading it costs ~5 ns where a precise one costs ~30, about half the
+hit budget.
+
+Negative answers (missing key / field) are cached too; they are
+invalidated the same way when the key appears.
+*/
+
+#include "ThreadSafeStore.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+struct NearCacheOptions {
+    size_t max_entries = 10000;                    // Keys (a hash's cached fields share one)
+    size_t max_bytes = 64 * 1024 * 1024;
+    std::chrono::milliseconds ttl{60000};          // Upper bound on any entry's life
+};
+
+struct NearCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t invalidations = 0;    // Entries dropped by the store
+    uint64_t evictions = 0;        // Dropped for entry / byte limits
+    uint64_t expirations = 0;      // Dropped for TTL
+    uint64_t raced_fills = 0;      // Fills skipped: invalidated mid-read
+    double mean_hit_age_ms = 0;    // Age of served entries (staleness bound)
+    size_t entries = 0;
+    size_t bytes = 0;
+
+    double hitRate() const {
+        uint64_t total = hits + misses;
+        return total ? static_cast<double>(hits) / total : 0.0;
+    }
+};
+
+class NearCache {
+public:
+    explicit NearCache(ThreadSafeStore& store, NearCacheOptions options = NearCacheOptions());
+    ~NearCache();  // Turns tracking off
+
+    NearCache(const NearCache&) = delete;
+    NearCache& operator=(const NearCache&) = delete;
+
+    // Reads: served locally when cached
+    std::optional<std::string> get(const std::string& key);
+    std::optional<std::string> hget(const std::string& key, const std::string& field);
+
+    // Writes go straight to the store; its invalidation drops the local copy
+    bool set(const std::string& key, const std::string& value, int ttl = 0);
+    bool hset(const std::string& key, const std::string& field, const std::string& value);
+    bool del(const std::string& key);
+
+    // Drop everything local (the store is untouched)
+    void clear();
+
+    NearCacheStats stats() const;
+
+private:
+    using TimeNs = int64_t;  // Coarse monotonic nanoseconds
+
+    static TimeNs coarseNow();
+
+    // Everything cached for one store key
+    struct Entry {
+        bool has_value = false;                   // GET answer cached
+        std::optional<std::string> value;
+        std::unordered_map<std::string, std::optional<std::string>> fields;  // HGET answers
+        TimeNs expires = 0;                       // Min of ttl and the store's TTLs
+        TimeNs filled = 0;
+        size_t bytes = 0;
+        bool referenced = false;                  // CLOCK bit, set by hits
+        std::list<std::string>::iterator ring;    // Position in ring_
+    };
+
+    // Hook for ClientTracking (null key = flush)
+    void invalidate(const std::string* key);
+
+    // Cached answer, or nullptr; `field` null = the GET answer
+    const std::optional<std::string>* lookupLocked(const std::string& key, const std::string* field);
+
+    // Store an answer fetched while `epoch` was current
+    void fill(const std::string& key, const std::string* field, const std::optional<std::string>& answer,
+              TimeNs expires, uint64_t epoch);
+
+    // Store key TTL / field TTL capped by options_.ttl
+    TimeNs expiryFor(long long pttl_ms, int field_ttl_s) const;
+
+    void eraseLocked(std::unordered_map<std::string, Entry>::iterator it);
+    void trimLocked();
+
+    ThreadSafeStore& store_;
+    NearCacheOptions options_;
+    uint64_t client_ = 0;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::list<std::string> ring_;  // CLOCK order: new keys at the back, hand at the front
+    size_t bytes_ = 0;
+
+    // Bumped by every invalidation; fills compare it (see header comment)
+    std::atomic<uint64_t> epoch_{0};
+
+    NearCacheStats stats_;  // Counters only; entries/bytes/age filled in by stats()
+    double hit_age_ms_total_ = 0;
+};
+
+#endif // NEARCACHE_H
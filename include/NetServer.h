@@ -0,0 +1,148 @@
+#ifndef NETSERVER_H
+#define NETSERVER_H
+
+/*
+NetServer - TCP front end for a ThreadSafeStore, on epoll or io_uring
+
+One event-loop thread serves every connection, speaking the
+ShmTransport frames (u32 length | u32 op | args → u32 length | u32
+status | payload). The loop runs on one of two backends, picked at
+start() (or by KV_NET_BACKEND=epoll|io_uring):
+
+- EPOLL    : level-triggered epoll; accept4 / read / write per ready fd.
+             Three-plus syscalls per request.
+- IO_URING : everything is a submission, and one io_uring_enter both
+             submits the batch and reaps completions:
+             * multishot ACCEPT - armed once, one completion per client
+             * multishot RECV   - armed once per connection
+             * provided-buffer ring - RECV picks a buffer from a
+               registered pool only when data arrives, so idle
+               connections hold no read buffer (10K idle clients would
+               otherwise pin 10K buffers)
+             * SENDs for every reply produced in a pass go in together
+
+Both keep no per-connection read buffer unless a frame arrives split
+across reads. A client that pipelines requests without reading replies
+is paused once max_output reply bytes are queued for it: its remaining
+requests wait in the read buffer, the loop stops reading its socket
+(EPOLLIN dropped / multishot RECV cancelled), and it resumes once the
+replies drain below the cap. IO_URING needs Linux 6.0 (multishot recv); elsewhere
+start() falls back to EPOLL and backend() reports what is running.
+*/
+
+#include "ShmTransport.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+enum class NetBackend {
+    EPOLL,
+    IO_URING
+};
+
+struct NetServerOptions {
+    NetBackend backend = NetBackend::EPOLL;
+    std::string host = "127.0.0.1";
+    uint16_t port = 0;                 // 0 = any free port (see port())
+    int backlog = 4096;
+    size_t buffer_size = 2048;         // Receive buffer (epoll scratch / each provided buffer)
+    size_t buffer_count = 16384;       // IO_URING provided buffers (power of two): sized for
+                                       // requests landing at once, not for connections
+    size_t queue_depth = 4096;         // IO_URING submission queue entries
+    size_t max_output = 1024 * 1024;   // Queued reply bytes per connection before it is paused
+};
+
+struct NetServerStats {
+    size_t connections = 0;       // Open now
+    uint64_t accepted = 0;
+    uint64_t requests = 0;
+    uint64_t bytes_in = 0;
+    uint64_t bytes_out = 0;
+    uint64_t loop_syscalls = 0;   // epoll_wait/read/write/accept, or io_uring_enter
+    uint64_t buffer_stalls = 0;   // IO_URING: recv found the buffer pool empty
+    double cpu_seconds = 0;       // Event-loop thread CPU time
+};
+
+class NetServer {
+public:
+    explicit NetServer(ThreadSafeStore& store, NetServerOptions options = NetServerOptions());
+    ~NetServer();  // stop()
+
+    NetServer(const NetServer&) = delete;
+    NetServer& operator=(const NetServer&) = delete;
+
+    // Bind, listen and start the loop; false if the socket or backend can't be set up
+    bool start();
+
+    // Close every connection and join the loop; start() may be called again
+    // (with a different backend via setBackend())
+    void stop();
+
+    bool running() const { return loop_.joinable(); }
+    void setBackend(NetBackend backend) { options_.backend = backend; }
+
+    // Backend actually running (IO_URING degrades to EPOLL if unsupported)
+    NetBackend backend() const { return backend_; }
+    uint16_t port() const { return port_; }
+
+    NetServerStats stats() const;
+
+    // Kernel supports the io_uring features the backend needs
+    static bool ioUringSupported();
+
+private:
+    struct Connection {
+        int fd = -1;
+        std::string in;          // Partial frame only; empty between requests
+        std::string out;         // Replies not yet handed to the kernel
+        std::string sending;     // IO_URING: buffer of the SEND in flight
+        size_t sent = 0;         // Of `sending`, bytes acknowledged
+        bool send_pending = false;  // IO_URING: SEND in flight; EPOLL: waiting for EPOLLOUT
+        bool closing = false;    // IO_URING: close once the SEND completes
+        bool paused = false;     // Output over max_output: input not read or executed
+        bool recv_armed = false; // IO_URING: multishot RECV active
+
+        // Reply bytes not yet acknowledged by the kernel
+        size_t queued() const { return out.size() + sending.size() - sent; }
+    };
+
+    struct Uring;
+
+    // Execute every complete frame in `data` (after conn.in), append replies to conn.out.
+    // Stops once max_output bytes are queued and keeps the rest in conn.in.
+    // False on a malformed frame.
+    bool consume(Connection& conn, const char* data, size_t n);
+
+    void runEpoll();
+    void runUring();
+    void closeAll();
+
+    ThreadSafeStore& store_;
+    NetServerOptions options_;
+    NetBackend backend_ = NetBackend::EPOLL;
+    uint16_t port_ = 0;
+    int listener_ = -1;
+    int wake_fd_ = -1;  // eventfd; stop() writes it to end the loop
+
+    std::unordered_map<uint64_t, Connection> connections_;  // Loop thread only
+    uint64_t next_id_ = 1;
+    std::unique_ptr<Uring> uring_;
+
+    std::atomic<size_t> open_{0};
+    std::atomic<uint64_t> accepted_{0};
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> bytes_in_{0};
+    std::atomic<uint64_t> bytes_out_{0};
+    std::atomic<uint64_t> syscalls_{0};
+    std::atomic<uint64_t> buffer_stalls_{0};
+    double cpu_seconds_ = 0;  // Loop CPU of finished runs
+    double run_cpu_ = 0;      // Set by the loop as it exits; stop() folds it in
+    std::thread loop_;
+};
+
+#endif // NETSERVER_H
@@ -0,0 +1,64 @@
+#ifndef NUMATOPOLOGY_H
+#define NUMATOPOLOGY_H
+
+/*
+NumaTopology - Which CPUs belong to which memory node
+
+On multi-socket machines every socket has its own memory.
+Touching the other socket's memory crosses the interconnect
+(roughly 1.5-2x the latency of local memory).
+
+This helper:
+- Discovers nodes from /sys/devices/system/node (Linux)
+- Can EMULATE N nodes on a single-node box (for testing):
+    NumaTopology::emulated(2)  or  KV_NUMA_EMULATE=2
+- Pins the calling thread to a node's CPUs (sched_setaffinity)
+- Makes the calling thread allocate from a node (set_mempolicy)
+
+Everything is best-effort: on non-Linux or restricted containers
+the calls return false and the store keeps working unpinned.
+*/
+
+#include <string>
+#include <vector>
+
+struct NumaNode {
+    int id;
+    std::vector<int> cpus;
+};
+
+class NumaTopology {
+private:
+    std::vector<NumaNode> nodes_;
+    bool emulated_ = false;
+
+public:
+    // Real topology (or emulated if KV_NUMA_EMULATE=N is set)
+    static NumaTopology detect();
+
+    // Split the online CPUs into `node_count` fake nodes
+    static NumaTopology emulated(size_t node_count);
+
+    size_t nodeCount() const { return nodes_.size(); }
+    const NumaNode& node(size_t index) const { return nodes_.at(index); }
+    bool isEmulated() const { return emulated_; }
+
+    // Node index owning `cpu` (0 if unknown)
+    size_t nodeOfCpu(int cpu) const;
+
+    // Node index of the CPU the calling thread is running on
+    size_t currentNode() const;
+
+    // Restrict the calling thread to the CPUs of `node`
+    bool pinThreadToNode(size_t node) const;
+
+    // Prefer memory from `node` for all future allocations of the calling
+    // thread (keyspace nodes, values, collection nodes...)
+    // No-op on emulated topologies: the fake nodes share one real node
+    bool bindThreadMemoryToNode(size_t node) const;
+
+    // Human-readable summary, e.g. "2 nodes (emulated): 0:[0,2] 1:[1,3]"
+    std::string describe() const;
+};
+
+#endif // NUMATOPOLOGY_H
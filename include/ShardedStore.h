@@ -0,0 +1,77 @@
+#ifndef SHARDEDSTORE_H
+#define SHARDEDSTORE_H
+
+/*
+ShardedStore - One ThreadSafeStore per NUMA node
+
+Splits the keyspace into shards, each owned by a NUMA node:
+- Key → shard by hash (deterministic, any thread can find a key)
+- Node tag: a key starting with "{node:N}" hashes only over node N's
+  shards, so clients that own their data (sessions, per-thread
+  counters...) keep it on the node they run on AND findable through
+  shardFor(); localKey() adds the calling thread's tag
+- Each shard's keyspace table (entries, short keys, bucket arrays)
+  is mbind()'ed to its node, so it stays node-local whichever thread
+  writes it (StorageOptions::numa_node)
+- Each shard's async worker is pinned to its node's CPUs and
+  allocates from its node's memory, so values and collections written
+  through *_async/submit() are node-local too; synchronous writes from
+  another node put those on the caller's node (see
+  ThreadSafeStore::setNumaNode)
+- localShard() is a shard of the caller's node, picked per thread -
+  not by key. Keys written there are a separate namespace: shardFor()
+  never routes to them unless they carry that node's tag. Use it for
+  scratch data a thread only reaches through localShard() itself
+
+    ShardedStore sharded(NumaTopology::emulated(2));
+    sharded.shardFor("user:1").set_async("user:1", "alice");
+
+    std::string key = sharded.localKey("session:7");  // "{node:1}session:7"
+    sharded.shardFor(key).set(key, "...");            // node-local, findable anywhere
+
+Also gives lock striping for free: shards never contend with each other.
+*/
+
+#include "NumaTopology.h"
+#include "ThreadSafeStore.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+class ShardedStore {
+private:
+    std::shared_ptr<const NumaTopology> topology_;
+    std::vector<std::unique_ptr<ThreadSafeStore>> shards_;
+    std::vector<size_t> shard_node_;  // shard index → node index
+
+public:
+    // shards_per_node: more shards = less lock contention per node
+    // options: per-shard storage options (numa_node is set per shard)
+    explicit ShardedStore(NumaTopology topology = NumaTopology::detect(),
+                          size_t shards_per_node = 1,
+                          StorageOptions options = StorageOptions());
+
+    size_t shardCount() const { return shards_.size(); }
+    ThreadSafeStore& shard(size_t index) { return *shards_.at(index); }
+
+    // Shard owning `key` (one of node N's shards for "{node:N}..." keys;
+    // a tag naming no node is hashed like any other key)
+    size_t shardIndex(const std::string& key) const;
+    ThreadSafeStore& shardFor(const std::string& key) { return *shards_[shardIndex(key)]; }
+
+    // `key` tagged with the calling thread's node
+    std::string localKey(const std::string& key) const;
+
+    // A shard on the node the calling thread runs on, chosen per thread
+    // rather than by key: shardFor() doesn't see keys written here
+    // (see above)
+    ThreadSafeStore& localShard();
+
+    size_t nodeOfShard(size_t index) const { return shard_node_.at(index); }
+    const NumaTopology& topology() const { return *topology_; }
+
+    // Total keys across shards
+    size_t size() const;
+};
+
+#endif // SHARDEDSTORE_H
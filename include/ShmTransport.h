@@ -0,0 +1,152 @@
+#ifndef SHMTRANSPORT_H
+#define SHMTRANSPORT_H
+
+/*
+ShmTransport - Shared-memory request/response transport for co-located clients
+
+A loopback TCP round trip is two trips through the network stack, two
+socket buffers and two wakeups: ~15 µs for a GET that the store answers
+in ~100 ns. When client and store share a host, both sides can instead
+map one memory segment and exchange frames through it:
+
+    ShmServer server(store);            memfd segment + dispatcher thread
+    ShmClient client(server.fd());      claims a slot (any process with the fd)
+    client.set("k", "v");
+    client.get("k");                    → "v"
+
+Segment layout (memfd, so nothing to clean up in /dev/shm):
+
+    [ header | slot 0 | slot 1 | ... ]
+    slot = state word + request ring (client → server)
+                      + response ring (server → client)
+
+Each ring is single-producer/single-consumer: the producer owns `tail`,
+the consumer owns `head`, each on its own cache line, so a frame moves
+with two memcpys and one release store - no locks, no syscalls.
+
+Waiting: a consumer with nothing to read spins first, then sleeps on a
+futex (the server on one doorbell shared by all slots, a client on its
+response ring). Producers only issue FUTEX_WAKE when the consumer has
+flagged itself asleep, so a busy pair never enters the kernel. The spin
+budget adapts like glibc's adaptive mutex: it drifts toward twice the
+spins that recently sufficed, and halves after every sleep. On a
+single-CPU host spinning only delays the other side, so it is off.
+
+Frames: request  = u32 length | u32 op | (u32 len, bytes) per argument
+        response = u32 length | u32 status | payload
+A request whose length overruns what the client published closes the
+slot: later calls on that client fail until it is released.
+
+ShmClient is synchronous (one request in flight), so a frame that fits
+the ring never waits for space; larger ones are rejected. Not
+thread-safe: one ShmClient per thread, like one connection per thread.
+*/
+
+#include "ThreadSafeStore.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+
+enum class ShmOp : uint32_t {
+    PING,
+    GET,
+    SET,     // key, value, ttl (decimal seconds)
+    DEL,
+    EXISTS
+};
+
+// Run one request frame (op | arguments, without the length prefix)
+// against the store: returns the status (0 nil, 1 ok, 2 error) and fills
+// `payload`. NetServer speaks the same frames over sockets.
+uint32_t executeFrame(ThreadSafeStore& store, std::string_view frame, std::optional<std::string>& payload);
+
+struct ShmTransportOptions {
+    size_t max_clients = 16;
+    size_t ring_bytes = 64 * 1024;  // Per ring; rounded up to a power of two
+    int max_spin = -1;              // Spin ceiling before sleeping; -1 = auto (0 on one CPU)
+};
+
+struct ShmTransportStats {
+    size_t clients = 0;       // Slots claimed
+    uint64_t requests = 0;
+    uint64_t sleeps = 0;      // Times the dispatcher went to the futex
+    uint64_t wakeups = 0;     // FUTEX_WAKE calls issued by the dispatcher
+};
+
+namespace shm {
+struct Header;
+struct Ring;
+struct Slot;
+}  // namespace shm
+
+class ShmServer {
+public:
+    explicit ShmServer(ThreadSafeStore& store, ShmTransportOptions options = ShmTransportOptions());
+    ~ShmServer();  // Stops the dispatcher; attached clients see disconnects
+
+    ShmServer(const ShmServer&) = delete;
+    ShmServer& operator=(const ShmServer&) = delete;
+
+    // Segment mapped and dispatcher running (false off Linux or if memfd fails)
+    bool ok() const { return header_ != nullptr; }
+
+    // The memfd; hand it to clients (fork, SCM_RIGHTS, /proc/<pid>/fd/N)
+    int fd() const { return fd_; }
+
+    ShmTransportStats stats() const;
+
+private:
+    void run();
+    bool serveOnce();  // Drain every claimed slot; false if nothing was pending
+    void dispatch(shm::Slot& slot, const char* frame, uint32_t length);
+
+    ThreadSafeStore& store_;
+    int fd_ = -1;
+    size_t size_ = 0;
+    shm::Header* header_ = nullptr;
+
+    uint32_t spin_limit_;
+    uint32_t max_spin_;
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> sleeps_{0};
+    std::atomic<uint64_t> wakeups_{0};
+    std::thread dispatcher_;
+};
+
+class ShmClient {
+public:
+    // Map the segment behind `fd` and claim a free slot
+    explicit ShmClient(int fd);
+    ~ShmClient();  // Releases the slot
+
+    ShmClient(const ShmClient&) = delete;
+    ShmClient& operator=(const ShmClient&) = delete;
+
+    // Slot claimed (false if the segment is full, invalid or shut down)
+    bool connected() const { return slot_ != nullptr; }
+
+    bool ping();
+    std::optional<std::string> get(const std::string& key);
+    bool set(const std::string& key, const std::string& value, int ttl = 0);
+    bool del(const std::string& key);
+    bool exists(const std::string& key);
+
+private:
+    // One round trip; the reply payload goes to `reply` (may be null).
+    // Returns the status word, or nullopt on transport failure.
+    std::optional<uint32_t> call(ShmOp op, std::initializer_list<std::string_view> args, std::string* reply);
+
+    size_t size_ = 0;
+    shm::Header* header_ = nullptr;
+    shm::Slot* slot_ = nullptr;
+
+    uint32_t spin_limit_;
+    uint32_t max_spin_;
+};
+
+#endif // SHMTRANSPORT_H
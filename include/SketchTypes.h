@@ -0,0 +1,112 @@
+#ifndef SKETCHTYPES_H
+#define SKETCHTYPES_H
+
+/*
+SketchTypes.h - Frequency sketches (CMS.* / TOPK.*)
+
+Counting every event in a HASH costs one field per distinct item.
+Sketches answer "how often?" and "who are the heavy hitters?" in
+FIXED memory chosen up front, at the price of bounded error.
+
+1. CountMinSketch (CMS.INCRBY / CMS.QUERY / CMS.MERGE)
+   - depth rows x width counters, one flat row-major array
+   - INCRBY adds to one counter per row; QUERY takes the row minimum
+   - Never under-counts; over-counts by at most error * total with
+     the configured probability
+   - MERGE is an element-wise weighted sum over the flat arrays
+     (a single loop the compiler vectorizes)
+
+2. TopKSketch (TOPK.ADD / TOPK.LIST) - HeavyKeeper
+   - depth rows x width buckets of (fingerprint, count), stored as two
+     flat arrays (struct-of-arrays)
+   - A colliding item DECAYS the bucket's count with probability
+     decay^count, so small flows get evicted while elephants stay
+   - The current top-k (item, count) list is kept in small parallel
+     arrays; lookups scan the fingerprints before comparing strings
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+class CountMinSketch {
+public:
+    CountMinSketch(size_t width, size_t depth);
+
+    // CMS.INITBYPROB: error = over-count as a fraction of the total,
+    // probability = chance of exceeding it
+    static CountMinSketch fromErrorRate(double error, double probability);
+
+    // Returns the new estimate for the item; counters saturate at
+    // UINT64_MAX instead of wrapping
+    uint64_t incrBy(const std::string& item, uint64_t increment);
+    uint64_t query(const std::string& item) const;
+
+    // counters += weight * other.counters (saturating); false if
+    // dimensions differ
+    bool merge(const CountMinSketch& other, uint64_t weight = 1);
+
+    size_t width() const { return width_; }
+    size_t depth() const { return depth_; }
+    uint64_t total() const { return total_; }
+
+private:
+    size_t width_;
+    size_t depth_;
+    uint64_t total_ = 0;
+    std::vector<uint64_t> counters_;  // depth_ rows of width_, row-major
+};
+
+class TopKSketch {
+public:
+    static constexpr double kDefaultDecay = 0.9;
+
+    // width/depth of 0 pick HeavyKeeper's recommended k*log(k) x log(k)
+    explicit TopKSketch(size_t k, size_t width = 0, size_t depth = 0, double decay = kDefaultDecay);
+
+    // Returns the item expelled from the top-k, if any
+    std::optional<std::string> incrBy(const std::string& item, uint32_t increment);
+    std::optional<std::string> add(const std::string& item) { return incrBy(item, 1); }
+
+    bool contains(const std::string& item) const;  // In the current top-k
+
+    // Estimated count (sketch estimate, not just heap members)
+    uint32_t count(const std::string& item) const;
+
+    // Top-k by count, descending
+    std::vector<std::pair<std::string, uint32_t>> list() const;
+
+    // Folds another sketch's heavy hitters in (re-adds them with their counts)
+    void merge(const TopKSketch& other);
+
+    size_t k() const { return k_; }
+    size_t width() const { return width_; }
+    size_t depth() const { return depth_; }
+
+private:
+    static constexpr size_t kDecayTable = 256;  // decay^c for small c
+
+    size_t findInHeap(uint32_t fp, const std::string& item) const;  // Index or heap size
+    size_t heapMin() const;
+
+    size_t k_;
+    size_t width_;
+    size_t depth_;
+
+    std::vector<uint32_t> fingerprints_;  // depth_ x width_, row-major
+    std::vector<uint32_t> counts_;        // Same layout
+
+    std::vector<double> decay_table_;
+    uint64_t rng_ = 0x9e3779b97f4a7c15ULL;
+
+    // Top-k list as parallel arrays; k is small, so a scan over the
+    // fingerprints beats maintaining a real heap
+    std::vector<uint32_t> heap_fp_;
+    std::vector<uint32_t> heap_count_;
+    std::vector<std::string> heap_item_;
+};
+
+#endif // SKETCHTYPES_H
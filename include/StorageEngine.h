@@ -17,31 +17,272 @@ Design Pattern: Repository Pattern
 */
 
 #include "ValueTypes.h"
+#include "HashIndex.h"
+#include "HugePageResource.h"
+#include "LazyFree.h"
+#include "TenantQuota.h"
+#include "ClientTracking.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
 #include <unordered_map>
 #include <string>
+#include <string_view>
 #include <optional>
 #include <vector>
 
+// Construction-time tuning knobs
+struct StorageOptions {
+    // Back the keyspace table (nodes + bucket arrays) with 2 MB pages
+    HugePageMode huge_pages = HugePageMode::OFF;
+    
+    // OS NUMA node the keyspace table is placed on (-1 = wherever the
+    // writing thread runs); turns the arena on even with huge pages OFF
+    int numa_node = -1;
+};
+
+// SET key value [NX | XX] [GET] [EX | PX | EXAT | PXAT | KEEPTTL]
+enum class SetCondition {
+    ALWAYS,
+    NX,     // Only if the key doesn't exist
+    XX      // Only if the key exists
+};
+
+enum class SetExpiry {
+    NONE,       // Clear any TTL
+    EX,         // expiry_value seconds from now
+    PX,         // expiry_value milliseconds from now
+    EXAT,       // Absolute unix time, seconds
+    PXAT,       // Absolute unix time, milliseconds
+    KEEPTTL     // Keep the existing TTL
+};
+
+struct SetOptions {
+    SetCondition condition = SetCondition::ALWAYS;
+    SetExpiry expiry = SetExpiry::NONE;
+    int64_t expiry_value = 0;
+    bool get = false;               // Return the previous value
+};
+
+struct SetResult {
+    bool written = false;                   // False if NX/XX blocked it, invalid TTL or GET on a non-string
+    std::optional<std::string> old_value;   // GET: previous string value (even when not written)
+};
+
+// INFO keyspace line for one logical database
+struct KeyspaceStats {
+    size_t keys = 0;          // Live keys
+    size_t expires = 0;       // Of those, keys with a TTL
+    long long avg_ttl_ms = 0; // Mean remaining TTL over `expires` (0 if none)
+    size_t expired = 0;       // Keys reclaimed by lazy or active expiry so far
+};
+
+// One slice of the incremental active expiry cycle
+struct ExpireSlice {
+    size_t sampled = 0;    // Keys with a TTL or field TTLs checked
+    size_t expired = 0;    // Of those, keys or hashes reclaimed
+    bool wrapped = false;  // The cursor finished a pass over the table
+};
+
+// Keyspace table: pmr so its memory can come from a huge page arena
+using KeySpace = std::pmr::unordered_map<std::string, RedisValue>;
+
 class StorageEngine {
 private:
-    // Main storage: key → RedisValue (with type and expiry)
-    std::unordered_map<std::string, RedisValue> store_;
+    // Arena behind store_ (null when huge pages and NUMA placement are off)
+    // Declared before store_ so they outlive it
+    std::unique_ptr<HugePageResource> huge_pages_;
+    std::unique_ptr<std::pmr::memory_resource> pool_;
     
-    // Helper: Check and remove expired keys
+    // Main storage: key → RedisValue (with type and expiry)
+    KeySpace store_;
+    
+    // Secondary indexes over hash fields (see HashIndex.h)
+    HashIndexCatalog indexes_;
+    
+    // Background destructor for big detached values (see LazyFree.h)
+    LazyFree lazy_free_;
+    
+    // Keys removed because their TTL passed (KeyspaceStats::expired).
+    // Bumped only on exclusive paths, but keyspaceStats() reads it from
+    // the shared one, so relaxed atomic
+    std::atomic<uint64_t> expired_keys_{0};
+    
+    // Bucket of store_ where the next activeExpireSlice() resumes
+    size_t expire_cursor_ = 0;
+    
+    // Per-tenant memory budgets (see TenantQuota.h)
+    QuotaTable quotas_;
+    int mutation_depth_ = 0;  // Nested Accounted guards
+    
+    // Invalidation table shared by all databases (see ClientTracking.h)
+    ClientTracking* tracking_ = nullptr;
+    
+    // RAII around every mutating command: when it returns, `key` is
+    // re-charged to its namespace and tracking clients are invalidated;
+    // the outermost guard then evicts over-budget namespaces (so no
+    // command ever loses a key it still holds an iterator to). Paths
+    // that leave the key as it was return through unchanged()
+    class Accounted {
+    public:
+        Accounted(StorageEngine& engine, const std::string& key);
+        ~Accounted();
+        
+        Accounted(const Accounted&) = delete;
+        Accounted& operator=(const Accounted&) = delete;
+        
+        // Nothing was written (SET NX on a live key, HDEL of a missing
+        // field, a rejected XADD...): no re-charge, no invalidation.
+        // Returns `result` so a no-op path stays one line
+        void unchanged() { changed_ = false; }
+        template <typename T>
+        T unchanged(T result) {
+            changed_ = false;
+            return result;
+        }
+        
+    private:
+        StorageEngine& engine_;
+        const std::string& key_;
+        bool active_;
+        bool changed_ = true;
+    };
+    
+    // Helper: signalModifiedKey - re-measure key for its namespace
+    // ledger and invalidate clients tracking it
+    void keyChanged(const std::string& key);
+    
+    // Helper: Like keyChanged, for a key about to be erased outside any
+    // command (expiry, eviction) - call before erasing it
+    void keyRemoved(const std::string& key);
+    
+    // Helper: Evict from every namespace over its budget
+    void enforceQuotas();
+    
+    // Helper: Rebuild all ledgers from the keyspace (O(n), admin only)
+    void recount();
+    
+    // Helper: Check and remove expired keys (writers: exclusive lock); the
+    // value goes through dispose(), so big ones are freed in the background
     bool isExpired(const std::string& key);
     
+    // Helper: Like isExpired, but leaves an expired key in place - read
+    // commands run under ThreadSafeStore's SHARED lock, so they report it
+    // absent and leave the erase, quota release and unindex to writers
+    // and cleanupExpired()
+    bool isExpiredForRead(const std::string& key);
+    
     // Helper: Ensure key exists and has correct type
     bool validateType(const std::string& key, ValueType expected) const;
     
+    // Helper: Live value of type T for reading, or nullptr - never unshares
+    // a COPY'd payload (the findX helpers below are for writers)
+    template <typename T>
+    const T* peek(const std::string& key) {
+        if (isExpiredForRead(key)) return nullptr;
+        
+        auto it = store_.find(key);
+        if (it == store_.end()) return nullptr;
+        return std::get_if<T>(&it->second.view());
+    }
+    
+    // Helper: Live string at key, or nullptr (missing/expired/wrong type)
+    RedisString* findString(const std::string& key);
+    
+    // Helper: Live list at key, or nullptr (missing/expired/wrong type)
+    RedisList* findList(const std::string& key);
+    
+    // Helper: Live stream at key, or nullptr (missing/expired/wrong type)
+    RedisStream* findStream(const std::string& key);
+    
+    // Helper: Live geo index at key, or nullptr
+    RedisGeo* findGeo(const std::string& key);
+    
+    // Helper: Live filters at key, or nullptr
+    RedisBloom* findBloom(const std::string& key);
+    RedisCuckoo* findCuckoo(const std::string& key);
+    
+    // Helper: Live sketches at key, or nullptr
+    RedisCountMin* findCountMin(const std::string& key);
+    RedisTopK* findTopK(const std::string& key);
+    
+    // Helper: Live t-digest at key, or nullptr
+    RedisTDigest* findTDigest(const std::string& key);
+    
+    // Helper: Live time series at key, or nullptr
+    RedisTimeSeries* findTimeSeries(const std::string& key);
+    
+    // Helper: Live JSON document at key, or nullptr
+    RedisJson* findJson(const std::string& key);
+    
+    // Helper: Live vector set at key, or nullptr
+    RedisVectorSet* findVectorSet(const std::string& key);
+    
+    // Helper: Erase a key whose TTL passed (lazy or active expiry),
+    // returns the iterator after it
+    KeySpace::iterator reclaimExpired(KeySpace::iterator it);
+    
+    // Helper: Drop expired hash fields - writers and cleanupExpired only;
+    // readers skip due fields instead (they share the lock). Returns true if the hash became empty and the key was erased
+    bool purgeExpiredFields(KeySpace::iterator it);
+    
+    // Helper: Write one hash field (index hooks, clears the field's TTL)
+    // Returns true if the field is new
+    bool writeHashField(KeySpace::iterator it, const std::string& field, const std::string& value);
+    
+    // Helper: Erase the field at dense position `index` (index hooks, and
+    // the field TTLs follow the hash's swap-remove)
+    void eraseHashField(KeySpace::iterator it, RedisHash& hash, size_t index);
+    
+    // Helper: Destroy a detached value - big ones on the lazy free thread
+    void dispose(RedisValue value);
+    
+    // Helper: Put a detached value at key, replacing (and disposing) any old one
+    void place(const std::string& key, RedisValue value);
+    
+    // Helper: Remove a value from the hash indexes before it is erased/overwritten.
+    // Exclusive-lock paths only: HINDEX readers iterate the index concurrently
+    void unindex(const std::string& key, const RedisValue& value);
+    
+    // Helper: Live (unexpired) hash field, or nullptr - never mutates
+    const std::string* liveHashField(const std::string& key, const std::string& field) const;
+    
 public:
+    explicit StorageEngine(const StorageOptions& options = StorageOptions());
+    
     // ========== STRING OPERATIONS ==========
     
     // SET key value [EX seconds]
     bool set(const std::string& key, const std::string& value, int ttl = 0);
     
+    // SET with the full option matrix, in one keyspace probe
+    SetResult set(const std::string& key, const std::string& value, const SetOptions& options);
+    
     // GET key
     std::optional<std::string> get(const std::string& key);
     
+    // APPEND key value - in place, keeps the TTL; returns the new length
+    // (0 on wrong type or if the result would exceed 512 MB)
+    size_t append(const std::string& key, const std::string& value);
+    
+    // SETRANGE key offset value - overwrite at offset, zero-padding a gap;
+    // returns the new length (0 on wrong type or past 512 MB)
+    size_t setrange(const std::string& key, size_t offset, const std::string& value);
+    
+    // GETRANGE key start end - inclusive, negative counts from the end
+    // View into the stored value: valid until the key is next written
+    std::string_view getrange(const std::string& key, long start, long end);
+    
+    // STRLEN key
+    size_t strlen(const std::string& key);
+    
+    // GETEX key [EX seconds | PERSIST] - ttl > 0 sets a new TTL
+    std::optional<std::string> getex(const std::string& key, int ttl = 0, bool persist = false);
+    
+    // GETDEL key - value moved out, then the key is erased
+    std::optional<std::string> getdel(const std::string& key);
+    
     // ========== LIST OPERATIONS ==========
     
     // LPUSH key value1 [value2 ...] - push to left (head)
@@ -62,6 +303,33 @@ public:
     // LLEN key - get list length
     size_t llen(const std::string& key);
     
+    // LINDEX key index - negative counts from the tail
+    std::optional<std::string> lindex(const std::string& key, int index);
+    
+    // LSET key index value - false if no such key or index out of range
+    bool lset(const std::string& key, int index, const std::string& value);
+    
+    // LINSERT key BEFORE|AFTER pivot value
+    // New length, -1 if pivot not found, 0 if no such key
+    long linsert(const std::string& key, ListInsert where, const std::string& pivot, const std::string& value);
+    
+    // LTRIM key start stop - keep [start, stop]; whole chunks are dropped
+    // False only on wrong type (a missing key is already "trimmed")
+    bool ltrim(const std::string& key, int start, int stop);
+    
+    // LREM key count value - count > 0 from head, < 0 from tail, 0 = all
+    size_t lrem(const std::string& key, int count, const std::string& value);
+    
+    // LPOS key value [RANK r] [COUNT n] [MAXLEN len] - matching indices
+    // rank -1 = first match from the tail; count 0 = all; maxlen 0 = no limit
+    std::vector<size_t> lpos(const std::string& key, const std::string& value, int rank = 1,
+                             size_t count = 1, size_t maxlen = 0);
+    
+    // LMOVE source destination LEFT|RIGHT LEFT|RIGHT - moved element
+    // nullopt if source is empty or destination holds another type
+    std::optional<std::string> lmove(const std::string& source, const std::string& destination,
+                                     ListEnd from, ListEnd to);
+    
     // ========== SET OPERATIONS ==========
     
     // SADD key member1 [member2 ...] - add members to set
@@ -79,6 +347,16 @@ public:
     // SCARD key - get set size
     size_t scard(const std::string& key);
     
+    // SMISMEMBER key member1 [member2 ...] - key resolved once
+    std::vector<bool> smismember(const std::string& key, const std::vector<std::string>& members);
+    
+    // SRANDMEMBER key [count] - count > 0: up to count distinct members,
+    // count < 0: exactly -count members, repeats allowed
+    std::vector<std::string> srandmember(const std::string& key, long count = 1);
+    
+    // SPOP key [count] - remove and return up to count random members
+    std::vector<std::string> spop(const std::string& key, size_t count = 1);
+    
     // ========== HASH OPERATIONS ==========
     
     // HSET key field value
@@ -99,11 +377,304 @@ public:
     // HLEN key - get number of fields
     size_t hlen(const std::string& key);
     
+    // HSET key field1 value1 [field2 value2 ...] - returns the number of new fields
+    size_t hset(const std::string& key, const std::vector<std::pair<std::string, std::string>>& fields);
+    
+    // HMGET key field1 [field2 ...] - nullopt per missing field
+    std::vector<std::optional<std::string>> hmget(const std::string& key, const std::vector<std::string>& fields);
+    
+    // HRANDFIELD key [count] WITHVALUES - same count rules as SRANDMEMBER
+    std::vector<std::pair<std::string, std::string>> hrandfield(const std::string& key, long count = 1);
+    
+    // HEXPIRE key seconds FIELDS field1 [field2 ...] - per-field TTL
+    // Per field: 1 = TTL set, 2 = deleted (seconds <= 0), -2 = no such field
+    std::vector<int> hexpire(const std::string& key, int seconds, const std::vector<std::string>& fields);
+    
+    // HTTL key FIELDS field1 [field2 ...]
+    // Per field: remaining seconds, -1 = no TTL, -2 = no such field
+    std::vector<int> httl(const std::string& key, const std::vector<std::string>& fields);
+    
+    // HPERSIST key FIELDS field1 [field2 ...] - remove field TTLs
+    // Per field: 1 = TTL removed, -1 = had no TTL, -2 = no such field
+    std::vector<int> hpersist(const std::string& key, const std::vector<std::string>& fields);
+    
+    // ========== HASH INDEX OPERATIONS ==========
+    
+    // HINDEX.CREATE name PREFIX prefix FIELD field EXACT|NUMERIC
+    // Indexes the existing hashes too; false if the name is taken
+    bool hindexCreate(const std::string& name, const std::string& prefix, const std::string& field,
+                      HashIndexKind kind);
+    
+    // HINDEX.DROP name
+    bool hindexDrop(const std::string& name);
+    
+    // HINDEX.LOOKUP name value - keys whose field equals value (EXACT)
+    std::vector<std::string> hindexLookup(const std::string& name, const std::string& value) const;
+    
+    // HINDEX.RANGE name min max [LIMIT n] - keys by ascending value (NUMERIC)
+    std::vector<std::string> hindexRange(const std::string& name, double min, double max,
+                                         size_t limit = 0) const;
+    
+    // HINDEX.LIST
+    std::vector<HashIndexInfo> hindexList() const;
+    
+    // ========== STREAM OPERATIONS ==========
+    
+    // XADD key [MAXLEN n] <* | ms-* | ms-seq> field value [field value ...]
+    // Returns new entry ID, nullopt on wrong type or non-increasing ID
+    std::optional<std::string> xadd(const std::string& key, const std::string& id,
+                                    const StreamFields& fields, size_t maxlen = 0);
+    
+    // XRANGE key start end [COUNT n] - "-" and "+" mean min/max ID
+    std::vector<StreamEntry> xrange(const std::string& key, const std::string& start,
+                                    const std::string& end, size_t count = 0);
+    
+    // XREAD [COUNT n] STREAMS key [key ...] id [id ...] (non-blocking part)
+    // Entries strictly after each ID; "$" = only entries added from now on
+    std::vector<std::pair<std::string, std::vector<StreamEntry>>> xread(
+        const std::vector<std::pair<std::string, std::string>>& streams, size_t count = 0);
+    
+    // Last ID of a stream ("0-0" if missing) - resolves "$" for blocking XREAD
+    std::string streamLastId(const std::string& key);
+    
+    // XLEN key
+    size_t xlen(const std::string& key);
+    
+    // XTRIM key MAXLEN n - returns number of entries removed
+    size_t xtrim(const std::string& key, size_t maxlen);
+    
+    // XGROUP CREATE key group <id | $> [MKSTREAM]
+    bool xgroupCreate(const std::string& key, const std::string& group,
+                      const std::string& id, bool mkstream = false);
+    
+    // XREADGROUP GROUP group consumer [COUNT n] STREAMS key <> | id>
+    // nullopt if the key or group doesn't exist
+    std::optional<std::vector<StreamEntry>> xreadgroup(const std::string& key, const std::string& group,
+                                                       const std::string& consumer,
+                                                       const std::string& id, size_t count = 0);
+    
+    // XACK key group id [id ...]
+    size_t xack(const std::string& key, const std::string& group, const std::vector<std::string>& ids);
+    
+    // XPENDING key group [COUNT n]
+    std::vector<StreamPendingInfo> xpending(const std::string& key, const std::string& group, size_t count = 0);
+    
+    // ========== GEO OPERATIONS ==========
+    
+    // GEOADD key lon lat member [lon lat member ...]
+    // Returns number of NEW members (invalid coordinates are skipped)
+    size_t geoadd(const std::string& key, const std::vector<GeoMember>& members);
+    
+    // GEOPOS key member [member ...] - (lon, lat) or nullopt per member
+    std::vector<std::optional<std::pair<double, double>>> geopos(const std::string& key,
+                                                                 const std::vector<std::string>& members);
+    
+    // GEODIST key member1 member2 [m|km|mi|ft]
+    std::optional<double> geodist(const std::string& key, const std::string& member1,
+                                  const std::string& member2, const std::string& unit = "m");
+    
+    // GEOSEARCH key <FROMMEMBER m | FROMLONLAT lon lat> <BYRADIUS r | BYBOX w h> unit [COUNT n] [ASC|DESC]
+    std::vector<GeoResult> geosearch(const std::string& key, const GeoSearchQuery& query);
+    
+    // ========== BLOOM / CUCKOO FILTER OPERATIONS ==========
+    
+    // BF.RESERVE key error_rate capacity [EXPANSION n]
+    // False if the key exists or the parameters are invalid
+    bool bfreserve(const std::string& key, double error_rate, size_t capacity, unsigned expansion = 2);
+    
+    // BF.ADD key item - true if newly added (creates a default filter)
+    bool bfadd(const std::string& key, const std::string& item);
+    
+    // BF.MADD key item [item ...]
+    std::vector<bool> bfmadd(const std::string& key, const std::vector<std::string>& items);
+    
+    // BF.EXISTS key item - false positives possible, false negatives never
+    bool bfexists(const std::string& key, const std::string& item);
+    
+    // BF.MEXISTS key item [item ...] - batched, prefetching probe
+    std::vector<bool> bfmexists(const std::string& key, const std::vector<std::string>& items);
+    
+    // CF.RESERVE key capacity [EXPANSION n]
+    bool cfreserve(const std::string& key, size_t capacity, unsigned expansion = 2);
+    
+    // CF.ADD key item (duplicates allowed)
+    bool cfadd(const std::string& key, const std::string& item);
+    
+    // CF.EXISTS key item
+    bool cfexists(const std::string& key, const std::string& item);
+    
+    // CF.MEXISTS key item [item ...]
+    std::vector<bool> cfmexists(const std::string& key, const std::vector<std::string>& items);
+    
+    // CF.DEL key item - removes one copy
+    bool cfdel(const std::string& key, const std::string& item);
+    
+    // ========== COUNT-MIN / TOP-K SKETCH OPERATIONS ==========
+    
+    // CMS.INITBYDIM key width depth - false if the key exists
+    bool cmsInitByDim(const std::string& key, size_t width, size_t depth);
+    
+    // CMS.INITBYPROB key error probability
+    bool cmsInitByProb(const std::string& key, double error, double probability);
+    
+    // CMS.INCRBY key item increment [item increment ...]
+    // New estimates, empty if the key is missing or not a sketch
+    std::vector<uint64_t> cmsIncrBy(const std::string& key,
+                                    const std::vector<std::pair<std::string, uint64_t>>& increments);
+    
+    // CMS.QUERY key item [item ...] - empty if the key is missing
+    std::vector<uint64_t> cmsQuery(const std::string& key, const std::vector<std::string>& items);
+    
+    // CMS.MERGE dest numkeys src [src ...] [WEIGHTS w ...]
+    // dest must exist; all sketches must share its dimensions
+    bool cmsMerge(const std::string& dest, const std::vector<std::string>& sources,
+                  const std::vector<uint64_t>& weights = {});
+    
+    // TOPK.RESERVE key k [width depth decay] - false if the key exists
+    bool topkReserve(const std::string& key, size_t k, size_t width = 0, size_t depth = 0,
+                     double decay = TopKSketch::kDefaultDecay);
+    
+    // TOPK.ADD key item [item ...] - item expelled from the top-k per add
+    std::vector<std::optional<std::string>> topkAdd(const std::string& key, const std::vector<std::string>& items);
+    
+    // TOPK.INCRBY key item increment [item increment ...]
+    std::vector<std::optional<std::string>> topkIncrBy(const std::string& key,
+                                                       const std::vector<std::pair<std::string, uint64_t>>& increments);
+    
+    // TOPK.QUERY key item [item ...] - in the current top-k?
+    std::vector<bool> topkQuery(const std::string& key, const std::vector<std::string>& items);
+    
+    // TOPK.LIST key WITHCOUNT - descending by count
+    std::vector<std::pair<std::string, uint32_t>> topkList(const std::string& key);
+    
+    // Folds the sources' heavy hitters into dest (dest must exist)
+    bool topkMerge(const std::string& dest, const std::vector<std::string>& sources);
+    
+    // ========== T-DIGEST OPERATIONS ==========
+    
+    // TDIGEST.CREATE key [COMPRESSION c] - false if the key exists
+    bool tdigestCreate(const std::string& key, double compression = TDigest::kDefaultCompression);
+    
+    // TDIGEST.ADD key value [value ...] - false if the key is missing
+    bool tdigestAdd(const std::string& key, const std::vector<double>& values);
+    
+    // TDIGEST.QUANTILE key q [q ...] - empty if the key is missing
+    std::vector<double> tdigestQuantile(const std::string& key, const std::vector<double>& quantiles);
+    
+    // TDIGEST.CDF key value [value ...]
+    std::vector<double> tdigestCdf(const std::string& key, const std::vector<double>& values);
+    
+    // TDIGEST.MERGE dest numkeys src [src ...] [COMPRESSION c]
+    // Creates dest if missing (compression 0 = largest of the sources)
+    bool tdigestMerge(const std::string& dest, const std::vector<std::string>& sources, double compression = 0);
+    
+    // ========== TIME SERIES OPERATIONS ==========
+    
+    // TS.CREATE key [RETENTION ms] - false if the key exists
+    bool tsCreate(const std::string& key, int64_t retention_ms = 0);
+    
+    // TS.ADD key timestamp value - creates the series if missing
+    // False if timestamp is not newer than the last sample
+    bool tsAdd(const std::string& key, int64_t timestamp, double value);
+    
+    // TS.MADD for one key - returns number of samples appended
+    size_t tsMadd(const std::string& key, const std::vector<TimeSeriesSample>& samples);
+    
+    // TS.GET key - latest sample
+    std::optional<TimeSeriesSample> tsGet(const std::string& key);
+    
+    // TS.RANGE key from to [AGGREGATION avg|min|max|sum|count bucket_ms]
+    std::vector<TimeSeriesSample> tsRange(const std::string& key, int64_t from, int64_t to,
+                                          TimeSeriesAggregation aggregation = TimeSeriesAggregation::NONE,
+                                          int64_t bucket_ms = 0);
+    
+    // TS.INFO key
+    std::optional<TimeSeriesInfo> tsInfo(const std::string& key);
+    
+    // ========== JSON OPERATIONS ==========
+    
+    // JSON.SET key path json - a new key needs the root path
+    // False on malformed JSON, bad path or missing parent
+    bool jsonSet(const std::string& key, const std::string& path, const std::string& json);
+    
+    // JSON.GET key [path] - serialized value
+    std::optional<std::string> jsonGet(const std::string& key, const std::string& path = "$");
+    
+    // JSON.DEL key [path] - deleting the root deletes the key
+    size_t jsonDel(const std::string& key, const std::string& path = "$");
+    
+    // JSON.NUMINCRBY key path value - new number, serialized
+    std::optional<std::string> jsonNumIncrBy(const std::string& key, const std::string& path, double increment);
+    
+    // JSON.ARRAPPEND key path json [json ...] - new array length
+    std::optional<size_t> jsonArrAppend(const std::string& key, const std::string& path,
+                                        const std::vector<std::string>& values);
+    
+    // JSON.TYPE key [path]
+    std::optional<std::string> jsonType(const std::string& key, const std::string& path = "$");
+    
+    // ========== VECTOR SET OPERATIONS ==========
+    
+    // VADD key [Q8|NOQUANT] [M m] [EF ef] VALUES dim ... element
+    // The first add fixes dim / quantization / graph parameters
+    // False on a dimension mismatch, zero vector, existing element or wrong type
+    bool vadd(const std::string& key, const std::string& element, const std::vector<float>& vector,
+              VectorQuant quant = VectorQuant::Q8, size_t m = RedisVectorSet::kDefaultM,
+              size_t ef_construction = RedisVectorSet::kDefaultEfConstruction);
+    
+    // VSIM key VALUES dim ... [COUNT k] [EF ef] - best first
+    std::vector<VectorMatch> vsim(const std::string& key, const std::vector<float>& query,
+                                  size_t k = 10, size_t ef = 0);
+    
+    // VSIM key ELE element [COUNT k] [EF ef] - excludes the element itself
+    std::vector<VectorMatch> vsimElement(const std::string& key, const std::string& element,
+                                         size_t k = 10, size_t ef = 0);
+    
+    // VCARD key
+    size_t vcard(const std::string& key);
+    
+    // VDIM key - 0 if missing
+    size_t vdim(const std::string& key);
+    
+    // VEMB key element - normalized (dequantized) vector
+    std::optional<std::vector<float>> vemb(const std::string& key, const std::string& element);
+    
+    // ========== QUOTA OPERATIONS ==========
+    
+    // QUOTA.SET name PREFIX prefix BUDGET bytes - create or re-budget a
+    // namespace (empty prefix = this whole database; budget 0 = account
+    // only). Existing keys are charged right away and the namespace is
+    // evicted down to the budget. False if the prefix is already taken
+    // or `name` exists with another prefix.
+    bool setQuota(const std::string& name, const std::string& prefix, size_t budget);
+    
+    // QUOTA.DROP name - its keys become unaccounted (nothing is deleted)
+    bool dropQuota(const std::string& name);
+    
+    // QUOTA.INFO - usage, hit/miss and eviction counters per namespace
+    std::vector<NamespaceStats> quotaStats() const;
+    
     // ========== GENERAL OPERATIONS ==========
     
     // DEL key - delete key (any type)
     bool remove(const std::string& key);
     
+    // UNLINK key - like DEL, but a big value is freed in the background
+    bool unlink(const std::string& key);
+    
+    // RENAME key newkey - relinks the table node (no value copy), keeps
+    // the TTL, overwrites newkey; false if key doesn't exist
+    bool rename(const std::string& key, const std::string& newkey);
+    
+    // COPY source destination [REPLACE] - O(1): both keys share the
+    // payload copy-on-write (see RedisValue); false if source is missing
+    // or destination exists without replace
+    bool copy(const std::string& source, const std::string& destination, bool replace = false);
+    
+    // MOVE key db - into another engine (logical database); false if key
+    // is missing or already exists there
+    bool move(const std::string& key, StorageEngine& destination);
+    
     // EXISTS key
     bool exists(const std::string& key);
     
@@ -116,26 +687,62 @@ public:
     // TTL key - get remaining time to live (-1 if no expiry, -2 if not exists)
     int ttl(const std::string& key);
     
+    // PTTL key - like TTL, in milliseconds
+    long long pttl(const std::string& key);
+    
     // KEYS - get all keys (for testing, not production)
     std::vector<std::string> keys() const;
     
     // DBSIZE - get number of keys
     size_t size() const;
     
-    // FLUSHDB - delete all keys
-    void clear();
+    // FLUSHDB [ASYNC] - delete all keys; async detaches the whole table
+    // and frees it in the background
+    void clear(bool async = false);
     
-    // Clean up expired keys (call periodically)
+    // Clean up expired keys and expired hash fields (call periodically)
+    // Returns number of keys removed
     size_t cleanupExpired();
     
+    // One bounded slice of active expiry: resumes the bucket cursor left
+    // by the previous slice and checks up to `samples` keys carrying a TTL
+    // or field TTLs, reclaiming the expired ones. At most
+    // kExpireBucketsPerSample buckets are walked per sample, so keys
+    // without TTLs can't stretch a slice
+    static constexpr size_t kExpireBucketsPerSample = 20;
+    ExpireSlice activeExpireSlice(size_t samples);
+    
+    // Huge page coverage of the keyspace arena (all zero when off)
+    HugePageStats hugePageStats() const;
+    
+    // Lazy free queue depth and totals
+    LazyFreeStats lazyFreeStats() const;
+    
+    // Report reads / modifications to `tracking` (null = off); it must
+    // outlive the engine
+    void setTracking(ClientTracking* tracking) { tracking_ = tracking; }
+    
+    // INFO keyspace - key/TTL counts for this database (one scan)
+    KeyspaceStats keyspaceStats() const;
+    
     // Get raw data for persistence
-    const std::unordered_map<std::string, RedisValue>& getRawData() const {
+    const KeySpace& getRawData() const {
         return store_;
     }
     
-    // Load raw data from persistence
-    void loadRawData(const std::unordered_map<std::string, RedisValue>& data) {
-        store_ = data;
+    // Load raw data from persistence (the type getRawData() returns, so a
+    // round trip copies table to table)
+    void loadRawData(const KeySpace& data) {
+        if (&data == &store_) return;
+        store_.clear();
+        indexes_.clearEntries();
+        store_.insert(data.begin(), data.end());
+        for (const auto& [key, value] : store_) {
+            if (value.getType() == ValueType::HASH) indexes_.hashAdded(key, std::get<RedisHash>(value.view()));
+        }
+        recount();
+        enforceQuotas();
+        if (tracking_) tracking_->flushed();
     }
 };
 
@@ -0,0 +1,147 @@
+#ifndef STREAMTYPE_H
+#define STREAMTYPE_H
+
+/*
+StreamType.h - Redis STREAM data type (append-only log with IDs)
+
+Entry IDs are "<ms>-<seq>" and strictly increasing, so a stream is
+an ordered log you can range-scan by time.
+
+Memory layout (what makes 10^8 entries affordable):
+- Entries are packed into blocks of up to 128 entries
+- Ordered index: first ID of each block → block (std::map, O(log n) seek)
+- Inside a block every entry is a varint byte string:
+    ms delta from block's first ID, seq, field count,
+    and either just the values (if field names equal the block's
+    first entry - the common case) or names + values
+- Per entry overhead: 4 byte offset + a few varint bytes
+
+Consumer groups:
+- last_delivered: high-water mark for ">" reads
+- pending (PEL): delivered but not yet XACKed entries, per consumer
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+struct StreamID {
+    uint64_t ms = 0;
+    uint64_t seq = 0;
+
+    bool operator<(const StreamID& o) const { return ms < o.ms || (ms == o.ms && seq < o.seq); }
+    bool operator==(const StreamID& o) const { return ms == o.ms && seq == o.seq; }
+    bool operator!=(const StreamID& o) const { return !(*this == o); }
+    bool operator<=(const StreamID& o) const { return !(o < *this); }
+    bool operator>(const StreamID& o) const { return o < *this; }
+
+    static StreamID min() { return StreamID{0, 0}; }
+    static StreamID max() { return StreamID{UINT64_MAX, UINT64_MAX}; }
+
+    // "1700000000000-3" (or "1700000000000" with missing_seq as seq)
+    static std::optional<StreamID> parse(const std::string& text, uint64_t missing_seq = 0);
+    std::string toString() const;
+};
+
+using StreamFields = std::vector<std::pair<std::string, std::string>>;
+
+struct StreamEntry {
+    StreamID id;
+    StreamFields fields;
+};
+
+// One row of XPENDING
+struct StreamPendingInfo {
+    StreamID id;
+    std::string consumer;
+    int64_t idle_ms;
+    uint64_t delivery_count;
+};
+
+class RedisStream {
+public:
+    static constexpr size_t kBlockEntries = 128;
+
+    // XADD: id_spec is "*", "<ms>-*" or "<ms>-<seq>"
+    // Returns the new ID, or nullopt if the ID is not greater than the last one
+    std::optional<StreamID> add(const std::string& id_spec, const StreamFields& fields);
+
+    // XRANGE (inclusive bounds), count = 0 means unlimited
+    std::vector<StreamEntry> range(StreamID start, StreamID end, size_t count = 0) const;
+
+    // Entries strictly after `id` (XREAD)
+    std::vector<StreamEntry> after(StreamID id, size_t count = 0) const;
+
+    // XTRIM MAXLEN - keep the newest `maxlen` entries, returns removed count
+    size_t trim(size_t maxlen);
+
+    size_t length() const { return length_; }
+    StreamID lastId() const { return last_id_; }
+
+    // ========== CONSUMER GROUPS ==========
+
+    // XGROUP CREATE - deliver entries after `start`; false if it exists
+    bool createGroup(const std::string& group, StreamID start);
+
+    // XREADGROUP ">" - new entries for `consumer`, added to the PEL
+    // nullopt if the group doesn't exist
+    std::optional<std::vector<StreamEntry>> readGroupNew(const std::string& group,
+                                                         const std::string& consumer,
+                                                         size_t count);
+
+    // XREADGROUP <id> - re-read this consumer's pending entries after `id`
+    std::optional<std::vector<StreamEntry>> readGroupPending(const std::string& group,
+                                                             const std::string& consumer,
+                                                             StreamID id, size_t count);
+
+    // XACK - returns number of entries removed from the PEL
+    size_t ack(const std::string& group, const std::vector<StreamID>& ids);
+
+    // XPENDING (extended form)
+    std::vector<StreamPendingInfo> pending(const std::string& group, size_t count = 0) const;
+
+    size_t groupCount() const { return groups_.size(); }
+
+private:
+    // Packed block of up to kBlockEntries entries (see header comment)
+    struct Block {
+        StreamID first;                       // ID of entry 0 (delta base)
+        std::vector<std::string> master_fields;  // Field names of entry 0
+        std::vector<uint32_t> offsets;        // Start of each entry in payload
+        std::string payload;
+
+        size_t size() const { return offsets.size(); }
+        void append(StreamID id, const StreamFields& fields);
+        StreamEntry decode(size_t index) const;
+        StreamID idAt(size_t index) const;
+    };
+
+    struct PendingEntry {
+        std::string consumer;
+        std::chrono::steady_clock::time_point delivered;
+        uint64_t delivery_count;
+    };
+
+    struct ConsumerGroup {
+        StreamID last_delivered;
+        std::map<StreamID, PendingEntry> pending;  // PEL
+    };
+
+    // Visit entries with start <= id <= end, stop when fn returns false
+    template <typename Fn>
+    void scan(StreamID start, StreamID end, Fn&& fn) const;
+
+    std::optional<StreamEntry> find(StreamID id) const;
+
+    std::map<StreamID, Block> blocks_;  // first ID → block
+    size_t length_ = 0;
+    StreamID last_id_;
+    std::unordered_map<std::string, ConsumerGroup> groups_;
+};
+
+#endif // STREAMTYPE_H
@@ -0,0 +1,72 @@
+#ifndef TDIGESTTYPE_H
+#define TDIGESTTYPE_H
+
+/*
+TDigestType.h - Streaming percentiles (TDIGEST.*)
+
+Keeping raw latency samples in a LIST grows without bound, and a
+p99 needs every sample pulled out and sorted. A t-digest summarizes
+the distribution as <= 2 x compression weighted centroids (mean, weight):
+- Centroids near the tails (q ≈ 0 or 1) stay tiny → accurate p99/p999
+- Centroids near the median may absorb many samples
+- Size is bounded by compression, not by the sample count
+  (compression 100 ≈ 2 KB of centroids + 3.2 KB of buffer)
+
+Inserts are buffered:
+- add() appends to an unsorted buffer of 4 * compression values
+- when it fills, the buffer is sorted and merged with the centroids
+  in ONE linear pass (merging digest, k2 scale function)
+→ amortized O(1) per insert (plus the buffer sort)
+
+Reads never mutate: quantile()/cdf() on a digest with buffered values
+work on a merged copy, so they are safe under a shared lock.
+*/
+
+#include <cstddef>
+#include <vector>
+
+class TDigest {
+public:
+    static constexpr double kDefaultCompression = 100;
+
+    explicit TDigest(double compression = kDefaultCompression);
+
+    void add(double value);
+    void add(const std::vector<double>& values);  // Batched
+
+    // Folds another digest in (centroids are merged, not re-added)
+    void merge(const TDigest& other);
+
+    // Value at quantile q in [0, 1]; NaN if empty
+    double quantile(double q) const;
+    std::vector<double> quantile(const std::vector<double>& qs) const;
+
+    // Fraction of samples <= value; NaN if empty
+    double cdf(double value) const;
+    std::vector<double> cdf(const std::vector<double>& values) const;
+
+    double min() const { return min_; }
+    double max() const { return max_; }
+    double totalWeight() const { return total_weight_ + static_cast<double>(buffer_.size()); }
+    double compression() const { return compression_; }
+    size_t centroids() const { return means_.size(); }
+
+private:
+    // Merges the buffer and `extra` centroids into means_/weights_
+    void compress(std::vector<double> extra_means = {}, std::vector<double> extra_weights = {});
+
+    // Point queries on a digest whose buffer is empty
+    double quantileMerged(double q) const;
+    double cdfMerged(double value) const;
+
+    double compression_;
+    double min_;
+    double max_;
+    double total_weight_ = 0;       // Weight in the centroids
+
+    std::vector<double> means_;     // Sorted centroid means
+    std::vector<double> weights_;   // Parallel to means_
+    std::vector<double> buffer_;    // Unmerged unit-weight samples
+};
+
+#endif // TDIGESTTYPE_H
@@ -0,0 +1,118 @@
+#ifndef TENANTQUOTA_H
+#define TENANTQUOTA_H
+
+/*
+TenantQuota.h - Per-tenant memory budgets with isolated eviction
+
+With one memory limit for the whole process, one noisy tenant pushes
+everyone else's hot keys out. A namespace gives a group of keys its
+own budget and its own eviction pool:
+
+    QUOTA.SET tenant-a PREFIX a:  BUDGET 64mb
+    QUOTA.SET tenant-b PREFIX b:  BUDGET 16mb
+    QUOTA.SET db3      PREFIX ""  BUDGET 1gb    (run in db 3: the whole logical DB)
+
+A key belongs to the namespace with the longest matching prefix, or to
+none - then it is neither accounted nor evicted.
+
+Accounting is incremental: every mutating engine command re-measures
+only the keys it touched (a MEMORY USAGE-style estimate, collections
+sampled, so O(1) per key) and applies the delta to the owner's ledger.
+When the command returns and a namespace is over budget, keys are
+evicted from THAT namespace only, least recently used first
+(approximated like Redis: the oldest of 5 random ledger entries).
+
+The ledger is a DenseTable keyed by key, so the random sample is O(1)
+and the ledger doubles as the eviction pool. No namespaces → one
+branch per command.
+*/
+
+#include "DenseTable.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+struct NamespaceStats {
+    std::string name;
+    std::string prefix;     // Keys covered (empty = the whole database)
+    size_t budget = 0;      // Bytes; 0 = account only, never evict
+    size_t used = 0;        // Estimated bytes of the live keys
+    size_t keys = 0;
+    uint64_t hits = 0;      // Read lookups that found the key
+    uint64_t misses = 0;    // Read lookups that didn't
+    uint64_t evictions = 0; // Keys evicted to stay within budget
+};
+
+class QuotaTable {
+public:
+    static constexpr size_t kEvictionSamples = 5;
+
+    // Access clock of a ledger entry. Reads stamp it under the store's
+    // SHARED lock, so it is atomic; copyable so the ledger can grow.
+    struct Stamp {
+        std::atomic<uint64_t> value{0};
+
+        Stamp() = default;
+        Stamp(const Stamp& other) : value(other.value.load(std::memory_order_relaxed)) {}
+        Stamp& operator=(const Stamp& other) {
+            value.store(other.value.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            return *this;
+        }
+    };
+
+    struct Charge {
+        size_t bytes = 0;
+        Stamp last_access;
+    };
+
+    struct Namespace {
+        std::string name;
+        std::string prefix;
+        size_t budget = 0;
+        size_t used = 0;
+        std::atomic<uint64_t> hits{0};
+        std::atomic<uint64_t> misses{0};
+        uint64_t evictions = 0;
+        DenseTable<std::pair<std::string, Charge>> ledger;  // key → charge
+
+        bool overBudget() const { return budget != 0 && used > budget; }
+    };
+
+    bool empty() const { return namespaces_.empty(); }
+
+    // Create or re-budget; false if another namespace has this prefix
+    bool define(const std::string& name, const std::string& prefix, size_t budget);
+    bool drop(const std::string& name);
+    std::vector<NamespaceStats> stats() const;
+
+    // Namespace owning key (longest prefix), or nullptr
+    Namespace* owner(std::string_view key) const;
+
+    // Key now costs `bytes` (0 = gone); also counts as an access
+    void charge(Namespace& ns, const std::string& key, size_t bytes);
+
+    // Lookup of key; `read` lookups count as hits/misses
+    void touch(std::string_view key, bool found, bool read);
+
+    // Least recently accessed of a few sampled keys, or nullptr if empty
+    const std::string* victim(const Namespace& ns) const;
+
+    // FLUSHDB / reload: drop all charges, keep definitions and counters
+    void clearCharges();
+
+    template <typename Fn>
+    void forEach(Fn fn) {
+        for (auto& ns : namespaces_) fn(*ns);
+    }
+
+private:
+    std::vector<std::unique_ptr<Namespace>> namespaces_;  // Few; scanned per lookup
+    std::atomic<uint64_t> clock_{0};
+};
+
+#endif // TENANTQUOTA_H
@@ -14,15 +14,49 @@ Why separate from KeyValueStore?
 - Single Responsibility: concurrency control is separate concern
 - Testability: can test KeyValueStore without threading complexity
 - Optional: can use KeyValueStore without overhead if single-threaded
+
+Logical databases (SELECT / SWAPDB / MOVE):
+- One KeyValueStore per database, each with its own keyspace, expiry
+  and stats; commands act on the database the CALLING THREAD selected
+  (a thread plays the role of a Redis connection), default 0
+- SWAPDB exchanges two database pointers under the exclusive lock:
+  O(1) and atomic, so a dataset rebuilt offline in db 1 goes live
+  with no reader ever seeing it half-loaded
 */
 
 #include "KeyValueStore.h"
+#include "AsyncExecutor.h"
+#include "NumaTopology.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
 #include <mutex>
 #include <shared_mutex>  // C++17: read-write lock
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 class ThreadSafeStore {
 private:
-    KeyValueStore store_;
+    // Invalidation table for client-side caching, shared by all databases
+    // Declared before dbs_ so it outlives the engines pointing at it
+    ClientTracking tracking_;
+    
+    // Logical databases; slots are swapped by swapdb(), so resolve
+    // them with db() only while holding mutex_
+    std::vector<std::unique_ptr<KeyValueStore>> dbs_;
+    
+    // Distinguishes stores in the per-thread SELECT table (an address
+    // could be reused by a later store)
+    const uint64_t id_;
+    
+    // Database selected by the calling thread
+    size_t selected() const;
+    KeyValueStore& db() const { return *dbs_[selected()]; }
     
     // shared_mutex allows multiple readers OR one writer
     // Better than mutex for read-heavy workloads
@@ -30,10 +64,56 @@ private:
     // Writers: unique_lock (exclusive)
     mutable std::shared_mutex mutex_;
     
+    // Wakes blocked XREAD callers when a stream may have grown
+    mutable std::condition_variable_any stream_cv_;
+    
+    // Lazily started worker for the *_async commands (see AsyncExecutor.h)
+    // Declared after dbs_/mutex_ so it is destroyed (and drained) first
+    std::once_flag executor_once_;
+    std::unique_ptr<AsyncExecutor> executor_;
+    std::atomic<AsyncExecutor*> executor_published_{nullptr};  // For readers that bypass call_once
+    
+    AsyncExecutor& executor();
+    
+    // Applies a batch under a single exclusive lock
+    void runBatch(AsyncExecutor::Batch& batch);
+    
+    // NUMA node the async worker is pinned to (-1 = unpinned)
+    std::atomic<int> numa_node_{-1};
+    
+    // Background active-expiry cycle (keys + hash fields)
+    std::thread expiry_thread_;
+    std::mutex expiry_mutex_;
+    std::condition_variable expiry_cv_;
+    bool expiry_stop_ = false;
+    size_t expiry_db_ = 0;  // Database the next cycle starts at (expiry thread only)
+    
+    // Like Redis' active expire: keys with TTLs sampled per slice, and
+    // a database gets another slice while over 10% of them had expired
+    static constexpr size_t kActiveExpireSamples = 20;
+    static constexpr size_t kActiveExpireAcceptablePercent = 10;
+    
+    // One cycle: bounded slices, each under its own exclusive lock, until
+    // every database is below the acceptable ratio or `budget` runs out
+    void activeExpireCycle(std::chrono::steady_clock::duration budget);
+    
 public:
+    static constexpr size_t kDefaultDatabases = 16;
+    
+    explicit ThreadSafeStore(const StorageOptions& options = StorageOptions(),
+                             size_t databases = kDefaultDatabases);
+    ~ThreadSafeStore();
+    
     // ========== STRING COMMANDS ==========
     bool set(const std::string& key, const std::string& value, int ttl = 0);
+    SetResult set(const std::string& key, const std::string& value, const SetOptions& options);
     std::optional<std::string> get(const std::string& key) const;
+    size_t append(const std::string& key, const std::string& value);
+    size_t setrange(const std::string& key, size_t offset, const std::string& value);
+    std::string getrange(const std::string& key, long start, long end) const;
+    size_t strlen(const std::string& key) const;
+    std::optional<std::string> getex(const std::string& key, int ttl = 0, bool persist = false);
+    std::optional<std::string> getdel(const std::string& key);
     
     // ========== LIST COMMANDS ==========
     size_t lpush(const std::string& key, const std::vector<std::string>& values);
@@ -42,6 +122,14 @@ public:
     std::optional<std::string> rpop(const std::string& key);
     std::vector<std::string> lrange(const std::string& key, int start, int stop) const;
     size_t llen(const std::string& key) const;
+    std::optional<std::string> lindex(const std::string& key, int index) const;
+    bool lset(const std::string& key, int index, const std::string& value);
+    long linsert(const std::string& key, ListInsert where, const std::string& pivot, const std::string& value);
+    bool ltrim(const std::string& key, int start, int stop);
+    size_t lrem(const std::string& key, int count, const std::string& value);
+    std::vector<size_t> lpos(const std::string& key, const std::string& value, int rank = 1, size_t count = 1,
+                             size_t maxlen = 0) const;
+    std::optional<std::string> lmove(const std::string& source, const std::string& destination, ListEnd from, ListEnd to);
     
     // ========== SET COMMANDS ==========
     size_t sadd(const std::string& key, const std::vector<std::string>& members);
@@ -49,6 +137,9 @@ public:
     bool sismember(const std::string& key, const std::string& member) const;
     std::vector<std::string> smembers(const std::string& key) const;
     size_t scard(const std::string& key) const;
+    std::vector<bool> smismember(const std::string& key, const std::vector<std::string>& members) const;
+    std::vector<std::string> srandmember(const std::string& key, long count = 1) const;
+    std::vector<std::string> spop(const std::string& key, size_t count = 1);
     
     // ========== HASH COMMANDS ==========
     bool hset(const std::string& key, const std::string& field, const std::string& value);
@@ -57,22 +148,277 @@ public:
     bool hexists(const std::string& key, const std::string& field) const;
     std::unordered_map<std::string, std::string> hgetall(const std::string& key) const;
     size_t hlen(const std::string& key) const;
+    std::vector<int> hexpire(const std::string& key, int seconds, const std::vector<std::string>& fields);
+    std::vector<int> httl(const std::string& key, const std::vector<std::string>& fields) const;
+    std::vector<int> hpersist(const std::string& key, const std::vector<std::string>& fields);
+    size_t hset(const std::string& key, const std::vector<std::pair<std::string, std::string>>& fields);
+    std::vector<std::optional<std::string>> hmget(const std::string& key, const std::vector<std::string>& fields) const;
+    std::vector<std::pair<std::string, std::string>> hrandfield(const std::string& key, long count = 1) const;
+    
+    // ========== STREAM COMMANDS ==========
+    std::optional<std::string> xadd(const std::string& key, const std::string& id,
+                                    const StreamFields& fields, size_t maxlen = 0);
+    std::vector<StreamEntry> xrange(const std::string& key, const std::string& start,
+                                    const std::string& end, size_t count = 0) const;
+    
+    // XREAD [COUNT n] [BLOCK ms] STREAMS ...
+    // block_ms < 0: return immediately; 0: wait forever; > 0: wait up to block_ms
+    // "$" IDs are resolved once, before waiting (only entries added later match)
+    std::vector<std::pair<std::string, std::vector<StreamEntry>>> xread(
+        const std::vector<std::pair<std::string, std::string>>& streams,
+        size_t count = 0, int block_ms = -1) const;
+    
+    size_t xlen(const std::string& key) const;
+    size_t xtrim(const std::string& key, size_t maxlen);
+    bool xgroupCreate(const std::string& key, const std::string& group,
+                      const std::string& id, bool mkstream = false);
+    std::optional<std::vector<StreamEntry>> xreadgroup(const std::string& key, const std::string& group,
+                                                       const std::string& consumer,
+                                                       const std::string& id, size_t count = 0);
+    size_t xack(const std::string& key, const std::string& group, const std::vector<std::string>& ids);
+    std::vector<StreamPendingInfo> xpending(const std::string& key, const std::string& group, size_t count = 0) const;
+    
+    // ========== GEO COMMANDS ==========
+    size_t geoadd(const std::string& key, const std::vector<GeoMember>& members);
+    std::vector<std::optional<std::pair<double, double>>> geopos(const std::string& key,
+                                                                 const std::vector<std::string>& members) const;
+    std::optional<double> geodist(const std::string& key, const std::string& member1,
+                                  const std::string& member2, const std::string& unit = "m") const;
+    std::vector<GeoResult> geosearch(const std::string& key, const GeoSearchQuery& query) const;
+    
+    // ========== BLOOM / CUCKOO FILTER COMMANDS ==========
+    bool bfreserve(const std::string& key, double error_rate, size_t capacity, unsigned expansion = 2);
+    bool bfadd(const std::string& key, const std::string& item);
+    std::vector<bool> bfmadd(const std::string& key, const std::vector<std::string>& items);
+    bool bfexists(const std::string& key, const std::string& item) const;
+    std::vector<bool> bfmexists(const std::string& key, const std::vector<std::string>& items) const;
+    bool cfreserve(const std::string& key, size_t capacity, unsigned expansion = 2);
+    bool cfadd(const std::string& key, const std::string& item);
+    bool cfexists(const std::string& key, const std::string& item) const;
+    std::vector<bool> cfmexists(const std::string& key, const std::vector<std::string>& items) const;
+    bool cfdel(const std::string& key, const std::string& item);
+    
+    // ========== COUNT-MIN / TOP-K SKETCH COMMANDS ==========
+    bool cmsInitByDim(const std::string& key, size_t width, size_t depth);
+    bool cmsInitByProb(const std::string& key, double error, double probability);
+    std::vector<uint64_t> cmsIncrBy(const std::string& key, const std::vector<std::pair<std::string, uint64_t>>& increments);
+    std::vector<uint64_t> cmsQuery(const std::string& key, const std::vector<std::string>& items) const;
+    bool cmsMerge(const std::string& dest, const std::vector<std::string>& sources, const std::vector<uint64_t>& weights = {});
+    bool topkReserve(const std::string& key, size_t k, size_t width = 0, size_t depth = 0, double decay = TopKSketch::kDefaultDecay);
+    std::vector<std::optional<std::string>> topkAdd(const std::string& key, const std::vector<std::string>& items);
+    std::vector<std::optional<std::string>> topkIncrBy(const std::string& key, const std::vector<std::pair<std::string, uint64_t>>& increments);
+    std::vector<bool> topkQuery(const std::string& key, const std::vector<std::string>& items) const;
+    std::vector<std::pair<std::string, uint32_t>> topkList(const std::string& key) const;
+    bool topkMerge(const std::string& dest, const std::vector<std::string>& sources);
+    
+    // ========== T-DIGEST COMMANDS ==========
+    bool tdigestCreate(const std::string& key, double compression = TDigest::kDefaultCompression);
+    bool tdigestAdd(const std::string& key, const std::vector<double>& values);
+    std::vector<double> tdigestQuantile(const std::string& key, const std::vector<double>& quantiles) const;
+    std::vector<double> tdigestCdf(const std::string& key, const std::vector<double>& values) const;
+    bool tdigestMerge(const std::string& dest, const std::vector<std::string>& sources, double compression = 0);
+    
+    // ========== TIME SERIES COMMANDS ==========
+    bool tsCreate(const std::string& key, int64_t retention_ms = 0);
+    bool tsAdd(const std::string& key, int64_t timestamp, double value);
+    size_t tsMadd(const std::string& key, const std::vector<TimeSeriesSample>& samples);
+    std::optional<TimeSeriesSample> tsGet(const std::string& key) const;
+    std::vector<TimeSeriesSample> tsRange(const std::string& key, int64_t from, int64_t to, TimeSeriesAggregation aggregation = TimeSeriesAggregation::NONE, int64_t bucket_ms = 0) const;
+    std::optional<TimeSeriesInfo> tsInfo(const std::string& key) const;
+    
+    // ========== JSON COMMANDS ==========
+    bool jsonSet(const std::string& key, const std::string& path, const std::string& json);
+    std::optional<std::string> jsonGet(const std::string& key, const std::string& path = "$") const;
+    size_t jsonDel(const std::string& key, const std::string& path = "$");
+    std::optional<std::string> jsonNumIncrBy(const std::string& key, const std::string& path, double increment);
+    std::optional<size_t> jsonArrAppend(const std::string& key, const std::string& path, const std::vector<std::string>& values);
+    std::optional<std::string> jsonType(const std::string& key, const std::string& path = "$") const;
+    
+    // ========== VECTOR SET COMMANDS ==========
+    bool vadd(const std::string& key, const std::string& element, const std::vector<float>& vector,
+              VectorQuant quant = VectorQuant::Q8, size_t m = RedisVectorSet::kDefaultM,
+              size_t ef_construction = RedisVectorSet::kDefaultEfConstruction);
+    std::vector<VectorMatch> vsim(const std::string& key, const std::vector<float>& query, size_t k = 10, size_t ef = 0) const;
+    std::vector<VectorMatch> vsimElement(const std::string& key, const std::string& element, size_t k = 10, size_t ef = 0) const;
+    size_t vcard(const std::string& key) const;
+    size_t vdim(const std::string& key) const;
+    std::optional<std::vector<float>> vemb(const std::string& key, const std::string& element) const;
+    
+    // ========== HASH INDEX COMMANDS ==========
+    bool hindexCreate(const std::string& name, const std::string& prefix, const std::string& field,
+                      HashIndexKind kind);
+    bool hindexDrop(const std::string& name);
+    std::vector<std::string> hindexLookup(const std::string& name, const std::string& value) const;
+    std::vector<std::string> hindexRange(const std::string& name, double min, double max, size_t limit = 0) const;
+    std::vector<HashIndexInfo> hindexList() const;
+    
+    // ========== QUOTA COMMANDS ==========
+    // Namespaces live in the selected database; prefix "" budgets all of it
+    bool setQuota(const std::string& name, const std::string& prefix, size_t budget);
+    bool dropQuota(const std::string& name);
+    std::vector<NamespaceStats> quotaStats() const;
     
     // ========== GENERAL COMMANDS ==========
     bool del(const std::string& key);
+    bool unlink(const std::string& key);
+    bool rename(const std::string& key, const std::string& newkey);
+    bool copy(const std::string& source, const std::string& destination, bool replace = false);
     bool exists(const std::string& key) const;
     std::optional<ValueType> type(const std::string& key) const;
     bool expire(const std::string& key, int seconds);
     int ttl(const std::string& key) const;
+    long long pttl(const std::string& key) const;
     std::vector<std::string> keys() const;
     size_t size() const;
-    void clear();
+    void clear(bool async = false);
+    HugePageStats hugePageStats() const;
+    LazyFreeStats lazyFreeStats() const;
+    
+    // ========== DATABASE COMMANDS ==========
+    // SELECT index - for the calling thread only; false if out of range
+    bool select(size_t index);
+    size_t selectedDb() const { return selected(); }
+    size_t databases() const { return dbs_.size(); }
+    
+    // SWAPDB a b - O(1), atomic for every other thread
+    bool swapdb(size_t a, size_t b);
+    
+    // MOVE key db - from the selected database; false if the key is
+    // missing, already in `index`, or `index` is the selected database
+    bool move(const std::string& key, size_t index);
+    
+    // FLUSHALL [ASYNC]
+    void flushall(bool async = false);
+    
+    // INFO keyspace - one entry per database
+    std::vector<KeyspaceStats> keyspaceStats() const;
+    
+    // ========== CLIENT TRACKING ==========
+    // CLIENT TRACKING ON [BCAST] [PREFIX p ...] [NOLOOP] - the calling
+    // thread becomes the returned client: keys it reads are remembered and
+    // `callback` is told when they change (see ClientTracking.h)
+    uint64_t trackingOn(TrackingOptions options, InvalidationCallback callback);
+    bool trackingOff(uint64_t client);
+    
+    // Commands from the calling thread run as `client` (0 = untracked);
+    // returns the previous binding
+    uint64_t trackingBind(uint64_t client) { return tracking_.bind(client); }
+    
+    // tracking-table-max-keys
+    void setTrackingTableMaxKeys(size_t max_keys) { tracking_.setMaxKeys(max_keys); }
+    TrackingStats trackingStats() const { return tracking_.stats(); }
+    
+    // ========== ACTIVE EXPIRY ==========
+    // Lazy expiry only reclaims what gets touched; this runs an
+    // incremental expiry cycle every `interval` on a background thread so
+    // untouched expired keys and hash fields are reclaimed too. A cycle
+    // takes at most a quarter of the interval, and the store lock is
+    // released between its slices of ~20 keys
+    void startActiveExpiry(std::chrono::milliseconds interval = std::chrono::milliseconds(1000));
+    void stopActiveExpiry();
+    
+    // ========== ASYNC COMMANDS ==========
+    // Never block the caller on the store lock: the operation is queued and
+    // applied by a background worker that batches queued ops per lock.
+    //
+    // Future form:   auto f = store.get_async("k"); ... f.get();  (blocks in get())
+    // Callback form: store.get_async("k", [](auto v) { ... });
+    //                (callback runs on the worker, after the lock is released;
+    //                a failed command reports false / nullopt)
+    std::future<bool> set_async(const std::string& key, const std::string& value, int ttl = 0);
+    std::future<std::optional<std::string>> get_async(const std::string& key);
+    std::future<bool> del_async(const std::string& key);
+    
+    void set_async(const std::string& key, const std::string& value, int ttl,
+                   std::function<void(bool)> done);
+    void get_async(const std::string& key,
+                   std::function<void(std::optional<std::string>)> done);
+    void del_async(const std::string& key, std::function<void(bool)> done);
     
-    // Access underlying store (for persistence)
-    KeyValueStore& getStore() { return store_; }
-    const KeyValueStore& getStore() const { return store_; }
+    // Coroutine form (C++20): co_set / co_get / co_del, below the class
+    
+    // Run any KeyValueStore command asynchronously (on the database
+    // selected when it is submitted):
+    //   auto n = store.submit([](KeyValueStore& s) { return s.llen("q"); });
+    template <typename Fn>
+    auto submit(Fn fn) -> std::future<std::invoke_result_t<Fn&, KeyValueStore&>>;
+    
+    // Async ops queued but not yet applied
+    size_t pendingAsync() const;
+    
+    // ========== NUMA PLACEMENT ==========
+    // Pin the async worker to `node` and make it allocate from that node.
+    // Writes issued through *_async/submit() then place values and
+    // collection nodes in node-local memory (first touch); synchronous
+    // writes allocate them on the caller's node. The keyspace table
+    // itself is placed by StorageOptions::numa_node instead, which holds
+    // for every writer. Returns whether pinning succeeded.
+    std::future<bool> setNumaNode(std::shared_ptr<const NumaTopology> topology, size_t node);
+    int numaNode() const { return numa_node_.load(std::memory_order_relaxed); }
+    
+    // Access the selected database's store (for persistence)
+    KeyValueStore& getStore() { return db(); }
+    const KeyValueStore& getStore() const { return db(); }
 };
 
+template <typename Fn>
+auto ThreadSafeStore::submit(Fn fn) -> std::future<std::invoke_result_t<Fn&, KeyValueStore&>> {
+    using Result = std::invoke_result_t<Fn&, KeyValueStore&>;
+    
+    // std::function needs copyable callables, so share the promise
+    auto promise = std::make_shared<std::promise<Result>>();
+    auto future = promise->get_future();
+    
+    // Pin the caller's database now; the worker thread has its own SELECT
+    size_t index = selected();
+    
+    AsyncTask task;
+    task.apply = [this, promise, index, fn = std::move(fn)]() mutable {
+        try {
+            KeyValueStore& store = *dbs_[index];
+            if constexpr (std::is_void_v<Result>) {
+                fn(store);
+                promise->set_value();
+            } else {
+                promise->set_value(fn(store));
+            }
+        } catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    };
+    executor().submit(std::move(task));
+    return future;
+}
+
+#if defined(__cpp_impl_coroutine)
+// Coroutine form of the async commands (C++20 callers; the library itself
+// stays C++17, and these are free functions so ThreadSafeStore reads the
+// same in both):
+//   std::optional<std::string> v = co_await co_get(store, "k");
+// Built on the callback overloads: the calling thread never blocks, and
+// the coroutine resumes on the async worker - hand heavy work back to
+// your own executor from there
+inline AsyncAwaiter<bool> co_set(ThreadSafeStore& store, const std::string& key,
+                                 const std::string& value, int ttl = 0) {
+    return AsyncAwaiter<bool>([&store, key, value, ttl](std::function<void(bool)> done) {
+        store.set_async(key, value, ttl, std::move(done));
+    });
+}
+
+inline AsyncAwaiter<std::optional<std::string>> co_get(ThreadSafeStore& store, const std::string& key) {
+    return AsyncAwaiter<std::optional<std::string>>(
+        [&store, key](std::function<void(std::optional<std::string>)> done) {
+            store.get_async(key, std::move(done));
+        });
+}
+
+inline AsyncAwaiter<bool> co_del(ThreadSafeStore& store, const std::string& key) {
+    return AsyncAwaiter<bool>([&store, key](std::function<void(bool)> done) {
+        store.del_async(key, std::move(done));
+    });
+}
+#endif
+
 // ============================================================================
 // CONCURRENCY CONCEPTS:
 // ============================================================================
@@ -107,7 +453,18 @@ public:
 //    - We use coarse-grained for simplicity
 //    - Real Redis uses single thread + event loop (no locks!)
 //
-// 4. Deadlock prevention:
+// 4. Async batching (set_async/get_async/submit):
+//    - Callers push onto a queue and return immediately
+//    - One worker drains the queue and applies the whole batch
+//      under ONE unique_lock (N ops, 1 lock handoff)
+//    - Callbacks run after unlock, so they can call the store again -
+//      but must not wait on another async future (see AsyncExecutor.cpp)
+//    - Waiting on a returned future parks the thread; the non-blocking
+//      paths are the callback overloads and, in C++20 code, co_set /
+//      co_get / co_del, which suspend the coroutine and resume it on
+//      the worker (AsyncAwaiter in AsyncExecutor.h)
+//
+// 5. Deadlock prevention:
 //    - Acquire locks in consistent order
 //    - Use RAII (lock_guard, unique_lock)
 //    - Keep critical sections short
@@ -0,0 +1,123 @@
+#ifndef TIMESERIESTYPE_H
+#define TIMESERIESTYPE_H
+
+/*
+TimeSeriesType.h - Compressed time series (TS.*)
+
+Storing samples with RPUSH costs ~60 bytes each (a std::string per
+sample plus list overhead). Real metrics are regular: timestamps
+arrive at a fixed interval and values change slowly. Gorilla
+compression (Facebook, VLDB 2015) exploits both:
+
+Timestamps - delta-of-delta:
+    dod = (t[i] - t[i-1]) - (t[i-1] - t[i-2])
+    '0'                        dod == 0 (the usual case: 1 bit!)
+    '10'   + 7 bits            dod in [-64, 63]
+    '110'  + 9 bits            dod in [-256, 255]
+    '1110' + 12 bits           dod in [-2048, 2047]
+    '1111' + 64 bits           anything else
+
+Values - XOR with the previous value:
+    '0'                        same value
+    '10' + meaningful bits     fits the previous leading/trailing zero window
+    '11' + 5 bits leading + 6 bits length + meaningful bits
+
+→ ~1-2 bytes per sample for typical metrics
+
+Layout:
+- Samples are appended to chunks of up to 4 KB of bitstream
+- Chunks live in a deque ordered by time: appends touch the back,
+  retention drops whole chunks from the front
+- Queries decode only the chunks overlapping [from, to] into flat
+  timestamp/value arrays, then aggregate each bucket with
+  multi-accumulator loops the compiler vectorizes
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <vector>
+
+struct TimeSeriesSample {
+    int64_t timestamp;  // Milliseconds
+    double value;
+};
+
+enum class TimeSeriesAggregation {
+    NONE,
+    AVG,
+    MIN,
+    MAX,
+    SUM,
+    COUNT
+};
+
+struct TimeSeriesInfo {
+    size_t samples;
+    size_t chunks;
+    size_t bytes;          // Compressed bitstream size
+    int64_t first_timestamp;
+    int64_t last_timestamp;
+    int64_t retention_ms;  // 0 = keep forever
+};
+
+class RedisTimeSeries {
+public:
+    static constexpr size_t kChunkBytes = 4096;
+
+    explicit RedisTimeSeries(int64_t retention_ms = 0) : retention_ms_(retention_ms) {}
+
+    // Appends a sample; false if timestamp <= the last one (or too old
+    // for the retention window)
+    bool add(int64_t timestamp, double value);
+
+    std::optional<TimeSeriesSample> last() const;
+
+    // Samples in [from, to]; with an aggregation, one sample per
+    // bucket_ms-wide bucket (aligned to 0) stamped at the bucket start
+    std::vector<TimeSeriesSample> range(int64_t from, int64_t to,
+                                        TimeSeriesAggregation aggregation = TimeSeriesAggregation::NONE,
+                                        int64_t bucket_ms = 0) const;
+
+    TimeSeriesInfo info() const;
+    size_t size() const { return samples_; }
+    size_t chunkCount() const { return chunks_.size(); }
+    size_t bytes() const { return words_ * sizeof(uint64_t); }  // Compressed bitstream, O(1)
+
+private:
+    // Gorilla-compressed run of samples
+    struct Chunk {
+        std::vector<uint64_t> words;  // Bitstream, MSB first
+        size_t bit_count = 0;
+        size_t count = 0;
+        int64_t first_timestamp = 0;
+        int64_t last_timestamp = 0;
+
+        // Encoder state
+        int64_t prev_delta = 0;
+        uint64_t prev_bits = 0;
+        int prev_leading = -1;        // -1 = no window yet
+        int prev_trailing = 0;
+
+        void append(int64_t timestamp, double value);
+        void writeBits(uint64_t value, int n);
+
+        // Appends all samples to the flat arrays
+        void decode(std::vector<int64_t>& timestamps, std::vector<double>& values) const;
+
+        bool full() const { return bit_count >= kChunkBytes * 8; }
+    };
+
+    // Drops chunks entirely older than the retention window
+    void expireChunks();
+
+    int64_t oldestAllowed() const;
+
+    std::deque<Chunk> chunks_;
+    int64_t retention_ms_;
+    size_t samples_ = 0;
+    size_t words_ = 0;  // Bitstream words across all chunks
+};
+
+#endif // TIMESERIESTYPE_H
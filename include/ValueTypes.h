@@ -6,9 +6,19 @@ ValueTypes.h - Redis Data Type Definitions
 
 Supports 4 core Redis data types:
 1. STRING - Simple key-value (most common)
-2. LIST   - Ordered collection (double-ended queue)
-3. SET    - Unordered unique elements
-4. HASH   - Field-value pairs (like nested map)
+2. LIST   - Ordered collection (quicklist of packed chunks, see ListType.h)
+3. SET    - Unordered unique elements (dense table, see DenseTable.h)
+4. HASH   - Field-value pairs (dense table, see DenseTable.h)
+5. STREAM - Append-only log with time-ordered IDs (see StreamType.h)
+6. GEO    - Geohash-sorted positions (see GeoType.h)
+7. BLOOM  - Scalable blocked Bloom filter (see FilterTypes.h)
+8. CUCKOO - Cuckoo filter with deletes (see FilterTypes.h)
+9. CMS    - Count-min sketch (see SketchTypes.h)
+10. TOPK  - HeavyKeeper top-k sketch (see SketchTypes.h)
+11. TDIGEST - Streaming percentile summary (see TDigestType.h)
+12. TIMESERIES - Gorilla-compressed samples (see TimeSeriesType.h)
+13. JSON   - Parsed document tree with path updates (see JsonType.h)
+14. VECTORSET - Embeddings with HNSW k-NN search (see VectorSetType.h)
 
 Why use variant?
 - Type-safe union (vs void* or inheritance)
@@ -16,12 +26,24 @@ Why use variant?
 - std::visit for type-safe operations
 */
 
+#include "DenseTable.h"
+#include "FilterTypes.h"
+#include "GeoType.h"
+#include "JsonType.h"
+#include "ListType.h"
+#include "SketchTypes.h"
+#include "StreamType.h"
+#include "TDigestType.h"
+#include "TimeSeriesType.h"
+#include "VectorSetType.h"
+#include <algorithm>
 #include <string>
 #include <vector>
 #include <unordered_set>
 #include <unordered_map>
 #include <variant>
 #include <chrono>
+#include <memory>
 #include <optional>
 
 // Forward declarations
@@ -32,30 +54,116 @@ enum class ValueType {
     STRING,
     LIST,
     SET,
-    HASH
+    HASH,
+    STREAM,
+    GEO,
+    BLOOM,
+    CUCKOO,
+    CMS,
+    TOPK,
+    TDIGEST,
+    TIMESERIES,
+    JSON,
+    VECTORSET
 };
 
 // Type aliases for clarity
 using RedisString = std::string;
-using RedisList = std::vector<std::string>;
-using RedisSet = std::unordered_set<std::string>;
-using RedisHash = std::unordered_map<std::string, std::string>;
+using RedisList = QuickList;
+using RedisSet = DenseSet;
+using RedisHash = DenseHash;
+// RedisStream: class in StreamType.h (packed blocks + consumer groups)
+// RedisGeo:    class in GeoType.h (geohash-ordered index)
+using RedisBloom = ScalableBloomFilter;
+using RedisCuckoo = CuckooFilter;
+using RedisCountMin = CountMinSketch;
+using RedisTopK = TopKSketch;
+using RedisTDigest = TDigest;
+// RedisTimeSeries: class in TimeSeriesType.h (compressed chunks)
+// RedisJson:       class in JsonType.h (parsed tree + paths)
+// RedisVectorSet:  class in VectorSetType.h (HNSW graph)
 
 // std::variant - type-safe union (C++17)
 // Can hold ONE of these types at a time
-using RedisData = std::variant<RedisString, RedisList, RedisSet, RedisHash>;
+using RedisData = std::variant<RedisString, RedisList, RedisSet, RedisHash, RedisStream, RedisGeo,
+                               RedisBloom, RedisCuckoo, RedisCountMin, RedisTopK, RedisTDigest,
+                               RedisTimeSeries, RedisJson, RedisVectorSet>;
 
 // Time point for TTL (Time-To-Live)
 using TimePoint = std::chrono::system_clock::time_point;
 
+// Per-field expiry for HASH values (HEXPIRE)
+// Kept out of RedisHash so hashes without field TTLs pay nothing
+// (RedisValue only holds a null pointer until the first HEXPIRE)
+//
+// Deadlines are keyed by the field's dense position in the hash (see
+// DenseTable.h), not its name, so no field string is copied. Every field
+// erase must report the hash's swap-remove through erased().
+struct HashFieldExpiry {
+    std::unordered_map<uint32_t, TimePoint> deadlines;  // position → expiry
+    TimePoint earliest = TimePoint::max();              // min of deadlines
+    
+    // Recompute earliest after removals
+    void refresh() {
+        earliest = TimePoint::max();
+        for (const auto& [index, when] : deadlines) {
+            if (when < earliest) earliest = when;
+        }
+    }
+    
+    // Every one of the hash's `fields` is past its deadline (deadlines
+    // only ever name live positions)
+    bool allDue(size_t fields, TimePoint now) const {
+        if (deadlines.size() < fields || earliest > now) return false;
+        return std::all_of(deadlines.begin(), deadlines.end(),
+                           [now](const auto& entry) { return entry.second <= now; });
+    }
+    
+    // The hash erased position `index`; its former last entry (`last`)
+    // now lives there, deadline included
+    void erased(size_t index, size_t last) {
+        deadlines.erase(static_cast<uint32_t>(index));
+        if (index == last) return;
+        auto moved = deadlines.find(static_cast<uint32_t>(last));
+        if (moved == deadlines.end()) return;
+        deadlines.emplace(static_cast<uint32_t>(index), moved->second);
+        deadlines.erase(moved);
+    }
+};
+
 // Complete Redis value with metadata
+//
+// Copy-on-write: COPY turns the payload into a shared RedisData (share()),
+// so duplicating a 100 MB hash is a refcount bump. Readers go through
+// view(); writers call own(), which copies the payload first if another
+// key still shares it (or just takes it back if this is the last owner).
+// Shared payloads never cross lock domains: every key referencing one
+// lives in the same StorageEngine (or its sibling databases).
 struct RedisValue {
-    RedisData data;                          // Actual data (string/list/set/hash)
+    RedisData data;                          // Owned payload (unused while shared is set)
     std::optional<TimePoint> expiry;         // Optional expiration time
+    std::unique_ptr<HashFieldExpiry> field_expiry;  // HASH only, null if no field TTLs
+    std::shared_ptr<RedisData> shared;       // COW payload after COPY, else null
     
     // Default constructor (required for map operations)
     RedisValue() : data(RedisString("")), expiry(std::nullopt) {}
     
+    // Deep copy of an owned payload; a shared one just gains a reference
+    RedisValue(const RedisValue& other)
+        : data(other.data), expiry(other.expiry),
+          field_expiry(other.field_expiry
+                           ? std::make_unique<HashFieldExpiry>(*other.field_expiry)
+                           : nullptr),
+          shared(other.shared) {}
+    
+    RedisValue& operator=(const RedisValue& other) {
+        if (this != &other) *this = RedisValue(other);
+        return *this;
+    }
+    
+    RedisValue(RedisValue&&) = default;
+    RedisValue& operator=(RedisValue&&) = default;
+    
     // Constructor for non-expiring values
     explicit RedisValue(RedisData d) 
         : data(std::move(d)), expiry(std::nullopt) {}
@@ -69,10 +177,38 @@ struct RedisValue {
         }
     }
     
-    // Check if value has expired
+    // Payload for reading (never copies)
+    const RedisData& view() const { return shared ? *shared : data; }
+    
+    // Payload for writing: unshares first
+    RedisData& own() {
+        if (shared) {
+            if (shared.use_count() == 1) {
+                data = std::move(*shared);  // Last owner: take it back
+            } else {
+                data = *shared;
+            }
+            shared.reset();
+        }
+        return data;
+    }
+    
+    // COPY: a value sharing this one's payload (O(1) for any size)
+    RedisValue share() {
+        if (!shared) {
+            shared = std::make_shared<RedisData>(std::move(data));
+            data = RedisString();
+        }
+        return RedisValue(*this);
+    }
+    
+    // Check if value has expired; a hash whose every field has expired
+    // is gone too (Redis deletes the key with its last field)
     bool isExpired() const {
-        if (!expiry.has_value()) return false;
-        return std::chrono::system_clock::now() > expiry.value();
+        if (!expiry.has_value() && !field_expiry) return false;
+        auto now = std::chrono::system_clock::now();
+        if (expiry.has_value() && now > expiry.value()) return true;
+        return field_expiry && field_expiry->allDue(std::get<RedisHash>(view()).size(), now);
     }
     
     // Get type of stored data
@@ -84,7 +220,17 @@ struct RedisValue {
             else if constexpr (std::is_same_v<T, RedisList>) return ValueType::LIST;
             else if constexpr (std::is_same_v<T, RedisSet>) return ValueType::SET;
             else if constexpr (std::is_same_v<T, RedisHash>) return ValueType::HASH;
-        }, data);
+            else if constexpr (std::is_same_v<T, RedisStream>) return ValueType::STREAM;
+            else if constexpr (std::is_same_v<T, RedisGeo>) return ValueType::GEO;
+            else if constexpr (std::is_same_v<T, RedisBloom>) return ValueType::BLOOM;
+            else if constexpr (std::is_same_v<T, RedisCuckoo>) return ValueType::CUCKOO;
+            else if constexpr (std::is_same_v<T, RedisCountMin>) return ValueType::CMS;
+            else if constexpr (std::is_same_v<T, RedisTopK>) return ValueType::TOPK;
+            else if constexpr (std::is_same_v<T, RedisTDigest>) return ValueType::TDIGEST;
+            else if constexpr (std::is_same_v<T, RedisTimeSeries>) return ValueType::TIMESERIES;
+            else if constexpr (std::is_same_v<T, RedisJson>) return ValueType::JSON;
+            else if constexpr (std::is_same_v<T, RedisVectorSet>) return ValueType::VECTORSET;
+        }, view());
     }
 };
 
@@ -95,6 +241,16 @@ inline std::string typeToString(ValueType type) {
         case ValueType::LIST:   return "list";
         case ValueType::SET:    return "set";
         case ValueType::HASH:   return "hash";
+        case ValueType::STREAM: return "stream";
+        case ValueType::GEO:    return "geo";
+        case ValueType::BLOOM:  return "bloom";
+        case ValueType::CUCKOO: return "cuckoo";
+        case ValueType::CMS:    return "cms";
+        case ValueType::TOPK:   return "topk";
+        case ValueType::TDIGEST: return "tdigest";
+        case ValueType::TIMESERIES: return "timeseries";
+        case ValueType::JSON:   return "json";
+        case ValueType::VECTORSET: return "vectorset";
         default: return "unknown";
     }
 }
@@ -141,6 +297,7 @@ inline std::string typeToString(ValueType type) {
 //    - Keys auto-expire after duration
 //    - Redis uses this for caching
 //    - std::chrono for time arithmetic
+//    - Hash fields can expire individually (HashFieldExpiry side table)
 //
 // ============================================================================
 
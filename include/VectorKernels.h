@@ -0,0 +1,32 @@
+#ifndef VECTORKERNELS_H
+#define VECTORKERNELS_H
+
+/*
+VectorKernels.h - Dot-product kernels with runtime CPU dispatch
+
+The library is built for baseline x86-64 (no -march=native), so the
+SIMD versions are compiled per function with
+__attribute__((target("..."))) and picked ONCE at startup with
+__builtin_cpu_supports:
+
+    avx512  - 16 floats / 32 int8 per instruction (AVX-512F + BW)
+    avx2    - 8 floats (FMA) / 16 int8 per instruction
+    scalar  - portable fallback (and non-x86 builds)
+
+Set KV_VECTOR_KERNEL=scalar|avx2|avx512 to force a (supported)
+level, e.g. to compare them in vector_bench.
+*/
+
+#include <cstddef>
+#include <cstdint>
+
+// sum(a[i] * b[i])
+float dotF32(const float* a, const float* b, size_t n);
+
+// sum(a[i] * b[i]) over int8 (exact, accumulated in int32)
+int32_t dotI8(const int8_t* a, const int8_t* b, size_t n);
+
+// Selected level: "avx512", "avx2" or "scalar"
+const char* vectorKernelName();
+
+#endif // VECTORKERNELS_H
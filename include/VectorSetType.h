@@ -0,0 +1,135 @@
+#ifndef VECTORSETTYPE_H
+#define VECTORSETTYPE_H
+
+/*
+VectorSetType.h - Vector set with HNSW k-NN search (VADD / VSIM)
+
+Embeddings live next to the records they describe; VSIM finds the
+k most similar elements (cosine similarity) without a full scan.
+
+HNSW (Hierarchical Navigable Small World, Malkov & Yashunin):
+- Every element is a node in a proximity graph; a random subset is
+  also in sparser upper layers (level ~ -ln(U) / ln(M))
+- Search: greedy descent through the upper layers to get close,
+  then a best-first search with `ef` candidates on layer 0
+- Larger ef → higher recall, lower QPS (see bench/vector_bench.cpp)
+- Neighbor lists are pruned with the diversity heuristic, so
+  clusters stay connected to each other
+
+Storage (all contiguous, indexed by node id):
+- FP32: normalized float vectors, dim floats per node
+- Q8:   normalized vectors quantized to int8 (max-abs scaling),
+        dim bytes + one float scale per node → 4x smaller,
+        distances via exact int32 dot products
+- Layer-0 links: one flat array, (2M + 1) slots per node
+  (count + ids), so the hot layer is a single allocation
+- Distance kernels: see VectorKernels.h (AVX-512 / AVX2 / scalar)
+
+Searches are const and use a thread-local visited table, so many
+VSIM can run in parallel under a shared lock.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+enum class VectorQuant {
+    FP32,   // NOQUANT
+    Q8      // int8 (default, like Redis vector sets)
+};
+
+struct VectorMatch {
+    std::string element;
+    double score;           // Similarity: 1 = same direction, 0 = opposite
+};
+
+class RedisVectorSet {
+public:
+    static constexpr size_t kDefaultM = 16;
+    static constexpr size_t kDefaultEfConstruction = 200;
+    static constexpr size_t kDefaultEfSearch = 100;
+
+    RedisVectorSet(size_t dim, VectorQuant quant = VectorQuant::Q8,
+                   size_t m = kDefaultM, size_t ef_construction = kDefaultEfConstruction);
+
+    // False if the element exists, the dimension differs or the vector is all zeros
+    bool add(const std::string& element, const std::vector<float>& vector);
+
+    // k most similar elements, best first (ef = 0 → max(k, kDefaultEfSearch))
+    std::vector<VectorMatch> search(const std::vector<float>& query, size_t k, size_t ef = 0) const;
+
+    // Search around an existing element (VSIM ... ELE); nullopt if missing
+    std::optional<std::vector<VectorMatch>> searchElement(const std::string& element, size_t k,
+                                                          size_t ef = 0) const;
+
+    // Stored (normalized, possibly dequantized) vector
+    std::optional<std::vector<float>> embedding(const std::string& element) const;
+
+    size_t size() const { return names_.size(); }
+    size_t dim() const { return dim_; }
+    VectorQuant quant() const { return quant_; }
+
+private:
+    using NodeId = uint32_t;
+    using Candidate = std::pair<float, NodeId>;  // (distance, node)
+
+    // Query in the same representation as the stored vectors
+    struct Query {
+        std::vector<float> f32;
+        std::vector<int8_t> q8;
+        float scale = 0;
+    };
+
+    std::optional<Query> prepare(const std::vector<float>& vector) const;
+    Query nodeQuery(NodeId node) const;
+
+    // Cosine distance (1 - cos) between a query / node and a node
+    float distance(const Query& query, NodeId node) const;
+    float distance(NodeId a, NodeId b) const;
+    void prefetch(NodeId node) const;
+
+    // Neighbor list of node at level (count + ids view)
+    const NodeId* links(NodeId node, int level, size_t& count) const;
+    void setLinks(NodeId node, int level, const std::vector<NodeId>& ids);
+    size_t maxLinks(int level) const { return level == 0 ? 2 * m_ : m_; }
+
+    NodeId greedyClosest(const Query& query, NodeId start, int from_level, int to_level) const;
+
+    // Best-first search on one layer; returns up to ef closest (unsorted)
+    std::vector<Candidate> searchLayer(const Query& query, NodeId entry, size_t ef, int level) const;
+
+    // Diversity heuristic: keep candidates closer to the base than to
+    // any already selected neighbor (input sorted by distance)
+    std::vector<NodeId> selectNeighbors(std::vector<Candidate> candidates, size_t m) const;
+
+    std::vector<VectorMatch> toMatches(std::vector<Candidate> found, size_t k,
+                                       std::optional<NodeId> skip) const;
+
+    size_t dim_;
+    VectorQuant quant_;
+    size_t m_;
+    size_t ef_construction_;
+    double level_mult_;
+    std::mt19937_64 rng_{42};
+
+    std::vector<float> f32_;       // FP32: node * dim_
+    std::vector<int8_t> q8_;       // Q8:   node * dim_
+    std::vector<float> scales_;    // Q8:   per node
+
+    std::vector<NodeId> level0_;                      // node * (2M + 1)
+    std::vector<std::vector<std::vector<NodeId>>> upper_;  // node → level-1 → ids
+    std::vector<int> levels_;
+
+    std::vector<std::string> names_;
+    std::unordered_map<std::string, NodeId> ids_;
+
+    NodeId entry_ = 0;
+    int max_level_ = -1;           // -1 = empty
+};
+
+#endif // VECTORSETTYPE_H
@@ -0,0 +1,72 @@
+#include "../include/AsyncExecutor.h"
+#include <utility>
+
+AsyncExecutor::AsyncExecutor(BatchRunner runner, size_t max_batch)
+    : runner_(std::move(runner)),
+      max_batch_(max_batch > 0 ? max_batch : 1),
+      worker_(&AsyncExecutor::run, this) {}
+
+AsyncExecutor::~AsyncExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_one();
+    worker_.join();  // Worker drains remaining tasks before exiting
+}
+
+void AsyncExecutor::submit(AsyncTask task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(std::move(task));
+    }
+    cv_.notify_one();
+}
+
+size_t AsyncExecutor::pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+}
+
+size_t AsyncExecutor::batchesRun() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return batches_run_;
+}
+
+void AsyncExecutor::run() {
+    Batch batch;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+
+            if (queue_.empty()) return;  // stopping_ and fully drained
+
+            // Take up to max_batch_ tasks; swap is O(1) when all fit
+            if (queue_.size() <= max_batch_) {
+                batch.swap(queue_);
+            } else {
+                auto split = queue_.begin() + static_cast<std::ptrdiff_t>(max_batch_);
+                batch.assign(std::make_move_iterator(queue_.begin()),
+                             std::make_move_iterator(split));
+                queue_.erase(queue_.begin(), split);
+            }
+        }
+
+        // One lock acquisition for the whole batch
+        runner_(batch);
+
+        // Completions run outside the store lock, so callbacks may issue
+        // blocking commands. They must not wait on a *_async or submit()
+        // future: that task queues behind this one worker, which the
+        // waiting callback is blocking - a deadlock
+        for (auto& task : batch) {
+            if (task.complete) task.complete();
+        }
+        batch.clear();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        batches_run_++;
+    }
+}
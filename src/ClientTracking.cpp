@@ -0,0 +1,206 @@
+#include "../include/ClientTracking.h"
+#include <algorithm>
+#include <random>
+
+// ========== CLIENT TRACKING ==========
+
+// Per-thread client binding: tracking instance id → client id
+static std::unordered_map<uint64_t, uint64_t>& bindings() {
+    static thread_local std::unordered_map<uint64_t, uint64_t> table;
+    return table;
+}
+
+static uint64_t nextTrackingId() {
+    static std::atomic<uint64_t> next{1};
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+ClientTracking::ClientTracking(size_t max_keys)
+    : id_(nextTrackingId()), max_keys_(std::max<size_t>(max_keys, 1)) {}
+
+uint64_t ClientTracking::enable(TrackingOptions options, InvalidationCallback callback) {
+    uint64_t client;
+    {
+        std::unique_lock<std::shared_mutex> lock(clients_mutex_);
+        client = next_client_++;
+
+        if (options.bcast) {
+            if (options.prefixes.empty()) options.prefixes.push_back("");
+            for (const auto& prefix : options.prefixes) {
+                auto it = std::find_if(prefixes_.begin(), prefixes_.end(),
+                                       [&](const auto& entry) { return entry.first == prefix; });
+                if (it == prefixes_.end()) it = prefixes_.insert(prefixes_.end(), {prefix, {}});
+                it->second.push_back(client);
+            }
+        }
+
+        Client entry;
+        entry.options = std::move(options);
+        entry.callback = std::make_shared<const InvalidationCallback>(std::move(callback));
+        clients_.emplace(client, std::move(entry));
+        clients_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+    bind(client);
+    return client;
+}
+
+bool ClientTracking::disable(uint64_t client) {
+    std::unique_lock<std::shared_mutex> lock(clients_mutex_);
+    auto it = clients_.find(client);
+    if (it == clients_.end()) return false;
+
+    // Table entries naming the client are left to lapse: delivery skips
+    // unknown ids and the entry goes with the key's next invalidation
+    for (auto& [prefix, subscribers] : prefixes_) {
+        subscribers.erase(std::remove(subscribers.begin(), subscribers.end(), client), subscribers.end());
+    }
+    prefixes_.erase(std::remove_if(prefixes_.begin(), prefixes_.end(),
+                                   [](const auto& entry) { return entry.second.empty(); }),
+                    prefixes_.end());
+
+    clients_.erase(it);
+    clients_count_.fetch_sub(1, std::memory_order_relaxed);
+    if (bindings().count(id_) && bindings()[id_] == client) bindings().erase(id_);
+    return true;
+}
+
+uint64_t ClientTracking::bind(uint64_t client) {
+    uint64_t previous = boundClient();
+    if (client == previous) return previous;
+    if (client == 0) {
+        bindings().erase(id_);
+    } else {
+        bindings()[id_] = client;
+    }
+    return previous;
+}
+
+uint64_t ClientTracking::boundClient() const {
+    const auto& table = bindings();
+    if (table.empty()) return 0;
+    auto it = table.find(id_);
+    return it == table.end() ? 0 : it->second;
+}
+
+void ClientTracking::setMaxKeys(size_t max_keys) {
+    max_keys_.store(std::max<size_t>(max_keys, 1), std::memory_order_relaxed);
+
+    std::vector<Delivery> out;
+    {
+        std::shared_lock<std::shared_mutex> registry(clients_mutex_);
+        for (auto& stripe : stripes_) {
+            std::lock_guard<std::mutex> lock(stripe.mutex);
+            evictLocked(stripe, out);
+        }
+    }
+    deliver(out);
+}
+
+TrackingStats ClientTracking::stats() const {
+    TrackingStats stats;
+    {
+        std::shared_lock<std::shared_mutex> registry(clients_mutex_);
+        stats.clients = clients_.size();
+        stats.prefixes = prefixes_.size();
+    }
+    stats.keys = keys_.load(std::memory_order_relaxed);
+    stats.max_keys = max_keys_.load(std::memory_order_relaxed);
+    stats.invalidations = invalidations_.load(std::memory_order_relaxed);
+    stats.evicted_keys = evicted_keys_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void ClientTracking::keyRead(const std::string& key) {
+    uint64_t client = boundClient();
+    if (client == 0) return;
+
+    std::vector<Delivery> out;
+    {
+        std::shared_lock<std::shared_mutex> registry(clients_mutex_);
+        auto it = clients_.find(client);
+        if (it == clients_.end() || it->second.options.bcast) return;  // BCAST keeps no per-key state
+
+        Stripe& stripe = stripeOf(key);
+        std::lock_guard<std::mutex> lock(stripe.mutex);
+        auto [entry, inserted] = stripe.table.try_emplace(key);
+        if (inserted) keys_.fetch_add(1, std::memory_order_relaxed);
+        auto& readers = entry->second;
+        if (std::find(readers.begin(), readers.end(), client) == readers.end()) readers.push_back(client);
+        evictLocked(stripe, out);
+    }
+    deliver(out);
+}
+
+void ClientTracking::keyModified(const std::string& key) {
+    std::vector<Delivery> out;
+    {
+        std::shared_lock<std::shared_mutex> registry(clients_mutex_);
+        if (keys_.load(std::memory_order_relaxed) == 0 && prefixes_.empty()) return;
+
+        uint64_t writer = boundClient();
+        {
+            Stripe& stripe = stripeOf(key);
+            std::lock_guard<std::mutex> lock(stripe.mutex);
+            invalidateLocked(stripe, key, writer, out);
+        }
+
+        for (const auto& [prefix, subscribers] : prefixes_) {
+            if (key.compare(0, prefix.size(), prefix) != 0) continue;
+            for (uint64_t client : subscribers) {
+                auto it = clients_.find(client);
+                if (it == clients_.end() || (client == writer && it->second.options.noloop)) continue;
+                out.push_back({it->second.callback, key, false});
+            }
+        }
+    }
+    deliver(out);
+}
+
+void ClientTracking::flushed() {
+    std::vector<Delivery> out;
+    {
+        std::shared_lock<std::shared_mutex> registry(clients_mutex_);
+        for (auto& stripe : stripes_) {
+            std::lock_guard<std::mutex> lock(stripe.mutex);
+            keys_.fetch_sub(stripe.table.size(), std::memory_order_relaxed);
+            stripe.table.clear();
+        }
+        for (const auto& [id, client] : clients_) out.push_back({client.callback, std::string(), true});
+    }
+    deliver(out);
+}
+
+void ClientTracking::invalidateLocked(Stripe& stripe, const std::string& key, uint64_t writer,
+                                      std::vector<Delivery>& out) {
+    auto entry = stripe.table.find(key);
+    if (entry == stripe.table.end()) return;
+
+    for (uint64_t client : entry->second) {
+        auto it = clients_.find(client);
+        if (it == clients_.end() || (client == writer && it->second.options.noloop)) continue;
+        out.push_back({it->second.callback, key, false});
+    }
+    stripe.table.erase(entry);  // Read again to be tracked again
+    keys_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void ClientTracking::evictLocked(Stripe& stripe, std::vector<Delivery>& out) {
+    // Only this stripe's keys are at hand; a stripe that runs dry leaves
+    // the rest of the overshoot to the next insert elsewhere
+    thread_local std::mt19937_64 rng(std::random_device{}());
+    while (keys_.load(std::memory_order_relaxed) > max_keys_.load(std::memory_order_relaxed) &&
+           !stripe.table.empty()) {
+        std::uniform_int_distribution<size_t> pick(0, stripe.table.size() - 1);
+        std::string key = stripe.table.at(pick(rng)).first;
+        invalidateLocked(stripe, key, 0, out);  // Even the writer must drop it
+        evicted_keys_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void ClientTracking::deliver(std::vector<Delivery>& out) {
+    // Outside every lock so a callback may disable() or read stats()
+    for (const auto& delivery : out) {
+        (*delivery.callback)(delivery.all ? nullptr : &delivery.key);
+    }
+    invalidations_.fetch_add(out.size(), std::memory_order_relaxed);
+}
@@ -0,0 +1,390 @@
+#include "../include/FilterTypes.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+constexpr size_t kPrefetchDistance = 8;  // Items ahead in batch probes
+
+uint64_t hashItem(const std::string& item) {
+    return std::hash<std::string>{}(item);
+}
+
+// splitmix64 finalizer - derives independent bits from one hash
+uint64_t mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+// Maps a hash to [0, n) without a division
+size_t reduce(uint64_t h, size_t n) {
+    return static_cast<size_t>((static_cast<unsigned __int128>(h) * n) >> 64);
+}
+
+size_t nextPowerOfTwo(size_t n) {
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+}  // namespace
+
+// ========== BLOOM FILTER ==========
+
+namespace {
+
+// The k bit positions of an item, as an 8-word (512-bit) mask
+struct BloomMask {
+    uint64_t words[8] = {};
+
+    BloomMask(uint64_t hash, unsigned k) {
+        // Independent 9-bit slices of a rehash stream (7 per 64-bit word);
+        // double hashing correlates too much within only 512 bits
+        uint64_t h = hash;
+        for (unsigned i = 0; i < k; i++) {
+            if (i % 7 == 0) h = mix(h);
+            unsigned bit = (h >> (9 * (i % 7))) & 511;
+            words[bit >> 6] |= 1ULL << (bit & 63);
+        }
+    }
+};
+
+}  // namespace
+
+ScalableBloomFilter::ScalableBloomFilter(double error_rate, size_t capacity, unsigned expansion)
+    : error_rate_(error_rate), expansion_(std::max(1u, expansion)), next_error_(error_rate) {
+    addLayer(std::max<size_t>(1, capacity), error_rate);
+}
+
+namespace {
+
+// False positive rate of a blocked Bloom filter: blocks receive a
+// Poisson-distributed number of items, and overloaded blocks dominate
+double blockedErrorRate(double bits_per_item, unsigned k) {
+    double lambda = 512.0 / bits_per_item;  // Mean items per block
+    double rate = 0;
+    double poisson = std::exp(-lambda);     // P(j = 0)
+    for (int j = 0; j < 4 * lambda + 32; j++) {
+        double fill = 1 - std::pow(1 - 1.0 / 512, static_cast<double>(j) * k);
+        rate += poisson * std::pow(fill, k);
+        poisson *= lambda / (j + 1);
+    }
+    return rate;
+}
+
+}  // namespace
+
+void ScalableBloomFilter::addLayer(size_t capacity, double error_rate) {
+    // Start from the classic size and grow until the blocked layout
+    // meets the target (blocking costs ~10% at 1%, more at 0.1%)
+    double ln2 = std::log(2.0);
+    double bits_per_item = -std::log(error_rate) / (ln2 * ln2);
+    unsigned k = 1;
+    while (true) {
+        k = std::clamp(static_cast<unsigned>(std::round(ln2 * bits_per_item)), 1u, 16u);
+        if (blockedErrorRate(bits_per_item, k) <= error_rate || bits_per_item > 64) break;
+        bits_per_item *= 1.02;
+    }
+
+    Layer layer;
+    layer.hashes = k;
+    layer.capacity = capacity;
+    size_t bits = static_cast<size_t>(std::ceil(bits_per_item * capacity));
+    layer.blocks.assign(std::max<size_t>(1, (bits + 511) / 512), Block{});
+    layers_.push_back(std::move(layer));
+
+    next_error_ = error_rate * 0.5;  // Tightening ratio: errors sum to < 2x
+}
+
+namespace {
+
+template <typename Block>
+bool blockContains(const Block& block, const BloomMask& mask) {
+#if defined(__AVX2__)
+    // testc: (~block & mask) == 0 for each 256-bit half
+    const __m256i* b = reinterpret_cast<const __m256i*>(block.words);
+    const __m256i* m = reinterpret_cast<const __m256i*>(mask.words);
+    return _mm256_testc_si256(_mm256_load_si256(b), _mm256_loadu_si256(m)) &
+           _mm256_testc_si256(_mm256_load_si256(b + 1), _mm256_loadu_si256(m + 1));
+#else
+    uint64_t missing = 0;
+    for (int w = 0; w < 8; w++) missing |= mask.words[w] & ~block.words[w];
+    return missing == 0;
+#endif
+}
+
+template <typename Block>
+void blockSet(Block& block, const BloomMask& mask) {
+    for (int w = 0; w < 8; w++) block.words[w] |= mask.words[w];
+}
+
+}  // namespace
+
+bool ScalableBloomFilter::add(const std::string& item) {
+    if (contains(item)) return false;
+
+    if (layers_.back().count >= layers_.back().capacity) {
+        addLayer(layers_.back().capacity * expansion_, next_error_);
+    }
+
+    Layer& layer = layers_.back();
+    uint64_t h = hashItem(item);
+    blockSet(layer.blocks[reduce(h, layer.blocks.size())], BloomMask(h, layer.hashes));
+    layer.count++;
+    count_++;
+    return true;
+}
+
+bool ScalableBloomFilter::contains(const std::string& item) const {
+    uint64_t h = hashItem(item);
+
+    // Newest layer first - it holds the most items
+    for (auto it = layers_.rbegin(); it != layers_.rend(); ++it) {
+        if (blockContains(it->blocks[reduce(h, it->blocks.size())], BloomMask(h, it->hashes))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<bool> ScalableBloomFilter::addMany(const std::vector<std::string>& items) {
+    std::vector<bool> result;
+    result.reserve(items.size());
+    for (const auto& item : items) result.push_back(add(item));
+    return result;
+}
+
+std::vector<bool> ScalableBloomFilter::containsMany(const std::vector<std::string>& items) const {
+    std::vector<uint64_t> hashes(items.size());
+    for (size_t i = 0; i < items.size(); i++) hashes[i] = hashItem(items[i]);
+
+    auto prefetch = [&](size_t i) {
+        for (const auto& layer : layers_) {
+            __builtin_prefetch(&layer.blocks[reduce(hashes[i], layer.blocks.size())]);
+        }
+    };
+
+    // Keep kPrefetchDistance blocks in flight while probing
+    for (size_t i = 0; i < std::min(kPrefetchDistance, items.size()); i++) prefetch(i);
+
+    std::vector<bool> result(items.size(), false);
+    for (size_t i = 0; i < items.size(); i++) {
+        if (i + kPrefetchDistance < items.size()) prefetch(i + kPrefetchDistance);
+
+        for (auto it = layers_.rbegin(); it != layers_.rend(); ++it) {
+            if (blockContains(it->blocks[reduce(hashes[i], it->blocks.size())],
+                              BloomMask(hashes[i], it->hashes))) {
+                result[i] = true;
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+size_t ScalableBloomFilter::bytes() const {
+    size_t total = 0;
+    for (const auto& layer : layers_) total += layer.blocks.size() * sizeof(Block);
+    return total;
+}
+
+// ========== CUCKOO FILTER ==========
+
+namespace {
+
+constexpr uint64_t kLaneLow = 0x0001000100010001ULL;   // 1 in every 16-bit lane
+constexpr uint64_t kLaneHigh = 0x8000800080008000ULL;  // Top bit of every lane
+
+// Non-zero iff some 16-bit lane of x is zero; the LOWEST set bit
+// marks the first zero lane exactly
+uint64_t zeroLanes(uint64_t x) {
+    return (x - kLaneLow) & ~x & kLaneHigh;
+}
+
+int firstLane(uint64_t zero_lanes) {
+    return __builtin_ctzll(zero_lanes) >> 4;
+}
+
+uint16_t fingerprint(uint64_t hash) {
+    auto fp = static_cast<uint16_t>(hash >> 48);
+    return fp == 0 ? 1 : fp;  // 0 marks an empty slot
+}
+
+// Partial-key cuckoo hashing: i2 = i1 ^ H(fp), so either bucket
+// can be computed from the other plus the fingerprint
+size_t altIndex(size_t index, uint16_t fp, size_t mask) {
+    return (index ^ (fp * 0x5bd1e995ULL)) & mask;
+}
+
+bool bucketHas(uint64_t bucket, uint16_t fp) {
+    return zeroLanes(bucket ^ (fp * kLaneLow)) != 0;
+}
+
+bool bucketInsert(uint64_t& bucket, uint16_t fp) {
+    uint64_t empty = zeroLanes(bucket);
+    if (!empty) return false;
+    bucket |= static_cast<uint64_t>(fp) << (firstLane(empty) * 16);
+    return true;
+}
+
+bool bucketRemove(uint64_t& bucket, uint16_t fp) {
+    uint64_t match = zeroLanes(bucket ^ (fp * kLaneLow));
+    if (!match) return false;
+    bucket &= ~(0xFFFFULL << (firstLane(match) * 16));
+    return true;
+}
+
+}  // namespace
+
+CuckooFilter::CuckooFilter(size_t capacity, unsigned expansion)
+    : expansion_(std::max(1u, expansion)) {
+    addTable(std::max<size_t>(1, capacity));
+}
+
+void CuckooFilter::addTable(size_t capacity) {
+    Table table;
+    table.buckets.assign(nextPowerOfTwo((capacity + kSlotsPerBucket - 1) / kSlotsPerBucket), 0);
+    table.mask = table.buckets.size() - 1;
+    tables_.push_back(std::move(table));
+}
+
+bool CuckooFilter::insertInto(Table& table, uint64_t hash, uint16_t fp) {
+    size_t i1 = hash & table.mask;
+    size_t i2 = altIndex(i1, fp, table.mask);
+    if (bucketInsert(table.buckets[i1], fp) || bucketInsert(table.buckets[i2], fp)) return true;
+
+    // Both full: evict along a random walk, remembering the path so a
+    // failed walk can be undone (no fingerprint is ever lost)
+    struct Step {
+        size_t bucket;
+        int lane;
+    };
+    std::vector<Step> path;
+    path.reserve(kMaxKicks);
+
+    uint64_t rng = mix(hash);
+    size_t index = (rng & 1) ? i1 : i2;
+    uint16_t current = fp;
+
+    for (int kick = 0; kick < kMaxKicks; kick++) {
+        rng = mix(rng);
+        int lane = static_cast<int>(rng & 3);
+        uint64_t& bucket = table.buckets[index];
+
+        auto victim = static_cast<uint16_t>(bucket >> (lane * 16));
+        bucket = (bucket & ~(0xFFFFULL << (lane * 16))) | (static_cast<uint64_t>(current) << (lane * 16));
+        path.push_back(Step{index, lane});
+        current = victim;
+
+        index = altIndex(index, current, table.mask);
+        if (bucketInsert(table.buckets[index], current)) return true;
+    }
+
+    for (auto it = path.rbegin(); it != path.rend(); ++it) {
+        uint64_t& bucket = table.buckets[it->bucket];
+        auto displaced = static_cast<uint16_t>(bucket >> (it->lane * 16));
+        bucket = (bucket & ~(0xFFFFULL << (it->lane * 16))) | (static_cast<uint64_t>(current) << (it->lane * 16));
+        current = displaced;
+    }
+    return false;
+}
+
+bool CuckooFilter::add(const std::string& item) {
+    uint64_t h = hashItem(item);
+    uint16_t fp = fingerprint(h);
+
+    // Free slot in any table first (cheap), then kick in the newest
+    for (auto& table : tables_) {
+        size_t i1 = h & table.mask;
+        if (bucketInsert(table.buckets[i1], fp) ||
+            bucketInsert(table.buckets[altIndex(i1, fp, table.mask)], fp)) {
+            count_++;
+            return true;
+        }
+    }
+
+    if (!insertInto(tables_.back(), h, fp)) {
+        // Full: grow with a bigger table (the fresh table always has room)
+        addTable(tables_.back().buckets.size() * kSlotsPerBucket * expansion_);
+        if (!insertInto(tables_.back(), h, fp)) return false;
+    }
+    count_++;
+    return true;
+}
+
+bool CuckooFilter::contains(const std::string& item) const {
+    uint64_t h = hashItem(item);
+    uint16_t fp = fingerprint(h);
+
+    for (const auto& table : tables_) {
+        size_t i1 = h & table.mask;
+        if (bucketHas(table.buckets[i1], fp) ||
+            bucketHas(table.buckets[altIndex(i1, fp, table.mask)], fp)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<bool> CuckooFilter::containsMany(const std::vector<std::string>& items) const {
+    std::vector<uint64_t> hashes(items.size());
+    for (size_t i = 0; i < items.size(); i++) hashes[i] = hashItem(items[i]);
+
+    auto prefetch = [&](size_t i) {
+        uint16_t fp = fingerprint(hashes[i]);
+        for (const auto& table : tables_) {
+            size_t i1 = hashes[i] & table.mask;
+            __builtin_prefetch(&table.buckets[i1]);
+            __builtin_prefetch(&table.buckets[altIndex(i1, fp, table.mask)]);
+        }
+    };
+
+    for (size_t i = 0; i < std::min(kPrefetchDistance, items.size()); i++) prefetch(i);
+
+    std::vector<bool> result(items.size(), false);
+    for (size_t i = 0; i < items.size(); i++) {
+        if (i + kPrefetchDistance < items.size()) prefetch(i + kPrefetchDistance);
+
+        uint16_t fp = fingerprint(hashes[i]);
+        for (const auto& table : tables_) {
+            size_t i1 = hashes[i] & table.mask;
+            if (bucketHas(table.buckets[i1], fp) ||
+                bucketHas(table.buckets[altIndex(i1, fp, table.mask)], fp)) {
+                result[i] = true;
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+bool CuckooFilter::remove(const std::string& item) {
+    uint64_t h = hashItem(item);
+    uint16_t fp = fingerprint(h);
+
+    // Newest table first, matching where the latest copy most likely went
+    for (auto it = tables_.rbegin(); it != tables_.rend(); ++it) {
+        size_t i1 = h & it->mask;
+        if (bucketRemove(it->buckets[i1], fp) ||
+            bucketRemove(it->buckets[altIndex(i1, fp, it->mask)], fp)) {
+            count_--;
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t CuckooFilter::bytes() const {
+    size_t total = 0;
+    for (const auto& table : tables_) total += table.buckets.size() * sizeof(uint64_t);
+    return total;
+}
@@ -0,0 +1,392 @@
+#include "../include/GeoType.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr double kEarthRadius = 6372797.560856;  // Meters (same constant as Redis)
+constexpr double kLatMin = -85.05112878;
+constexpr double kLatMax = 85.05112878;
+constexpr double kLonMin = -180.0;
+constexpr double kLonMax = 180.0;
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kDegToRad = kPi / 180.0;
+
+// Spread the low 32 bits of v so bit i moves to bit 2i
+uint64_t spreadBits(uint64_t v) {
+    v &= 0xFFFFFFFFULL;
+    v = (v | (v << 16)) & 0x0000FFFF0000FFFFULL;
+    v = (v | (v << 8))  & 0x00FF00FF00FF00FFULL;
+    v = (v | (v << 4))  & 0x0F0F0F0F0F0F0F0FULL;
+    v = (v | (v << 2))  & 0x3333333333333333ULL;
+    v = (v | (v << 1))  & 0x5555555555555555ULL;
+    return v;
+}
+
+// Longitude bits on odd positions, latitude on even
+uint64_t interleave(uint64_t lon_bits, uint64_t lat_bits) {
+    return (spreadBits(lon_bits) << 1) | spreadBits(lat_bits);
+}
+
+uint64_t quantize(double value, double min, double max) {
+    constexpr double kCells = static_cast<double>(1ULL << RedisGeo::kStepBits);
+    auto q = static_cast<uint64_t>((value - min) / (max - min) * kCells);
+    return std::min<uint64_t>(q, (1ULL << RedisGeo::kStepBits) - 1);
+}
+
+double haversine(double lon1, double lat1, double lon2, double lat2) {
+    double dlat = (lat2 - lat1) * kDegToRad;
+    double dlon = (lon2 - lon1) * kDegToRad;
+    double u = std::sin(dlat / 2);
+    double v = std::sin(dlon / 2);
+    double a = u * u + std::cos(lat1 * kDegToRad) * std::cos(lat2 * kDegToRad) * v * v;
+    return 2.0 * kEarthRadius * std::asin(std::sqrt(std::min(1.0, a)));
+}
+
+// Haversine "a" term for an angular distance of `meters`
+double haversineBound(double meters) {
+    double half = std::min(meters / (2.0 * kEarthRadius), kPi / 2);
+    double s = std::sin(half);
+    return s * s;
+}
+
+// ========== DISTANCE FILTER KERNELS ==========
+// Struct-of-arrays, no branches, no calls: the compiler turns these
+// loops into SIMD code. Uses
+//   cos(a - b) = cos a cos b + sin a sin b
+// so per candidate only precomputed sin/cos values are needed.
+// `a` is the haversine term: monotonic in distance, so it also ranks.
+
+struct Center {
+    double sin_lat, cos_lat, sin_lon, cos_lon;
+};
+
+void filterRadius(const double* sin_lat, const double* cos_lat,
+                  const double* sin_lon, const double* cos_lon, size_t n,
+                  const Center& c, double bound, double* a, uint8_t* keep) {
+    for (size_t i = 0; i < n; i++) {
+        double cos_dlat = c.cos_lat * cos_lat[i] + c.sin_lat * sin_lat[i];
+        double cos_dlon = c.cos_lon * cos_lon[i] + c.sin_lon * sin_lon[i];
+        a[i] = 0.5 * (1.0 - cos_dlat) + c.cos_lat * cos_lat[i] * 0.5 * (1.0 - cos_dlon);
+        keep[i] = a[i] <= bound;
+    }
+}
+
+void filterBox(const double* sin_lat, const double* cos_lat,
+               const double* sin_lon, const double* cos_lon, size_t n,
+               const Center& c, double ns_bound, double ew_bound, double* a, uint8_t* keep) {
+    for (size_t i = 0; i < n; i++) {
+        double cos_dlat = c.cos_lat * cos_lat[i] + c.sin_lat * sin_lat[i];
+        double cos_dlon = c.cos_lon * cos_lon[i] + c.sin_lon * sin_lon[i];
+        double a_ns = 0.5 * (1.0 - cos_dlat);                               // Along meridian
+        double a_ew = cos_lat[i] * cos_lat[i] * 0.5 * (1.0 - cos_dlon);     // Along parallel
+        a[i] = a_ns + c.cos_lat * cos_lat[i] * 0.5 * (1.0 - cos_dlon);
+        keep[i] = (a_ns <= ns_bound) & (a_ew <= ew_bound);
+    }
+}
+
+}  // namespace
+
+std::optional<double> RedisGeo::unitToMeters(const std::string& unit) {
+    if (unit == "m") return 1.0;
+    if (unit == "km") return 1000.0;
+    if (unit == "mi") return 1609.34;
+    if (unit == "ft") return 0.3048;
+    return std::nullopt;
+}
+
+bool RedisGeo::validCoordinates(double longitude, double latitude) {
+    return longitude >= kLonMin && longitude <= kLonMax &&
+           latitude >= kLatMin && latitude <= kLatMax;
+}
+
+// ========== CHUNKED INDEX ==========
+
+size_t RedisGeo::Chunk::find(uint64_t h, const std::string& m) const {
+    auto first = std::lower_bound(hash.begin(), hash.end(), h);
+    for (auto i = static_cast<size_t>(first - hash.begin()); i < size() && hash[i] == h; i++) {
+        if (member[i] == m) return i;
+    }
+    return size();
+}
+
+void RedisGeo::Chunk::insert(size_t pos, uint64_t h, const std::string& m, double lon, double lat) {
+    double lat_rad = lat * kDegToRad;
+    double lon_rad = lon * kDegToRad;
+    auto at = [pos](auto& v) { return v.begin() + static_cast<std::ptrdiff_t>(pos); };
+
+    hash.insert(at(hash), h);
+    member.insert(at(member), m);
+    longitude.insert(at(longitude), lon);
+    latitude.insert(at(latitude), lat);
+    sin_lat.insert(at(sin_lat), std::sin(lat_rad));
+    cos_lat.insert(at(cos_lat), std::cos(lat_rad));
+    sin_lon.insert(at(sin_lon), std::sin(lon_rad));
+    cos_lon.insert(at(cos_lon), std::cos(lon_rad));
+}
+
+void RedisGeo::Chunk::erase(size_t pos) {
+    auto at = [pos](auto& v) { return v.begin() + static_cast<std::ptrdiff_t>(pos); };
+
+    hash.erase(at(hash));
+    member.erase(at(member));
+    longitude.erase(at(longitude));
+    latitude.erase(at(latitude));
+    sin_lat.erase(at(sin_lat));
+    cos_lat.erase(at(cos_lat));
+    sin_lon.erase(at(sin_lon));
+    cos_lon.erase(at(cos_lon));
+}
+
+RedisGeo::Chunk RedisGeo::Chunk::splitHalf() {
+    size_t half = size() / 2;
+    Chunk upper;
+    auto move = [half](auto& from, auto& to) {
+        to.assign(std::make_move_iterator(from.begin() + static_cast<std::ptrdiff_t>(half)),
+                  std::make_move_iterator(from.end()));
+        from.resize(half);
+    };
+
+    move(hash, upper.hash);
+    move(member, upper.member);
+    move(longitude, upper.longitude);
+    move(latitude, upper.latitude);
+    move(sin_lat, upper.sin_lat);
+    move(cos_lat, upper.cos_lat);
+    move(sin_lon, upper.sin_lon);
+    move(cos_lon, upper.cos_lon);
+    return upper;
+}
+
+RedisGeo::ChunkMap::iterator RedisGeo::chunkFor(const IndexKey& key) {
+    // Last chunk whose first key <= key (or the first chunk)
+    auto it = chunks_.upper_bound(key);
+    if (it != chunks_.begin()) --it;
+    return it;
+}
+
+RedisGeo::ChunkMap::const_iterator RedisGeo::chunkFor(const IndexKey& key) const {
+    auto it = chunks_.upper_bound(key);
+    if (it != chunks_.begin()) --it;
+    return it;
+}
+
+void RedisGeo::insertPoint(uint64_t h, const std::string& member, double lon, double lat) {
+    IndexKey key{h, member};
+
+    if (chunks_.empty()) {
+        Chunk chunk;
+        chunk.insert(0, h, member, lon, lat);
+        chunks_.emplace(std::move(key), std::move(chunk));
+        return;
+    }
+
+    auto it = chunkFor(key);
+    Chunk& chunk = it->second;
+
+    // Position inside the chunk, ordered by (hash, member)
+    auto pos = static_cast<size_t>(
+        std::lower_bound(chunk.hash.begin(), chunk.hash.end(), h) - chunk.hash.begin());
+    while (pos < chunk.size() && chunk.hash[pos] == h && chunk.member[pos] < member) pos++;
+    chunk.insert(pos, h, member, lon, lat);
+
+    if (pos == 0) {
+        // New smallest key of the first chunk: re-key the map node
+        auto node = chunks_.extract(it);
+        node.key() = key;
+        it = chunks_.insert(std::move(node)).position;
+    }
+
+    if (it->second.size() > kChunkPoints) {
+        Chunk upper = it->second.splitHalf();
+        IndexKey upper_key = upper.key(0);
+        chunks_.emplace(std::move(upper_key), std::move(upper));
+    }
+}
+
+void RedisGeo::erasePoint(uint64_t h, const std::string& member) {
+    if (chunks_.empty()) return;
+
+    auto it = chunkFor(IndexKey{h, member});
+    Chunk& chunk = it->second;
+    size_t pos = chunk.find(h, member);
+    if (pos == chunk.size()) return;
+
+    chunk.erase(pos);
+    if (chunk.size() == 0) {
+        chunks_.erase(it);
+    } else if (pos == 0) {
+        auto node = chunks_.extract(it);
+        node.key() = node.mapped().key(0);
+        chunks_.insert(std::move(node));
+    }
+}
+
+bool RedisGeo::add(double longitude, double latitude, const std::string& member) {
+    uint64_t h = interleave(quantize(longitude, kLonMin, kLonMax),
+                            quantize(latitude, kLatMin, kLatMax));
+
+    auto it = members_.find(member);
+    bool is_new = it == members_.end();
+    if (is_new) {
+        members_.emplace(member, h);
+    } else {
+        erasePoint(it->second, member);
+        it->second = h;
+    }
+
+    insertPoint(h, member, longitude, latitude);
+    return is_new;
+}
+
+bool RedisGeo::remove(const std::string& member) {
+    auto it = members_.find(member);
+    if (it == members_.end()) return false;
+    erasePoint(it->second, member);
+    members_.erase(it);
+    return true;
+}
+
+std::optional<std::pair<double, double>> RedisGeo::position(const std::string& member) const {
+    auto it = members_.find(member);
+    if (it == members_.end()) return std::nullopt;
+
+    const Chunk& chunk = chunkFor(IndexKey{it->second, member})->second;
+    size_t pos = chunk.find(it->second, member);
+    if (pos == chunk.size()) return std::nullopt;
+    return std::make_pair(chunk.longitude[pos], chunk.latitude[pos]);
+}
+
+std::optional<double> RedisGeo::distance(const std::string& a, const std::string& b) const {
+    auto pa = position(a);
+    auto pb = position(b);
+    if (!pa || !pb) return std::nullopt;
+    return haversine(pa->first, pa->second, pb->first, pb->second);
+}
+
+std::optional<uint64_t> RedisGeo::hash(const std::string& member) const {
+    auto it = members_.find(member);
+    if (it == members_.end()) return std::nullopt;
+    return it->second;
+}
+
+std::optional<std::vector<GeoResult>> RedisGeo::search(const GeoSearchQuery& query) const {
+    auto unit = unitToMeters(query.unit);
+    if (!unit) return std::nullopt;
+
+    double lon = query.longitude;
+    double lat = query.latitude;
+    if (query.from_member) {
+        auto pos = position(*query.from_member);
+        if (!pos) return std::nullopt;
+        lon = pos->first;
+        lat = pos->second;
+    }
+    if (!validCoordinates(lon, lat)) return std::nullopt;
+
+    bool by_box = query.width > 0 && query.height > 0;
+    if (!by_box && query.radius <= 0) return std::nullopt;
+
+    double half_ew = (by_box ? query.width / 2 : query.radius) * *unit;   // Meters
+    double half_ns = (by_box ? query.height / 2 : query.radius) * *unit;
+
+    // 1. Grid step: finest whose cells are >= the search extent
+    //    (east-west cells shrink with cos(latitude) - use the worst latitude)
+    double worst_lat = std::min(std::abs(lat) + half_ns / kEarthRadius / kDegToRad, kLatMax);
+    double lat_span_m = (kLatMax - kLatMin) * kDegToRad * kEarthRadius;
+    double lon_span_m = 2 * kPi * kEarthRadius * std::cos(worst_lat * kDegToRad);
+
+    int step = kStepBits;
+    while (step > 1 && (lat_span_m / (1ULL << step) < half_ns ||
+                        lon_span_m / (1ULL << step) < half_ew)) {
+        step--;
+    }
+
+    // 2. Range-scan the 3x3 cells around the center
+    int shift = kStepBits - step;
+    int64_t cells = 1LL << step;
+    auto cx = static_cast<int64_t>(quantize(lon, kLonMin, kLonMax) >> shift);
+    auto cy = static_cast<int64_t>(quantize(lat, kLatMin, kLatMax) >> shift);
+
+    std::vector<uint64_t> prefixes;
+    for (int dy = -1; dy <= 1; dy++) {
+        int64_t y = cy + dy;
+        if (y < 0 || y >= cells) continue;              // No wrap across the poles
+        for (int dx = -1; dx <= 1; dx++) {
+            int64_t x = ((cx + dx) % cells + cells) % cells;  // Longitude wraps
+            prefixes.push_back(interleave(static_cast<uint64_t>(x), static_cast<uint64_t>(y)));
+        }
+    }
+    std::sort(prefixes.begin(), prefixes.end());
+    prefixes.erase(std::unique(prefixes.begin(), prefixes.end()), prefixes.end());
+
+    // Scan each cell's key range chunk by chunk; filter in place on the
+    // chunk arrays, remember survivors as (a, chunk, index)
+    struct Hit {
+        double a;
+        const Chunk* chunk;
+        size_t index;
+    };
+    std::vector<Hit> hits;
+    std::vector<double> a(kChunkPoints);
+    std::vector<uint8_t> keep(kChunkPoints);
+
+    double lat_rad = lat * kDegToRad;
+    double lon_rad = lon * kDegToRad;
+    Center center{std::sin(lat_rad), std::cos(lat_rad), std::sin(lon_rad), std::cos(lon_rad)};
+    double radius_bound = haversineBound(half_ew);
+    double ns_bound = haversineBound(half_ns);
+    double ew_bound = haversineBound(half_ew);
+
+    int range_shift = 2 * shift;
+    for (uint64_t prefix : prefixes) {
+        uint64_t lo = prefix << range_shift;
+        uint64_t hi = (prefix + 1) << range_shift;
+
+        for (auto it = chunkFor(IndexKey{lo, std::string()});
+             it != chunks_.end() && it->first.first < hi; ++it) {
+            const Chunk& chunk = it->second;
+            auto begin = static_cast<size_t>(
+                std::lower_bound(chunk.hash.begin(), chunk.hash.end(), lo) - chunk.hash.begin());
+            auto end = static_cast<size_t>(
+                std::lower_bound(chunk.hash.begin() + begin, chunk.hash.end(), hi) - chunk.hash.begin());
+            if (begin >= end) continue;
+
+            size_t n = end - begin;
+            if (by_box) {
+                filterBox(&chunk.sin_lat[begin], &chunk.cos_lat[begin], &chunk.sin_lon[begin],
+                          &chunk.cos_lon[begin], n, center, ns_bound, ew_bound, a.data(), keep.data());
+            } else {
+                filterRadius(&chunk.sin_lat[begin], &chunk.cos_lat[begin], &chunk.sin_lon[begin],
+                             &chunk.cos_lon[begin], n, center, radius_bound, a.data(), keep.data());
+            }
+
+            for (size_t i = 0; i < n; i++) {
+                if (keep[i]) hits.push_back(Hit{a[i], &chunk, begin + i});
+            }
+        }
+    }
+
+    // Rank by the haversine term; only the returned hits get exact
+    // distances and member copies
+    auto by_a = [asc = query.ascending](const Hit& x, const Hit& y) {
+        return asc ? x.a < y.a : x.a > y.a;
+    };
+    if (query.count > 0 && query.count < hits.size()) {
+        std::partial_sort(hits.begin(), hits.begin() + static_cast<std::ptrdiff_t>(query.count),
+                          hits.end(), by_a);
+        hits.resize(query.count);
+    } else {
+        std::sort(hits.begin(), hits.end(), by_a);
+    }
+
+    std::vector<GeoResult> results;
+    results.reserve(hits.size());
+    for (const auto& hit : hits) {
+        double plon = hit.chunk->longitude[hit.index];
+        double plat = hit.chunk->latitude[hit.index];
+        double meters = haversine(lon, lat, plon, plat);
+        results.push_back(GeoResult{hit.chunk->member[hit.index], meters / *unit, plon, plat});
+    }
+    return results;
+}
@@ -0,0 +1,137 @@
+#include "../include/HashIndex.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
+// ========== HASH INDEX ==========
+
+std::optional<double> HashIndex::parseNumber(const std::string& value) {
+    const char* first = value.data();
+    const char* last = first + value.size();
+    if (first != last && *first == '+') first++;  // from_chars rejects a leading '+'
+
+    double number;
+    auto [ptr, ec] = std::from_chars(first, last, number);
+    if (ec != std::errc() || ptr != last || first == last || std::isnan(number)) return std::nullopt;
+    return number;
+}
+
+void HashIndex::insert(const std::string& key, const std::string& value) {
+    if (kind_ == HashIndexKind::EXACT) {
+        if (exact_[value].insert(key).second) entries_++;
+        return;
+    }
+
+    auto number = parseNumber(value);
+    if (number && numeric_.emplace(*number, key).second) entries_++;
+}
+
+void HashIndex::erase(const std::string& key, const std::string& value) {
+    if (kind_ == HashIndexKind::EXACT) {
+        auto it = exact_.find(value);
+        if (it == exact_.end()) return;
+
+        entries_ -= it->second.erase(key);
+        if (it->second.empty()) exact_.erase(it);
+        return;
+    }
+
+    auto number = parseNumber(value);
+    if (number) entries_ -= numeric_.erase({*number, key});
+}
+
+void HashIndex::clear() {
+    exact_.clear();
+    numeric_.clear();
+    entries_ = 0;
+}
+
+const std::unordered_set<std::string>* HashIndex::lookup(const std::string& value) const {
+    auto it = exact_.find(value);
+    return it == exact_.end() ? nullptr : &it->second;
+}
+
+void HashIndex::forEachInRange(double min, double max,
+                               const std::function<bool(const std::string& key)>& visit) const {
+    // (min, "") sorts before every key with that value
+    for (auto it = numeric_.lower_bound({min, std::string()}); it != numeric_.end() && it->first <= max; ++it) {
+        if (!visit(it->second)) return;
+    }
+}
+
+// ========== CATALOG ==========
+
+bool HashIndexCatalog::create(const std::string& name, HashIndex index) {
+    if (indexes_.count(name)) return false;
+
+    auto owned = std::make_unique<HashIndex>(std::move(index));
+    by_field_[owned->field()].push_back(owned.get());
+    indexes_.emplace(name, std::move(owned));
+    return true;
+}
+
+bool HashIndexCatalog::drop(const std::string& name) {
+    auto it = indexes_.find(name);
+    if (it == indexes_.end()) return false;
+
+    auto route = by_field_.find(it->second->field());
+    auto& routed = route->second;
+    routed.erase(std::find(routed.begin(), routed.end(), it->second.get()));
+    if (routed.empty()) by_field_.erase(route);
+
+    indexes_.erase(it);
+    return true;
+}
+
+const HashIndex* HashIndexCatalog::find(const std::string& name) const {
+    auto it = indexes_.find(name);
+    return it == indexes_.end() ? nullptr : it->second.get();
+}
+
+std::vector<HashIndexInfo> HashIndexCatalog::list() const {
+    std::vector<HashIndexInfo> result;
+    result.reserve(indexes_.size());
+    for (const auto& [name, index] : indexes_) {
+        result.push_back(HashIndexInfo{name, index->prefix(), index->field(), index->kind(), index->entries()});
+    }
+    return result;
+}
+
+void HashIndexCatalog::fieldChanged(const std::string& key, const std::string& field,
+                                    const std::string* old_value, const std::string* new_value) {
+    if (old_value && new_value && *old_value == *new_value) return;
+
+    auto route = by_field_.find(field);
+    if (route == by_field_.end()) return;
+
+    for (HashIndex* index : route->second) {
+        if (!index->covers(key)) continue;
+        if (old_value) index->erase(key, *old_value);
+        if (new_value) index->insert(key, *new_value);
+    }
+}
+
+void HashIndexCatalog::hashAdded(const std::string& key, const Hash& hash) {
+    // Few indexed fields: probe the hash per field, not per hash entry
+    for (const auto& [field, indexes] : by_field_) {
+        auto it = hash.find(field);
+        if (it == hash.end()) continue;
+        for (HashIndex* index : indexes) {
+            if (index->covers(key)) index->insert(key, it->second);
+        }
+    }
+}
+
+void HashIndexCatalog::hashRemoved(const std::string& key, const Hash& hash) {
+    for (const auto& [field, indexes] : by_field_) {
+        auto it = hash.find(field);
+        if (it == hash.end()) continue;
+        for (HashIndex* index : indexes) {
+            if (index->covers(key)) index->erase(key, it->second);
+        }
+    }
+}
+
+void HashIndexCatalog::clearEntries() {
+    for (auto& [name, index] : indexes_) index->clear();
+}
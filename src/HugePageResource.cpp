@@ -0,0 +1,229 @@
+#include "../include/HugePageResource.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <new>
+#include <string>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr size_t kLargeThreshold = HugePageResource::kHugePageSize / 4;
+
+size_t roundUp(size_t n, size_t multiple) {
+    return (n + multiple - 1) / multiple * multiple;
+}
+
+// Power-of-two class of a small request: 0 = 16 bytes, 1 = 32, ...
+size_t sizeClass(size_t bytes) {
+    size_t cls = 0;
+    while ((size_t{16} << cls) < bytes) cls++;
+    return cls;
+}
+
+// Prefer `node` for a fresh (untouched) mapping. MPOL_PREFERRED is spelled
+// out to avoid a libnuma dependency (as in NumaTopology); a full node
+// falls back to others instead of failing the allocation
+void bindToNode(void* base, size_t size, int node) {
+#if defined(__linux__) && defined(SYS_mbind)
+    constexpr int kMpolPreferred = 1;
+    constexpr unsigned long kBitsPerWord = sizeof(unsigned long) * 8;
+
+    std::vector<unsigned long> mask(static_cast<size_t>(node) / kBitsPerWord + 1, 0);
+    mask[static_cast<size_t>(node) / kBitsPerWord] |= 1UL << (static_cast<size_t>(node) % kBitsPerWord);
+    syscall(SYS_mbind, base, size, kMpolPreferred, mask.data(),
+            mask.size() * kBitsPerWord + 1, 0);
+#else
+    (void)base;
+    (void)size;
+    (void)node;
+#endif
+}
+
+}  // namespace
+
+HugePageResource::HugePageResource(HugePageMode mode, int numa_node)
+    : mode_(mode), numa_node_(numa_node) {
+#ifdef __linux__
+    if (mode_ == HugePageMode::EXPLICIT) {
+        // Probe the hugetlbfs pool once; degrade if it is empty
+        void* probe = mmap(nullptr, kHugePageSize, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (probe == MAP_FAILED) {
+            mode_ = HugePageMode::TRANSPARENT;
+        } else {
+            munmap(probe, kHugePageSize);
+        }
+    }
+#else
+    mode_ = HugePageMode::OFF;
+    numa_node_ = -1;
+#endif
+}
+
+HugePageResource::~HugePageResource() {
+    for (const auto& region : regions_) {
+        unmapRegion(region.base, region.size);
+    }
+}
+
+char* HugePageResource::mapRegion(size_t size) {
+#ifdef __linux__
+    if (mode_ == HugePageMode::EXPLICIT) {
+        void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED) {
+            // hugetlb pages are only reserved here; placement happens on
+            // fault, so binding now still applies
+            if (numa_node_ >= 0) bindToNode(p, size, numa_node_);
+            return static_cast<char*>(p);
+        }
+        // Pool exhausted - fall through to a THP mapping
+    }
+
+    if (mmapped()) {
+        // Over-map by one huge page, then trim so the region is 2 MB aligned
+        // (THP can only use huge pages for aligned 2 MB ranges)
+        size_t span = size + kHugePageSize;
+        void* raw = mmap(nullptr, span, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) throw std::bad_alloc();
+
+        auto addr = reinterpret_cast<uintptr_t>(raw);
+        uintptr_t aligned = roundUp(addr, kHugePageSize);
+        if (aligned > addr) munmap(raw, aligned - addr);
+        size_t tail = (addr + span) - (aligned + size);
+        if (tail > 0) munmap(reinterpret_cast<void*>(aligned + size), tail);
+
+        if (mode_ != HugePageMode::OFF) {
+            madvise(reinterpret_cast<void*>(aligned), size, MADV_HUGEPAGE);
+        }
+        if (numa_node_ >= 0) bindToNode(reinterpret_cast<void*>(aligned), size, numa_node_);
+        return reinterpret_cast<char*>(aligned);
+    }
+#endif
+    return static_cast<char*>(::operator new(size, std::align_val_t(kHugePageSize)));
+}
+
+void HugePageResource::unmapRegion(char* base, size_t size) {
+#ifdef __linux__
+    if (mmapped()) {
+        munmap(base, size);
+        return;
+    }
+#endif
+    ::operator delete(base, std::align_val_t(kHugePageSize));
+}
+
+void* HugePageResource::do_allocate(size_t bytes, size_t alignment) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (bytes >= kLargeThreshold) {
+        // Dedicated mapping, returned to the OS on deallocate
+        size_t size = roundUp(bytes, kHugePageSize);
+        char* base = mapRegion(size);
+        regions_.push_back(Region{base, size});
+        return base;
+    }
+
+    size_t cls = sizeClass(bytes);
+    bytes = kMinBlock << cls;
+    alignment = std::max(alignment, kMinBlock);
+    if (FreeBlock* block = free_[cls]) {
+        if (reinterpret_cast<uintptr_t>(block) % alignment == 0) {
+            free_[cls] = block->next;
+            return block;
+        }
+    }
+
+    auto aligned = reinterpret_cast<char*>(roundUp(reinterpret_cast<uintptr_t>(bump_), alignment));
+    if (bump_ == nullptr || aligned + bytes > bump_end_) {
+        char* base = mapRegion(kHugePageSize);
+        regions_.push_back(Region{base, kHugePageSize});
+        bump_ = base;
+        bump_end_ = base + kHugePageSize;
+        aligned = base;
+    }
+
+    bump_ = aligned + bytes;
+    return aligned;
+}
+
+void HugePageResource::do_deallocate(void* p, size_t bytes, size_t) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (bytes < kLargeThreshold) {
+        // Bump memory stays mapped; the block is reused by its class
+        auto* block = static_cast<FreeBlock*>(p);
+        size_t cls = sizeClass(bytes);
+        block->next = free_[cls];
+        free_[cls] = block;
+        return;
+    }
+
+    auto it = std::find_if(regions_.begin(), regions_.end(),
+                           [p](const Region& r) { return r.base == p; });
+    if (it != regions_.end()) {
+        unmapRegion(it->base, it->size);
+        regions_.erase(it);
+    }
+}
+
+bool HugePageResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+HugePageStats HugePageResource::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    HugePageStats stats;
+    for (const auto& region : regions_) stats.mapped_bytes += region.size;
+
+#ifdef __linux__
+    // Walk smaps; sum AnonHugePages (THP) or the full size (hugetlb, which
+    // reports KernelPageSize 2048 kB) for mappings inside our regions
+    std::ifstream smaps("/proc/self/smaps");
+    std::string line;
+    bool ours = false;
+    size_t mapping_size = 0;
+
+    // Adjacent regions may be merged into one VMA by the kernel; they all
+    // carry MADV_HUGEPAGE/MAP_HUGETLB, so they never merge with foreign
+    // mappings and an overlap test is enough
+    auto overlapsRegions = [this](uintptr_t lo, uintptr_t hi) {
+        for (const auto& r : regions_) {
+            auto base = reinterpret_cast<uintptr_t>(r.base);
+            if (lo < base + r.size && hi > base) return true;
+        }
+        return false;
+    };
+
+    while (std::getline(smaps, line)) {
+        unsigned long lo = 0, hi = 0;
+        if (std::sscanf(line.c_str(), "%lx-%lx ", &lo, &hi) == 2) {
+            // Header: "7f12...-7f14... rw-p 00000000 00:00 0"
+            ours = overlapsRegions(lo, hi);
+            mapping_size = hi - lo;
+            continue;
+        }
+        if (!ours) continue;
+
+        size_t kb = 0;
+        if (line.rfind("AnonHugePages:", 0) == 0) {
+            std::sscanf(line.c_str(), "AnonHugePages: %zu kB", &kb);
+            stats.huge_bytes += kb * 1024;
+        } else if (line.rfind("KernelPageSize:", 0) == 0) {
+            std::sscanf(line.c_str(), "KernelPageSize: %zu kB", &kb);
+            if (kb * 1024 >= kHugePageSize) stats.huge_bytes += mapping_size;
+        }
+    }
+#endif
+
+    stats.huge_bytes = std::min(stats.huge_bytes, stats.mapped_bytes);
+    return stats;
+}
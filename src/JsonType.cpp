@@ -0,0 +1,598 @@
+#include "../include/JsonType.h"
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+namespace {
+
+// ========== PARSER ==========
+
+constexpr uint64_t kOnes = 0x0101010101010101ULL;
+constexpr uint64_t kHighs = 0x8080808080808080ULL;
+
+// Non-zero iff some byte of x is zero
+uint64_t zeroBytes(uint64_t x) {
+    return (x - kOnes) & ~x & kHighs;
+}
+
+// Non-zero iff some byte of x is '"', '\' or < 0x20
+uint64_t specialBytes(uint64_t x) {
+    uint64_t quote = zeroBytes(x ^ (kOnes * '"'));
+    uint64_t backslash = zeroBytes(x ^ (kOnes * '\\'));
+    uint64_t control = (x - kOnes * 0x20) & ~x & kHighs;
+    return quote | backslash | control;
+}
+
+void appendUtf8(std::string& out, uint32_t cp) {
+    if (cp < 0x80) {
+        out.push_back(static_cast<char>(cp));
+    } else if (cp < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else if (cp < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    }
+}
+
+class Parser {
+public:
+    explicit Parser(std::string_view text) : p_(text.data()), end_(text.data() + text.size()) {}
+
+    std::optional<JsonValue> document() {
+        JsonValue value;
+        if (!parseValue(value, 0)) return std::nullopt;
+        skipWhitespace();
+        if (p_ != end_) return std::nullopt;  // Trailing garbage
+        return value;
+    }
+
+private:
+    void skipWhitespace() {
+        while (p_ < end_ && (*p_ == ' ' || *p_ == '\n' || *p_ == '\r' || *p_ == '\t')) p_++;
+    }
+
+    bool literal(const char* word, size_t len) {
+        if (static_cast<size_t>(end_ - p_) < len || std::memcmp(p_, word, len) != 0) return false;
+        p_ += len;
+        return true;
+    }
+
+    bool parseValue(JsonValue& out, int depth) {
+        if (depth > JsonValue::kMaxDepth) return false;
+        skipWhitespace();
+        if (p_ == end_) return false;
+
+        switch (*p_) {
+            case '{': return parseObject(out, depth);
+            case '[': return parseArray(out, depth);
+            case '"': {
+                std::string s;
+                if (!parseString(s)) return false;
+                out.data = std::move(s);
+                return true;
+            }
+            case 't': out.data = true; return literal("true", 4);
+            case 'f': out.data = false; return literal("false", 5);
+            case 'n': out.data = nullptr; return literal("null", 4);
+            default: return parseNumber(out);
+        }
+    }
+
+    bool parseObject(JsonValue& out, int depth) {
+        p_++;  // '{'
+        JsonObject object;
+        skipWhitespace();
+        if (p_ < end_ && *p_ == '}') {
+            p_++;
+            out.data = std::move(object);
+            return true;
+        }
+
+        while (true) {
+            skipWhitespace();
+            std::string key;
+            if (p_ == end_ || *p_ != '"' || !parseString(key)) return false;
+
+            skipWhitespace();
+            if (p_ == end_ || *p_ != ':') return false;
+            p_++;
+
+            JsonValue value;
+            if (!parseValue(value, depth + 1)) return false;
+            object.emplace_back(std::move(key), std::move(value));
+
+            skipWhitespace();
+            if (p_ == end_) return false;
+            if (*p_ == ',') { p_++; continue; }
+            if (*p_ == '}') { p_++; break; }
+            return false;
+        }
+        out.data = std::move(object);
+        return true;
+    }
+
+    bool parseArray(JsonValue& out, int depth) {
+        p_++;  // '['
+        JsonArray array;
+        skipWhitespace();
+        if (p_ < end_ && *p_ == ']') {
+            p_++;
+            out.data = std::move(array);
+            return true;
+        }
+
+        while (true) {
+            JsonValue value;
+            if (!parseValue(value, depth + 1)) return false;
+            array.push_back(std::move(value));
+
+            skipWhitespace();
+            if (p_ == end_) return false;
+            if (*p_ == ',') { p_++; continue; }
+            if (*p_ == ']') { p_++; break; }
+            return false;
+        }
+        out.data = std::move(array);
+        return true;
+    }
+
+    bool parseHex4(uint32_t& out) {
+        if (end_ - p_ < 4) return false;
+        out = 0;
+        for (int i = 0; i < 4; i++) {
+            char c = *p_++;
+            out <<= 4;
+            if (c >= '0' && c <= '9') out |= c - '0';
+            else if (c >= 'a' && c <= 'f') out |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') out |= c - 'A' + 10;
+            else return false;
+        }
+        return true;
+    }
+
+    bool parseString(std::string& out) {
+        p_++;  // Opening quote
+
+        while (true) {
+            // Fast path: copy plain runs 8 bytes at a time
+            const char* run = p_;
+            while (end_ - p_ >= 8) {
+                uint64_t word;
+                std::memcpy(&word, p_, 8);
+                if (specialBytes(word)) break;
+                p_ += 8;
+            }
+            while (p_ < end_ && *p_ != '"' && *p_ != '\\' && static_cast<unsigned char>(*p_) >= 0x20) p_++;
+            out.append(run, p_ - run);
+
+            if (p_ == end_ || static_cast<unsigned char>(*p_) < 0x20) return false;
+            if (*p_ == '"') {
+                p_++;
+                return true;
+            }
+
+            // Escape sequence
+            p_++;
+            if (p_ == end_) return false;
+            char c = *p_++;
+            switch (c) {
+                case '"': out.push_back('"'); break;
+                case '\\': out.push_back('\\'); break;
+                case '/': out.push_back('/'); break;
+                case 'b': out.push_back('\b'); break;
+                case 'f': out.push_back('\f'); break;
+                case 'n': out.push_back('\n'); break;
+                case 'r': out.push_back('\r'); break;
+                case 't': out.push_back('\t'); break;
+                case 'u': {
+                    uint32_t cp;
+                    if (!parseHex4(cp)) return false;
+                    if (cp >= 0xD800 && cp <= 0xDBFF) {
+                        // Surrogate pair
+                        uint32_t low;
+                        if (end_ - p_ < 2 || p_[0] != '\\' || p_[1] != 'u') return false;
+                        p_ += 2;
+                        if (!parseHex4(low) || low < 0xDC00 || low > 0xDFFF) return false;
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+                        return false;
+                    }
+                    appendUtf8(out, cp);
+                    break;
+                }
+                default: return false;
+            }
+        }
+    }
+
+    bool parseNumber(JsonValue& out) {
+        // Validate the JSON grammar, then convert with from_chars
+        const char* start = p_;
+        bool integral = true;
+
+        if (p_ < end_ && *p_ == '-') p_++;
+        if (p_ == end_ || !(*p_ >= '0' && *p_ <= '9')) return false;
+        if (*p_ == '0') {
+            p_++;
+        } else {
+            while (p_ < end_ && *p_ >= '0' && *p_ <= '9') p_++;
+        }
+        if (p_ < end_ && *p_ == '.') {
+            integral = false;
+            p_++;
+            if (p_ == end_ || !(*p_ >= '0' && *p_ <= '9')) return false;
+            while (p_ < end_ && *p_ >= '0' && *p_ <= '9') p_++;
+        }
+        if (p_ < end_ && (*p_ == 'e' || *p_ == 'E')) {
+            integral = false;
+            p_++;
+            if (p_ < end_ && (*p_ == '+' || *p_ == '-')) p_++;
+            if (p_ == end_ || !(*p_ >= '0' && *p_ <= '9')) return false;
+            while (p_ < end_ && *p_ >= '0' && *p_ <= '9') p_++;
+        }
+
+        if (integral) {
+            int64_t i;
+            auto [ptr, ec] = std::from_chars(start, p_, i);
+            if (ec == std::errc() && ptr == p_) {
+                out.data = i;
+                return true;
+            }
+            // Out of int64 range: fall through to double
+        }
+
+        double d;
+        auto [ptr, ec] = std::from_chars(start, p_, d);
+        if (ec != std::errc() || ptr != p_ || !std::isfinite(d)) return false;
+        out.data = d;
+        return true;
+    }
+
+    const char* p_;
+    const char* end_;
+};
+
+// ========== SERIALIZER ==========
+
+void dumpString(std::string& out, const std::string& s) {
+    static const char* hex = "0123456789abcdef";
+    out.push_back('"');
+    for (char ch : s) {
+        auto c = static_cast<unsigned char>(ch);
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            default:
+                if (c < 0x20) {
+                    out += "\\u00";
+                    out.push_back(hex[c >> 4]);
+                    out.push_back(hex[c & 0xF]);
+                } else {
+                    out.push_back(ch);
+                }
+        }
+    }
+    out.push_back('"');
+}
+
+template <typename T>
+void dumpNumber(std::string& out, T value) {
+    char buf[32];
+    auto [ptr, ec] = std::to_chars(buf, buf + sizeof(buf), value);
+    out.append(buf, ptr);
+}
+
+}  // namespace
+
+// ========== JSON VALUE ==========
+
+std::optional<JsonValue> JsonValue::parse(std::string_view text) {
+    return Parser(text).document();
+}
+
+void JsonValue::dump(std::string& out) const {
+    std::visit([&out](auto&& v) {
+        using T = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same_v<T, std::nullptr_t>) {
+            out += "null";
+        } else if constexpr (std::is_same_v<T, bool>) {
+            out += v ? "true" : "false";
+        } else if constexpr (std::is_same_v<T, int64_t> || std::is_same_v<T, double>) {
+            dumpNumber(out, v);
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            dumpString(out, v);
+        } else if constexpr (std::is_same_v<T, JsonArray>) {
+            out.push_back('[');
+            for (size_t i = 0; i < v.size(); i++) {
+                if (i > 0) out.push_back(',');
+                v[i].dump(out);
+            }
+            out.push_back(']');
+        } else {
+            out.push_back('{');
+            for (size_t i = 0; i < v.size(); i++) {
+                if (i > 0) out.push_back(',');
+                dumpString(out, v[i].first);
+                out.push_back(':');
+                v[i].second.dump(out);
+            }
+            out.push_back('}');
+        }
+    }, data);
+}
+
+std::string JsonValue::dump() const {
+    std::string out;
+    dump(out);
+    return out;
+}
+
+size_t JsonValue::footprint() const {
+    size_t bytes = sizeof(JsonValue);
+    if (auto* s = std::get_if<std::string>(&data)) {
+        bytes += s->size();
+    } else if (auto* array = std::get_if<JsonArray>(&data)) {
+        for (const auto& value : *array) bytes += value.footprint();
+    } else if (auto* object = std::get_if<JsonObject>(&data)) {
+        for (const auto& [name, value] : *object) bytes += sizeof(std::string) + name.size() + value.footprint();
+    }
+    return bytes;
+}
+
+size_t JsonValue::nodeCount() const {
+    size_t nodes = 1;
+    if (auto* array = std::get_if<JsonArray>(&data)) {
+        for (const auto& value : *array) nodes += value.nodeCount();
+    } else if (auto* object = std::get_if<JsonObject>(&data)) {
+        for (const auto& [name, value] : *object) nodes += value.nodeCount();
+    }
+    return nodes;
+}
+
+std::string JsonValue::typeName() const {
+    static const char* names[] = {"null", "boolean", "integer", "number", "string", "array", "object"};
+    return names[data.index()];
+}
+
+// ========== PATHS ==========
+
+bool RedisJson::isRootPath(const std::string& path) {
+    return path == "$" || path == ".";
+}
+
+std::optional<std::vector<RedisJson::PathStep>> RedisJson::parsePath(const std::string& path) {
+    std::vector<PathStep> steps;
+    size_t i = 0;
+    if (path.empty()) return std::nullopt;
+    if (path[0] == '$') i = 1;
+    if (path == ".") return steps;
+
+    while (i < path.size()) {
+        if (path[i] == '.') {
+            // .key - up to the next '.' or '['
+            size_t start = ++i;
+            while (i < path.size() && path[i] != '.' && path[i] != '[') i++;
+            if (i == start) return std::nullopt;
+            steps.emplace_back(path.substr(start, i - start));
+        } else if (path[i] == '[') {
+            i++;
+            if (i < path.size() && (path[i] == '\'' || path[i] == '"')) {
+                // ['key']
+                char quote = path[i++];
+                size_t close = path.find(quote, i);
+                if (close == std::string::npos || close + 1 >= path.size() || path[close + 1] != ']') {
+                    return std::nullopt;
+                }
+                steps.emplace_back(path.substr(i, close - i));
+                i = close + 2;
+            } else {
+                // [index]
+                size_t close = path.find(']', i);
+                if (close == std::string::npos) return std::nullopt;
+                int64_t index;
+                auto [ptr, ec] = std::from_chars(path.data() + i, path.data() + close, index);
+                if (ec != std::errc() || ptr != path.data() + close) return std::nullopt;
+                steps.emplace_back(index);
+                i = close + 1;
+            }
+        } else if (steps.empty() && path[0] != '$') {
+            // Legacy "a.b" without a leading dot
+            size_t start = i;
+            while (i < path.size() && path[i] != '.' && path[i] != '[') i++;
+            steps.emplace_back(path.substr(start, i - start));
+        } else {
+            return std::nullopt;
+        }
+    }
+    return steps;
+}
+
+namespace {
+
+// Child of `node` for one step, nullptr if missing
+template <typename Node>
+Node* child(Node* node, const std::variant<std::string, int64_t>& step) {
+    if (auto* key = std::get_if<std::string>(&step)) {
+        auto* object = std::get_if<JsonObject>(&node->data);
+        if (!object) return nullptr;
+        for (auto& [name, value] : *object) {
+            if (name == *key) return &value;
+        }
+        return nullptr;
+    }
+
+    auto* array = std::get_if<JsonArray>(&node->data);
+    if (!array) return nullptr;
+    int64_t index = std::get<int64_t>(step);
+    auto size = static_cast<int64_t>(array->size());
+    if (index < 0) index += size;
+    if (index < 0 || index >= size) return nullptr;
+    return &(*array)[static_cast<size_t>(index)];
+}
+
+}  // namespace
+
+JsonValue* RedisJson::resolve(const std::vector<PathStep>& steps) {
+    JsonValue* node = &root_;
+    for (const auto& step : steps) {
+        node = child(node, step);
+        if (!node) return nullptr;
+    }
+    return node;
+}
+
+const JsonValue* RedisJson::resolve(const std::vector<PathStep>& steps) const {
+    const JsonValue* node = &root_;
+    for (const auto& step : steps) {
+        node = child(node, step);
+        if (!node) return nullptr;
+    }
+    return node;
+}
+
+// ========== COMMANDS ==========
+
+std::optional<std::string> RedisJson::get(const std::string& path) const {
+    auto steps = parsePath(path);
+    if (!steps) return std::nullopt;
+
+    const JsonValue* node = resolve(*steps);
+    if (!node) return std::nullopt;
+    return node->dump();
+}
+
+bool RedisJson::set(const std::string& path, JsonValue value) {
+    auto steps = parsePath(path);
+    if (!steps) return false;
+
+    size_t added = value.footprint();
+    size_t added_nodes = value.nodeCount();
+    if (steps->empty()) {
+        root_ = std::move(value);
+        bytes_ = added;
+        nodes_ = added_nodes;
+        return true;
+    }
+
+    if (JsonValue* node = resolve(*steps)) {
+        bytes_ = bytes_ - node->footprint() + added;
+        nodes_ = nodes_ - node->nodeCount() + added_nodes;
+        *node = std::move(value);
+        return true;
+    }
+
+    // Missing last step: add it as a new member of an object parent
+    PathStep last = steps->back();
+    steps->pop_back();
+    JsonValue* parent = resolve(*steps);
+    auto* key = std::get_if<std::string>(&last);
+    if (!parent || !key) return false;
+
+    auto* object = std::get_if<JsonObject>(&parent->data);
+    if (!object) return false;
+    bytes_ += sizeof(std::string) + key->size() + added;
+    nodes_ += added_nodes;
+    object->emplace_back(std::move(*key), std::move(value));
+    return true;
+}
+
+size_t RedisJson::del(const std::string& path) {
+    auto steps = parsePath(path);
+    if (!steps || steps->empty()) return 0;
+
+    PathStep last = steps->back();
+    steps->pop_back();
+    JsonValue* parent = resolve(*steps);
+    if (!parent) return 0;
+
+    if (auto* key = std::get_if<std::string>(&last)) {
+        auto* object = std::get_if<JsonObject>(&parent->data);
+        if (!object) return 0;
+        for (auto it = object->begin(); it != object->end(); ++it) {
+            if (it->first == *key) {
+                bytes_ -= sizeof(std::string) + it->first.size() + it->second.footprint();
+                nodes_ -= it->second.nodeCount();
+                object->erase(it);
+                return 1;
+            }
+        }
+        return 0;
+    }
+
+    auto* array = std::get_if<JsonArray>(&parent->data);
+    if (!array) return 0;
+    int64_t index = std::get<int64_t>(last);
+    auto size = static_cast<int64_t>(array->size());
+    if (index < 0) index += size;
+    if (index < 0 || index >= size) return 0;
+    bytes_ -= (*array)[static_cast<size_t>(index)].footprint();
+    nodes_ -= (*array)[static_cast<size_t>(index)].nodeCount();
+    array->erase(array->begin() + index);
+    return 1;
+}
+
+std::optional<std::string> RedisJson::numIncrBy(const std::string& path, double increment) {
+    auto steps = parsePath(path);
+    if (!steps) return std::nullopt;
+    JsonValue* node = resolve(*steps);
+    if (!node) return std::nullopt;
+
+    if (auto* i = std::get_if<int64_t>(&node->data)) {
+        // Integer stays integer when the increment is integral and nothing overflows
+        int64_t result;
+        if (std::trunc(increment) == increment && std::fabs(increment) < 9007199254740992.0 &&
+            !__builtin_add_overflow(*i, static_cast<int64_t>(increment), &result)) {
+            *i = result;
+            return node->dump();
+        }
+        double d = static_cast<double>(*i) + increment;
+        if (!std::isfinite(d)) return std::nullopt;
+        node->data = d;
+        return node->dump();
+    }
+
+    if (auto* d = std::get_if<double>(&node->data)) {
+        double result = *d + increment;
+        if (!std::isfinite(result)) return std::nullopt;
+        *d = result;
+        return node->dump();
+    }
+    return std::nullopt;
+}
+
+std::optional<size_t> RedisJson::arrAppend(const std::string& path, std::vector<JsonValue> values) {
+    auto steps = parsePath(path);
+    if (!steps) return std::nullopt;
+    JsonValue* node = resolve(*steps);
+    if (!node) return std::nullopt;
+
+    auto* array = std::get_if<JsonArray>(&node->data);
+    if (!array) return std::nullopt;
+    for (auto& value : values) {
+        bytes_ += value.footprint();
+        nodes_ += value.nodeCount();
+        array->push_back(std::move(value));
+    }
+    return array->size();
+}
+
+std::optional<std::string> RedisJson::type(const std::string& path) const {
+    auto steps = parsePath(path);
+    if (!steps) return std::nullopt;
+    const JsonValue* node = resolve(*steps);
+    if (!node) return std::nullopt;
+    return node->typeName();
+}
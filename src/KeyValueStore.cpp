@@ -6,12 +6,40 @@ bool KeyValueStore::set(const std::string& key, const std::string& value, int tt
     return storage_.set(key, value, ttl);
 }
 
+SetResult KeyValueStore::set(const std::string& key, const std::string& value, const SetOptions& options) {
+    return storage_.set(key, value, options);
+}
+
 std::optional<std::string> KeyValueStore::get(const std::string& key) const {
     // const_cast needed because storage methods check expiration (modify state)
     // Alternative: make storage_ mutable (cleaner)
     return const_cast<StorageEngine&>(storage_).get(key);
 }
 
+size_t KeyValueStore::append(const std::string& key, const std::string& value) {
+    return storage_.append(key, value);
+}
+
+size_t KeyValueStore::setrange(const std::string& key, size_t offset, const std::string& value) {
+    return storage_.setrange(key, offset, value);
+}
+
+std::string KeyValueStore::getrange(const std::string& key, long start, long end) const {
+    return std::string(const_cast<StorageEngine&>(storage_).getrange(key, start, end));
+}
+
+size_t KeyValueStore::strlen(const std::string& key) const {
+    return const_cast<StorageEngine&>(storage_).strlen(key);
+}
+
+std::optional<std::string> KeyValueStore::getex(const std::string& key, int ttl, bool persist) {
+    return storage_.getex(key, ttl, persist);
+}
+
+std::optional<std::string> KeyValueStore::getdel(const std::string& key) {
+    return storage_.getdel(key);
+}
+
 // ========== LIST COMMANDS ==========
 
 size_t KeyValueStore::lpush(const std::string& key, const std::vector<std::string>& values) {
@@ -38,6 +66,34 @@ size_t KeyValueStore::llen(const std::string& key) const {
     return const_cast<StorageEngine&>(storage_).llen(key);
 }
 
+std::optional<std::string> KeyValueStore::lindex(const std::string& key, int index) const {
+    return const_cast<StorageEngine&>(storage_).lindex(key, index);
+}
+
+bool KeyValueStore::lset(const std::string& key, int index, const std::string& value) {
+    return storage_.lset(key, index, value);
+}
+
+long KeyValueStore::linsert(const std::string& key, ListInsert where, const std::string& pivot, const std::string& value) {
+    return storage_.linsert(key, where, pivot, value);
+}
+
+bool KeyValueStore::ltrim(const std::string& key, int start, int stop) {
+    return storage_.ltrim(key, start, stop);
+}
+
+size_t KeyValueStore::lrem(const std::string& key, int count, const std::string& value) {
+    return storage_.lrem(key, count, value);
+}
+
+std::vector<size_t> KeyValueStore::lpos(const std::string& key, const std::string& value, int rank, size_t count, size_t maxlen) const {
+    return const_cast<StorageEngine&>(storage_).lpos(key, value, rank, count, maxlen);
+}
+
+std::optional<std::string> KeyValueStore::lmove(const std::string& source, const std::string& destination, ListEnd from, ListEnd to) {
+    return storage_.lmove(source, destination, from, to);
+}
+
 // ========== SET COMMANDS ==========
 
 size_t KeyValueStore::sadd(const std::string& key, const std::vector<std::string>& members) {
@@ -60,6 +116,18 @@ size_t KeyValueStore::scard(const std::string& key) const {
     return const_cast<StorageEngine&>(storage_).scard(key);
 }
 
+std::vector<bool> KeyValueStore::smismember(const std::string& key, const std::vector<std::string>& members) const {
+    return const_cast<StorageEngine&>(storage_).smismember(key, members);
+}
+
+std::vector<std::string> KeyValueStore::srandmember(const std::string& key, long count) const {
+    return const_cast<StorageEngine&>(storage_).srandmember(key, count);
+}
+
+std::vector<std::string> KeyValueStore::spop(const std::string& key, size_t count) {
+    return storage_.spop(key, count);
+}
+
 // ========== HASH COMMANDS ==========
 
 bool KeyValueStore::hset(const std::string& key, const std::string& field, const std::string& value) {
@@ -86,12 +154,344 @@ size_t KeyValueStore::hlen(const std::string& key) const {
     return const_cast<StorageEngine&>(storage_).hlen(key);
 }
 
+std::vector<int> KeyValueStore::hexpire(const std::string& key, int seconds, const std::vector<std::string>& fields) {
+    return storage_.hexpire(key, seconds, fields);
+}
+
+std::vector<int> KeyValueStore::httl(const std::string& key, const std::vector<std::string>& fields) const {
+    return const_cast<StorageEngine&>(storage_).httl(key, fields);
+}
+
+std::vector<int> KeyValueStore::hpersist(const std::string& key, const std::vector<std::string>& fields) {
+    return storage_.hpersist(key, fields);
+}
+
+size_t KeyValueStore::hset(const std::string& key, const std::vector<std::pair<std::string, std::string>>& fields) {
+    return storage_.hset(key, fields);
+}
+
+std::vector<std::optional<std::string>> KeyValueStore::hmget(const std::string& key, const std::vector<std::string>& fields) const {
+    return const_cast<StorageEngine&>(storage_).hmget(key, fields);
+}
+
+std::vector<std::pair<std::string, std::string>> KeyValueStore::hrandfield(const std::string& key, long count) const {
+    return const_cast<StorageEngine&>(storage_).hrandfield(key, count);
+}
+
+// ========== STREAM COMMANDS ==========
+
+std::optional<std::string> KeyValueStore::xadd(const std::string& key, const std::string& id,
+                                               const StreamFields& fields, size_t maxlen) {
+    return storage_.xadd(key, id, fields, maxlen);
+}
+
+std::vector<StreamEntry> KeyValueStore::xrange(const std::string& key, const std::string& start,
+                                               const std::string& end, size_t count) const {
+    return const_cast<StorageEngine&>(storage_).xrange(key, start, end, count);
+}
+
+std::vector<std::pair<std::string, std::vector<StreamEntry>>> KeyValueStore::xread(
+    const std::vector<std::pair<std::string, std::string>>& streams, size_t count) const {
+    return const_cast<StorageEngine&>(storage_).xread(streams, count);
+}
+
+std::string KeyValueStore::streamLastId(const std::string& key) const {
+    return const_cast<StorageEngine&>(storage_).streamLastId(key);
+}
+
+size_t KeyValueStore::xlen(const std::string& key) const {
+    return const_cast<StorageEngine&>(storage_).xlen(key);
+}
+
+size_t KeyValueStore::xtrim(const std::string& key, size_t maxlen) {
+    return storage_.xtrim(key, maxlen);
+}
+
+bool KeyValueStore::xgroupCreate(const std::string& key, const std::string& group,
+                                 const std::string& id, bool mkstream) {
+    return storage_.xgroupCreate(key, group, id, mkstream);
+}
+
+std::optional<std::vector<StreamEntry>> KeyValueStore::xreadgroup(const std::string& key, const std::string& group,
+                                                                  const std::string& consumer,
+                                                                  const std::string& id, size_t count) {
+    return storage_.xreadgroup(key, group, consumer, id, count);
+}
+
+size_t KeyValueStore::xack(const std::string& key, const std::string& group, const std::vector<std::string>& ids) {
+    return storage_.xack(key, group, ids);
+}
+
+std::vector<StreamPendingInfo> KeyValueStore::xpending(const std::string& key, const std::string& group, size_t count) const {
+    return const_cast<StorageEngine&>(storage_).xpending(key, group, count);
+}
+
+// ========== GEO COMMANDS ==========
+
+size_t KeyValueStore::geoadd(const std::string& key, const std::vector<GeoMember>& members) {
+    return storage_.geoadd(key, members);
+}
+
+std::vector<std::optional<std::pair<double, double>>> KeyValueStore::geopos(const std::string& key,
+                                                                            const std::vector<std::string>& members) const {
+    return const_cast<StorageEngine&>(storage_).geopos(key, members);
+}
+
+std::optional<double> KeyValueStore::geodist(const std::string& key, const std::string& member1,
+                                             const std::string& member2, const std::string& unit) const {
+    return const_cast<StorageEngine&>(storage_).geodist(key, member1, member2, unit);
+}
+
+std::vector<GeoResult> KeyValueStore::geosearch(const std::string& key, const GeoSearchQuery& query) const {
+    return const_cast<StorageEngine&>(storage_).geosearch(key, query);
+}
+
+// ========== BLOOM / CUCKOO FILTER COMMANDS ==========
+
+bool KeyValueStore::bfreserve(const std::string& key, double error_rate, size_t capacity, unsigned expansion) {
+    return storage_.bfreserve(key, error_rate, capacity, expansion);
+}
+
+bool KeyValueStore::bfadd(const std::string& key, const std::string& item) {
+    return storage_.bfadd(key, item);
+}
+
+std::vector<bool> KeyValueStore::bfmadd(const std::string& key, const std::vector<std::string>& items) {
+    return storage_.bfmadd(key, items);
+}
+
+bool KeyValueStore::bfexists(const std::string& key, const std::string& item) const {
+    return const_cast<StorageEngine&>(storage_).bfexists(key, item);
+}
+
+std::vector<bool> KeyValueStore::bfmexists(const std::string& key, const std::vector<std::string>& items) const {
+    return const_cast<StorageEngine&>(storage_).bfmexists(key, items);
+}
+
+bool KeyValueStore::cfreserve(const std::string& key, size_t capacity, unsigned expansion) {
+    return storage_.cfreserve(key, capacity, expansion);
+}
+
+bool KeyValueStore::cfadd(const std::string& key, const std::string& item) {
+    return storage_.cfadd(key, item);
+}
+
+bool KeyValueStore::cfexists(const std::string& key, const std::string& item) const {
+    return const_cast<StorageEngine&>(storage_).cfexists(key, item);
+}
+
+std::vector<bool> KeyValueStore::cfmexists(const std::string& key, const std::vector<std::string>& items) const {
+    return const_cast<StorageEngine&>(storage_).cfmexists(key, items);
+}
+
+bool KeyValueStore::cfdel(const std::string& key, const std::string& item) {
+    return storage_.cfdel(key, item);
+}
+
+// ========== COUNT-MIN / TOP-K SKETCH COMMANDS ==========
+
+bool KeyValueStore::cmsInitByDim(const std::string& key, size_t width, size_t depth) {
+    return storage_.cmsInitByDim(key, width, depth);
+}
+
+bool KeyValueStore::cmsInitByProb(const std::string& key, double error, double probability) {
+    return storage_.cmsInitByProb(key, error, probability);
+}
+
+std::vector<uint64_t> KeyValueStore::cmsIncrBy(const std::string& key, const std::vector<std::pair<std::string, uint64_t>>& increments) {
+    return storage_.cmsIncrBy(key, increments);
+}
+
+std::vector<uint64_t> KeyValueStore::cmsQuery(const std::string& key, const std::vector<std::string>& items) const {
+    return const_cast<StorageEngine&>(storage_).cmsQuery(key, items);
+}
+
+bool KeyValueStore::cmsMerge(const std::string& dest, const std::vector<std::string>& sources, const std::vector<uint64_t>& weights) {
+    return storage_.cmsMerge(dest, sources, weights);
+}
+
+bool KeyValueStore::topkReserve(const std::string& key, size_t k, size_t width, size_t depth, double decay) {
+    return storage_.topkReserve(key, k, width, depth, decay);
+}
+
+std::vector<std::optional<std::string>> KeyValueStore::topkAdd(const std::string& key, const std::vector<std::string>& items) {
+    return storage_.topkAdd(key, items);
+}
+
+std::vector<std::optional<std::string>> KeyValueStore::topkIncrBy(const std::string& key, const std::vector<std::pair<std::string, uint64_t>>& increments) {
+    return storage_.topkIncrBy(key, increments);
+}
+
+std::vector<bool> KeyValueStore::topkQuery(const std::string& key, const std::vector<std::string>& items) const {
+    return const_cast<StorageEngine&>(storage_).topkQuery(key, items);
+}
+
+std::vector<std::pair<std::string, uint32_t>> KeyValueStore::topkList(const std::string& key) const {
+    return const_cast<StorageEngine&>(storage_).topkList(key);
+}
+
+bool KeyValueStore::topkMerge(const std::string& dest, const std::vector<std::string>& sources) {
+    return storage_.topkMerge(dest, sources);
+}
+
+// ========== T-DIGEST COMMANDS ==========
+
+bool KeyValueStore::tdigestCreate(const std::string& key, double compression) {
+    return storage_.tdigestCreate(key, compression);
+}
+
+bool KeyValueStore::tdigestAdd(const std::string& key, const std::vector<double>& values) {
+    return storage_.tdigestAdd(key, values);
+}
+
+std::vector<double> KeyValueStore::tdigestQuantile(const std::string& key, const std::vector<double>& quantiles) const {
+    return const_cast<StorageEngine&>(storage_).tdigestQuantile(key, quantiles);
+}
+
+std::vector<double> KeyValueStore::tdigestCdf(const std::string& key, const std::vector<double>& values) const {
+    return const_cast<StorageEngine&>(storage_).tdigestCdf(key, values);
+}
+
+bool KeyValueStore::tdigestMerge(const std::string& dest, const std::vector<std::string>& sources, double compression) {
+    return storage_.tdigestMerge(dest, sources, compression);
+}
+
+// ========== TIME SERIES COMMANDS ==========
+
+bool KeyValueStore::tsCreate(const std::string& key, int64_t retention_ms) {
+    return storage_.tsCreate(key, retention_ms);
+}
+
+bool KeyValueStore::tsAdd(const std::string& key, int64_t timestamp, double value) {
+    return storage_.tsAdd(key, timestamp, value);
+}
+
+size_t KeyValueStore::tsMadd(const std::string& key, const std::vector<TimeSeriesSample>& samples) {
+    return storage_.tsMadd(key, samples);
+}
+
+std::optional<TimeSeriesSample> KeyValueStore::tsGet(const std::string& key) const {
+    return const_cast<StorageEngine&>(storage_).tsGet(key);
+}
+
+std::vector<TimeSeriesSample> KeyValueStore::tsRange(const std::string& key, int64_t from, int64_t to, TimeSeriesAggregation aggregation, int64_t bucket_ms) const {
+    return const_cast<StorageEngine&>(storage_).tsRange(key, from, to, aggregation, bucket_ms);
+}
+
+std::optional<TimeSeriesInfo> KeyValueStore::tsInfo(const std::string& key) const {
+    return const_cast<StorageEngine&>(storage_).tsInfo(key);
+}
+
+// ========== JSON COMMANDS ==========
+
+bool KeyValueStore::jsonSet(const std::string& key, const std::string& path, const std::string& json) {
+    return storage_.jsonSet(key, path, json);
+}
+
+std::optional<std::string> KeyValueStore::jsonGet(const std::string& key, const std::string& path) const {
+    return const_cast<StorageEngine&>(storage_).jsonGet(key, path);
+}
+
+size_t KeyValueStore::jsonDel(const std::string& key, const std::string& path) {
+    return storage_.jsonDel(key, path);
+}
+
+std::optional<std::string> KeyValueStore::jsonNumIncrBy(const std::string& key, const std::string& path, double increment) {
+    return storage_.jsonNumIncrBy(key, path, increment);
+}
+
+std::optional<size_t> KeyValueStore::jsonArrAppend(const std::string& key, const std::string& path, const std::vector<std::string>& values) {
+    return storage_.jsonArrAppend(key, path, values);
+}
+
+std::optional<std::string> KeyValueStore::jsonType(const std::string& key, const std::string& path) const {
+    return const_cast<StorageEngine&>(storage_).jsonType(key, path);
+}
+
+// ========== VECTOR SET COMMANDS ==========
+
+bool KeyValueStore::vadd(const std::string& key, const std::string& element, const std::vector<float>& vector, VectorQuant quant, size_t m, size_t ef_construction) {
+    return storage_.vadd(key, element, vector, quant, m, ef_construction);
+}
+
+std::vector<VectorMatch> KeyValueStore::vsim(const std::string& key, const std::vector<float>& query, size_t k, size_t ef) const {
+    return const_cast<StorageEngine&>(storage_).vsim(key, query, k, ef);
+}
+
+std::vector<VectorMatch> KeyValueStore::vsimElement(const std::string& key, const std::string& element, size_t k, size_t ef) const {
+    return const_cast<StorageEngine&>(storage_).vsimElement(key, element, k, ef);
+}
+
+size_t KeyValueStore::vcard(const std::string& key) const {
+    return const_cast<StorageEngine&>(storage_).vcard(key);
+}
+
+size_t KeyValueStore::vdim(const std::string& key) const {
+    return const_cast<StorageEngine&>(storage_).vdim(key);
+}
+
+std::optional<std::vector<float>> KeyValueStore::vemb(const std::string& key, const std::string& element) const {
+    return const_cast<StorageEngine&>(storage_).vemb(key, element);
+}
+
+// ========== HASH INDEX COMMANDS ==========
+
+bool KeyValueStore::hindexCreate(const std::string& name, const std::string& prefix, const std::string& field, HashIndexKind kind) {
+    return storage_.hindexCreate(name, prefix, field, kind);
+}
+
+bool KeyValueStore::hindexDrop(const std::string& name) {
+    return storage_.hindexDrop(name);
+}
+
+std::vector<std::string> KeyValueStore::hindexLookup(const std::string& name, const std::string& value) const {
+    return storage_.hindexLookup(name, value);
+}
+
+std::vector<std::string> KeyValueStore::hindexRange(const std::string& name, double min, double max, size_t limit) const {
+    return storage_.hindexRange(name, min, max, limit);
+}
+
+std::vector<HashIndexInfo> KeyValueStore::hindexList() const {
+    return storage_.hindexList();
+}
+
+// ========== QUOTA COMMANDS ==========
+
+bool KeyValueStore::setQuota(const std::string& name, const std::string& prefix, size_t budget) {
+    return storage_.setQuota(name, prefix, budget);
+}
+
+bool KeyValueStore::dropQuota(const std::string& name) {
+    return storage_.dropQuota(name);
+}
+
+std::vector<NamespaceStats> KeyValueStore::quotaStats() const {
+    return storage_.quotaStats();
+}
+
 // ========== GENERAL COMMANDS ==========
 
 bool KeyValueStore::del(const std::string& key) {
     return storage_.remove(key);
 }
 
+bool KeyValueStore::unlink(const std::string& key) {
+    return storage_.unlink(key);
+}
+
+bool KeyValueStore::rename(const std::string& key, const std::string& newkey) {
+    return storage_.rename(key, newkey);
+}
+
+bool KeyValueStore::copy(const std::string& source, const std::string& destination, bool replace) {
+    return storage_.copy(source, destination, replace);
+}
+
+bool KeyValueStore::move(const std::string& key, KeyValueStore& destination) {
+    return storage_.move(key, destination.storage_);
+}
+
 bool KeyValueStore::exists(const std::string& key) const {
     return const_cast<StorageEngine&>(storage_).exists(key);
 }
@@ -108,6 +508,10 @@ int KeyValueStore::ttl(const std::string& key) const {
     return const_cast<StorageEngine&>(storage_).ttl(key);
 }
 
+long long KeyValueStore::pttl(const std::string& key) const {
+    return const_cast<StorageEngine&>(storage_).pttl(key);
+}
+
 std::vector<std::string> KeyValueStore::keys() const {
     return storage_.keys();
 }
@@ -116,8 +520,28 @@ size_t KeyValueStore::size() const {
     return storage_.size();
 }
 
-void KeyValueStore::clear() {
-    storage_.clear();
+void KeyValueStore::clear(bool async) {
+    storage_.clear(async);
+}
+
+size_t KeyValueStore::cleanupExpired() {
+    return storage_.cleanupExpired();
+}
+
+ExpireSlice KeyValueStore::activeExpireSlice(size_t samples) {
+    return storage_.activeExpireSlice(samples);
+}
+
+HugePageStats KeyValueStore::hugePageStats() const {
+    return storage_.hugePageStats();
+}
+
+LazyFreeStats KeyValueStore::lazyFreeStats() const {
+    return storage_.lazyFreeStats();
+}
+
+KeyspaceStats KeyValueStore::keyspaceStats() const {
+    return storage_.keyspaceStats();
 }
 
 // ============================================================================
@@ -0,0 +1,57 @@
+#include "../include/LazyFree.h"
+
+LazyFree::~LazyFree() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_one();
+    if (worker_.joinable()) worker_.join();  // Worker drains the queue before exiting
+}
+
+void LazyFree::push(std::unique_ptr<Garbage> garbage) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(std::move(garbage));
+        if (!worker_.joinable()) worker_ = std::thread(&LazyFree::run, this);
+    }
+    cv_.notify_one();
+}
+
+void LazyFree::drain() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return queue_.empty() && in_flight_ == 0; });
+}
+
+LazyFreeStats LazyFree::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    LazyFreeStats stats;
+    stats.pending = queue_.size() + in_flight_;
+    stats.freed = freed_;
+    return stats;
+}
+
+void LazyFree::run() {
+    std::vector<std::unique_ptr<Garbage>> batch;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) return;  // stopping_ and fully drained
+
+            batch.swap(queue_);
+            in_flight_ = batch.size();
+        }
+
+        // The expensive part, outside every lock
+        batch.clear();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            freed_ += in_flight_;
+            in_flight_ = 0;
+        }
+        idle_.notify_all();
+    }
+}
@@ -0,0 +1,367 @@
+#include "../include/ListType.h"
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// ========== CHUNK ==========
+
+std::string_view QuickList::Chunk::at(size_t i) const {
+    size_t j = i + first;
+    return std::string_view(bytes.data() + offsets[j], offsets[j + 1] - offsets[j]);
+}
+
+void QuickList::Chunk::compact() {
+    if (first == 0) return;
+
+    uint32_t base = offsets[first];
+    bytes.erase(0, base);
+    offsets.erase(offsets.begin(), offsets.begin() + first);
+    for (auto& offset : offsets) offset -= base;
+    first = 0;
+}
+
+void QuickList::Chunk::clear() {
+    bytes.clear();
+    offsets.assign(1, 0);
+    first = 0;
+}
+
+void QuickList::Chunk::append(std::string_view value) {
+    bytes.append(value);
+    offsets.push_back(static_cast<uint32_t>(bytes.size()));
+}
+
+void QuickList::Chunk::insert(size_t i, std::string_view value) {
+    compact();
+    if (i == size()) {
+        append(value);
+        return;
+    }
+
+    auto len = static_cast<uint32_t>(value.size());
+    uint32_t pos = offsets[i];
+    bytes.insert(pos, value);
+    for (size_t j = i + 1; j < offsets.size(); j++) offsets[j] += len;
+    offsets.insert(offsets.begin() + i + 1, pos + len);
+}
+
+void QuickList::Chunk::replace(size_t i, std::string_view value) {
+    size_t j = i + first;
+    uint32_t start = offsets[j];
+    uint32_t old_len = offsets[j + 1] - start;
+    bytes.replace(start, old_len, value);
+
+    auto delta = static_cast<int64_t>(value.size()) - old_len;
+    for (size_t k = j + 1; k < offsets.size(); k++) {
+        offsets[k] = static_cast<uint32_t>(offsets[k] + delta);
+    }
+}
+
+void QuickList::Chunk::erase(size_t from, size_t to) {
+    if (from >= to) return;
+
+    // Front: just advance the dead prefix (LPOP, LTRIM head). fits()
+    // only sees live elements, so the prefix is dropped once it holds
+    // half the entries or bytes - else RPUSH + LPOP grows one chunk forever
+    if (from == 0) {
+        first += static_cast<uint32_t>(to);
+        if (size() == 0) {
+            clear();
+        } else if (first >= size() || offsets[first] >= payload()) {
+            compact();
+        }
+        return;
+    }
+
+    // Back: truncate (RPOP, LTRIM tail)
+    if (to == size()) {
+        size_t f = from + first;
+        bytes.resize(offsets[f]);
+        offsets.resize(f + 1);
+        return;
+    }
+
+    compact();
+    uint32_t start = offsets[from];
+    uint32_t gap = offsets[to] - start;
+    bytes.erase(start, gap);
+    for (size_t k = to + 1; k < offsets.size(); k++) offsets[k] -= gap;
+    offsets.erase(offsets.begin() + from + 1, offsets.begin() + to + 1);
+}
+
+void QuickList::Chunk::eraseAt(const std::vector<uint32_t>& sorted) {
+    if (sorted.empty()) return;
+
+    Chunk rebuilt;
+    rebuilt.bytes.reserve(payload());
+    size_t next = 0;
+    for (size_t i = 0; i < size(); i++) {
+        if (next < sorted.size() && sorted[next] == i) {
+            next++;
+            continue;
+        }
+        rebuilt.append(at(i));
+    }
+    *this = std::move(rebuilt);
+}
+
+void QuickList::Chunk::matches(std::string_view value, std::vector<uint32_t>& out) const {
+    if (value.size() > std::numeric_limits<uint32_t>::max()) return;
+
+    auto len = static_cast<uint32_t>(value.size());
+    const uint32_t* o = offsets.data();
+    size_t n = offsets.size() - 1;
+    size_t j = first;
+
+    auto check = [&](size_t k) {
+        if (std::memcmp(bytes.data() + o[k], value.data(), len) == 0) {
+            out.push_back(static_cast<uint32_t>(k - first));
+        }
+    };
+
+#ifdef __SSE2__
+    // Lengths of 4 elements at once: offsets[k + 1] - offsets[k]
+    const __m128i want = _mm_set1_epi32(static_cast<int>(len));
+    for (; j + 4 <= n; j += 4) {
+        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(o + j));
+        __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(o + j + 1));
+        __m128i eq = _mm_cmpeq_epi32(_mm_sub_epi32(hi, lo), want);
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+        while (mask) {
+            check(j + __builtin_ctz(mask));
+            mask &= mask - 1;
+        }
+    }
+#endif
+    for (; j < n; j++) {
+        if (o[j + 1] - o[j] == len) check(j);
+    }
+}
+
+// ========== QUICKLIST ==========
+
+std::pair<size_t, size_t> QuickList::locate(size_t index) const {
+    if (index < size_ / 2) {
+        size_t c = 0;
+        while (index >= chunks_[c].size()) index -= chunks_[c++].size();
+        return {c, index};
+    }
+
+    size_t from_back = size_ - 1 - index;
+    size_t c = chunks_.size() - 1;
+    while (from_back >= chunks_[c].size()) from_back -= chunks_[c--].size();
+    return {c, chunks_[c].size() - 1 - from_back};
+}
+
+void QuickList::pushFront(std::string_view value) {
+    if (chunks_.empty() || !fits(chunks_.front(), value)) chunks_.emplace_front();
+    chunks_.front().insert(0, value);
+    size_++;
+}
+
+void QuickList::pushBack(std::string_view value) {
+    if (chunks_.empty() || !fits(chunks_.back(), value)) chunks_.emplace_back();
+    chunks_.back().append(value);
+    size_++;
+}
+
+std::optional<std::string> QuickList::popFront() {
+    if (size_ == 0) return std::nullopt;
+
+    auto& chunk = chunks_.front();
+    std::string value(chunk.at(0));
+    chunk.erase(0, 1);
+    if (chunk.size() == 0) chunks_.pop_front();
+    size_--;
+    return value;
+}
+
+std::optional<std::string> QuickList::popBack() {
+    if (size_ == 0) return std::nullopt;
+
+    auto& chunk = chunks_.back();
+    size_t last = chunk.size() - 1;
+    std::string value(chunk.at(last));
+    chunk.erase(last, last + 1);
+    if (chunk.size() == 0) chunks_.pop_back();
+    size_--;
+    return value;
+}
+
+std::string QuickList::at(size_t index) const {
+    auto [c, i] = locate(index);
+    return std::string(chunks_[c].at(i));
+}
+
+void QuickList::set(size_t index, std::string_view value) {
+    auto [c, i] = locate(index);
+    chunks_[c].replace(i, value);
+}
+
+void QuickList::insert(size_t index, std::string_view value) {
+    if (index == 0) return pushFront(value);
+    if (index >= size_) return pushBack(value);
+
+    auto [c, i] = locate(index);
+    if (fits(chunks_[c], value)) {
+        chunks_[c].insert(i, value);
+        size_++;
+        return;
+    }
+
+    // Full chunk: split at i, then the value goes at the end of the head part
+    Chunk tail;
+    for (size_t k = i; k < chunks_[c].size(); k++) tail.append(chunks_[c].at(k));
+    chunks_[c].erase(i, chunks_[c].size());
+    chunks_.insert(chunks_.begin() + c + 1, std::move(tail));
+
+    if (fits(chunks_[c], value)) {
+        chunks_[c].append(value);
+    } else {
+        Chunk single;
+        single.append(value);
+        chunks_.insert(chunks_.begin() + c + 1, std::move(single));
+    }
+    size_++;
+}
+
+std::vector<std::string> QuickList::range(size_t start, size_t stop) const {
+    std::vector<std::string> result;
+    if (start > stop || stop >= size_) return result;
+
+    size_t n = stop - start + 1;
+    result.reserve(n);
+    auto [c, i] = locate(start);
+    while (result.size() < n) {
+        result.emplace_back(chunks_[c].at(i));
+        if (++i == chunks_[c].size()) {
+            c++;
+            i = 0;
+        }
+    }
+    return result;
+}
+
+void QuickList::trim(size_t start, size_t stop) {
+    if (start > stop || start >= size_) {
+        chunks_.clear();
+        size_ = 0;
+        return;
+    }
+    if (stop >= size_) stop = size_ - 1;
+
+    // Whole chunks go first; only the boundary chunks are cut
+    size_t drop_front = start;
+    while (drop_front > 0 && chunks_.front().size() <= drop_front) {
+        drop_front -= chunks_.front().size();
+        chunks_.pop_front();
+    }
+    if (drop_front > 0) chunks_.front().erase(0, drop_front);
+
+    size_t drop_back = size_ - 1 - stop;
+    while (drop_back > 0 && chunks_.back().size() <= drop_back) {
+        drop_back -= chunks_.back().size();
+        chunks_.pop_back();
+    }
+    if (drop_back > 0) {
+        auto& chunk = chunks_.back();
+        chunk.erase(chunk.size() - drop_back, chunk.size());
+    }
+
+    size_ = stop - start + 1;
+}
+
+size_t QuickList::remove(std::string_view value, long count) {
+    size_t limit = count == 0 ? std::numeric_limits<size_t>::max() : static_cast<size_t>(std::labs(count));
+    size_t removed = 0;
+    std::vector<uint32_t> hits;
+
+    if (count >= 0) {
+        for (size_t c = 0; c < chunks_.size() && removed < limit;) {
+            hits.clear();
+            chunks_[c].matches(value, hits);
+            if (hits.size() > limit - removed) hits.resize(limit - removed);
+
+            chunks_[c].eraseAt(hits);
+            removed += hits.size();
+            if (chunks_[c].size() == 0) {
+                chunks_.erase(chunks_.begin() + c);
+            } else {
+                c++;
+            }
+        }
+    } else {
+        for (size_t c = chunks_.size(); c-- > 0 && removed < limit;) {
+            hits.clear();
+            chunks_[c].matches(value, hits);
+            if (hits.size() > limit - removed) hits.erase(hits.begin(), hits.end() - (limit - removed));
+
+            chunks_[c].eraseAt(hits);
+            removed += hits.size();
+            if (chunks_[c].size() == 0) chunks_.erase(chunks_.begin() + c);
+        }
+    }
+
+    size_ -= removed;
+    return removed;
+}
+
+std::vector<size_t> QuickList::positions(std::string_view value, long rank, size_t count, size_t maxlen) const {
+    std::vector<size_t> result;
+    if (rank == 0) return result;
+
+    size_t skip = static_cast<size_t>(std::labs(rank)) - 1;
+    std::vector<uint32_t> hits;
+
+    if (rank > 0) {
+        size_t base = 0;
+        for (const auto& chunk : chunks_) {
+            if (maxlen && base >= maxlen) break;
+
+            hits.clear();
+            chunk.matches(value, hits);
+            for (uint32_t h : hits) {
+                if (maxlen && base + h >= maxlen) return result;
+                if (skip > 0) {
+                    skip--;
+                    continue;
+                }
+                result.push_back(base + h);
+                if (count && result.size() == count) return result;
+            }
+            base += chunk.size();
+        }
+        return result;
+    }
+
+    size_t end = size_;
+    for (auto it = chunks_.rbegin(); it != chunks_.rend(); ++it) {
+        size_t base = end - it->size();
+        if (maxlen && size_ - end >= maxlen) break;
+
+        hits.clear();
+        it->matches(value, hits);
+        for (auto h = hits.rbegin(); h != hits.rend(); ++h) {
+            size_t index = base + *h;
+            if (maxlen && size_ - 1 - index >= maxlen) return result;
+            if (skip > 0) {
+                skip--;
+                continue;
+            }
+            result.push_back(index);
+            if (count && result.size() == count) return result;
+        }
+        end = base;
+    }
+    return result;
+}
+
+std::optional<size_t> QuickList::find(std::string_view value) const {
+    auto found = positions(value, 1, 1, 0);
+    if (found.empty()) return std::nullopt;
+    return found.front();
+}
@@ -0,0 +1,214 @@
+#include "../include/NearCache.h"
+#include <algorithm>
+
+NearCache::TimeNs NearCache::coarseNow() {
+#ifdef CLOCK_MONOTONIC_COARSE
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+    return static_cast<TimeNs>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+NearCache::NearCache(ThreadSafeStore& store, NearCacheOptions options)
+    : store_(store), options_(options) {
+    // trackingOn() binds the calling thread; keep that thread's own binding
+    uint64_t previous = store_.trackingBind(0);
+    client_ = store_.trackingOn(TrackingOptions(), [this](const std::string* key) { invalidate(key); });
+    store_.trackingBind(previous);
+}
+
+NearCache::~NearCache() {
+    // Deliveries run under the store lock, so none is in flight after this
+    store_.trackingOff(client_);
+}
+
+// ========== READS ==========
+
+std::optional<std::string> NearCache::get(const std::string& key) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (const auto* cached = lookupLocked(key, nullptr)) return *cached;
+        stats_.misses++;
+    }
+
+    // Miss: a tracked read, so the store reports the key's next change
+    uint64_t epoch = epoch_.load(std::memory_order_acquire);
+    uint64_t previous = store_.trackingBind(client_);
+    auto value = store_.get(key);
+    long long pttl = value ? store_.pttl(key) : -2;
+    store_.trackingBind(previous);
+
+    fill(key, nullptr, value, expiryFor(pttl, -1), epoch);
+    return value;
+}
+
+std::optional<std::string> NearCache::hget(const std::string& key, const std::string& field) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (const auto* cached = lookupLocked(key, &field)) return *cached;
+        stats_.misses++;
+    }
+
+    uint64_t epoch = epoch_.load(std::memory_order_acquire);
+    uint64_t previous = store_.trackingBind(client_);
+    auto value = store_.hget(key, field);
+    long long pttl = value ? store_.pttl(key) : -2;
+    int field_ttl = value ? store_.httl(key, {field}).front() : -2;
+    store_.trackingBind(previous);
+
+    fill(key, &field, value, expiryFor(pttl, field_ttl), epoch);
+    return value;
+}
+
+// ========== WRITES ==========
+
+bool NearCache::set(const std::string& key, const std::string& value, int ttl) {
+    return store_.set(key, value, ttl);
+}
+
+bool NearCache::hset(const std::string& key, const std::string& field, const std::string& value) {
+    return store_.hset(key, field, value);
+}
+
+bool NearCache::del(const std::string& key) {
+    return store_.del(key);
+}
+
+void NearCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    ring_.clear();
+    bytes_ = 0;
+}
+
+NearCacheStats NearCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    NearCacheStats stats = stats_;
+    stats.entries = entries_.size();
+    stats.bytes = bytes_;
+    stats.mean_hit_age_ms = stats_.hits ? hit_age_ms_total_ / static_cast<double>(stats_.hits) : 0.0;
+    return stats;
+}
+
+// ========== INTERNALS ==========
+
+void NearCache::invalidate(const std::string* key) {
+    // Before taking mutex_: a fill that already read the old value sees
+    // the new epoch and is dropped (see header comment)
+    epoch_.fetch_add(1, std::memory_order_acq_rel);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!key) {
+        stats_.invalidations += entries_.size();
+        entries_.clear();
+        ring_.clear();
+        bytes_ = 0;
+        return;
+    }
+
+    auto it = entries_.find(*key);
+    if (it == entries_.end()) return;
+    eraseLocked(it);
+    stats_.invalidations++;
+}
+
+const std::optional<std::string>* NearCache::lookupLocked(const std::string& key, const std::string* field) {
+    auto it = entries_.find(key);
+    if (it == entries_.end()) return nullptr;
+
+    Entry& entry = it->second;
+    TimeNs now = coarseNow();
+    if (now >= entry.expires) {
+        eraseLocked(it);
+        stats_.expirations++;
+        return nullptr;
+    }
+
+    const std::optional<std::string>* answer = nullptr;
+    if (!field) {
+        if (entry.has_value) answer = &entry.value;
+    } else {
+        auto field_it = entry.fields.find(*field);
+        if (field_it != entry.fields.end()) answer = &field_it->second;
+    }
+    if (!answer) return nullptr;
+
+    entry.referenced = true;
+    stats_.hits++;
+    hit_age_ms_total_ += static_cast<double>(now - entry.filled) / 1e6;
+    return answer;
+}
+
+void NearCache::fill(const std::string& key, const std::string* field, const std::optional<std::string>& answer,
+                     TimeNs expires, uint64_t epoch) {
+    TimeNs now = coarseNow();
+    if (expires <= now) return;  // Already due (e.g. TTL under a second)
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (epoch_.load(std::memory_order_acquire) != epoch) {
+        stats_.raced_fills++;
+        return;
+    }
+
+    auto [it, inserted] = entries_.try_emplace(key);
+    Entry& entry = it->second;
+    if (inserted) {
+        entry.ring = ring_.insert(ring_.end(), key);
+        entry.expires = expires;
+        entry.bytes = key.size() + sizeof(Entry);
+    } else {
+        bytes_ -= entry.bytes;
+        entry.referenced = true;
+        entry.expires = std::min(entry.expires, expires);
+    }
+    entry.filled = now;
+
+    auto size = [](const std::optional<std::string>& v) { return v ? v->size() : 0; };
+    if (!field) {
+        if (entry.has_value) entry.bytes -= size(entry.value);
+        entry.has_value = true;
+        entry.value = answer;
+    } else {
+        auto [field_it, field_new] = entry.fields.try_emplace(*field);
+        if (field_new) {
+            entry.bytes += field->size() + sizeof(*field_it);
+        } else {
+            entry.bytes -= size(field_it->second);
+        }
+        field_it->second = answer;
+    }
+    entry.bytes += size(answer);
+    bytes_ += entry.bytes;
+
+    trimLocked();
+}
+
+NearCache::TimeNs NearCache::expiryFor(long long pttl_ms, int field_ttl_s) const {
+    std::chrono::milliseconds life = options_.ttl;
+    if (pttl_ms >= 0) life = std::min(life, std::chrono::milliseconds(pttl_ms));
+    if (field_ttl_s >= 0) life = std::min<std::chrono::milliseconds>(life, std::chrono::seconds(field_ttl_s));
+    return coarseNow() + std::chrono::duration_cast<std::chrono::nanoseconds>(life).count();
+}
+
+void NearCache::eraseLocked(std::unordered_map<std::string, Entry>::iterator it) {
+    bytes_ -= it->second.bytes;
+    ring_.erase(it->second.ring);
+    entries_.erase(it);
+}
+
+void NearCache::trimLocked() {
+    while (!ring_.empty() && (entries_.size() > options_.max_entries || bytes_ > options_.max_bytes)) {
+        // Second chance: referenced keys go round again with the bit cleared
+        auto it = entries_.find(ring_.front());
+        if (it->second.referenced) {
+            it->second.referenced = false;
+            ring_.splice(ring_.end(), ring_, it->second.ring);
+            continue;
+        }
+        eraseLocked(it);
+        stats_.evictions++;
+    }
+}
@@ -0,0 +1,710 @@
+#include "../include/NetServer.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <linux/io_uring.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/utsname.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+static constexpr size_t kMaxFrame = 64 * 1024 * 1024;  // Bigger is a protocol error: drop the client
+
+// ========== IO_URING RING ==========
+
+#ifdef __linux__
+
+namespace {
+
+constexpr uint16_t kBufferGroup = 0;
+
+// user_data = connection id << 3 | operation
+enum Operation : uint64_t { kAccept = 1, kRecv, kSend, kWake, kCancel };
+
+uint64_t tag(uint64_t id, Operation op) {
+    return id << 3 | op;
+}
+
+int setupRing(unsigned entries, io_uring_params& params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+}
+
+double threadCpuSeconds(clockid_t clock) {
+    timespec ts;
+    if (clock_gettime(clock, &ts) != 0) return 0;
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1e9;
+}
+
+void setNoDelay(int fd) {
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+}  // namespace
+
+// Raw io_uring (no liburing): SQ/CQ rings plus one provided-buffer ring.
+// Loop thread only.
+struct NetServer::Uring {
+    int fd = -1;
+
+    void* sq_ptr = nullptr;
+    size_t sq_size = 0;
+    unsigned* sq_head = nullptr;
+    unsigned* sq_tail = nullptr;
+    unsigned* sq_array = nullptr;
+    unsigned sq_mask = 0;
+    unsigned sq_entries = 0;
+    unsigned sq_local_tail = 0;  // Prepared, not yet published
+    io_uring_sqe* sqes = nullptr;
+    size_t sqes_size = 0;
+
+    void* cq_ptr = nullptr;
+    size_t cq_size = 0;
+    unsigned* cq_head = nullptr;
+    unsigned* cq_tail = nullptr;
+    unsigned cq_mask = 0;
+    io_uring_cqe* cqes = nullptr;
+
+    io_uring_buf* bufs = nullptr;  // Provided-buffer ring shared with the kernel
+    size_t bufs_size = 0;
+    unsigned buf_count = 0;
+    uint16_t buf_tail = 0;
+    bool bufs_registered = false;
+    std::vector<char> memory;      // buf_count buffers of buffer_size
+    size_t buffer_size = 0;
+
+    uint64_t wake_value = 0;       // Target of the eventfd READ
+    bool disabled = false;         // Created with R_DISABLED; enable() from the loop thread
+
+    ~Uring() {
+        if (bufs_registered) {
+            io_uring_buf_reg reg{};
+            reg.bgid = kBufferGroup;
+            syscall(__NR_io_uring_register, fd, IORING_UNREGISTER_PBUF_RING, &reg, 1);
+        }
+        if (fd >= 0) close(fd);
+        if (bufs) munmap(bufs, bufs_size);
+        if (sqes) munmap(sqes, sqes_size);
+        if (cq_ptr && cq_ptr != sq_ptr) munmap(cq_ptr, cq_size);
+        if (sq_ptr) munmap(sq_ptr, sq_size);
+    }
+
+    bool init(unsigned entries, size_t count, size_t size) {
+        // Completions are only ever reaped by the loop thread: let the kernel
+        // defer their task work to its io_uring_enter (6.1+). The ring
+        // starts disabled so that thread, not this one, becomes its issuer.
+        io_uring_params params{};
+        params.flags = IORING_SETUP_SUBMIT_ALL | IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN |
+                       IORING_SETUP_R_DISABLED;
+        fd = setupRing(entries, params);
+        disabled = fd >= 0;
+        if (fd < 0) {
+            params = io_uring_params{};
+            fd = setupRing(entries, params);
+        }
+        if (fd < 0) return false;
+
+        sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single) sq_size = cq_size = std::max(sq_size, cq_size);
+
+        sq_ptr = mmap(nullptr, sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        if (sq_ptr == MAP_FAILED) {
+            sq_ptr = nullptr;
+            return false;
+        }
+        cq_ptr = single ? sq_ptr
+                        : mmap(nullptr, cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                               IORING_OFF_CQ_RING);
+        if (cq_ptr == MAP_FAILED) {
+            cq_ptr = nullptr;
+            return false;
+        }
+        sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqe_ptr = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                             IORING_OFF_SQES);
+        if (sqe_ptr == MAP_FAILED) return false;
+        sqes = static_cast<io_uring_sqe*>(sqe_ptr);
+
+        auto* sq = static_cast<char*>(sq_ptr);
+        sq_head = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        sq_mask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sq_entries = params.sq_entries;
+        sq_local_tail = *sq_tail;
+
+        auto* cq = static_cast<char*>(cq_ptr);
+        cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cq_mask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        // Provided buffers: the ring must be page aligned, entries a power of two
+        buf_count = 1;
+        while (buf_count < count && buf_count < 32768) buf_count <<= 1;
+        buffer_size = size;
+        bufs_size = buf_count * sizeof(io_uring_buf);
+        void* ring = mmap(nullptr, bufs_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ring == MAP_FAILED) return false;
+        bufs = static_cast<io_uring_buf*>(ring);
+
+        io_uring_buf_reg reg{};
+        reg.ring_addr = reinterpret_cast<uint64_t>(bufs);
+        reg.ring_entries = buf_count;
+        reg.bgid = kBufferGroup;
+        if (syscall(__NR_io_uring_register, fd, IORING_REGISTER_PBUF_RING, &reg, 1) != 0) return false;
+        bufs_registered = true;
+
+        memory.resize(buf_count * buffer_size);
+        for (unsigned bid = 0; bid < buf_count; bid++) recycle(static_cast<uint16_t>(bid));
+        publishBuffers();
+        return true;
+    }
+
+    bool enable() {
+        if (!disabled) return true;
+        disabled = false;
+        return syscall(__NR_io_uring_register, fd, IORING_REGISTER_ENABLE_RINGS, nullptr, 0) == 0;
+    }
+
+    char* buffer(uint16_t bid) { return memory.data() + bid * buffer_size; }
+
+    // Hand a buffer back; visible to the kernel after publishBuffers()
+    void recycle(uint16_t bid) {
+        // Field by field: bufs[0].resv doubles as the ring tail
+        io_uring_buf& buf = bufs[buf_tail & (buf_count - 1)];
+        buf.addr = reinterpret_cast<uint64_t>(buffer(bid));
+        buf.len = static_cast<uint32_t>(buffer_size);
+        buf.bid = bid;
+        buf_tail++;
+    }
+
+    void publishBuffers() {
+        auto* tail = reinterpret_cast<uint16_t*>(reinterpret_cast<char*>(bufs) + offsetof(io_uring_buf, resv));
+        __atomic_store_n(tail, buf_tail, __ATOMIC_RELEASE);
+    }
+
+    // Next free SQE, zeroed; submits early if the SQ is full
+    io_uring_sqe* sqe(std::atomic<uint64_t>& syscalls) {
+        if (sq_local_tail - __atomic_load_n(sq_head, __ATOMIC_ACQUIRE) == sq_entries) {
+            enter(0);
+            syscalls.fetch_add(1, std::memory_order_relaxed);
+        }
+        unsigned index = sq_local_tail & sq_mask;
+        sq_array[index] = index;
+        sq_local_tail++;
+        io_uring_sqe* entry = &sqes[index];
+        std::memset(entry, 0, sizeof(*entry));
+        return entry;
+    }
+
+    // Submit everything prepared and wait for `wait_for` completions
+    int enter(unsigned wait_for) {
+        __atomic_store_n(sq_tail, sq_local_tail, __ATOMIC_RELEASE);
+        unsigned to_submit = sq_local_tail - __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+        while (true) {
+            long ret = syscall(__NR_io_uring_enter, fd, to_submit, wait_for,
+                               wait_for ? IORING_ENTER_GETEVENTS : 0, nullptr, 0);
+            if (ret >= 0 || errno != EINTR) return static_cast<int>(ret);
+            to_submit = sq_local_tail - __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+        }
+    }
+};
+
+#else
+
+struct NetServer::Uring {};
+
+#endif
+
+// ========== SERVER ==========
+
+NetServer::NetServer(ThreadSafeStore& store, NetServerOptions options) : store_(store), options_(std::move(options)) {}
+
+NetServer::~NetServer() {
+    stop();
+}
+
+bool NetServer::ioUringSupported() {
+#ifdef __linux__
+    // Multishot recv arrived in 6.0 (multishot accept and buffer rings in 5.19)
+    utsname name;
+    if (uname(&name) != 0) return false;
+    int major = 0;
+    int minor = 0;
+    if (std::sscanf(name.release, "%d.%d", &major, &minor) != 2 || major < 6) return false;
+
+    io_uring_params params{};
+    int fd = setupRing(4, params);
+    if (fd < 0) return false;  // Disabled (kernel.io_uring_disabled, seccomp)
+    close(fd);
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool NetServer::start() {
+    if (running()) return true;
+#ifdef __linux__
+    NetBackend wanted = options_.backend;
+    if (const char* env = std::getenv("KV_NET_BACKEND")) {
+        std::string value = env;
+        if (value == "io_uring") wanted = NetBackend::IO_URING;
+        if (value == "epoll") wanted = NetBackend::EPOLL;
+    }
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(options_.port);
+    if (inet_pton(AF_INET, options_.host.c_str(), &addr.sin_addr) != 1) return false;
+
+    listener_ = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listener_ < 0) return false;
+    int one = 1;
+    setsockopt(listener_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    socklen_t len = sizeof(addr);
+    wake_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (bind(listener_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        listen(listener_, options_.backlog) != 0 ||
+        getsockname(listener_, reinterpret_cast<sockaddr*>(&addr), &len) != 0 || wake_fd_ < 0) {
+        close(listener_);
+        if (wake_fd_ >= 0) close(wake_fd_);
+        listener_ = wake_fd_ = -1;
+        return false;
+    }
+    port_ = ntohs(addr.sin_port);
+
+    backend_ = NetBackend::EPOLL;
+    if (wanted == NetBackend::IO_URING && ioUringSupported()) {
+        auto ring = std::make_unique<Uring>();
+        if (ring->init(static_cast<unsigned>(options_.queue_depth), options_.buffer_count,
+                       std::max<size_t>(options_.buffer_size, 64))) {
+            uring_ = std::move(ring);
+            backend_ = NetBackend::IO_URING;
+        }
+    }
+
+    loop_ = std::thread([this] {
+        if (backend_ == NetBackend::IO_URING) {
+            runUring();
+        } else {
+            runEpoll();
+        }
+        run_cpu_ = threadCpuSeconds(CLOCK_THREAD_CPUTIME_ID);
+    });
+    return true;
+#else
+    return false;
+#endif
+}
+
+void NetServer::stop() {
+    if (!loop_.joinable()) return;
+#ifdef __linux__
+    uint64_t one = 1;
+    ssize_t written = write(wake_fd_, &one, sizeof(one));
+    (void)written;
+    loop_.join();
+    cpu_seconds_ += run_cpu_;
+    run_cpu_ = 0;
+
+    uring_.reset();  // Cancels what is in flight before the buffers go
+    closeAll();
+    close(listener_);
+    close(wake_fd_);
+    listener_ = wake_fd_ = -1;
+#endif
+}
+
+NetServerStats NetServer::stats() const {
+    NetServerStats stats;
+    stats.connections = open_.load(std::memory_order_relaxed);
+    stats.accepted = accepted_.load(std::memory_order_relaxed);
+    stats.requests = requests_.load(std::memory_order_relaxed);
+    stats.bytes_in = bytes_in_.load(std::memory_order_relaxed);
+    stats.bytes_out = bytes_out_.load(std::memory_order_relaxed);
+    stats.loop_syscalls = syscalls_.load(std::memory_order_relaxed);
+    stats.buffer_stalls = buffer_stalls_.load(std::memory_order_relaxed);
+    stats.cpu_seconds = cpu_seconds_;
+#ifdef __linux__
+    clockid_t clock;
+    if (loop_.joinable() &&
+        pthread_getcpuclockid(const_cast<std::thread&>(loop_).native_handle(), &clock) == 0) {
+        stats.cpu_seconds += threadCpuSeconds(clock);
+    }
+#endif
+    return stats;
+}
+
+bool NetServer::consume(Connection& conn, const char* data, size_t n) {
+    // Usual case: nothing buffered, frames parse straight out of the receive buffer
+    std::string_view input(data, n);
+    if (!conn.in.empty()) {
+        conn.in.append(data, n);
+        input = conn.in;
+    }
+
+    size_t pos = 0;
+    std::optional<std::string> payload;
+    while (input.size() - pos >= sizeof(uint32_t) && conn.queued() < options_.max_output) {
+        uint32_t length;
+        std::memcpy(&length, input.data() + pos, sizeof(length));
+        if (length > kMaxFrame) return false;
+        if (input.size() - pos - sizeof(length) < length) break;
+
+        uint32_t status = executeFrame(store_, input.substr(pos + sizeof(length), length), payload);
+        requests_.fetch_add(1, std::memory_order_relaxed);
+        pos += sizeof(length) + length;
+
+        uint32_t reply_length = static_cast<uint32_t>(sizeof(status) + (payload ? payload->size() : 0));
+        conn.out.append(reinterpret_cast<const char*>(&reply_length), sizeof(reply_length));
+        conn.out.append(reinterpret_cast<const char*>(&status), sizeof(status));
+        if (payload) conn.out += *payload;
+    }
+
+    if (conn.in.empty()) {
+        conn.in.assign(input.data() + pos, input.size() - pos);
+    } else if (pos == conn.in.size()) {
+        std::string().swap(conn.in);  // Idle again: give the memory back
+    } else {
+        conn.in.erase(0, pos);
+    }
+    return true;
+}
+
+void NetServer::closeAll() {
+#ifdef __linux__
+    for (auto& [id, conn] : connections_) close(conn.fd);
+#endif
+    connections_.clear();
+    open_.store(0, std::memory_order_relaxed);
+}
+
+// ========== EPOLL LOOP ==========
+
+void NetServer::runEpoll() {
+#ifdef __linux__
+    constexpr uint64_t kListener = 0;
+    constexpr uint64_t kWakeup = UINT64_MAX;
+
+    int ep = epoll_create1(EPOLL_CLOEXEC);
+    if (ep < 0) return;
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.u64 = kListener;
+    epoll_ctl(ep, EPOLL_CTL_ADD, listener_, &ev);
+    ev.data.u64 = kWakeup;
+    epoll_ctl(ep, EPOLL_CTL_ADD, wake_fd_, &ev);
+
+    std::vector<char> scratch(std::max<size_t>(options_.buffer_size, 64));
+    std::vector<epoll_event> events(1024);
+
+    // Write what is queued, then run requests held back while output was
+    // over the cap. Watch EPOLLOUT only while something is left, and
+    // EPOLLIN only while the connection isn't paused.
+    auto flush = [&](uint64_t id, Connection& conn) {
+        while (true) {
+            while (!conn.out.empty()) {
+                ssize_t n = send(conn.fd, conn.out.data(), conn.out.size(), MSG_NOSIGNAL);
+                syscalls_.fetch_add(1, std::memory_order_relaxed);
+                if (n < 0) {
+                    if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+                    return false;
+                }
+                bytes_out_.fetch_add(static_cast<uint64_t>(n), std::memory_order_relaxed);
+                conn.out.erase(0, static_cast<size_t>(n));
+            }
+            if (conn.in.empty() || conn.queued() >= options_.max_output) break;
+            size_t before = conn.out.size();
+            if (!consume(conn, "", 0)) return false;
+            if (conn.out.size() == before) break;  // Only a partial frame left
+        }
+        bool want_out = !conn.out.empty();
+        bool paused = conn.queued() >= options_.max_output;
+        if (want_out != conn.send_pending || paused != conn.paused) {
+            epoll_event mod{};
+            mod.events = (paused ? 0u : static_cast<uint32_t>(EPOLLIN)) |
+                         (want_out ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+            mod.data.u64 = id;
+            epoll_ctl(ep, EPOLL_CTL_MOD, conn.fd, &mod);
+            syscalls_.fetch_add(1, std::memory_order_relaxed);
+            conn.send_pending = want_out;
+            conn.paused = paused;
+        }
+        return true;
+    };
+
+    bool running = true;
+    while (running) {
+        int ready = epoll_wait(ep, events.data(), static_cast<int>(events.size()), -1);
+        syscalls_.fetch_add(1, std::memory_order_relaxed);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        for (int i = 0; i < ready; i++) {
+            uint64_t id = events[i].data.u64;
+            if (id == kWakeup) {
+                running = false;
+                continue;
+            }
+
+            if (id == kListener) {
+                while (true) {
+                    int fd = accept4(listener_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                    syscalls_.fetch_add(1, std::memory_order_relaxed);
+                    if (fd < 0) break;
+                    setNoDelay(fd);
+                    uint64_t conn_id = next_id_++;
+                    connections_[conn_id].fd = fd;
+                    epoll_event add{};
+                    add.events = EPOLLIN;
+                    add.data.u64 = conn_id;
+                    epoll_ctl(ep, EPOLL_CTL_ADD, fd, &add);
+                    open_.fetch_add(1, std::memory_order_relaxed);
+                    accepted_.fetch_add(1, std::memory_order_relaxed);
+                }
+                continue;
+            }
+
+            auto it = connections_.find(id);
+            if (it == connections_.end()) continue;
+            Connection& conn = it->second;
+
+            bool ok = true;
+            if ((events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) && !conn.paused) {
+                while (conn.queued() < options_.max_output) {
+                    ssize_t n = read(conn.fd, scratch.data(), scratch.size());
+                    syscalls_.fetch_add(1, std::memory_order_relaxed);
+                    if (n > 0) {
+                        bytes_in_.fetch_add(static_cast<uint64_t>(n), std::memory_order_relaxed);
+                        if (!consume(conn, scratch.data(), static_cast<size_t>(n))) {
+                            ok = false;
+                            break;
+                        }
+                        if (static_cast<size_t>(n) < scratch.size()) break;  // Drained; skip the EAGAIN read
+                        continue;
+                    }
+                    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+                    ok = false;  // EOF or error
+                    break;
+                }
+            }
+            if (ok) ok = flush(id, conn);
+            if (!ok) {
+                close(conn.fd);  // Also leaves the epoll set
+                connections_.erase(it);
+                open_.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+    }
+    close(ep);
+#endif
+}
+
+// ========== IO_URING LOOP ==========
+
+void NetServer::runUring() {
+#ifdef __linux__
+    Uring& ring = *uring_;
+    if (!ring.enable()) return;
+
+    auto armAccept = [&] {
+        io_uring_sqe* sqe = ring.sqe(syscalls_);
+        sqe->opcode = IORING_OP_ACCEPT;
+        sqe->fd = listener_;
+        sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+        sqe->accept_flags = SOCK_CLOEXEC;
+        sqe->user_data = tag(0, kAccept);
+    };
+    auto armRecv = [&](uint64_t id, Connection& conn) {
+        io_uring_sqe* sqe = ring.sqe(syscalls_);
+        sqe->opcode = IORING_OP_RECV;
+        sqe->fd = conn.fd;
+        sqe->ioprio = IORING_RECV_MULTISHOT;
+        sqe->flags = IOSQE_BUFFER_SELECT;  // Buffer picked when data arrives
+        sqe->buf_group = kBufferGroup;
+        sqe->user_data = tag(id, kRecv);
+        conn.recv_armed = true;
+    };
+    auto armWake = [&] {
+        io_uring_sqe* sqe = ring.sqe(syscalls_);
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = wake_fd_;
+        sqe->addr = reinterpret_cast<uint64_t>(&ring.wake_value);
+        sqe->len = sizeof(ring.wake_value);
+        sqe->user_data = tag(0, kWake);
+    };
+    auto submitSend = [&](uint64_t id, Connection& conn) {
+        io_uring_sqe* sqe = ring.sqe(syscalls_);
+        sqe->opcode = IORING_OP_SEND;
+        sqe->fd = conn.fd;
+        sqe->addr = reinterpret_cast<uint64_t>(conn.sending.data() + conn.sent);
+        sqe->len = static_cast<uint32_t>(conn.sending.size() - conn.sent);
+        sqe->msg_flags = MSG_NOSIGNAL;
+        sqe->user_data = tag(id, kSend);
+        conn.send_pending = true;
+    };
+    // Output over the cap: cancel the multishot RECV. Completions already
+    // queued still land in conn.in; consume() won't run them until resume().
+    auto pause = [&](uint64_t id, Connection& conn) {
+        conn.paused = true;
+        if (!conn.recv_armed) return;
+        io_uring_sqe* sqe = ring.sqe(syscalls_);
+        sqe->opcode = IORING_OP_ASYNC_CANCEL;
+        sqe->fd = -1;
+        sqe->addr = tag(id, kRecv);
+        sqe->user_data = tag(id, kCancel);
+    };
+    // Replies drained below the cap: run the held-back requests, and read
+    // again if they didn't fill the output back up. False on a bad frame.
+    auto resume = [&](uint64_t id, Connection& conn) {
+        if (!consume(conn, "", 0)) return false;
+        if (conn.queued() >= options_.max_output) return true;
+        conn.paused = false;
+        if (!conn.recv_armed) armRecv(id, conn);
+        return true;
+    };
+    // shutdown() ends the multishot RECV; a SEND in flight still owns
+    // conn.sending, so the close waits for its completion
+    auto closeConnection = [&](std::unordered_map<uint64_t, Connection>::iterator it) {
+        Connection& conn = it->second;
+        if (!conn.closing) {
+            shutdown(conn.fd, SHUT_RDWR);
+            conn.closing = true;
+        }
+        if (conn.send_pending) return;
+        close(conn.fd);
+        connections_.erase(it);
+        open_.fetch_sub(1, std::memory_order_relaxed);
+    };
+
+    std::vector<uint64_t> replied;  // Connections with replies queued this pass
+    armAccept();
+    armWake();
+
+    bool running = true;
+    while (running) {
+        ring.publishBuffers();
+        int entered = ring.enter(1);
+        syscalls_.fetch_add(1, std::memory_order_relaxed);
+        if (entered < 0) break;
+
+        unsigned head = *ring.cq_head;
+        unsigned tail = __atomic_load_n(ring.cq_tail, __ATOMIC_ACQUIRE);
+        for (; head != tail; head++) {
+            const io_uring_cqe& cqe = ring.cqes[head & ring.cq_mask];
+            uint64_t id = cqe.user_data >> 3;
+            int res = cqe.res;
+            bool more = cqe.flags & IORING_CQE_F_MORE;
+
+            switch (static_cast<Operation>(cqe.user_data & 7)) {
+                case kAccept: {
+                    if (res >= 0) {
+                        setNoDelay(res);
+                        uint64_t conn_id = next_id_++;
+                        Connection& conn = connections_[conn_id];
+                        conn.fd = res;
+                        armRecv(conn_id, conn);
+                        open_.fetch_add(1, std::memory_order_relaxed);
+                        accepted_.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    if (!more) armAccept();
+                    break;
+                }
+
+                case kRecv: {
+                    bool has_buffer = cqe.flags & IORING_CQE_F_BUFFER;
+                    auto bid = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+                    auto it = connections_.find(id);
+                    if (it != connections_.end() && !more) it->second.recv_armed = false;
+
+                    bool ok = res > 0 || res == -ENOBUFS || res == -ECANCELED;
+                    if (it != connections_.end() && !it->second.closing && res > 0) {
+                        Connection& conn = it->second;
+                        bytes_in_.fetch_add(static_cast<uint64_t>(res), std::memory_order_relaxed);
+                        ok = consume(conn, ring.buffer(bid), static_cast<size_t>(res));
+                        if (!conn.out.empty() && !conn.send_pending) replied.push_back(id);
+                        if (ok && !conn.paused && conn.queued() >= options_.max_output) pause(id, conn);
+                    }
+                    if (has_buffer) ring.recycle(bid);
+
+                    if (it == connections_.end()) break;
+                    Connection& conn = it->second;
+                    if (!ok) {
+                        closeConnection(it);
+                    } else if (!more && !conn.closing && !conn.paused) {
+                        if (res == -ENOBUFS) buffer_stalls_.fetch_add(1, std::memory_order_relaxed);
+                        armRecv(id, conn);
+                    }
+                    break;
+                }
+
+                case kSend: {
+                    auto it = connections_.find(id);
+                    if (it == connections_.end()) break;
+                    Connection& conn = it->second;
+                    conn.send_pending = false;
+                    if (conn.closing || res < 0) {
+                        closeConnection(it);
+                        break;
+                    }
+                    bytes_out_.fetch_add(static_cast<uint64_t>(res), std::memory_order_relaxed);
+                    conn.sent += static_cast<size_t>(res);
+                    if (conn.sent < conn.sending.size()) {
+                        submitSend(id, conn);  // Short send: the rest
+                        break;
+                    }
+                    conn.sending.clear();
+                    conn.sent = 0;
+                    if (conn.paused && conn.queued() < options_.max_output && !resume(id, conn)) {
+                        closeConnection(it);
+                        break;
+                    }
+                    if (!conn.out.empty()) replied.push_back(id);
+                    break;
+                }
+
+                case kCancel:
+                    break;  // The RECV's own completion reports the outcome
+
+                case kWake:
+                    running = false;
+                    break;
+            }
+        }
+        __atomic_store_n(ring.cq_head, head, __ATOMIC_RELEASE);
+
+        // Batched sends: one SEND per connection per pass, all submitted
+        // by the next io_uring_enter together with the buffer returns
+        for (uint64_t conn_id : replied) {
+            auto it = connections_.find(conn_id);
+            if (it == connections_.end()) continue;
+            Connection& conn = it->second;
+            if (conn.send_pending || conn.closing || conn.out.empty()) continue;
+            conn.sending.swap(conn.out);
+            conn.out.clear();
+            conn.sent = 0;
+            submitSend(conn_id, conn);
+        }
+        replied.clear();
+    }
+#endif
+}
@@ -0,0 +1,180 @@
+#include "../include/NumaTopology.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Parse a sysfs cpulist such as "0-3,8,10-11"
+std::vector<int> parseCpuList(const std::string& text) {
+    std::vector<int> cpus;
+    std::stringstream ss(text);
+    std::string range;
+
+    while (std::getline(ss, range, ',')) {
+        if (range.empty() || range == "\n") continue;
+        auto dash = range.find('-');
+        try {
+            if (dash == std::string::npos) {
+                cpus.push_back(std::stoi(range));
+            } else {
+                int lo = std::stoi(range.substr(0, dash));
+                int hi = std::stoi(range.substr(dash + 1));
+                for (int cpu = lo; cpu <= hi; cpu++) cpus.push_back(cpu);
+            }
+        } catch (...) {
+            // Malformed entry - ignore it
+        }
+    }
+    return cpus;
+}
+
+std::vector<int> onlineCpus() {
+    std::vector<int> cpus;
+#ifdef __linux__
+    std::ifstream in("/sys/devices/system/cpu/online");
+    std::string text;
+    if (std::getline(in, text)) cpus = parseCpuList(text);
+#endif
+    if (cpus.empty()) {
+        unsigned n = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned cpu = 0; cpu < n; cpu++) cpus.push_back(static_cast<int>(cpu));
+    }
+    return cpus;
+}
+
+}  // namespace
+
+NumaTopology NumaTopology::detect() {
+    if (const char* env = std::getenv("KV_NUMA_EMULATE")) {
+        int n = std::atoi(env);
+        if (n > 0) return emulated(static_cast<size_t>(n));
+    }
+
+    NumaTopology topo;
+#ifdef __linux__
+    if (DIR* dir = opendir("/sys/devices/system/node")) {
+        while (dirent* entry = readdir(dir)) {
+            std::string name = entry->d_name;
+            if (name.rfind("node", 0) != 0 || name.size() <= 4) continue;
+            if (!std::all_of(name.begin() + 4, name.end(), ::isdigit)) continue;
+
+            std::ifstream in("/sys/devices/system/node/" + name + "/cpulist");
+            std::string text;
+            std::getline(in, text);
+
+            NumaNode node{std::stoi(name.substr(4)), parseCpuList(text)};
+            if (!node.cpus.empty()) topo.nodes_.push_back(std::move(node));
+        }
+        closedir(dir);
+    }
+#endif
+
+    if (topo.nodes_.empty()) {
+        // No NUMA info: whole machine is one node
+        topo.nodes_.push_back(NumaNode{0, onlineCpus()});
+    }
+
+    std::sort(topo.nodes_.begin(), topo.nodes_.end(),
+              [](const NumaNode& a, const NumaNode& b) { return a.id < b.id; });
+    return topo;
+}
+
+NumaTopology NumaTopology::emulated(size_t node_count) {
+    NumaTopology topo;
+    topo.emulated_ = true;
+    node_count = std::max<size_t>(1, node_count);
+
+    auto cpus = onlineCpus();
+    for (size_t i = 0; i < node_count; i++) {
+        topo.nodes_.push_back(NumaNode{static_cast<int>(i), {}});
+    }
+
+    // Round-robin CPUs over fake nodes; with fewer CPUs than nodes,
+    // nodes share CPUs so every node can still be pinned to something
+    size_t slots = std::max(cpus.size(), node_count);
+    for (size_t i = 0; i < slots; i++) {
+        auto& node_cpus = topo.nodes_[i % node_count].cpus;
+        int cpu = cpus[i % cpus.size()];
+        if (std::find(node_cpus.begin(), node_cpus.end(), cpu) == node_cpus.end()) {
+            node_cpus.push_back(cpu);
+        }
+    }
+    return topo;
+}
+
+size_t NumaTopology::nodeOfCpu(int cpu) const {
+    for (size_t i = 0; i < nodes_.size(); i++) {
+        const auto& cpus = nodes_[i].cpus;
+        if (std::find(cpus.begin(), cpus.end(), cpu) != cpus.end()) return i;
+    }
+    return 0;
+}
+
+size_t NumaTopology::currentNode() const {
+#ifdef __linux__
+    int cpu = sched_getcpu();
+    if (cpu >= 0) return nodeOfCpu(cpu);
+#endif
+    return 0;
+}
+
+bool NumaTopology::pinThreadToNode(size_t node) const {
+    if (node >= nodes_.size()) return false;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : nodes_[node].cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+bool NumaTopology::bindThreadMemoryToNode(size_t node) const {
+    if (node >= nodes_.size()) return false;
+    if (emulated_) return true;  // Single real node - nothing to bind
+
+#if defined(__linux__) && defined(SYS_set_mempolicy)
+    // MPOL_PREFERRED (from <numaif.h>, spelled out to avoid a libnuma
+    // dependency): allocate on `node`, fall back to others when it is full
+    constexpr int kMpolPreferred = 1;
+    constexpr unsigned long kBitsPerWord = sizeof(unsigned long) * 8;
+
+    int id = nodes_[node].id;
+    std::vector<unsigned long> mask(static_cast<size_t>(id) / kBitsPerWord + 1, 0);
+    mask[static_cast<size_t>(id) / kBitsPerWord] |= 1UL << (static_cast<size_t>(id) % kBitsPerWord);
+
+    return syscall(SYS_set_mempolicy, kMpolPreferred, mask.data(),
+                   mask.size() * kBitsPerWord + 1) == 0;
+#else
+    return false;
+#endif
+}
+
+std::string NumaTopology::describe() const {
+    std::ostringstream out;
+    out << nodes_.size() << (nodes_.size() == 1 ? " node" : " nodes");
+    if (emulated_) out << " (emulated)";
+    out << ":";
+    for (const auto& node : nodes_) {
+        out << " " << node.id << ":[";
+        for (size_t i = 0; i < node.cpus.size(); i++) {
+            out << (i ? "," : "") << node.cpus[i];
+        }
+        out << "]";
+    }
+    return out.str();
+}
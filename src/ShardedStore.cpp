@@ -0,0 +1,68 @@
+#include "../include/ShardedStore.h"
+#include <charconv>
+#include <functional>
+#include <optional>
+#include <string_view>
+#include <thread>
+
+ShardedStore::ShardedStore(NumaTopology topology, size_t shards_per_node, StorageOptions options)
+    : topology_(std::make_shared<const NumaTopology>(std::move(topology))) {
+    if (shards_per_node == 0) shards_per_node = 1;
+
+    std::vector<std::future<bool>> pinned;
+    for (size_t node = 0; node < topology_->nodeCount(); node++) {
+        // Emulated nodes share one real node - nothing to bind
+        options.numa_node = topology_->isEmulated() ? -1 : topology_->node(node).id;
+        for (size_t i = 0; i < shards_per_node; i++) {
+            shards_.push_back(std::make_unique<ThreadSafeStore>(options));
+            shard_node_.push_back(node);
+            pinned.push_back(shards_.back()->setNumaNode(topology_, node));
+        }
+    }
+
+    // Wait so the first async writes already land node-local
+    // (a failed pin is not fatal - the shard just runs unpinned)
+    for (auto& f : pinned) f.wait();
+}
+
+// Node index from a "{node:N}" key prefix
+static std::optional<size_t> nodeTag(const std::string& key) {
+    static constexpr std::string_view kTag = "{node:";
+    if (key.compare(0, kTag.size(), kTag) != 0) return std::nullopt;
+
+    const char* first = key.data() + kTag.size();
+    const char* last = key.data() + key.size();
+    size_t node = 0;
+    auto [end, ec] = std::from_chars(first, last, node);
+    if (ec != std::errc() || end == first || end == last || *end != '}') return std::nullopt;
+    return node;
+}
+
+size_t ShardedStore::shardIndex(const std::string& key) const {
+    size_t hash = std::hash<std::string>{}(key);
+    auto node = nodeTag(key);
+    if (!node || *node >= topology_->nodeCount()) return hash % shards_.size();
+
+    // Shards are laid out node by node
+    size_t per_node = shards_.size() / topology_->nodeCount();
+    return *node * per_node + hash % per_node;
+}
+
+std::string ShardedStore::localKey(const std::string& key) const {
+    return "{node:" + std::to_string(topology_->currentNode()) + "}" + key;
+}
+
+ThreadSafeStore& ShardedStore::localShard() {
+    size_t node = topology_->currentNode();
+
+    // Spread threads of the same node over that node's shards
+    size_t per_node = shards_.size() / topology_->nodeCount();
+    size_t offset = std::hash<std::thread::id>{}(std::this_thread::get_id()) % per_node;
+    return *shards_[node * per_node + offset];
+}
+
+size_t ShardedStore::size() const {
+    size_t total = 0;
+    for (const auto& shard : shards_) total += shard->size();
+    return total;
+}
@@ -0,0 +1,505 @@
+#include "../include/ShmTransport.h"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// ========== SEGMENT LAYOUT ==========
+
+namespace shm {
+
+constexpr uint64_t kMagic = 0x4b5653484d303031;  // "KVSHM001": segment format version
+constexpr size_t kLine = 64;
+constexpr uint32_t kMinSpin = 64;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "ring indices must be address-free");
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex words must be plain u32");
+
+// kClosed: the dispatcher dropped the slot over a malformed frame; it
+// stays unclaimable until its owner releases it
+enum SlotState : uint32_t { kFree, kClaiming, kActive, kClosed };
+enum Status : uint32_t { kNil, kOk, kError };
+
+struct Ring {
+    alignas(kLine) std::atomic<uint64_t> head{0};       // Consumer
+    alignas(kLine) std::atomic<uint64_t> tail{0};       // Producer
+    alignas(kLine) std::atomic<uint32_t> sleeping{0};   // Consumer is (about to be) in futexWait
+    std::atomic<uint32_t> signal{0};                    // The futex word
+};
+
+// Followed by the request ring's data, then the response ring's
+struct Slot {
+    alignas(kLine) std::atomic<uint32_t> state{kFree};
+    Ring request;
+    Ring response;
+};
+
+struct Header {
+    uint64_t magic = kMagic;
+    uint64_t size = 0;          // Whole segment
+    uint64_t slot_bytes = 0;
+    uint32_t max_clients = 0;
+    uint32_t ring_bytes = 0;
+    uint32_t max_spin = 0;
+    std::atomic<uint32_t> stopping{0};
+    alignas(kLine) std::atomic<uint32_t> sleeping{0};   // Dispatcher waits on `doorbell`
+    std::atomic<uint32_t> doorbell{0};
+};
+
+static Slot* slotAt(Header* header, size_t index) {
+    return reinterpret_cast<Slot*>(reinterpret_cast<char*>(header) + sizeof(Header) + index * header->slot_bytes);
+}
+
+static char* requestData(Slot* slot) {
+    return reinterpret_cast<char*>(slot) + sizeof(Slot);
+}
+
+static char* responseData(const Header* header, Slot* slot) {
+    return requestData(slot) + header->ring_bytes;
+}
+
+// Wrap-aware copies; positions are free-running byte counters
+static void copyIn(char* data, uint32_t capacity, uint64_t pos, const void* src, size_t n) {
+    size_t offset = pos & (capacity - 1);
+    size_t first = std::min<size_t>(n, capacity - offset);
+    std::memcpy(data + offset, src, first);
+    std::memcpy(data, static_cast<const char*>(src) + first, n - first);
+}
+
+static void copyOut(const char* data, uint32_t capacity, uint64_t pos, void* dst, size_t n) {
+    size_t offset = pos & (capacity - 1);
+    size_t first = std::min<size_t>(n, capacity - offset);
+    std::memcpy(dst, data + offset, first);
+    std::memcpy(static_cast<char*>(dst) + first, data, n - first);
+}
+
+// ========== WAITING ==========
+
+static void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+// Process-shared futexes (no FUTEX_PRIVATE_FLAG): the peer may be another process
+static void futexWait(std::atomic<uint32_t>& word, uint32_t expected) {
+#ifdef __linux__
+    timespec timeout{0, 100 * 1000 * 1000};  // Re-check `stopping` now and then
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+#else
+    (void)word;
+    (void)expected;
+    std::this_thread::yield();
+#endif
+}
+
+static void futexWake(std::atomic<uint32_t>& word) {
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#else
+    (void)word;
+#endif
+}
+
+// Producer side: wake the consumer only if it said it is going to sleep
+static bool notify(std::atomic<uint32_t>& sleeping, std::atomic<uint32_t>& signal) {
+    if (!sleeping.load()) return false;
+    signal.fetch_add(1);
+    futexWake(signal);
+    return true;
+}
+
+// Consumer side: spin up to `limit`, then sleep on `signal` until ready()
+// or stopping. Returns false only when stopping. Adapts `limit` (see
+// header comment).
+template <typename Ready>
+static bool await(std::atomic<uint32_t>& sleeping, std::atomic<uint32_t>& signal, const std::atomic<uint32_t>& stopping,
+                  uint32_t& limit, uint32_t max_spin, bool* slept, Ready ready) {
+    for (uint32_t spins = 0; spins < limit; spins++) {
+        if (ready()) {
+            int64_t drift = (2 * static_cast<int64_t>(spins) - limit) / 8;
+            limit = static_cast<uint32_t>(std::clamp<int64_t>(limit + drift, std::min(kMinSpin, max_spin), max_spin));
+            return true;
+        }
+        cpuRelax();
+    }
+
+    if (slept) *slept = true;
+    while (true) {
+        // sleeping before the re-check: a producer publishing after the
+        // re-check is guaranteed to see it and bump `signal`
+        sleeping.store(1);
+        uint32_t seen = signal.load();
+        if (ready()) break;
+        if (stopping.load()) {
+            sleeping.store(0);
+            return false;
+        }
+        futexWait(signal, seen);
+    }
+    sleeping.store(0);
+    limit = std::max(limit / 2, std::min(kMinSpin, max_spin));
+    return true;
+}
+
+}  // namespace shm
+
+using namespace shm;
+
+// ========== FRAMES ==========
+
+uint32_t executeFrame(ThreadSafeStore& store, std::string_view frame, std::optional<std::string>& payload) {
+    // Decode: op, then length-prefixed arguments
+    std::string_view args[3];
+    size_t argc = 0;
+    uint32_t op = UINT32_MAX;
+    size_t length = frame.size();
+    if (length >= sizeof(op)) {
+        std::memcpy(&op, frame.data(), sizeof(op));
+        size_t pos = sizeof(op);
+        while (pos + sizeof(uint32_t) <= length && argc < 3) {
+            uint32_t n;
+            std::memcpy(&n, frame.data() + pos, sizeof(n));
+            pos += sizeof(n);
+            if (n > length - pos) break;
+            args[argc++] = std::string_view(frame.data() + pos, n);
+            pos += n;
+        }
+        if (pos != length) op = UINT32_MAX;  // Truncated or trailing bytes
+    }
+
+    uint32_t status = kError;
+    payload.reset();
+    switch (static_cast<ShmOp>(op)) {
+        case ShmOp::PING:
+            status = kOk;
+            payload = "PONG";
+            break;
+        case ShmOp::GET:
+            if (argc != 1) break;
+            payload = store.get(std::string(args[0]));
+            status = payload ? kOk : kNil;
+            break;
+        case ShmOp::SET:
+            if (argc != 3) break;
+            status = store.set(std::string(args[0]), std::string(args[1]), std::atoi(std::string(args[2]).c_str()))
+                         ? kOk : kNil;
+            break;
+        case ShmOp::DEL:
+            if (argc != 1) break;
+            status = store.del(std::string(args[0])) ? kOk : kNil;
+            break;
+        case ShmOp::EXISTS:
+            if (argc != 1) break;
+            status = store.exists(std::string(args[0])) ? kOk : kNil;
+            break;
+    }
+
+    return status;
+}
+
+// ========== SERVER ==========
+
+ShmServer::ShmServer(ThreadSafeStore& store, ShmTransportOptions options) : store_(store) {
+    size_t ring = 1024;
+    while (ring < options.ring_bytes && ring < (size_t{1} << 30)) ring <<= 1;
+    size_t clients = std::max<size_t>(options.max_clients, 1);
+
+    max_spin_ = options.max_spin >= 0 ? static_cast<uint32_t>(options.max_spin)
+                                      : (std::thread::hardware_concurrency() > 1 ? 4000 : 0);
+    spin_limit_ = max_spin_;
+
+#ifdef __linux__
+    size_t slot_bytes = sizeof(Slot) + 2 * ring;
+    size_t size = sizeof(Header) + clients * slot_bytes;
+
+    int fd = memfd_create("kv-shm-transport", MFD_CLOEXEC);
+    if (fd < 0) return;
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        close(fd);
+        return;
+    }
+    void* base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        close(fd);
+        return;
+    }
+
+    auto* header = new (base) Header();
+    header->size = size;
+    header->slot_bytes = slot_bytes;
+    header->max_clients = static_cast<uint32_t>(clients);
+    header->ring_bytes = static_cast<uint32_t>(ring);
+    header->max_spin = max_spin_;
+    for (size_t i = 0; i < clients; i++) new (slotAt(header, i)) Slot();
+
+    fd_ = fd;
+    size_ = size;
+    header_ = header;
+    dispatcher_ = std::thread(&ShmServer::run, this);
+#else
+    (void)ring;
+    (void)clients;
+#endif
+}
+
+ShmServer::~ShmServer() {
+    if (!header_) return;
+
+    header_->stopping.store(1);
+    header_->doorbell.fetch_add(1);
+    futexWake(header_->doorbell);
+    if (dispatcher_.joinable()) dispatcher_.join();
+
+    // Clients blocked on a reply see `stopping` and give up
+    for (size_t i = 0; i < header_->max_clients; i++) {
+        Ring& response = slotAt(header_, i)->response;
+        response.signal.fetch_add(1);
+        futexWake(response.signal);
+    }
+
+#ifdef __linux__
+    munmap(header_, size_);  // Clients keep their own mappings alive
+    close(fd_);
+#endif
+}
+
+ShmTransportStats ShmServer::stats() const {
+    ShmTransportStats stats;
+    if (header_) {
+        for (size_t i = 0; i < header_->max_clients; i++) {
+            if (slotAt(header_, i)->state.load(std::memory_order_acquire) == kActive) stats.clients++;
+        }
+    }
+    stats.requests = requests_.load(std::memory_order_relaxed);
+    stats.sleeps = sleeps_.load(std::memory_order_relaxed);
+    stats.wakeups = wakeups_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void ShmServer::run() {
+    auto pending = [this] {
+        for (size_t i = 0; i < header_->max_clients; i++) {
+            Slot* slot = slotAt(header_, i);
+            if (slot->state.load(std::memory_order_acquire) != kActive) continue;
+            Ring& request = slot->request;
+            if (request.tail.load(std::memory_order_acquire) != request.head.load(std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    while (!header_->stopping.load(std::memory_order_relaxed)) {
+        if (serveOnce()) continue;
+
+        bool slept = false;
+        await(header_->sleeping, header_->doorbell, header_->stopping, spin_limit_, max_spin_, &slept, pending);
+        if (slept) sleeps_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool ShmServer::serveOnce() {
+    bool served = false;
+    std::string frame;
+
+    for (size_t i = 0; i < header_->max_clients; i++) {
+        Slot* slot = slotAt(header_, i);
+        if (slot->state.load(std::memory_order_acquire) != kActive) continue;
+
+        Ring& request = slot->request;
+        const char* data = requestData(slot);
+        uint64_t head = request.head.load(std::memory_order_relaxed);
+        uint64_t tail;
+        while (head != (tail = request.tail.load(std::memory_order_acquire))) {
+            // The client writes length and tail; never trust either
+            uint64_t available = tail - head;
+            uint32_t length = 0;
+            if (available >= sizeof(length) && available <= header_->ring_bytes) {
+                copyOut(data, header_->ring_bytes, head, &length, sizeof(length));
+            }
+            if (available < sizeof(length) || available > header_->ring_bytes || length > available - sizeof(length)) {
+                slot->state.store(kClosed, std::memory_order_release);
+                notify(slot->response.sleeping, slot->response.signal);
+                break;
+            }
+            frame.resize(length);
+            copyOut(data, header_->ring_bytes, head + sizeof(length), frame.data(), length);
+            head += sizeof(length) + length;
+            request.head.store(head, std::memory_order_release);
+
+            dispatch(*slot, frame.data(), length);
+            served = true;
+        }
+    }
+    return served;
+}
+
+void ShmServer::dispatch(Slot& slot, const char* frame, uint32_t length) {
+    requests_.fetch_add(1, std::memory_order_relaxed);
+
+    std::optional<std::string> payload;
+    uint32_t status = executeFrame(store_, std::string_view(frame, length), payload);
+
+    // The client waits for this reply before sending more, so the ring
+    // is empty here; only a reply bigger than the whole ring can't fit
+    size_t bytes = payload ? payload->size() : 0;
+    if (2 * sizeof(uint32_t) + bytes > header_->ring_bytes) {
+        status = kError;
+        bytes = 0;
+    }
+
+    Ring& response = slot.response;
+    char* data = responseData(header_, &slot);
+    uint64_t tail = response.tail.load(std::memory_order_relaxed);
+    uint32_t frame_length = static_cast<uint32_t>(sizeof(status) + bytes);
+    copyIn(data, header_->ring_bytes, tail, &frame_length, sizeof(frame_length));
+    copyIn(data, header_->ring_bytes, tail + sizeof(frame_length), &status, sizeof(status));
+    if (bytes) copyIn(data, header_->ring_bytes, tail + 2 * sizeof(uint32_t), payload->data(), bytes);
+    response.tail.store(tail + sizeof(frame_length) + frame_length);
+
+    if (notify(response.sleeping, response.signal)) wakeups_.fetch_add(1, std::memory_order_relaxed);
+}
+
+// ========== CLIENT ==========
+
+ShmClient::ShmClient(int fd) : spin_limit_(0), max_spin_(0) {
+#ifdef __linux__
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Header)) return;
+
+    size_t size = static_cast<size_t>(info.st_size);
+    void* base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) return;
+
+    auto* header = static_cast<Header*>(base);
+    if (header->magic != kMagic || header->size != size || header->stopping.load()) {
+        munmap(base, size);
+        return;
+    }
+
+    for (size_t i = 0; i < header->max_clients && !slot_; i++) {
+        Slot* slot = slotAt(header, i);
+        uint32_t expected = kFree;
+        if (!slot->state.compare_exchange_strong(expected, kClaiming)) continue;
+
+        // The dispatcher ignores the slot until it is kActive
+        for (Ring* ring : {&slot->request, &slot->response}) {
+            ring->head.store(0, std::memory_order_relaxed);
+            ring->tail.store(0, std::memory_order_relaxed);
+            ring->sleeping.store(0, std::memory_order_relaxed);
+        }
+        slot->state.store(kActive, std::memory_order_release);
+        slot_ = slot;
+    }
+    if (!slot_) {
+        munmap(base, size);
+        return;
+    }
+
+    size_ = size;
+    header_ = header;
+    max_spin_ = header->max_spin;
+    spin_limit_ = max_spin_;
+#else
+    (void)fd;
+#endif
+}
+
+ShmClient::~ShmClient() {
+    if (!slot_) return;
+    slot_->state.store(kFree, std::memory_order_release);
+#ifdef __linux__
+    munmap(header_, size_);
+#endif
+}
+
+bool ShmClient::ping() {
+    std::string reply;
+    return call(ShmOp::PING, {}, &reply) == kOk && reply == "PONG";
+}
+
+std::optional<std::string> ShmClient::get(const std::string& key) {
+    std::string reply;
+    if (call(ShmOp::GET, {key}, &reply) != kOk) return std::nullopt;
+    return reply;
+}
+
+bool ShmClient::set(const std::string& key, const std::string& value, int ttl) {
+    return call(ShmOp::SET, {key, value, std::to_string(ttl)}, nullptr) == kOk;
+}
+
+bool ShmClient::del(const std::string& key) {
+    return call(ShmOp::DEL, {key}, nullptr) == kOk;
+}
+
+bool ShmClient::exists(const std::string& key) {
+    return call(ShmOp::EXISTS, {key}, nullptr) == kOk;
+}
+
+std::optional<uint32_t> ShmClient::call(ShmOp op, std::initializer_list<std::string_view> args, std::string* reply) {
+    if (!slot_ || header_->stopping.load(std::memory_order_relaxed)) return std::nullopt;
+    if (slot_->state.load(std::memory_order_acquire) != kActive) return std::nullopt;  // Dropped by the server
+
+    size_t length = sizeof(uint32_t);
+    for (auto arg : args) length += sizeof(uint32_t) + arg.size();
+
+    Ring& request = slot_->request;
+    char* data = requestData(slot_);
+    uint32_t capacity = header_->ring_bytes;
+    uint64_t tail = request.tail.load(std::memory_order_relaxed);
+    if (sizeof(uint32_t) + length > capacity - (tail - request.head.load(std::memory_order_acquire))) {
+        return std::nullopt;  // Bigger than the ring
+    }
+
+    // Encode straight into the ring
+    auto put = [&](const void* bytes, size_t n) {
+        copyIn(data, capacity, tail, bytes, n);
+        tail += n;
+    };
+    uint32_t word = static_cast<uint32_t>(length);
+    put(&word, sizeof(word));
+    word = static_cast<uint32_t>(op);
+    put(&word, sizeof(word));
+    for (auto arg : args) {
+        word = static_cast<uint32_t>(arg.size());
+        put(&word, sizeof(word));
+        put(arg.data(), arg.size());
+    }
+    request.tail.store(tail);
+    notify(header_->sleeping, header_->doorbell);
+
+    Ring& response = slot_->response;
+    const char* reply_data = responseData(header_, slot_);
+    uint64_t head = response.head.load(std::memory_order_relaxed);
+    auto ready = [&] {
+        return response.tail.load(std::memory_order_acquire) != head ||
+               slot_->state.load(std::memory_order_acquire) != kActive;
+    };
+    if (!await(response.sleeping, response.signal, header_->stopping, spin_limit_, max_spin_, nullptr, ready) ||
+        response.tail.load(std::memory_order_acquire) == head) {
+        return std::nullopt;
+    }
+
+    uint32_t frame_length;
+    uint32_t status;
+    copyOut(reply_data, capacity, head, &frame_length, sizeof(frame_length));
+    copyOut(reply_data, capacity, head + sizeof(frame_length), &status, sizeof(status));
+    if (reply) {
+        reply->resize(frame_length - sizeof(status));
+        copyOut(reply_data, capacity, head + 2 * sizeof(uint32_t), reply->data(), reply->size());
+    }
+    response.head.store(head + sizeof(frame_length) + frame_length, std::memory_order_release);
+    return status;
+}
@@ -0,0 +1,217 @@
+#include "../include/SketchTypes.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace {
+
+uint64_t hashItem(const std::string& item) {
+    return std::hash<std::string>{}(item);
+}
+
+// splitmix64 finalizer
+uint64_t mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+// Maps a hash to [0, n) without a division
+size_t reduce(uint64_t h, size_t n) {
+    return static_cast<size_t>((static_cast<unsigned __int128>(h) * n) >> 64);
+}
+
+// Column of `row` for an item: double hashing h1 + row * h2
+size_t column(uint64_t h, size_t row, size_t width) {
+    uint64_t h2 = mix(h) | 1;
+    return reduce(h + row * h2, width);
+}
+
+// Counters stick at UINT64_MAX rather than wrapping round to a small
+// (under-)estimate, which a count-min sketch must never report
+uint64_t saturatingAdd(uint64_t a, uint64_t b) {
+    uint64_t sum = a + b;
+    return sum < a ? UINT64_MAX : sum;
+}
+
+uint64_t saturatingMul(uint64_t a, uint64_t b) {
+    uint64_t product;
+    return __builtin_mul_overflow(a, b, &product) ? UINT64_MAX : product;
+}
+
+}  // namespace
+
+// ========== COUNT-MIN SKETCH ==========
+
+CountMinSketch::CountMinSketch(size_t width, size_t depth)
+    : width_(std::max<size_t>(1, width)), depth_(std::max<size_t>(1, depth)),
+      counters_(width_ * depth_, 0) {}
+
+CountMinSketch CountMinSketch::fromErrorRate(double error, double probability) {
+    auto width = static_cast<size_t>(std::ceil(std::exp(1.0) / error));
+    auto depth = static_cast<size_t>(std::ceil(std::log(1.0 / probability)));
+    return CountMinSketch(width, depth);
+}
+
+uint64_t CountMinSketch::incrBy(const std::string& item, uint64_t increment) {
+    uint64_t h = hashItem(item);
+    uint64_t estimate = UINT64_MAX;
+
+    for (size_t row = 0; row < depth_; row++) {
+        uint64_t& counter = counters_[row * width_ + column(h, row, width_)];
+        counter = saturatingAdd(counter, increment);
+        estimate = std::min(estimate, counter);
+    }
+    total_ = saturatingAdd(total_, increment);
+    return estimate;
+}
+
+uint64_t CountMinSketch::query(const std::string& item) const {
+    uint64_t h = hashItem(item);
+    uint64_t estimate = UINT64_MAX;
+
+    for (size_t row = 0; row < depth_; row++) {
+        estimate = std::min(estimate, counters_[row * width_ + column(h, row, width_)]);
+    }
+    return estimate;
+}
+
+bool CountMinSketch::merge(const CountMinSketch& other, uint64_t weight) {
+    if (other.width_ != width_ || other.depth_ != depth_) return false;
+
+    const uint64_t* src = other.counters_.data();
+    uint64_t* dst = counters_.data();
+    for (size_t i = 0; i < counters_.size(); i++) {
+        dst[i] = saturatingAdd(dst[i], saturatingMul(weight, src[i]));
+    }
+
+    total_ = saturatingAdd(total_, saturatingMul(weight, other.total_));
+    return true;
+}
+
+// ========== TOP-K (HEAVYKEEPER) ==========
+
+TopKSketch::TopKSketch(size_t k, size_t width, size_t depth, double decay)
+    : k_(std::max<size_t>(1, k)) {
+    double log_k = std::log(std::max<double>(2.0, static_cast<double>(k_)));
+    width_ = width > 0 ? width : std::max<size_t>(8, static_cast<size_t>(k_ * log_k));
+    depth_ = depth > 0 ? depth : std::max<size_t>(5, static_cast<size_t>(std::ceil(log_k)));
+
+    fingerprints_.assign(width_ * depth_, 0);
+    counts_.assign(width_ * depth_, 0);
+
+    decay_table_.resize(kDecayTable);
+    for (size_t c = 0; c < kDecayTable; c++) decay_table_[c] = std::pow(decay, static_cast<double>(c));
+
+    heap_fp_.reserve(k_);
+    heap_count_.reserve(k_);
+    heap_item_.reserve(k_);
+}
+
+size_t TopKSketch::findInHeap(uint32_t fp, const std::string& item) const {
+    for (size_t i = 0; i < heap_fp_.size(); i++) {
+        if (heap_fp_[i] == fp && heap_item_[i] == item) return i;
+    }
+    return heap_fp_.size();
+}
+
+size_t TopKSketch::heapMin() const {
+    return static_cast<size_t>(std::min_element(heap_count_.begin(), heap_count_.end()) - heap_count_.begin());
+}
+
+std::optional<std::string> TopKSketch::incrBy(const std::string& item, uint32_t increment) {
+    if (increment == 0) return std::nullopt;
+
+    uint64_t h = hashItem(item);
+    auto fp = static_cast<uint32_t>(mix(h) >> 32);
+    uint32_t estimate = 0;
+
+    for (size_t row = 0; row < depth_; row++) {
+        size_t pos = row * width_ + column(h, row, width_);
+        uint32_t& count = counts_[pos];
+        uint32_t& owner = fingerprints_[pos];
+
+        if (count == 0) {
+            owner = fp;
+            count = increment;
+        } else if (owner == fp) {
+            count = count > UINT32_MAX - increment ? UINT32_MAX : count + increment;
+        } else {
+            // Collision: each unit decays the incumbent with probability decay^count
+            for (uint32_t left = increment; left > 0; left--) {
+                double chance = count < kDecayTable ? decay_table_[count] : 0.0;
+                if (chance == 0.0) break;
+
+                rng_ ^= rng_ << 13;
+                rng_ ^= rng_ >> 7;
+                rng_ ^= rng_ << 17;
+                if (static_cast<double>(rng_ >> 11) * 0x1.0p-53 < chance && --count == 0) {
+                    owner = fp;
+                    count = left;
+                    break;
+                }
+            }
+            if (owner != fp) continue;
+        }
+        estimate = std::max(estimate, count);
+    }
+
+    if (estimate == 0) return std::nullopt;
+
+    size_t index = findInHeap(fp, item);
+    if (index < heap_fp_.size()) {
+        heap_count_[index] = std::max(heap_count_[index], estimate);
+        return std::nullopt;
+    }
+
+    if (heap_fp_.size() < k_) {
+        heap_fp_.push_back(fp);
+        heap_count_.push_back(estimate);
+        heap_item_.push_back(item);
+        return std::nullopt;
+    }
+
+    size_t min = heapMin();
+    if (estimate <= heap_count_[min]) return std::nullopt;
+
+    std::string expelled = std::move(heap_item_[min]);
+    heap_fp_[min] = fp;
+    heap_count_[min] = estimate;
+    heap_item_[min] = item;
+    return expelled;
+}
+
+bool TopKSketch::contains(const std::string& item) const {
+    auto fp = static_cast<uint32_t>(mix(hashItem(item)) >> 32);
+    return findInHeap(fp, item) < heap_fp_.size();
+}
+
+uint32_t TopKSketch::count(const std::string& item) const {
+    uint64_t h = hashItem(item);
+    auto fp = static_cast<uint32_t>(mix(h) >> 32);
+    uint32_t estimate = 0;
+
+    for (size_t row = 0; row < depth_; row++) {
+        size_t pos = row * width_ + column(h, row, width_);
+        if (fingerprints_[pos] == fp) estimate = std::max(estimate, counts_[pos]);
+    }
+    return estimate;
+}
+
+std::vector<std::pair<std::string, uint32_t>> TopKSketch::list() const {
+    std::vector<std::pair<std::string, uint32_t>> result;
+    result.reserve(heap_item_.size());
+    for (size_t i = 0; i < heap_item_.size(); i++) result.emplace_back(heap_item_[i], heap_count_[i]);
+
+    std::sort(result.begin(), result.end(), [](const auto& a, const auto& b) {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    });
+    return result;
+}
+
+void TopKSketch::merge(const TopKSketch& other) {
+    for (const auto& [item, count] : other.list()) incrBy(item, count);
+}
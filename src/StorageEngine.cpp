@@ -1,17 +1,226 @@
 #include "../include/StorageEngine.h"
 #include <algorithm>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <unordered_set>
+#include <utility>
+
+StorageEngine::StorageEngine(const StorageOptions& options)
+    : huge_pages_(options.huge_pages != HugePageMode::OFF || options.numa_node >= 0
+                      ? std::make_unique<HugePageResource>(options.huge_pages, options.numa_node)
+                      : nullptr),
+      // Pool recycles freed nodes; the arena only hands out 2 MB regions
+      pool_(huge_pages_
+                ? std::make_unique<std::pmr::unsynchronized_pool_resource>(huge_pages_.get())
+                : nullptr),
+      store_(pool_ ? pool_.get() : std::pmr::get_default_resource()) {}
 
 // ========== HELPER FUNCTIONS ==========
 
-bool StorageEngine::isExpired(const std::string& key) {
+bool StorageEngine::isExpiredForRead(const std::string& key) {
     auto it = store_.find(key);
-    if (it == store_.end()) return false;
+    bool live = it != store_.end() && !it->second.isExpired();
     
-    if (it->second.isExpired()) {
-        store_.erase(it);  // Lazy deletion: remove on access
-        return true;
+    // Every command looks its keys up here: LRU clock + hit/miss, and
+    // reads (writers run inside an Accounted guard) are tracked
+    bool read = mutation_depth_ == 0;
+    if (!quotas_.empty()) quotas_.touch(key, live, read);
+    if (read && tracking_ && tracking_->enabled()) tracking_->keyRead(key);
+    
+    return it != store_.end() && !live;
+}
+
+bool StorageEngine::isExpired(const std::string& key) {
+    if (!isExpiredForRead(key)) return false;
+    
+    reclaimExpired(store_.find(key));  // Lazy deletion: remove on access
+    return true;
+}
+
+// Roughly how many allocations destroying the value frees. Types built
+// on a few big buffers count one per kFreeEffortBytes: releasing those
+// costs page unmapping in proportion to their size
+static constexpr size_t kFreeEffortBytes = 4096;
+
+static size_t freeEffort(const RedisValue& value) {
+    size_t effort = value.field_expiry ? value.field_expiry->deadlines.size() : 0;
+    return effort + std::visit([](const auto& data) -> size_t {
+        using T = std::decay_t<decltype(data)>;
+        if constexpr (std::is_same_v<T, RedisList>) return data.chunkCount();
+        else if constexpr (std::is_same_v<T, RedisSet> || std::is_same_v<T, RedisHash> ||
+                           std::is_same_v<T, RedisGeo> || std::is_same_v<T, RedisVectorSet>) return data.size();
+        else if constexpr (std::is_same_v<T, RedisStream>) return data.length() / RedisStream::kBlockEntries + 1;
+        else if constexpr (std::is_same_v<T, RedisJson>) return data.nodes();
+        else if constexpr (std::is_same_v<T, RedisTimeSeries>) return data.chunkCount() + 1;
+        else if constexpr (std::is_same_v<T, RedisBloom> || std::is_same_v<T, RedisCuckoo>) {
+            return data.bytes() / kFreeEffortBytes + 1;
+        } else if constexpr (std::is_same_v<T, RedisCountMin>) {
+            return data.width() * data.depth() * sizeof(uint64_t) / kFreeEffortBytes + 1;
+        } else if constexpr (std::is_same_v<T, RedisTopK>) {
+            return data.width() * data.depth() * 2 * sizeof(uint32_t) / kFreeEffortBytes + data.k() + 1;
+        } else return 1;
+    }, value.view());
+}
+
+// Approximate bytes held by key + value, like MEMORY USAGE: collections
+// are sized from a few sampled elements, so this is O(1) for any size
+static size_t memoryUsage(const std::string& key, const RedisValue& value) {
+    constexpr size_t kSamples = 5;
+    constexpr size_t kNodeOverhead = 64;  // Table node, hash, allocator headers
+    
+    // Mean length of up to kSamples elements spread over [0, n)
+    auto sampled = [](size_t n, auto&& lengthAt) -> size_t {
+        if (n == 0) return 0;
+        size_t step = std::max<size_t>(1, n / kSamples), total = 0, taken = 0;
+        for (size_t i = 0; i < n && taken < kSamples; i += step, taken++) total += lengthAt(i);
+        return total / taken;
+    };
+    
+    size_t bytes = kNodeOverhead + key.size() + sizeof(RedisValue);
+    if (value.field_expiry) bytes += value.field_expiry->deadlines.size() * (kNodeOverhead + sizeof(TimePoint));
+    
+    return bytes + std::visit([&](const auto& data) -> size_t {
+        using T = std::decay_t<decltype(data)>;
+        if constexpr (std::is_same_v<T, RedisString>) {
+            return data.capacity();
+        } else if constexpr (std::is_same_v<T, RedisList>) {
+            size_t avg = sampled(data.size(), [&](size_t i) { return data.at(i).size(); });
+            return data.size() * (avg + sizeof(uint32_t)) + data.chunkCount() * kNodeOverhead;
+        } else if constexpr (std::is_same_v<T, RedisSet>) {
+            size_t avg = sampled(data.size(), [&](size_t i) { return data.at(i).size(); });
+            return data.size() * (avg + sizeof(std::string) + 16);  // + hash and slot
+        } else if constexpr (std::is_same_v<T, RedisHash>) {
+            size_t avg = sampled(data.size(), [&](size_t i) {
+                return data.at(i).first.size() + data.at(i).second.size();
+            });
+            return data.size() * (avg + 2 * sizeof(std::string) + 16);
+        } else if constexpr (std::is_same_v<T, RedisStream>) {
+            return data.length() * kNodeOverhead + data.groupCount() * kNodeOverhead;
+        } else if constexpr (std::is_same_v<T, RedisGeo>) {
+            return data.size() * (kNodeOverhead + sizeof(double));
+        } else if constexpr (std::is_same_v<T, RedisBloom> || std::is_same_v<T, RedisCuckoo>) {
+            return data.bytes();
+        } else if constexpr (std::is_same_v<T, RedisCountMin>) {
+            return data.width() * data.depth() * sizeof(uint64_t);
+        } else if constexpr (std::is_same_v<T, RedisTopK>) {
+            return data.width() * data.depth() * 2 * sizeof(uint32_t) + data.k() * kNodeOverhead;
+        } else if constexpr (std::is_same_v<T, RedisTDigest>) {
+            return (data.centroids() + static_cast<size_t>(data.compression())) * 2 * sizeof(double);
+        } else if constexpr (std::is_same_v<T, RedisTimeSeries>) {
+            return data.bytes() + data.chunkCount() * kNodeOverhead;  // Gorilla: ~1-2 bytes per sample
+        } else if constexpr (std::is_same_v<T, RedisJson>) {
+            return data.bytes();
+        } else {
+            size_t per_dim = data.quant() == VectorQuant::FP32 ? sizeof(float) : sizeof(int8_t);
+            return data.size() * (data.dim() * per_dim + 2 * RedisVectorSet::kDefaultM * sizeof(uint32_t) +
+                                  kNodeOverhead);
+        }
+    }, value.view());
+}
+
+// Same cutoff as Redis' LAZYFREE_THRESHOLD
+static constexpr size_t kLazyFreeThreshold = 64;
+
+void StorageEngine::dispose(RedisValue value) {
+    if (freeEffort(value) > kLazyFreeThreshold) lazy_free_.release(std::move(value));
+}
+
+StorageEngine::Accounted::Accounted(StorageEngine& engine, const std::string& key)
+    : engine_(engine), key_(key),
+      active_(!engine.quotas_.empty() || (engine.tracking_ && engine.tracking_->enabled())) {
+    if (active_) engine_.mutation_depth_++;
+}
+
+StorageEngine::Accounted::~Accounted() {
+    if (!active_) return;
+    if (changed_) engine_.keyChanged(key_);
+    if (--engine_.mutation_depth_ == 0) engine_.enforceQuotas();
+}
+
+void StorageEngine::keyChanged(const std::string& key) {
+    if (tracking_) tracking_->keyModified(key);
+    if (quotas_.empty()) return;
+    
+    if (auto* ns = quotas_.owner(key)) {
+        auto it = store_.find(key);
+        quotas_.charge(*ns, key, it == store_.end() ? 0 : memoryUsage(key, it->second));
     }
-    return false;
+}
+
+void StorageEngine::keyRemoved(const std::string& key) {
+    if (tracking_) tracking_->keyModified(key);
+    if (quotas_.empty()) return;
+    
+    if (auto* ns = quotas_.owner(key)) quotas_.charge(*ns, key, 0);
+}
+
+void StorageEngine::enforceQuotas() {
+    quotas_.forEach([this](QuotaTable::Namespace& ns) {
+        while (ns.overBudget()) {
+            const std::string* victim = quotas_.victim(ns);
+            if (!victim) break;
+            
+            std::string key = *victim;  // The ledger entry goes first
+            quotas_.charge(ns, key, 0);
+            if (tracking_) tracking_->keyModified(key);
+            auto it = store_.find(key);
+            if (it != store_.end()) {
+                unindex(key, it->second);
+                RedisValue value = std::move(it->second);
+                store_.erase(it);
+                dispose(std::move(value));
+            }
+            ns.evictions++;
+        }
+    });
+}
+
+void StorageEngine::recount() {
+    quotas_.clearCharges();
+    if (quotas_.empty()) return;
+    for (const auto& [key, value] : store_) {
+        if (auto* ns = quotas_.owner(key)) quotas_.charge(*ns, key, memoryUsage(key, value));
+    }
+}
+
+void StorageEngine::unindex(const std::string& key, const RedisValue& value) {
+    if (indexes_.empty() || value.getType() != ValueType::HASH) return;
+    indexes_.hashRemoved(key, std::get<RedisHash>(value.view()));
+}
+
+// Field whose TTL has passed but that no writer has purged yet. Readers
+// run under the shared lock, so they skip such fields instead of erasing
+static bool fieldDue(const RedisValue& value, size_t index, std::chrono::system_clock::time_point now) {
+    const auto& fe = value.field_expiry;
+    if (!fe || fe->earliest > now) return false;
+    auto dit = fe->deadlines.find(static_cast<uint32_t>(index));
+    return dit != fe->deadlines.end() && dit->second <= now;
+}
+
+// Fields of a hash still live at `now`
+static size_t liveFieldCount(const RedisValue& value, std::chrono::system_clock::time_point now) {
+    const auto& hash = std::get<RedisHash>(value.view());
+    const auto& fe = value.field_expiry;
+    if (!fe || fe->earliest > now) return hash.size();
+    
+    // Deadlines only ever name live positions
+    size_t due = 0;
+    for (const auto& [index, deadline] : fe->deadlines) {
+        if (deadline <= now) due++;
+    }
+    return hash.size() - due;
+}
+
+const std::string* StorageEngine::liveHashField(const std::string& key, const std::string& field) const {
+    auto it = store_.find(key);
+    if (it == store_.end() || it->second.isExpired() || it->second.getType() != ValueType::HASH) return nullptr;
+    
+    const auto& hash = std::get<RedisHash>(it->second.view());
+    auto field_it = hash.find(field);
+    if (field_it == hash.end() ||
+        fieldDue(it->second, field_it - hash.begin(), std::chrono::system_clock::now())) return nullptr;
+    return &field_it->second;
 }
 
 bool StorageEngine::validateType(const std::string& key, ValueType expected) const {
@@ -20,20 +229,113 @@ bool StorageEngine::validateType(const std::string& key, ValueType expected) con
     return it->second.getType() == expected;
 }
 
+bool StorageEngine::purgeExpiredFields(KeySpace::iterator it) {
+    auto& fe = it->second.field_expiry;
+    if (!fe) return false;
+    
+    auto now = std::chrono::system_clock::now();
+    if (fe->earliest > now) return false;  // O(1) fast path: nothing due yet
+    
+    auto& hash = std::get<RedisHash>(it->second.own());
+    std::vector<uint32_t> due;
+    for (const auto& [index, deadline] : fe->deadlines) {
+        if (deadline <= now) due.push_back(index);
+    }
+    
+    // Highest position first: each swap-remove then pulls in a field
+    // that is not due, so the remaining positions stay valid
+    std::sort(due.begin(), due.end(), std::greater<uint32_t>());
+    for (uint32_t index : due) eraseHashField(it, hash, index);
+    
+    if (fe->deadlines.empty()) {
+        fe.reset();  // Back to zero overhead
+    } else {
+        fe->refresh();
+    }
+    
+    if (hash.empty()) {
+        keyRemoved(it->first);
+        store_.erase(it);
+        return true;
+    }
+    keyChanged(it->first);  // cleanupExpired purges outside any Accounted guard
+    return false;
+}
+
 // ========== STRING OPERATIONS ==========
 
 bool StorageEngine::set(const std::string& key, const std::string& value, int ttl) {
-    // Create RedisValue with string data
-    RedisValue redis_val(RedisString(value), ttl);
+    SetOptions options;
+    if (ttl > 0) {
+        options.expiry = SetExpiry::EX;
+        options.expiry_value = ttl;
+    }
+    return set(key, value, options).written;
+}
+
+// Keeps now + TTL (or an absolute time) inside system_clock's range
+static constexpr int64_t kMaxExpiryMs =
+    std::chrono::duration_cast<std::chrono::milliseconds>(TimePoint::duration::max()).count() / 2;
+
+SetResult StorageEngine::set(const std::string& key, const std::string& value, const SetOptions& options) {
+    Accounted accounted(*this, key);
+    SetResult result;
+    
+    // Resolve the TTL first: an invalid one must not touch the key
+    std::optional<TimePoint> expiry;
+    if (options.expiry != SetExpiry::NONE && options.expiry != SetExpiry::KEEPTTL) {
+        bool in_seconds = options.expiry == SetExpiry::EX || options.expiry == SetExpiry::EXAT;
+        int64_t v = options.expiry_value;
+        if (v <= 0 || v > (in_seconds ? kMaxExpiryMs / 1000 : kMaxExpiryMs)) return accounted.unchanged(result);
+        
+        std::chrono::milliseconds ms(in_seconds ? v * 1000 : v);
+        bool relative = options.expiry == SetExpiry::EX || options.expiry == SetExpiry::PX;
+        expiry = relative ? std::chrono::system_clock::now() + ms : TimePoint(ms);
+    }
     
-    // Insert or update
-    store_[key] = std::move(redis_val);
-    return true;
+    // One probe: finds the key, or inserts an empty string slot for it
+    auto [it, inserted] = store_.try_emplace(key);
+    bool live = !inserted && !it->second.isExpired();
+    
+    // An expired leftover is erased or overwritten below either way;
+    // count it like isExpired() does
+    if (!inserted && !live) expired_keys_.fetch_add(1, std::memory_order_relaxed);
+    
+    // Like Redis: GET on a non-string is an error and nothing is written
+    if (live && options.get && it->second.getType() != ValueType::STRING) return accounted.unchanged(result);
+    
+    bool blocked = (options.condition == SetCondition::NX && live) ||
+                   (options.condition == SetCondition::XX && !live);
+    if (blocked) {
+        if (live) {
+            if (options.get) result.old_value = std::get<RedisString>(it->second.view());
+            return accounted.unchanged(result);
+        }
+        if (!inserted) unindex(key, it->second);
+        store_.erase(it);  // Placeholder or expired leftover
+        return inserted ? accounted.unchanged(result) : result;
+    }
+    
+    if (options.expiry == SetExpiry::KEEPTTL && live) expiry = it->second.expiry;
+    if (!inserted) unindex(key, it->second);
+    
+    // Overwriting an owned string reuses its buffer; the old value moves out for GET
+    if (it->second.getType() == ValueType::STRING && !it->second.shared) {
+        auto& str = std::get<RedisString>(it->second.data);
+        if (live && options.get) result.old_value = std::move(str);
+        str.assign(value);
+    } else {
+        if (live && options.get) result.old_value = std::get<RedisString>(it->second.view());
+        dispose(std::exchange(it->second, RedisValue(RedisString(value))));
+    }
+    it->second.expiry = expiry;
+    result.written = true;
+    return result;
 }
 
 std::optional<std::string> StorageEngine::get(const std::string& key) {
     // Check expiration first
-    if (isExpired(key)) return std::nullopt;
+    if (isExpiredForRead(key)) return std::nullopt;
     
     auto it = store_.find(key);
     if (it == store_.end()) return std::nullopt;
@@ -45,70 +347,192 @@ std::optional<std::string> StorageEngine::get(const std::string& key) {
     
     // Extract string from variant
     // std::get<T> - throws if wrong type (we already checked)
-    return std::get<RedisString>(it->second.data);
+    return std::get<RedisString>(it->second.view());
+}
+
+RedisString* StorageEngine::findString(const std::string& key) {
+    if (isExpired(key)) return nullptr;
+    
+    auto it = store_.find(key);
+    if (it == store_.end() || it->second.getType() != ValueType::STRING) return nullptr;
+    return &std::get<RedisString>(it->second.own());
+}
+
+// Same cap as Redis' proto-max-bulk-len default
+static constexpr size_t kMaxStringBytes = 512 * 1024 * 1024;
+
+size_t StorageEngine::append(const std::string& key, const std::string& value) {
+    Accounted accounted(*this, key);
+    isExpired(key);
+    
+    auto it = store_.find(key);
+    if (it == store_.end()) {
+        if (value.size() > kMaxStringBytes) return accounted.unchanged(0);
+        store_.emplace(key, RedisValue(RedisString(value)));
+        return value.size();
+    }
+    if (it->second.getType() != ValueType::STRING) return accounted.unchanged(0);
+    
+    // std::string grows its capacity geometrically: amortized O(len(value))
+    auto& str = std::get<RedisString>(it->second.own());
+    if (str.size() + value.size() > kMaxStringBytes) return accounted.unchanged(0);
+    str.append(value);
+    return str.size();
+}
+
+size_t StorageEngine::setrange(const std::string& key, size_t offset, const std::string& value) {
+    Accounted accounted(*this, key);
+    if (offset > kMaxStringBytes || value.size() > kMaxStringBytes - offset) return accounted.unchanged(0);
+    isExpired(key);
+    
+    auto it = store_.find(key);
+    if (it == store_.end()) {
+        if (value.empty()) return accounted.unchanged(0);  // Like Redis: no key is created
+        it = store_.emplace(key, RedisValue(RedisString())).first;
+    } else if (it->second.getType() != ValueType::STRING) {
+        return accounted.unchanged(0);
+    }
+    
+    auto& str = std::get<RedisString>(it->second.own());
+    if (value.empty()) return accounted.unchanged(str.size());
+    if (str.size() < offset + value.size()) str.resize(offset + value.size(), '\0');
+    str.replace(offset, value.size(), value);
+    return str.size();
+}
+
+std::string_view StorageEngine::getrange(const std::string& key, long start, long end) {
+    const auto* str = peek<RedisString>(key);
+    if (!str || str->empty()) return {};
+    
+    auto len = static_cast<long>(str->size());
+    if (start < 0) start = std::max(0L, start + len);
+    if (end < 0) end = std::max(0L, end + len);
+    end = std::min(end, len - 1);
+    if (start > end) return {};
+    
+    return std::string_view(*str).substr(static_cast<size_t>(start), static_cast<size_t>(end - start + 1));
+}
+
+size_t StorageEngine::strlen(const std::string& key) {
+    const auto* str = peek<RedisString>(key);
+    return str ? str->size() : 0;
+}
+
+std::optional<std::string> StorageEngine::getex(const std::string& key, int ttl, bool persist) {
+    Accounted accounted(*this, key);
+    if (isExpired(key)) return accounted.unchanged(std::nullopt);
+    
+    auto it = store_.find(key);
+    if (it == store_.end() || it->second.getType() != ValueType::STRING) return accounted.unchanged(std::nullopt);
+    
+    if (ttl > 0) {
+        it->second.expiry = std::chrono::system_clock::now() + std::chrono::seconds(ttl);
+    } else if (persist && it->second.expiry) {
+        it->second.expiry.reset();
+    } else {
+        accounted.unchanged();  // Plain GETEX is a read
+    }
+    return std::get<RedisString>(it->second.view());
+}
+
+std::optional<std::string> StorageEngine::getdel(const std::string& key) {
+    Accounted accounted(*this, key);
+    if (isExpired(key)) return accounted.unchanged(std::nullopt);
+    
+    auto it = store_.find(key);
+    if (it == store_.end() || it->second.getType() != ValueType::STRING) return accounted.unchanged(std::nullopt);
+    
+    std::string value = std::move(std::get<RedisString>(it->second.own()));
+    store_.erase(it);
+    return value;
 }
 
 // ========== LIST OPERATIONS ==========
 
+RedisList* StorageEngine::findList(const std::string& key) {
+    if (isExpired(key)) return nullptr;
+    
+    auto it = store_.find(key);
+    if (it == store_.end() || it->second.getType() != ValueType::LIST) return nullptr;
+    return &std::get<RedisList>(it->second.own());
+}
+
+// Negative index counts from the tail; nullopt if out of range
+static std::optional<size_t> listIndex(int index, size_t size) {
+    long long i = index < 0 ? static_cast<long long>(size) + index : index;
+    if (i < 0 || i >= static_cast<long long>(size)) return std::nullopt;
+    return static_cast<size_t>(i);
+}
+
 size_t StorageEngine::lpush(const std::string& key, const std::vector<std::string>& values) {
-    if (isExpired(key)) store_.erase(key);
+    Accounted accounted(*this, key);
+    isExpired(key);
     
     auto it = store_.find(key);
     
     if (it == store_.end()) {
-        // Create new list
-        RedisList list(values.rbegin(), values.rend());  // Reverse to maintain order
-        store_[key] = RedisValue(list);
-        return list.size();
+        if (values.empty()) return accounted.unchanged(0);
+        
+        // Create new list (each value becomes the new head)
+        RedisList list;
+        for (const auto& value : values) list.pushFront(value);
+        size_t size = list.size();
+        store_.emplace(key, RedisValue(std::move(list)));
+        return size;
     }
     
     // Validate it's a list
-    if (it->second.getType() != ValueType::LIST) return 0;
+    if (it->second.getType() != ValueType::LIST) return accounted.unchanged(0);
     
     // Get reference to the list inside variant
-    auto& list = std::get<RedisList>(it->second.data);
+    auto& list = std::get<RedisList>(it->second.own());
+    if (values.empty()) return accounted.unchanged(list.size());
     
     // Insert at beginning (left)
-    list.insert(list.begin(), values.rbegin(), values.rend());
+    for (const auto& value : values) list.pushFront(value);
     
     return list.size();
 }
 
 size_t StorageEngine::rpush(const std::string& key, const std::vector<std::string>& values) {
-    if (isExpired(key)) store_.erase(key);
+    Accounted accounted(*this, key);
+    isExpired(key);
     
     auto it = store_.find(key);
     
     if (it == store_.end()) {
+        if (values.empty()) return accounted.unchanged(0);
+        
         // Create new list
-        store_[key] = RedisValue(RedisList(values));
+        RedisList list;
+        for (const auto& value : values) list.pushBack(value);
+        store_.emplace(key, RedisValue(std::move(list)));
         return values.size();
     }
     
-    if (it->second.getType() != ValueType::LIST) return 0;
+    if (it->second.getType() != ValueType::LIST) return accounted.unchanged(0);
     
-    auto& list = std::get<RedisList>(it->second.data);
+    auto& list = std::get<RedisList>(it->second.own());
+    if (values.empty()) return accounted.unchanged(list.size());
     
     // Insert at end (right)
-    list.insert(list.end(), values.begin(), values.end());
+    for (const auto& value : values) list.pushBack(value);
     
     return list.size();
 }
 
 std::optional<std::string> StorageEngine::lpop(const std::string& key) {
-    if (isExpired(key)) return std::nullopt;
+    Accounted accounted(*this, key);
+    if (isExpired(key)) return accounted.unchanged(std::nullopt);
     
     auto it = store_.find(key);
     if (it == store_.end() || it->second.getType() != ValueType::LIST) {
-        return std::nullopt;
+        return accounted.unchanged(std::nullopt);
     }
     
-    auto& list = std::get<RedisList>(it->second.data);
-    if (list.empty()) return std::nullopt;
-    
     // Pop from left (front)
-    std::string value = list.front();
-    list.erase(list.begin());
+    auto& list = std::get<RedisList>(it->second.own());
+    auto value = list.popFront();
     
     // Delete key if list becomes empty
     if (list.empty()) store_.erase(it);
@@ -117,19 +541,17 @@ std::optional<std::string> StorageEngine::lpop(const std::string& key) {
 }
 
 std::optional<std::string> StorageEngine::rpop(const std::string& key) {
-    if (isExpired(key)) return std::nullopt;
+    Accounted accounted(*this, key);
+    if (isExpired(key)) return accounted.unchanged(std::nullopt);
     
     auto it = store_.find(key);
     if (it == store_.end() || it->second.getType() != ValueType::LIST) {
-        return std::nullopt;
+        return accounted.unchanged(std::nullopt);
     }
     
-    auto& list = std::get<RedisList>(it->second.data);
-    if (list.empty()) return std::nullopt;
-    
     // Pop from right (back)
-    std::string value = list.back();
-    list.pop_back();
+    auto& list = std::get<RedisList>(it->second.own());
+    auto value = list.popBack();
     
     if (list.empty()) store_.erase(it);
     
@@ -137,14 +559,14 @@ std::optional<std::string> StorageEngine::rpop(const std::string& key) {
 }
 
 std::vector<std::string> StorageEngine::lrange(const std::string& key, int start, int stop) {
-    if (isExpired(key)) return {};
+    if (isExpiredForRead(key)) return {};
     
     auto it = store_.find(key);
     if (it == store_.end() || it->second.getType() != ValueType::LIST) {
         return {};
     }
     
-    const auto& list = std::get<RedisList>(it->second.data);
+    const auto& list = std::get<RedisList>(it->second.view());
     int size = static_cast<int>(list.size());
     
     // Handle negative indices (Python-style: -1 is last element)
@@ -158,35 +580,149 @@ std::vector<std::string> StorageEngine::lrange(const std::string& key, int start
     if (start > stop) return {};
     
     // Extract range
-    return std::vector<std::string>(list.begin() + start, list.begin() + stop + 1);
+    return list.range(start, stop);
 }
 
 size_t StorageEngine::llen(const std::string& key) {
-    if (isExpired(key)) return 0;
+    const auto* list = peek<RedisList>(key);
+    return list ? list->size() : 0;
+}
+
+std::optional<std::string> StorageEngine::lindex(const std::string& key, int index) {
+    const auto* list = peek<RedisList>(key);
+    if (!list) return std::nullopt;
+    
+    auto i = listIndex(index, list->size());
+    if (!i) return std::nullopt;
+    return list->at(*i);
+}
+
+bool StorageEngine::lset(const std::string& key, int index, const std::string& value) {
+    Accounted accounted(*this, key);
+    auto* list = findList(key);
+    if (!list) return accounted.unchanged(false);
+    
+    auto i = listIndex(index, list->size());
+    if (!i) return accounted.unchanged(false);
+    list->set(*i, value);
+    return true;
+}
+
+long StorageEngine::linsert(const std::string& key, ListInsert where, const std::string& pivot,
+                            const std::string& value) {
+    Accounted accounted(*this, key);
+    auto* list = findList(key);
+    if (!list) return accounted.unchanged(0);
+    
+    auto at = list->find(pivot);
+    if (!at) return accounted.unchanged(-1);
+    
+    list->insert(where == ListInsert::BEFORE ? *at : *at + 1, value);
+    return static_cast<long>(list->size());
+}
+
+bool StorageEngine::ltrim(const std::string& key, int start, int stop) {
+    Accounted accounted(*this, key);
+    if (isExpired(key)) return accounted.unchanged(true);
+    
+    auto it = store_.find(key);
+    if (it == store_.end()) return accounted.unchanged(true);
+    if (it->second.getType() != ValueType::LIST) return accounted.unchanged(false);
+    
+    auto& list = std::get<RedisList>(it->second.own());
+    long long size = static_cast<long long>(list.size());
+    long long from = start < 0 ? std::max(0LL, size + start) : start;
+    long long to = stop < 0 ? size + stop : std::min<long long>(stop, size - 1);
+    
+    if (from > to || from >= size) {
+        store_.erase(it);  // Nothing left
+        return true;
+    }
+    if (from == 0 && to >= size - 1) return accounted.unchanged(true);  // Keeps everything
+    list.trim(static_cast<size_t>(from), static_cast<size_t>(to));
+    return true;
+}
+
+size_t StorageEngine::lrem(const std::string& key, int count, const std::string& value) {
+    Accounted accounted(*this, key);
+    if (isExpired(key)) return accounted.unchanged(0);
     
     auto it = store_.find(key);
-    if (it == store_.end() || it->second.getType() != ValueType::LIST) return 0;
+    if (it == store_.end() || it->second.getType() != ValueType::LIST) return accounted.unchanged(0);
+    
+    auto& list = std::get<RedisList>(it->second.own());
+    size_t removed = list.remove(value, count);
+    if (removed == 0) return accounted.unchanged(0);
+    if (list.empty()) store_.erase(it);
+    
+    return removed;
+}
+
+std::vector<size_t> StorageEngine::lpos(const std::string& key, const std::string& value, int rank,
+                                        size_t count, size_t maxlen) {
+    const auto* list = peek<RedisList>(key);
+    if (!list || rank == 0) return {};
+    return list->positions(value, rank, count, maxlen);
+}
+
+std::optional<std::string> StorageEngine::lmove(const std::string& source, const std::string& destination,
+                                                ListEnd from, ListEnd to) {
+    Accounted accounted_source(*this, source);
+    Accounted accounted_destination(*this, destination);
+    isExpired(destination);
+    
+    // Type-check the destination before anything is popped
+    auto dest_it = store_.find(destination);
+    if (dest_it != store_.end() && dest_it->second.getType() != ValueType::LIST) {
+        accounted_source.unchanged();
+        return accounted_destination.unchanged(std::nullopt);
+    }
+    
+    auto* list = findList(source);
+    if (!list) {
+        accounted_source.unchanged();
+        return accounted_destination.unchanged(std::nullopt);
+    }
+    
+    auto value = from == ListEnd::LEFT ? list->popFront() : list->popBack();
+    if (source != destination && list->empty()) store_.erase(source);
+    
+    // Same key: rotation (the list can't have emptied, the value goes back)
+    auto it = store_.find(destination);
+    if (it == store_.end()) it = store_.emplace(destination, RedisValue(RedisList())).first;
     
-    return std::get<RedisList>(it->second.data).size();
+    auto& dest = std::get<RedisList>(it->second.own());
+    if (to == ListEnd::LEFT) {
+        dest.pushFront(*value);
+    } else {
+        dest.pushBack(*value);
+    }
+    return value;
 }
 
 // ========== SET OPERATIONS ==========
 
 size_t StorageEngine::sadd(const std::string& key, const std::vector<std::string>& members) {
-    if (isExpired(key)) store_.erase(key);
+    Accounted accounted(*this, key);
+    isExpired(key);
     
     auto it = store_.find(key);
     
     if (it == store_.end()) {
+        if (members.empty()) return accounted.unchanged(0);
+        
         // Create new set
-        RedisSet new_set(members.begin(), members.end());
-        store_[key] = RedisValue(new_set);
-        return new_set.size();
+        RedisSet new_set;
+        new_set.reserve(members.size());
+        for (const auto& member : members) new_set.insert(member);
+        size_t added = new_set.size();
+        store_[key] = RedisValue(std::move(new_set));
+        return added;
     }
     
-    if (it->second.getType() != ValueType::SET) return 0;
+    if (it->second.getType() != ValueType::SET) return accounted.unchanged(0);
     
-    auto& set = std::get<RedisSet>(it->second.data);
+    auto& set = std::get<RedisSet>(it->second.own());
     size_t added = 0;
     
     for (const auto& member : members) {
@@ -195,188 +731,1394 @@ size_t StorageEngine::sadd(const std::string& key, const std::vector<std::string
         }
     }
     
-    return added;
+    return added == 0 ? accounted.unchanged(0) : added;
 }
 
 size_t StorageEngine::srem(const std::string& key, const std::vector<std::string>& members) {
-    if (isExpired(key)) return 0;
+    Accounted accounted(*this, key);
+    if (isExpired(key)) return accounted.unchanged(0);
     
     auto it = store_.find(key);
-    if (it == store_.end() || it->second.getType() != ValueType::SET) return 0;
+    if (it == store_.end() || it->second.getType() != ValueType::SET) return accounted.unchanged(0);
     
-    auto& set = std::get<RedisSet>(it->second.data);
+    auto& set = std::get<RedisSet>(it->second.own());
     size_t removed = 0;
     
     for (const auto& member : members) {
         removed += set.erase(member);  // erase returns number removed (0 or 1)
     }
     
+    if (removed == 0) return accounted.unchanged(0);
     if (set.empty()) store_.erase(it);
     
     return removed;
 }
 
 bool StorageEngine::sismember(const std::string& key, const std::string& member) {
-    if (isExpired(key)) return false;
+    if (isExpiredForRead(key)) return false;
     
     auto it = store_.find(key);
     if (it == store_.end() || it->second.getType() != ValueType::SET) return false;
     
-    const auto& set = std::get<RedisSet>(it->second.data);
+    const auto& set = std::get<RedisSet>(it->second.view());
     return set.find(member) != set.end();
 }
 
 std::vector<std::string> StorageEngine::smembers(const std::string& key) {
-    if (isExpired(key)) return {};
+    if (isExpiredForRead(key)) return {};
     
     auto it = store_.find(key);
     if (it == store_.end() || it->second.getType() != ValueType::SET) return {};
     
-    const auto& set = std::get<RedisSet>(it->second.data);
+    const auto& set = std::get<RedisSet>(it->second.view());
     return std::vector<std::string>(set.begin(), set.end());
 }
 
 size_t StorageEngine::scard(const std::string& key) {
-    if (isExpired(key)) return 0;
+    if (isExpiredForRead(key)) return 0;
     
     auto it = store_.find(key);
     if (it == store_.end() || it->second.getType() != ValueType::SET) return 0;
     
-    return std::get<RedisSet>(it->second.data).size();
+    return std::get<RedisSet>(it->second.view()).size();
+}
+
+std::vector<bool> StorageEngine::smismember(const std::string& key, const std::vector<std::string>& members) {
+    std::vector<bool> result(members.size(), false);
+    if (isExpiredForRead(key)) return result;
+    
+    auto it = store_.find(key);
+    if (it == store_.end() || it->second.getType() != ValueType::SET) return result;
+    
+    const auto& set = std::get<RedisSet>(it->second.view());
+    for (size_t i = 0; i < members.size(); i++) result[i] = set.count(members[i]) > 0;
+    return result;
+}
+
+// Per-thread generator: sampling under a shared lock needs no extra sync
+static std::mt19937_64& randomEngine() {
+    thread_local std::mt19937_64 rng(std::random_device{}());
+    return rng;
+}
+
+// Dense positions for SRANDMEMBER / HRANDFIELD count semantics
+static std::vector<size_t> sampleIndices(size_t size, long count) {
+    std::vector<size_t> picked;
+    if (size == 0 || count == 0) return picked;
+    
+    auto& rng = randomEngine();
+    std::uniform_int_distribution<size_t> any(0, size - 1);
+    
+    // Negative count: independent draws, repeats allowed
+    if (count < 0) {
+        picked.resize(static_cast<size_t>(-count));
+        for (auto& index : picked) index = any(rng);
+        return picked;
+    }
+    
+    size_t n = std::min(size, static_cast<size_t>(count));
+    
+    // Few picks: rejection sampling (expected < 4/3 draws per pick)
+    if (n * 4 < size) {
+        std::unordered_set<size_t> seen;
+        while (picked.size() < n) {
+            size_t index = any(rng);
+            if (seen.insert(index).second) picked.push_back(index);
+        }
+        return picked;
+    }
+    
+    // Many picks: partial Fisher-Yates over all positions
+    picked.resize(size);
+    std::iota(picked.begin(), picked.end(), 0);
+    for (size_t i = 0; i < n; i++) {
+        std::uniform_int_distribution<size_t> rest(i, size - 1);
+        std::swap(picked[i], picked[rest(rng)]);
+    }
+    picked.resize(n);
+    return picked;
+}
+
+std::vector<std::string> StorageEngine::srandmember(const std::string& key, long count) {
+    if (isExpiredForRead(key)) return {};
+    
+    auto it = store_.find(key);
+    if (it == store_.end() || it->second.getType() != ValueType::SET) return {};
+    
+    const auto& set = std::get<RedisSet>(it->second.view());
+    std::vector<std::string> result;
+    for (size_t index : sampleIndices(set.size(), count)) result.push_back(set.at(index));
+    return result;
+}
+
+std::vector<std::string> StorageEngine::spop(const std::string& key, size_t count) {
+    Accounted accounted(*this, key);
+    if (isExpired(key)) return accounted.unchanged(std::vector<std::string>());
+    
+    auto it = store_.find(key);
+    if (it == store_.end() || it->second.getType() != ValueType::SET || count == 0) {
+        return accounted.unchanged(std::vector<std::string>());
+    }
+    
+    // Each pop is O(1): random dense position, then swap-remove
+    auto& set = std::get<RedisSet>(it->second.own());
+    std::vector<std::string> result;
+    auto& rng = randomEngine();
+    while (result.size() < count && !set.empty()) {
+        std::uniform_int_distribution<size_t> any(0, set.size() - 1);
+        auto member_it = set.begin() + static_cast<long>(any(rng));
+        result.push_back(std::move(*member_it));
+        set.erase(member_it);
+    }
+    
+    if (set.empty()) store_.erase(it);
+    return result;
 }
 
 // ========== HASH OPERATIONS ==========
 
+bool StorageEngine::writeHashField(KeySpace::iterator it, const std::string& field, const std::string& value) {
+    auto& hash = std::get<RedisHash>(it->second.own());
+    auto [field_it, inserted] = hash.try_emplace(field, value);
+    if (!inserted) {
+        if (!indexes_.empty()) indexes_.fieldChanged(it->first, field, &field_it->second, &value);
+        field_it->second = value;
+    } else if (!indexes_.empty()) {
+        indexes_.fieldChanged(it->first, field, nullptr, &value);
+    }
+    
+    // Like Redis: writing a field clears its TTL (a new field's position
+    // never carries one)
+    auto& fe = it->second.field_expiry;
+    if (!inserted && fe) {
+        fe->deadlines.erase(static_cast<uint32_t>(field_it - hash.begin()));
+        if (fe->deadlines.empty()) fe.reset();
+    }
+    return inserted;
+}
+
+void StorageEngine::eraseHashField(KeySpace::iterator it, RedisHash& hash, size_t index) {
+    auto field_it = hash.begin() + static_cast<long>(index);
+    if (!indexes_.empty()) indexes_.fieldChanged(it->first, field_it->first, &field_it->second, nullptr);
+    
+    size_t last = hash.size() - 1;
+    hash.erase(field_it);
+    if (auto& fe = it->second.field_expiry) fe->erased(index, last);
+}
+
 bool StorageEngine::hset(const std::string& key, const std::string& field, const std::string& value) {
-    if (isExpired(key)) store_.erase(key);
+    Accounted accounted(*this, key);
+    isExpired(key);
     
     auto it = store_.find(key);
     
     if (it == store_.end()) {
         // Create new hash
-        RedisHash hash;
-        hash[field] = value;
-        store_[key] = RedisValue(hash);
-        return true;
+        it = store_.emplace(key, RedisValue(RedisHash())).first;
+    } else if (it->second.getType() != ValueType::HASH) {
+        return accounted.unchanged(false);
     }
     
-    if (it->second.getType() != ValueType::HASH) return false;
-    
-    auto& hash = std::get<RedisHash>(it->second.data);
-    hash[field] = value;
+    writeHashField(it, field, value);
     return true;
 }
 
 std::optional<std::string> StorageEngine::hget(const std::string& key, const std::string& field) {
-    if (isExpired(key)) return std::nullopt;
+    if (isExpiredForRead(key)) return std::nullopt;
     
     auto it = store_.find(key);
     if (it == store_.end() || it->second.getType() != ValueType::HASH) return std::nullopt;
     
-    const auto& hash = std::get<RedisHash>(it->second.data);
+    const auto& hash = std::get<RedisHash>(it->second.view());
     auto field_it = hash.find(field);
     
-    if (field_it == hash.end()) return std::nullopt;
+    if (field_it == hash.end() ||
+        fieldDue(it->second, field_it - hash.begin(), std::chrono::system_clock::now())) return std::nullopt;
     return field_it->second;
 }
 
 size_t StorageEngine::hdel(const std::string& key, const std::vector<std::string>& fields) {
-    if (isExpired(key)) return 0;
+    Accounted accounted(*this, key);
+    if (isExpired(key)) return accounted.unchanged(0);
     
     auto it = store_.find(key);
-    if (it == store_.end() || it->second.getType() != ValueType::HASH) return 0;
+    if (it == store_.end() || it->second.getType() != ValueType::HASH) return accounted.unchanged(0);
+    if (purgeExpiredFields(it)) return accounted.unchanged(0);  // Purging signalled it
     
-    auto& hash = std::get<RedisHash>(it->second.data);
+    auto& hash = std::get<RedisHash>(it->second.own());
     size_t deleted = 0;
     
     for (const auto& field : fields) {
-        deleted += hash.erase(field);
+        auto field_it = hash.find(field);
+        if (field_it == hash.end()) continue;
+        
+        eraseHashField(it, hash, field_it - hash.begin());
+        deleted++;
+    }
+    if (it->second.field_expiry && it->second.field_expiry->deadlines.empty()) {
+        it->second.field_expiry.reset();
     }
     
+    if (deleted == 0) return accounted.unchanged(0);  // A purge above signalled itself
     if (hash.empty()) store_.erase(it);
     
     return deleted;
 }
 
 bool StorageEngine::hexists(const std::string& key, const std::string& field) {
-    if (isExpired(key)) return false;
+    if (isExpiredForRead(key)) return false;
     
     auto it = store_.find(key);
     if (it == store_.end() || it->second.getType() != ValueType::HASH) return false;
     
-    const auto& hash = std::get<RedisHash>(it->second.data);
-    return hash.find(field) != hash.end();
+    const auto& hash = std::get<RedisHash>(it->second.view());
+    auto field_it = hash.find(field);
+    return field_it != hash.end() &&
+           !fieldDue(it->second, field_it - hash.begin(), std::chrono::system_clock::now());
 }
 
 std::unordered_map<std::string, std::string> StorageEngine::hgetall(const std::string& key) {
-    if (isExpired(key)) return {};
+    if (isExpiredForRead(key)) return {};
     
     auto it = store_.find(key);
     if (it == store_.end() || it->second.getType() != ValueType::HASH) return {};
     
-    return std::get<RedisHash>(it->second.data);
+    const auto& hash = std::get<RedisHash>(it->second.view());
+    auto now = std::chrono::system_clock::now();
+    std::unordered_map<std::string, std::string> result;
+    result.reserve(hash.size());
+    for (size_t index = 0; index < hash.size(); index++) {
+        if (!fieldDue(it->second, index, now)) result.emplace(hash.at(index));
+    }
+    return result;
 }
 
 size_t StorageEngine::hlen(const std::string& key) {
-    if (isExpired(key)) return 0;
+    if (isExpiredForRead(key)) return 0;
     
     auto it = store_.find(key);
     if (it == store_.end() || it->second.getType() != ValueType::HASH) return 0;
     
-    return std::get<RedisHash>(it->second.data).size();
-}
-
-// ========== GENERAL OPERATIONS ==========
-
-bool StorageEngine::remove(const std::string& key) {
-    return store_.erase(key) > 0;
-}
-
-bool StorageEngine::exists(const std::string& key) {
-    if (isExpired(key)) return false;
-    return store_.find(key) != store_.end();
+    return liveFieldCount(it->second, std::chrono::system_clock::now());
 }
 
-std::optional<ValueType> StorageEngine::type(const std::string& key) {
-    if (isExpired(key)) return std::nullopt;
+size_t StorageEngine::hset(const std::string& key, const std::vector<std::pair<std::string, std::string>>& fields) {
+    Accounted accounted(*this, key);
+    if (fields.empty()) return accounted.unchanged(0);
+    isExpired(key);
     
     auto it = store_.find(key);
-    if (it == store_.end()) return std::nullopt;
     
-    return it->second.getType();
+    if (it == store_.end()) {
+        RedisHash hash;
+        hash.reserve(fields.size());
+        it = store_.emplace(key, RedisValue(std::move(hash))).first;
+    } else if (it->second.getType() != ValueType::HASH) {
+        return accounted.unchanged(0);
+    }
+    
+    // One keyspace lookup for all fields
+    size_t added = 0;
+    for (const auto& [field, value] : fields) {
+        if (writeHashField(it, field, value)) added++;
+    }
+    return added;
 }
 
-bool StorageEngine::expire(const std::string& key, int seconds) {
-    if (isExpired(key)) return false;
+std::vector<std::optional<std::string>> StorageEngine::hmget(const std::string& key,
+                                                             const std::vector<std::string>& fields) {
+    std::vector<std::optional<std::string>> result(fields.size());
+    if (isExpiredForRead(key)) return result;
     
     auto it = store_.find(key);
-    if (it == store_.end()) return false;
+    if (it == store_.end() || it->second.getType() != ValueType::HASH) return result;
     
-    if (seconds > 0) {
-        it->second.expiry = std::chrono::system_clock::now() + 
-                            std::chrono::seconds(seconds);
-    } else {
-        it->second.expiry = std::nullopt;  // Remove expiry
+    const auto& hash = std::get<RedisHash>(it->second.view());
+    auto now = std::chrono::system_clock::now();
+    for (size_t i = 0; i < fields.size(); i++) {
+        auto field_it = hash.find(fields[i]);
+        if (field_it != hash.end() && !fieldDue(it->second, field_it - hash.begin(), now)) {
+            result[i] = field_it->second;
+        }
     }
-    
-    return true;
+    return result;
 }
 
-int StorageEngine::ttl(const std::string& key) {
-    auto it = store_.find(key);
-    if (it == store_.end()) return -2;  // Key doesn't exist
+std::vector<std::pair<std::string, std::string>> StorageEngine::hrandfield(const std::string& key, long count) {
+    if (isExpiredForRead(key)) return {};
     
-    if (!it->second.expiry.has_value()) return -1;  // No expiry
+    auto it = store_.find(key);
+    if (it == store_.end() || it->second.getType() != ValueType::HASH) return {};
     
+    const auto& hash = std::get<RedisHash>(it->second.view());
+    std::vector<std::pair<std::string, std::string>> result;
     auto now = std::chrono::system_clock::now();
-    auto remaining = it->second.expiry.value() - now;
-    
-    if (remaining.count() <= 0) {
-        store_.erase(it);  // Expired
-        return -2;
+    const auto& fe = it->second.field_expiry;
+    if (!fe || fe->earliest > now) {
+        for (size_t index : sampleIndices(hash.size(), count)) result.push_back(hash.at(index));
+        return result;
     }
     
-    return std::chrono::duration_cast<std::chrono::seconds>(remaining).count();
+    // Some fields are due: sample among the live positions only
+    std::vector<size_t> live;
+    for (size_t index = 0; index < hash.size(); index++) {
+        if (!fieldDue(it->second, index, now)) live.push_back(index);
+    }
+    for (size_t pick : sampleIndices(live.size(), count)) result.push_back(hash.at(live[pick]));
+    return result;
+}
+
+// ========== HASH FIELD EXPIRY ==========
+
+std::vector<int> StorageEngine::hexpire(const std::string& key, int seconds, const std::vector<std::string>& fields) {
+    Accounted accounted(*this, key);
+    std::vector<int> result(fields.size(), -2);
+    if (isExpired(key)) return accounted.unchanged(result);
+    
+    auto it = store_.find(key);
+    if (it == store_.end() || it->second.getType() != ValueType::HASH) return accounted.unchanged(result);
+    if (purgeExpiredFields(it)) return accounted.unchanged(result);
+    
+    auto& hash = std::get<RedisHash>(it->second.own());
+    auto& fe = it->second.field_expiry;
+    auto deadline = std::chrono::system_clock::now() + std::chrono::seconds(seconds);
+    
+    for (size_t i = 0; i < fields.size(); i++) {
+        auto field_it = hash.find(fields[i]);
+        if (field_it == hash.end()) continue;  // -2
+        
+        size_t index = field_it - hash.begin();
+        if (seconds <= 0) {
+            // Expiring "now" deletes the field immediately
+            eraseHashField(it, hash, index);
+            result[i] = 2;
+            continue;
+        }
+        
+        if (!fe) fe = std::make_unique<HashFieldExpiry>();
+        fe->deadlines[static_cast<uint32_t>(index)] = deadline;
+        if (deadline < fe->earliest) fe->earliest = deadline;
+        result[i] = 1;
+    }
+    
+    if (fe) {
+        if (fe->deadlines.empty()) fe.reset();
+        else fe->refresh();
+    }
+    if (hash.empty()) store_.erase(it);
+    
+    // No field matched (a purge above signalled itself)
+    if (std::all_of(result.begin(), result.end(), [](int r) { return r == -2; })) return accounted.unchanged(result);
+    return result;
+}
+
+std::vector<int> StorageEngine::httl(const std::string& key, const std::vector<std::string>& fields) {
+    std::vector<int> result(fields.size(), -2);
+    if (isExpiredForRead(key)) return result;
+    
+    auto it = store_.find(key);
+    if (it == store_.end() || it->second.getType() != ValueType::HASH) return result;
+    
+    const auto& hash = std::get<RedisHash>(it->second.view());
+    const auto& fe = it->second.field_expiry;
+    auto now = std::chrono::system_clock::now();
+    
+    for (size_t i = 0; i < fields.size(); i++) {
+        auto field_it = hash.find(fields[i]);
+        if (field_it == hash.end()) continue;  // -2
+        size_t index = field_it - hash.begin();
+        if (fieldDue(it->second, index, now)) continue;  // -2
+        result[i] = -1;
+        if (!fe) continue;
+        
+        auto dit = fe->deadlines.find(static_cast<uint32_t>(index));
+        if (dit != fe->deadlines.end()) {
+            result[i] = static_cast<int>(
+                std::chrono::duration_cast<std::chrono::seconds>(dit->second - now).count());
+        }
+    }
+    return result;
+}
+
+std::vector<int> StorageEngine::hpersist(const std::string& key, const std::vector<std::string>& fields) {
+    Accounted accounted(*this, key);
+    std::vector<int> result(fields.size(), -2);
+    if (isExpired(key)) return accounted.unchanged(result);
+    
+    auto it = store_.find(key);
+    if (it == store_.end() || it->second.getType() != ValueType::HASH) return accounted.unchanged(result);
+    if (purgeExpiredFields(it)) return accounted.unchanged(result);
+    
+    const auto& hash = std::get<RedisHash>(it->second.view());
+    auto& fe = it->second.field_expiry;
+    
+    for (size_t i = 0; i < fields.size(); i++) {
+        auto field_it = hash.find(fields[i]);
+        if (field_it == hash.end()) continue;  // -2
+        result[i] = (fe && fe->deadlines.erase(static_cast<uint32_t>(field_it - hash.begin())) > 0) ? 1 : -1;
+    }
+    
+    if (fe) {
+        if (fe->deadlines.empty()) fe.reset();
+        else fe->refresh();
+    }
+    
+    // Only dropped TTLs change the key
+    if (std::find(result.begin(), result.end(), 1) == result.end()) return accounted.unchanged(result);
+    return result;
+}
+
+// ========== HASH INDEX OPERATIONS ==========
+
+bool StorageEngine::hindexCreate(const std::string& name, const std::string& prefix, const std::string& field,
+                                 HashIndexKind kind) {
+    if (indexes_.find(name)) return false;
+    
+    // Backfill from the live hashes before the index goes online
+    // (due fields are skipped like the read paths do: HGET reports them absent)
+    HashIndex index(prefix, field, kind);
+    auto now = std::chrono::system_clock::now();
+    for (const auto& [key, value] : store_) {
+        if (!index.covers(key) || value.getType() != ValueType::HASH || value.isExpired()) continue;
+        const auto& hash = std::get<RedisHash>(value.view());
+        auto it = hash.find(field);
+        if (it != hash.end() && !fieldDue(value, it - hash.begin(), now)) index.insert(key, it->second);
+    }
+    return indexes_.create(name, std::move(index));
+}
+
+bool StorageEngine::hindexDrop(const std::string& name) {
+    return indexes_.drop(name);
+}
+
+std::vector<std::string> StorageEngine::hindexLookup(const std::string& name, const std::string& value) const {
+    const auto* index = indexes_.find(name);
+    if (!index || index->kind() != HashIndexKind::EXACT) return {};
+    
+    const auto* keys = index->lookup(value);
+    if (!keys) return {};
+    
+    // Entries of expired keys/fields linger until a writer or cleanupExpired
+    // reclaims them (never from this shared-lock path): re-check
+    std::vector<std::string> result;
+    for (const auto& key : *keys) {
+        const auto* current = liveHashField(key, index->field());
+        if (current && *current == value) result.push_back(key);
+    }
+    return result;
+}
+
+std::vector<std::string> StorageEngine::hindexRange(const std::string& name, double min, double max,
+                                                    size_t limit) const {
+    const auto* index = indexes_.find(name);
+    if (!index || index->kind() != HashIndexKind::NUMERIC || min > max) return {};
+    
+    std::vector<std::string> result;
+    index->forEachInRange(min, max, [&](const std::string& key) {
+        if (liveHashField(key, index->field())) result.push_back(key);  // Skips expired, as in hindexLookup
+        return limit == 0 || result.size() < limit;
+    });
+    return result;
+}
+
+std::vector<HashIndexInfo> StorageEngine::hindexList() const {
+    return indexes_.list();
+}
+
+// ========== STREAM OPERATIONS ==========
+
+RedisStream* StorageEngine::findStream(const std::string& key) {
+    if (isExpired(key)) return nullptr;
+    
+    auto it = store_.find(key);
+    if (it == store_.end() || it->second.getType() != ValueType::STREAM) return nullptr;
+    return &std::get<RedisStream>(it->second.own());
+}
+
+std::optional<std::string> StorageEngine::xadd(const std::string& key, const std::string& id,
+                                               const StreamFields& fields, size_t maxlen) {
+    Accounted accounted(*this, key);
+    if (fields.empty()) return accounted.unchanged(std::nullopt);
+    isExpired(key);
+    
+    auto it = store_.find(key);
+    if (it == store_.end()) {
+        it = store_.emplace(key, RedisValue(RedisStream())).first;
+    } else if (it->second.getType() != ValueType::STREAM) {
+        return accounted.unchanged(std::nullopt);
+    }
+    
+    auto& stream = std::get<RedisStream>(it->second.own());
+    auto added = stream.add(id, fields);
+    if (!added) {
+        if (stream.length() == 0 && stream.groupCount() == 0) store_.erase(it);  // Don't leave a fresh empty stream
+        return accounted.unchanged(std::nullopt);
+    }
+    
+    if (maxlen > 0) stream.trim(maxlen);
+    return added->toString();
+}
+
+std::vector<StreamEntry> StorageEngine::xrange(const std::string& key, const std::string& start,
+                                               const std::string& end, size_t count) {
+    const auto* stream = peek<RedisStream>(key);
+    if (!stream) return {};
+    
+    // Incomplete IDs: "5" means 5-0 as start and 5-<max> as end
+    auto from = start == "-" ? StreamID::min() : StreamID::parse(start, 0);
+    auto to = end == "+" ? StreamID::max() : StreamID::parse(end, UINT64_MAX);
+    if (!from || !to) return {};
+    
+    return stream->range(*from, *to, count);
+}
+
+std::vector<std::pair<std::string, std::vector<StreamEntry>>> StorageEngine::xread(
+    const std::vector<std::pair<std::string, std::string>>& streams, size_t count) {
+    std::vector<std::pair<std::string, std::vector<StreamEntry>>> result;
+    
+    for (const auto& [key, id] : streams) {
+        const auto* stream = peek<RedisStream>(key);
+        if (!stream) continue;
+        
+        auto from = id == "$" ? stream->lastId() : StreamID::parse(id, 0);
+        if (!from) continue;
+        
+        auto entries = stream->after(*from, count);
+        if (!entries.empty()) result.emplace_back(key, std::move(entries));
+    }
+    return result;
+}
+
+std::string StorageEngine::streamLastId(const std::string& key) {
+    const auto* stream = peek<RedisStream>(key);
+    return stream ? stream->lastId().toString() : StreamID::min().toString();
+}
+
+size_t StorageEngine::xlen(const std::string& key) {
+    const auto* stream = peek<RedisStream>(key);
+    return stream ? stream->length() : 0;
+}
+
+size_t StorageEngine::xtrim(const std::string& key, size_t maxlen) {
+    Accounted accounted(*this, key);
+    auto* stream = findStream(key);
+    size_t trimmed = stream ? stream->trim(maxlen) : 0;
+    return trimmed == 0 ? accounted.unchanged(trimmed) : trimmed;
+}
+
+bool StorageEngine::xgroupCreate(const std::string& key, const std::string& group,
+                                 const std::string& id, bool mkstream) {
+    Accounted accounted(*this, key);
+    auto* stream = findStream(key);
+    bool created = false;
+    if (!stream) {
+        if (!mkstream || store_.find(key) != store_.end()) return accounted.unchanged(false);  // Missing, or wrong type
+        stream = &std::get<RedisStream>(store_.emplace(key, RedisValue(RedisStream())).first->second.own());
+        created = true;
+    }
+    
+    auto start = id == "$" ? stream->lastId() : StreamID::parse(id, 0);
+    if (start && stream->createGroup(group, *start)) return true;
+    return created ? false : accounted.unchanged(false);
+}
+
+std::optional<std::vector<StreamEntry>> StorageEngine::xreadgroup(const std::string& key, const std::string& group,
+                                                                  const std::string& consumer,
+                                                                  const std::string& id, size_t count) {
+    Accounted accounted(*this, key);
+    auto* stream = findStream(key);
+    if (!stream) return accounted.unchanged(std::nullopt);
+    
+    if (id == ">") return stream->readGroupNew(group, consumer, count);
+    
+    auto from = StreamID::parse(id, 0);
+    if (!from) return std::nullopt;
+    return stream->readGroupPending(group, consumer, *from, count);
+}
+
+size_t StorageEngine::xack(const std::string& key, const std::string& group, const std::vector<std::string>& ids) {
+    Accounted accounted(*this, key);
+    auto* stream = findStream(key);
+    if (!stream) return accounted.unchanged(0);
+    
+    std::vector<StreamID> parsed;
+    for (const auto& id : ids) {
+        if (auto p = StreamID::parse(id, 0)) parsed.push_back(*p);
+    }
+    size_t acked = stream->ack(group, parsed);
+    return acked == 0 ? accounted.unchanged(acked) : acked;
+}
+
+std::vector<StreamPendingInfo> StorageEngine::xpending(const std::string& key, const std::string& group, size_t count) {
+    const auto* stream = peek<RedisStream>(key);
+    return stream ? stream->pending(group, count) : std::vector<StreamPendingInfo>();
+}
+
+// ========== GEO OPERATIONS ==========
+
+RedisGeo* StorageEngine::findGeo(const std::string& key) {
+    if (isExpired(key)) return nullptr;
+    
+    auto it = store_.find(key);
+    if (it == store_.end() || it->second.getType() != ValueType::GEO) return nullptr;
+    return &std::get<RedisGeo>(it->second.own());
+}
+
+size_t StorageEngine::geoadd(const std::string& key, const std::vector<GeoMember>& members) {
+    Accounted accounted(*this, key);
+    isExpired(key);
+    
+    auto it = store_.find(key);
+    if (it == store_.end()) {
+        RedisGeo geo;
+        size_t added = 0;
+        for (const auto& m : members) {
+            if (RedisGeo::validCoordinates(m.longitude, m.latitude)) {
+                added += geo.add(m.longitude, m.latitude, m.member);
+            }
+        }
+        if (geo.size() == 0) return accounted.unchanged(added);
+        store_.emplace(key, RedisValue(std::move(geo)));
+        return added;
+    }
+    
+    if (it->second.getType() != ValueType::GEO) return accounted.unchanged(0);
+    
+    auto& geo = std::get<RedisGeo>(it->second.own());
+    size_t added = 0;
+    for (const auto& m : members) {
+        if (RedisGeo::validCoordinates(m.longitude, m.latitude)) {
+            added += geo.add(m.longitude, m.latitude, m.member);
+        }
+    }
+    return added;
+}
+
+std::vector<std::optional<std::pair<double, double>>> StorageEngine::geopos(const std::string& key,
+                                                                            const std::vector<std::string>& members) {
+    std::vector<std::optional<std::pair<double, double>>> result(members.size());
+    const auto* geo = peek<RedisGeo>(key);
+    if (!geo) return result;
+    
+    for (size_t i = 0; i < members.size(); i++) {
+        result[i] = geo->position(members[i]);
+    }
+    return result;
+}
+
+std::optional<double> StorageEngine::geodist(const std::string& key, const std::string& member1,
+                                             const std::string& member2, const std::string& unit) {
+    const auto* geo = peek<RedisGeo>(key);
+    auto meters_per_unit = RedisGeo::unitToMeters(unit);
+    if (!geo || !meters_per_unit) return std::nullopt;
+    
+    auto meters = geo->distance(member1, member2);
+    if (!meters) return std::nullopt;
+    return *meters / *meters_per_unit;
+}
+
+std::vector<GeoResult> StorageEngine::geosearch(const std::string& key, const GeoSearchQuery& query) {
+    const auto* geo = peek<RedisGeo>(key);
+    if (!geo) return {};
+    
+    auto results = geo->search(query);
+    return results ? std::move(*results) : std::vector<GeoResult>();
+}
+
+// ========== BLOOM / CUCKOO FILTER OPERATIONS ==========
+
+RedisBloom* StorageEngine::findBloom(const std::string& key) {
+    if (isExpired(key)) return nullptr;
+    
+    auto it = store_.find(key);
+    if (it == store_.end() || it->second.getType() != ValueType::BLOOM) return nullptr;
+    return &std::get<RedisBloom>(it->second.own());
+}
+
+RedisCuckoo* StorageEngine::findCuckoo(const std::string& key) {
+    if (isExpired(key)) return nullptr;
+    
+    auto it = store_.find(key);
+    if (it == store_.end() || it->second.getType() != ValueType::CUCKOO) return nullptr;
+    return &std::get<RedisCuckoo>(it->second.own());
+}
+
+bool StorageEngine::bfreserve(const std::string& key, double error_rate, size_t capacity, unsigned expansion) {
+    Accounted accounted(*this, key);
+    if (!(error_rate > 0 && error_rate < 1) || capacity == 0) return accounted.unchanged(false);
+    isExpired(key);
+    
+    if (!store_.emplace(key, RedisValue(RedisBloom(error_rate, capacity, expansion))).second) return accounted.unchanged(false);
+    return true;
+}
+
+bool StorageEngine::bfadd(const std::string& key, const std::string& item) {
+    Accounted accounted(*this, key);
+    auto added = bfmadd(key, {item});
+    if (added.empty() || !added.front()) return accounted.unchanged(false);
+    return true;
+}
+
+std::vector<bool> StorageEngine::bfmadd(const std::string& key, const std::vector<std::string>& items) {
+    Accounted accounted(*this, key);
+    isExpired(key);
+    
+    auto it = store_.find(key);
+    if (it == store_.end()) {
+        it = store_.emplace(key, RedisValue(RedisBloom())).first;
+    } else if (it->second.getType() != ValueType::BLOOM) {
+        return accounted.unchanged(std::vector<bool>());
+    }
+    
+    auto added = std::get<RedisBloom>(it->second.own()).addMany(items);
+    if (std::find(added.begin(), added.end(), true) == added.end()) accounted.unchanged();
+    return added;
+}
+
+bool StorageEngine::bfexists(const std::string& key, const std::string& item) {
+    const auto* bloom = peek<RedisBloom>(key);
+    return bloom && bloom->contains(item);
+}
+
+std::vector<bool> StorageEngine::bfmexists(const std::string& key, const std::vector<std::string>& items) {
+    const auto* bloom = peek<RedisBloom>(key);
+    if (!bloom) return std::vector<bool>(items.size(), false);
+    return bloom->containsMany(items);
+}
+
+bool StorageEngine::cfreserve(const std::string& key, size_t capacity, unsigned expansion) {
+    Accounted accounted(*this, key);
+    if (capacity == 0) return accounted.unchanged(false);
+    isExpired(key);
+    
+    if (!store_.emplace(key, RedisValue(RedisCuckoo(capacity, expansion))).second) return accounted.unchanged(false);
+    return true;
+}
+
+bool StorageEngine::cfadd(const std::string& key, const std::string& item) {
+    Accounted accounted(*this, key);
+    isExpired(key);
+    
+    auto it = store_.find(key);
+    if (it == store_.end()) {
+        it = store_.emplace(key, RedisValue(RedisCuckoo())).first;
+    } else if (it->second.getType() != ValueType::CUCKOO) {
+        return accounted.unchanged(false);
+    }
+    
+    return std::get<RedisCuckoo>(it->second.own()).add(item);
+}
+
+bool StorageEngine::cfexists(const std::string& key, const std::string& item) {
+    const auto* cuckoo = peek<RedisCuckoo>(key);
+    return cuckoo && cuckoo->contains(item);
+}
+
+std::vector<bool> StorageEngine::cfmexists(const std::string& key, const std::vector<std::string>& items) {
+    const auto* cuckoo = peek<RedisCuckoo>(key);
+    if (!cuckoo) return std::vector<bool>(items.size(), false);
+    return cuckoo->containsMany(items);
+}
+
+bool StorageEngine::cfdel(const std::string& key, const std::string& item) {
+    Accounted accounted(*this, key);
+    auto* cuckoo = findCuckoo(key);
+    if (!cuckoo || !cuckoo->remove(item)) return accounted.unchanged(false);
+    return true;
+}
+
+// ========== COUNT-MIN / TOP-K SKETCH OPERATIONS ==========
+
+RedisCountMin* StorageEngine::findCountMin(const std::string& key) {
+    if (isExpired(key)) return nullptr;
+    
+    auto it = store_.find(key);
+    if (it == store_.end() || it->second.getType() != ValueType::CMS) return nullptr;
+    return &std::get<RedisCountMin>(it->second.own());
+}
+
+RedisTopK* StorageEngine::findTopK(const std::string& key) {
+    if (isExpired(key)) return nullptr;
+    
+    auto it = store_.find(key);
+    if (it == store_.end() || it->second.getType() != ValueType::TOPK) return nullptr;
+    return &std::get<RedisTopK>(it->second.own());
+}
+
+bool StorageEngine::cmsInitByDim(const std::string& key, size_t width, size_t depth) {
+    Accounted accounted(*this, key);
+    if (width == 0 || depth == 0) return accounted.unchanged(false);
+    isExpired(key);
+    
+    if (!store_.emplace(key, RedisValue(RedisCountMin(width, depth))).second) return accounted.unchanged(false);
+    return true;
+}
+
+bool StorageEngine::cmsInitByProb(const std::string& key, double error, double probability) {
+    Accounted accounted(*this, key);
+    if (!(error > 0 && error < 1) || !(probability > 0 && probability < 1)) return accounted.unchanged(false);
+    isExpired(key);
+    
+    if (!store_.emplace(key, RedisValue(RedisCountMin::fromErrorRate(error, probability))).second) return accounted.unchanged(false);
+    return true;
+}
+
+std::vector<uint64_t> StorageEngine::cmsIncrBy(const std::string& key,
+                                               const std::vector<std::pair<std::string, uint64_t>>& increments) {
+    Accounted accounted(*this, key);
+    auto* cms = findCountMin(key);
+    if (!cms) return accounted.unchanged(std::vector<uint64_t>());
+    
+    std::vector<uint64_t> result;
+    result.reserve(increments.size());
+    for (const auto& [item, increment] : increments) {
+        result.push_back(cms->incrBy(item, increment));
+    }
+    return result;
+}
+
+std::vector<uint64_t> StorageEngine::cmsQuery(const std::string& key, const std::vector<std::string>& items) {
+    const auto* cms = peek<RedisCountMin>(key);
+    if (!cms) return {};
+    
+    std::vector<uint64_t> result;
+    result.reserve(items.size());
+    for (const auto& item : items) result.push_back(cms->query(item));
+    return result;
+}
+
+bool StorageEngine::cmsMerge(const std::string& dest, const std::vector<std::string>& sources,
+                             const std::vector<uint64_t>& weights) {
+    Accounted accounted(*this, dest);
+    if (!weights.empty() && weights.size() != sources.size()) return accounted.unchanged(false);
+    
+    auto* target = findCountMin(dest);
+    if (!target) return accounted.unchanged(false);
+    
+    // Validate everything first so a bad source leaves dest untouched
+    std::vector<const RedisCountMin*> inputs;
+    for (const auto& source : sources) {
+        const auto* cms = peek<RedisCountMin>(source);
+        if (!cms || cms->width() != target->width() || cms->depth() != target->depth()) return accounted.unchanged(false);
+        inputs.push_back(cms);
+    }
+    
+    // Merging dest into itself must read the pre-merge counters
+    RedisCountMin merged(target->width(), target->depth());
+    for (size_t i = 0; i < inputs.size(); i++) {
+        merged.merge(*inputs[i], weights.empty() ? 1 : weights[i]);
+    }
+    *target = std::move(merged);
+    return true;
+}
+
+bool StorageEngine::topkReserve(const std::string& key, size_t k, size_t width, size_t depth, double decay) {
+    Accounted accounted(*this, key);
+    if (k == 0 || !(decay > 0 && decay <= 1)) return accounted.unchanged(false);
+    isExpired(key);
+    
+    if (!store_.emplace(key, RedisValue(RedisTopK(k, width, depth, decay))).second) return accounted.unchanged(false);
+    return true;
+}
+
+std::vector<std::optional<std::string>> StorageEngine::topkAdd(const std::string& key,
+                                                               const std::vector<std::string>& items) {
+    Accounted accounted(*this, key);
+    auto* topk = findTopK(key);
+    if (!topk) return accounted.unchanged(std::vector<std::optional<std::string>>());
+    
+    std::vector<std::optional<std::string>> result;
+    result.reserve(items.size());
+    for (const auto& item : items) result.push_back(topk->add(item));
+    return result;
+}
+
+std::vector<std::optional<std::string>> StorageEngine::topkIncrBy(
+    const std::string& key, const std::vector<std::pair<std::string, uint64_t>>& increments) {
+    Accounted accounted(*this, key);
+    auto* topk = findTopK(key);
+    if (!topk) return accounted.unchanged(std::vector<std::optional<std::string>>());
+    
+    std::vector<std::optional<std::string>> result;
+    result.reserve(increments.size());
+    for (const auto& [item, increment] : increments) {
+        auto clamped = static_cast<uint32_t>(std::min<uint64_t>(increment, UINT32_MAX));
+        result.push_back(topk->incrBy(item, clamped));
+    }
+    return result;
+}
+
+std::vector<bool> StorageEngine::topkQuery(const std::string& key, const std::vector<std::string>& items) {
+    std::vector<bool> result(items.size(), false);
+    const auto* topk = peek<RedisTopK>(key);
+    if (!topk) return result;
+    
+    for (size_t i = 0; i < items.size(); i++) result[i] = topk->contains(items[i]);
+    return result;
+}
+
+std::vector<std::pair<std::string, uint32_t>> StorageEngine::topkList(const std::string& key) {
+    const auto* topk = peek<RedisTopK>(key);
+    return topk ? topk->list() : std::vector<std::pair<std::string, uint32_t>>();
+}
+
+bool StorageEngine::topkMerge(const std::string& dest, const std::vector<std::string>& sources) {
+    Accounted accounted(*this, dest);
+    auto* target = findTopK(dest);
+    if (!target) return accounted.unchanged(false);
+    
+    std::vector<RedisTopK> inputs;  // Copies: a source may be dest itself
+    for (const auto& source : sources) {
+        const auto* topk = peek<RedisTopK>(source);
+        if (!topk) return accounted.unchanged(false);
+        inputs.push_back(*topk);
+    }
+    
+    for (const auto& topk : inputs) target->merge(topk);
+    return true;
+}
+
+// ========== T-DIGEST OPERATIONS ==========
+
+RedisTDigest* StorageEngine::findTDigest(const std::string& key) {
+    if (isExpired(key)) return nullptr;
+    
+    auto it = store_.find(key);
+    if (it == store_.end() || it->second.getType() != ValueType::TDIGEST) return nullptr;
+    return &std::get<RedisTDigest>(it->second.own());
+}
+
+bool StorageEngine::tdigestCreate(const std::string& key, double compression) {
+    Accounted accounted(*this, key);
+    if (!(compression > 0)) return accounted.unchanged(false);
+    isExpired(key);
+    
+    if (!store_.emplace(key, RedisValue(RedisTDigest(compression))).second) return accounted.unchanged(false);
+    return true;
+}
+
+bool StorageEngine::tdigestAdd(const std::string& key, const std::vector<double>& values) {
+    Accounted accounted(*this, key);
+    auto* digest = findTDigest(key);
+    if (!digest) return accounted.unchanged(false);
+    
+    digest->add(values);
+    return true;
+}
+
+std::vector<double> StorageEngine::tdigestQuantile(const std::string& key, const std::vector<double>& quantiles) {
+    const auto* digest = peek<RedisTDigest>(key);
+    return digest ? digest->quantile(quantiles) : std::vector<double>();
+}
+
+std::vector<double> StorageEngine::tdigestCdf(const std::string& key, const std::vector<double>& values) {
+    const auto* digest = peek<RedisTDigest>(key);
+    return digest ? digest->cdf(values) : std::vector<double>();
+}
+
+bool StorageEngine::tdigestMerge(const std::string& dest, const std::vector<std::string>& sources,
+                                 double compression) {
+    Accounted accounted(*this, dest);
+    std::vector<RedisTDigest> inputs;  // Copies: dest may be one of the sources
+    double largest = 0;
+    for (const auto& source : sources) {
+        const auto* digest = peek<RedisTDigest>(source);
+        if (!digest) return accounted.unchanged(false);
+        inputs.push_back(*digest);
+        largest = std::max(largest, digest->compression());
+    }
+    
+    isExpired(dest);
+    auto it = store_.find(dest);
+    if (it == store_.end()) {
+        it = store_.emplace(dest, RedisValue(RedisTDigest(compression > 0 ? compression : largest))).first;
+    } else if (it->second.getType() != ValueType::TDIGEST) {
+        return accounted.unchanged(false);
+    }
+    
+    auto& target = std::get<RedisTDigest>(it->second.own());
+    for (const auto& digest : inputs) target.merge(digest);
+    return true;
+}
+
+// ========== TIME SERIES OPERATIONS ==========
+
+RedisTimeSeries* StorageEngine::findTimeSeries(const std::string& key) {
+    if (isExpired(key)) return nullptr;
+    
+    auto it = store_.find(key);
+    if (it == store_.end() || it->second.getType() != ValueType::TIMESERIES) return nullptr;
+    return &std::get<RedisTimeSeries>(it->second.own());
+}
+
+bool StorageEngine::tsCreate(const std::string& key, int64_t retention_ms) {
+    Accounted accounted(*this, key);
+    if (retention_ms < 0) return accounted.unchanged(false);
+    isExpired(key);
+    
+    if (!store_.emplace(key, RedisValue(RedisTimeSeries(retention_ms))).second) return accounted.unchanged(false);
+    return true;
+}
+
+bool StorageEngine::tsAdd(const std::string& key, int64_t timestamp, double value) {
+    Accounted accounted(*this, key);
+    if (tsMadd(key, {TimeSeriesSample{timestamp, value}}) != 1) return accounted.unchanged(false);
+    return true;
+}
+
+size_t StorageEngine::tsMadd(const std::string& key, const std::vector<TimeSeriesSample>& samples) {
+    Accounted accounted(*this, key);
+    isExpired(key);
+    
+    auto add = [&samples](RedisTimeSeries& series) {
+        size_t added = 0;
+        for (const auto& sample : samples) {
+            added += series.add(sample.timestamp, sample.value);
+        }
+        return added;
+    };
+    
+    auto it = store_.find(key);
+    if (it == store_.end()) {
+        // The key only appears once a sample is actually accepted
+        RedisTimeSeries series;
+        size_t added = add(series);
+        if (added == 0) return accounted.unchanged(added);
+        store_.emplace(key, RedisValue(std::move(series)));
+        return added;
+    }
+    if (it->second.getType() != ValueType::TIMESERIES) return accounted.unchanged(0);
+    size_t added = add(std::get<RedisTimeSeries>(it->second.own()));
+    return added == 0 ? accounted.unchanged(added) : added;
+}
+
+std::optional<TimeSeriesSample> StorageEngine::tsGet(const std::string& key) {
+    const auto* series = peek<RedisTimeSeries>(key);
+    return series ? series->last() : std::nullopt;
+}
+
+std::vector<TimeSeriesSample> StorageEngine::tsRange(const std::string& key, int64_t from, int64_t to,
+                                                     TimeSeriesAggregation aggregation, int64_t bucket_ms) {
+    const auto* series = peek<RedisTimeSeries>(key);
+    if (!series) return {};
+    return series->range(from, to, aggregation, bucket_ms);
+}
+
+std::optional<TimeSeriesInfo> StorageEngine::tsInfo(const std::string& key) {
+    const auto* series = peek<RedisTimeSeries>(key);
+    if (!series) return std::nullopt;
+    return series->info();
+}
+
+// ========== JSON OPERATIONS ==========
+
+RedisJson* StorageEngine::findJson(const std::string& key) {
+    if (isExpired(key)) return nullptr;
+    
+    auto it = store_.find(key);
+    if (it == store_.end() || it->second.getType() != ValueType::JSON) return nullptr;
+    return &std::get<RedisJson>(it->second.own());
+}
+
+bool StorageEngine::jsonSet(const std::string& key, const std::string& path, const std::string& json) {
+    Accounted accounted(*this, key);
+    auto value = JsonValue::parse(json);
+    if (!value) return accounted.unchanged(false);
+    isExpired(key);
+    
+    auto it = store_.find(key);
+    if (it == store_.end()) {
+        if (!RedisJson::isRootPath(path)) return accounted.unchanged(false);
+        store_.emplace(key, RedisValue(RedisJson(std::move(*value))));
+        return true;
+    }
+    
+    if (it->second.getType() != ValueType::JSON) return accounted.unchanged(false);
+    if (!std::get<RedisJson>(it->second.own()).set(path, std::move(*value))) return accounted.unchanged(false);
+    return true;
+}
+
+std::optional<std::string> StorageEngine::jsonGet(const std::string& key, const std::string& path) {
+    const auto* doc = peek<RedisJson>(key);
+    if (!doc) return std::nullopt;
+    return doc->get(path);
+}
+
+size_t StorageEngine::jsonDel(const std::string& key, const std::string& path) {
+    Accounted accounted(*this, key);
+    auto* doc = findJson(key);
+    if (!doc) return accounted.unchanged(0);
+    
+    if (RedisJson::isRootPath(path)) {
+        // Whole document: big trees are freed on the lazy free thread
+        auto it = store_.find(key);
+        RedisValue value = std::move(it->second);
+        store_.erase(it);
+        dispose(std::move(value));
+        return 1;
+    }
+    size_t removed = doc->del(path);
+    return removed == 0 ? accounted.unchanged(removed) : removed;
+}
+
+std::optional<std::string> StorageEngine::jsonNumIncrBy(const std::string& key, const std::string& path,
+                                                        double increment) {
+    Accounted accounted(*this, key);
+    auto* doc = findJson(key);
+    if (!doc) return accounted.unchanged(std::nullopt);
+    auto result = doc->numIncrBy(path, increment);
+    return result ? result : accounted.unchanged(std::nullopt);
+}
+
+std::optional<size_t> StorageEngine::jsonArrAppend(const std::string& key, const std::string& path,
+                                                   const std::vector<std::string>& values) {
+    Accounted accounted(*this, key);
+    auto* doc = findJson(key);
+    if (!doc) return accounted.unchanged(std::nullopt);
+    
+    // Parse everything first: a bad value appends nothing
+    std::vector<JsonValue> parsed;
+    parsed.reserve(values.size());
+    for (const auto& text : values) {
+        auto value = JsonValue::parse(text);
+        if (!value) return accounted.unchanged(std::nullopt);
+        parsed.push_back(std::move(*value));
+    }
+    auto length = doc->arrAppend(path, std::move(parsed));
+    return length ? length : accounted.unchanged(std::nullopt);
+}
+
+std::optional<std::string> StorageEngine::jsonType(const std::string& key, const std::string& path) {
+    const auto* doc = peek<RedisJson>(key);
+    if (!doc) return std::nullopt;
+    return doc->type(path);
+}
+
+// ========== VECTOR SET OPERATIONS ==========
+
+RedisVectorSet* StorageEngine::findVectorSet(const std::string& key) {
+    if (isExpired(key)) return nullptr;
+    
+    auto it = store_.find(key);
+    if (it == store_.end() || it->second.getType() != ValueType::VECTORSET) return nullptr;
+    return &std::get<RedisVectorSet>(it->second.own());
+}
+
+bool StorageEngine::vadd(const std::string& key, const std::string& element, const std::vector<float>& vector,
+                         VectorQuant quant, size_t m, size_t ef_construction) {
+    Accounted accounted(*this, key);
+    if (vector.empty()) return accounted.unchanged(false);
+    isExpired(key);
+    
+    auto it = store_.find(key);
+    if (it == store_.end()) {
+        RedisVectorSet set(vector.size(), quant, m, ef_construction);
+        if (!set.add(element, vector)) return accounted.unchanged(false);
+        store_.emplace(key, RedisValue(std::move(set)));
+        return true;
+    }
+    
+    if (it->second.getType() != ValueType::VECTORSET) return accounted.unchanged(false);
+    if (!std::get<RedisVectorSet>(it->second.own()).add(element, vector)) return accounted.unchanged(false);
+    return true;
+}
+
+std::vector<VectorMatch> StorageEngine::vsim(const std::string& key, const std::vector<float>& query,
+                                             size_t k, size_t ef) {
+    const auto* set = peek<RedisVectorSet>(key);
+    if (!set) return {};
+    return set->search(query, k, ef);
+}
+
+std::vector<VectorMatch> StorageEngine::vsimElement(const std::string& key, const std::string& element,
+                                                    size_t k, size_t ef) {
+    const auto* set = peek<RedisVectorSet>(key);
+    if (!set) return {};
+    return set->searchElement(element, k, ef).value_or(std::vector<VectorMatch>());
+}
+
+size_t StorageEngine::vcard(const std::string& key) {
+    const auto* set = peek<RedisVectorSet>(key);
+    return set ? set->size() : 0;
+}
+
+size_t StorageEngine::vdim(const std::string& key) {
+    const auto* set = peek<RedisVectorSet>(key);
+    return set ? set->dim() : 0;
+}
+
+std::optional<std::vector<float>> StorageEngine::vemb(const std::string& key, const std::string& element) {
+    const auto* set = peek<RedisVectorSet>(key);
+    if (!set) return std::nullopt;
+    return set->embedding(element);
+}
+
+// ========== QUOTA OPERATIONS ==========
+
+bool StorageEngine::setQuota(const std::string& name, const std::string& prefix, size_t budget) {
+    if (!quotas_.define(name, prefix, budget)) return false;
+    recount();  // A new prefix may take keys over from a shorter one
+    enforceQuotas();
+    return true;
+}
+
+bool StorageEngine::dropQuota(const std::string& name) {
+    if (!quotas_.drop(name)) return false;
+    recount();
+    return true;
+}
+
+std::vector<NamespaceStats> StorageEngine::quotaStats() const {
+    return quotas_.stats();
+}
+
+// ========== GENERAL OPERATIONS ==========
+
+bool StorageEngine::remove(const std::string& key) {
+    Accounted accounted(*this, key);
+    auto it = store_.find(key);
+    if (it == store_.end()) return accounted.unchanged(false);
+    
+    unindex(key, it->second);
+    store_.erase(it);
+    return true;
+}
+
+bool StorageEngine::unlink(const std::string& key) {
+    Accounted accounted(*this, key);
+    if (isExpired(key)) return accounted.unchanged(false);
+    
+    auto it = store_.find(key);
+    if (it == store_.end()) return accounted.unchanged(false);
+    
+    unindex(key, it->second);
+    RedisValue value = std::move(it->second);
+    store_.erase(it);
+    dispose(std::move(value));
+    return true;
+}
+
+void StorageEngine::place(const std::string& key, RedisValue value) {
+    Accounted accounted(*this, key);
+    auto [it, inserted] = store_.try_emplace(key, std::move(value));
+    if (!inserted) {
+        unindex(key, it->second);
+        dispose(std::exchange(it->second, std::move(value)));
+    }
+    if (!indexes_.empty() && it->second.getType() == ValueType::HASH) {
+        indexes_.hashAdded(key, std::get<RedisHash>(it->second.view()));
+    }
+}
+
+bool StorageEngine::rename(const std::string& key, const std::string& newkey) {
+    Accounted accounted_key(*this, key);
+    Accounted accounted_newkey(*this, newkey);
+    auto it = isExpired(key) ? store_.end() : store_.find(key);
+    if (it == store_.end() || key == newkey) {
+        accounted_key.unchanged();
+        return accounted_newkey.unchanged(it != store_.end());
+    }
+    
+    // Clear the destination first, then re-key the node in place
+    isExpired(newkey);
+    auto old = store_.find(newkey);
+    if (old != store_.end()) {
+        unindex(newkey, old->second);
+        RedisValue replaced = std::move(old->second);
+        store_.erase(old);
+        dispose(std::move(replaced));
+    }
+    
+    unindex(key, it->second);
+    auto node = store_.extract(it);
+    node.key() = newkey;
+    auto moved = store_.insert(std::move(node)).position;
+    if (!indexes_.empty() && moved->second.getType() == ValueType::HASH) {
+        indexes_.hashAdded(newkey, std::get<RedisHash>(moved->second.view()));
+    }
+    return true;
+}
+
+bool StorageEngine::copy(const std::string& source, const std::string& destination, bool replace) {
+    Accounted accounted(*this, destination);
+    if (source == destination || isExpired(source)) return accounted.unchanged(false);
+    
+    auto it = store_.find(source);
+    if (it == store_.end()) return accounted.unchanged(false);
+    if (!replace && exists(destination)) return accounted.unchanged(false);
+    
+    place(destination, it->second.share());
+    return true;
+}
+
+bool StorageEngine::move(const std::string& key, StorageEngine& destination) {
+    Accounted accounted(*this, key);
+    if (&destination == this || isExpired(key)) return accounted.unchanged(false);
+    
+    auto it = store_.find(key);
+    if (it == store_.end() || destination.exists(key)) return accounted.unchanged(false);
+    
+    // Tables may sit on different memory resources: move the value, not the node
+    unindex(key, it->second);
+    RedisValue value = std::move(it->second);
+    store_.erase(it);
+    destination.place(key, std::move(value));
+    return true;
+}
+
+bool StorageEngine::exists(const std::string& key) {
+    if (isExpiredForRead(key)) return false;
+    return store_.find(key) != store_.end();
+}
+
+std::optional<ValueType> StorageEngine::type(const std::string& key) {
+    if (isExpiredForRead(key)) return std::nullopt;
+    
+    auto it = store_.find(key);
+    if (it == store_.end()) return std::nullopt;
+    
+    return it->second.getType();
+}
+
+bool StorageEngine::expire(const std::string& key, int seconds) {
+    Accounted accounted(*this, key);
+    if (isExpired(key)) return accounted.unchanged(false);
+    
+    auto it = store_.find(key);
+    if (it == store_.end()) return accounted.unchanged(false);
+    
+    if (seconds > 0) {
+        it->second.expiry = std::chrono::system_clock::now() + 
+                            std::chrono::seconds(seconds);
+    } else {
+        it->second.expiry = std::nullopt;  // Remove expiry
+    }
+    
+    return true;
+}
+
+int StorageEngine::ttl(const std::string& key) {
+    // Expired: absent to the reader; a writer or cleanupExpired reclaims it
+    if (isExpiredForRead(key)) return -2;
+    
+    auto it = store_.find(key);
+    if (it == store_.end()) return -2;  // Key doesn't exist
+    
+    if (!it->second.expiry.has_value()) return -1;  // No expiry
+    
+    auto remaining = it->second.expiry.value() - std::chrono::system_clock::now();
+    return std::max<long long>(0, std::chrono::duration_cast<std::chrono::seconds>(remaining).count());
+}
+
+long long StorageEngine::pttl(const std::string& key) {
+    if (isExpiredForRead(key)) return -2;
+    
+    auto it = store_.find(key);
+    if (it == store_.end()) return -2;
+    if (!it->second.expiry.has_value()) return -1;
+    
+    auto remaining = it->second.expiry.value() - std::chrono::system_clock::now();
+    return std::max<long long>(0, std::chrono::duration_cast<std::chrono::milliseconds>(remaining).count());
 }
 
 std::vector<std::string> StorageEngine::keys() const {
@@ -401,26 +2143,127 @@ size_t StorageEngine::size() const {
     return count;
 }
 
-void StorageEngine::clear() {
+void StorageEngine::clear(bool async) {
+    indexes_.clearEntries();
+    quotas_.clearCharges();
+    if (tracking_) tracking_->flushed();
+    if (!async || store_.empty()) {
+        store_.clear();
+        return;
+    }
+    
+    if (!pool_) {
+        // O(1): the old table (nodes, buckets, values) leaves whole
+        KeySpace detached(store_.get_allocator().resource());
+        detached.swap(store_);
+        lazy_free_.release(std::move(detached));
+        return;
+    }
+    
+    // The huge page pool is single-threaded, so its nodes are returned
+    // here (cheap pool pushes); only the values' memory goes async
+    std::vector<RedisValue> values;
+    values.reserve(store_.size());
+    for (auto& [key, value] : store_) values.push_back(std::move(value));
     store_.clear();
+    lazy_free_.release(std::move(values));
 }
 
-size_t StorageEngine::cleanupExpired() {
-    size_t removed = 0;
-    
-    // Can't erase while iterating, so collect expired keys first
-    std::vector<std::string> expired_keys;
+HugePageStats StorageEngine::hugePageStats() const {
+    return huge_pages_ ? huge_pages_->stats() : HugePageStats();
+}
+
+LazyFreeStats StorageEngine::lazyFreeStats() const {
+    return lazy_free_.stats();
+}
+
+KeyspaceStats StorageEngine::keyspaceStats() const {
+    KeyspaceStats stats;
+    stats.expired = expired_keys_.load(std::memory_order_relaxed);
     
+    auto now = std::chrono::system_clock::now();
+    long long ttl_sum = 0;
     for (const auto& [key, value] : store_) {
-        if (value.isExpired()) {
-            expired_keys.push_back(key);
+        if (value.isExpired()) continue;
+        stats.keys++;
+        if (value.expiry) {
+            stats.expires++;
+            ttl_sum += std::chrono::duration_cast<std::chrono::milliseconds>(*value.expiry - now).count();
         }
     }
+    if (stats.expires) stats.avg_ttl_ms = ttl_sum / static_cast<long long>(stats.expires);
+    return stats;
+}
+
+KeySpace::iterator StorageEngine::reclaimExpired(KeySpace::iterator it) {
+    keyRemoved(it->first);
+    unindex(it->first, it->second);
+    RedisValue value = std::move(it->second);
+    it = store_.erase(it);
+    dispose(std::move(value));
+    expired_keys_.fetch_add(1, std::memory_order_relaxed);
+    return it;
+}
+
+size_t StorageEngine::cleanupExpired() {
+    size_t removed = 0;
     
-    for (const auto& key : expired_keys) {
-        store_.erase(key);
-        removed++;
+    // Erase-while-iterating is safe with the iterator returned by erase()
+    for (auto it = store_.begin(); it != store_.end();) {
+        if (it->second.isExpired()) {
+            it = reclaimExpired(it);
+            removed++;
+            continue;
+        }
+        
+        // Active field expiry: reclaim expired hash fields too
+        if (it->second.field_expiry) {
+            auto next = std::next(it);
+            if (purgeExpiredFields(it)) {
+                removed++;  // Hash emptied → key removed
+            }
+            it = next;
+            continue;
+        }
+        ++it;
     }
     
     return removed;
+}
+
+ExpireSlice StorageEngine::activeExpireSlice(size_t samples) {
+    ExpireSlice slice;
+    size_t buckets = store_.bucket_count();
+    if (expire_cursor_ >= buckets) expire_cursor_ = 0;  // Rehashed since the last slice
+    
+    // Collect first, erase after: erasing would invalidate the bucket walk
+    auto now = std::chrono::system_clock::now();
+    std::vector<std::string> due;
+    for (size_t walked = 0; walked < samples * kExpireBucketsPerSample && slice.sampled < samples; walked++) {
+        for (auto local = store_.cbegin(expire_cursor_); local != store_.cend(expire_cursor_); ++local) {
+            const RedisValue& value = local->second;
+            if (!value.expiry && !value.field_expiry) continue;
+            
+            slice.sampled++;
+            if (value.isExpired() || (value.field_expiry && value.field_expiry->earliest <= now)) {
+                due.push_back(local->first);
+            }
+        }
+        if (++expire_cursor_ == buckets) {
+            expire_cursor_ = 0;
+            slice.wrapped = true;
+            break;
+        }
+    }
+    
+    for (const auto& key : due) {
+        auto it = store_.find(key);
+        if (it->second.isExpired()) {
+            reclaimExpired(it);
+        } else {
+            purgeExpiredFields(it);
+        }
+        slice.expired++;
+    }
+    return slice;
 }
\ No newline at end of file
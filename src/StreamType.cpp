@@ -0,0 +1,311 @@
+#include "../include/StreamType.h"
+#include <algorithm>
+#include <charconv>
+
+namespace {
+
+// LEB128-style varint: 7 bits per byte, high bit = "more bytes follow"
+void putVarint(std::string& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<char>((v & 0x7F) | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<char>(v));
+}
+
+uint64_t getVarint(const std::string& in, size_t& pos) {
+    uint64_t v = 0;
+    int shift = 0;
+    while (true) {
+        auto byte = static_cast<uint8_t>(in[pos++]);
+        v |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return v;
+        shift += 7;
+    }
+}
+
+void putString(std::string& out, const std::string& s) {
+    putVarint(out, s.size());
+    out.append(s);
+}
+
+std::string getString(const std::string& in, size_t& pos) {
+    size_t len = getVarint(in, pos);
+    std::string s = in.substr(pos, len);
+    pos += len;
+    return s;
+}
+
+// Plain decimal digits only: stoull would accept leading blanks, a '+'
+// and "-3" (wrapping it to 2^64-3); from_chars on an unsigned takes none
+std::optional<uint64_t> parseU64(const char* first, const char* last) {
+    uint64_t v = 0;
+    auto [end, ec] = std::from_chars(first, last, v);
+    if (ec != std::errc() || end != last) return std::nullopt;
+    return v;
+}
+
+uint64_t nowMs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+}  // namespace
+
+// ========== STREAM ID ==========
+
+std::optional<StreamID> StreamID::parse(const std::string& text, uint64_t missing_seq) {
+    const char* begin = text.data();
+    const char* end = begin + text.size();
+    const char* dash = std::find(begin, end, '-');
+
+    auto ms = parseU64(begin, dash);
+    if (!ms) return std::nullopt;
+
+    StreamID id{*ms, missing_seq};
+    if (dash != end) {
+        auto seq = parseU64(dash + 1, end);
+        if (!seq) return std::nullopt;
+        id.seq = *seq;
+    }
+    return id;
+}
+
+std::string StreamID::toString() const {
+    return std::to_string(ms) + "-" + std::to_string(seq);
+}
+
+// ========== PACKED BLOCK ==========
+
+void RedisStream::Block::append(StreamID id, const StreamFields& fields) {
+    if (offsets.empty()) {
+        first = id;
+        master_fields.clear();
+        for (const auto& [name, value] : fields) master_fields.push_back(name);
+    }
+
+    bool same_fields = fields.size() == master_fields.size();
+    for (size_t i = 0; same_fields && i < fields.size(); i++) {
+        same_fields = fields[i].first == master_fields[i];
+    }
+
+    offsets.push_back(static_cast<uint32_t>(payload.size()));
+    putVarint(payload, id.ms - first.ms);
+    putVarint(payload, id.seq);
+    putVarint(payload, (fields.size() << 1) | (same_fields ? 1 : 0));
+
+    for (const auto& [name, value] : fields) {
+        if (!same_fields) putString(payload, name);
+        putString(payload, value);
+    }
+}
+
+StreamID RedisStream::Block::idAt(size_t index) const {
+    size_t pos = offsets[index];
+    StreamID id;
+    id.ms = first.ms + getVarint(payload, pos);
+    id.seq = getVarint(payload, pos);
+    return id;
+}
+
+StreamEntry RedisStream::Block::decode(size_t index) const {
+    size_t pos = offsets[index];
+    StreamEntry entry;
+    entry.id.ms = first.ms + getVarint(payload, pos);
+    entry.id.seq = getVarint(payload, pos);
+
+    uint64_t header = getVarint(payload, pos);
+    bool same_fields = header & 1;
+    size_t count = header >> 1;
+
+    entry.fields.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        std::string name = same_fields ? master_fields[i] : getString(payload, pos);
+        entry.fields.emplace_back(std::move(name), getString(payload, pos));
+    }
+    return entry;
+}
+
+// ========== APPEND / READ ==========
+
+std::optional<StreamID> RedisStream::add(const std::string& id_spec, const StreamFields& fields) {
+    StreamID id;
+
+    if (id_spec == "*") {
+        uint64_t ms = nowMs();
+        if (ms > last_id_.ms) {
+            id = StreamID{ms, 0};
+        } else {
+            // Clock went backwards or same ms: keep IDs monotonic
+            if (last_id_.seq == UINT64_MAX) return std::nullopt;
+            id = StreamID{last_id_.ms, last_id_.seq + 1};
+        }
+    } else if (id_spec.size() > 2 && id_spec.compare(id_spec.size() - 2, 2, "-*") == 0) {
+        auto ms = StreamID::parse(id_spec.substr(0, id_spec.size() - 2));
+        if (!ms) return std::nullopt;
+        id = StreamID{ms->ms, ms->ms == last_id_.ms ? last_id_.seq + 1 : 0};
+    } else {
+        auto parsed = StreamID::parse(id_spec);
+        if (!parsed) return std::nullopt;
+        id = *parsed;
+    }
+
+    // IDs must strictly increase (and 0-0 is reserved)
+    if (id <= last_id_) return std::nullopt;
+
+    if (blocks_.empty() || blocks_.rbegin()->second.size() >= kBlockEntries) {
+        Block block;
+        block.append(id, fields);
+        blocks_.emplace(id, std::move(block));
+    } else {
+        blocks_.rbegin()->second.append(id, fields);
+    }
+
+    last_id_ = id;
+    length_++;
+    return id;
+}
+
+template <typename Fn>
+void RedisStream::scan(StreamID start, StreamID end, Fn&& fn) const {
+    if (blocks_.empty() || end < start) return;
+
+    // Seek: last block whose first ID <= start
+    auto it = blocks_.upper_bound(start);
+    if (it != blocks_.begin()) --it;
+
+    for (; it != blocks_.end() && it->first <= end; ++it) {
+        const Block& block = it->second;
+        for (size_t i = 0; i < block.size(); i++) {
+            StreamID id = block.idAt(i);
+            if (id < start) continue;
+            if (end < id) return;
+            if (!fn(block, i)) return;
+        }
+    }
+}
+
+std::vector<StreamEntry> RedisStream::range(StreamID start, StreamID end, size_t count) const {
+    std::vector<StreamEntry> result;
+    scan(start, end, [&](const Block& block, size_t i) {
+        result.push_back(block.decode(i));
+        return count == 0 || result.size() < count;
+    });
+    return result;
+}
+
+std::vector<StreamEntry> RedisStream::after(StreamID id, size_t count) const {
+    if (id == StreamID::max()) return {};
+    StreamID start = id.seq == UINT64_MAX ? StreamID{id.ms + 1, 0} : StreamID{id.ms, id.seq + 1};
+    return range(start, StreamID::max(), count);
+}
+
+std::optional<StreamEntry> RedisStream::find(StreamID id) const {
+    auto entries = range(id, id, 1);
+    if (entries.empty()) return std::nullopt;
+    return entries.front();
+}
+
+size_t RedisStream::trim(size_t maxlen) {
+    if (length_ <= maxlen) return 0;
+    size_t to_remove = length_ - maxlen;
+    size_t removed = 0;
+
+    // Whole blocks first - O(1) per block
+    while (!blocks_.empty() && removed + blocks_.begin()->second.size() <= to_remove) {
+        removed += blocks_.begin()->second.size();
+        blocks_.erase(blocks_.begin());
+    }
+
+    // Partial head block: repack its surviving tail (at most kBlockEntries)
+    if (removed < to_remove && !blocks_.empty()) {
+        const Block& old_block = blocks_.begin()->second;
+        size_t skip = to_remove - removed;
+
+        Block repacked;
+        for (size_t i = skip; i < old_block.size(); i++) {
+            StreamEntry entry = old_block.decode(i);
+            repacked.append(entry.id, entry.fields);
+        }
+        StreamID first = repacked.first;
+
+        blocks_.erase(blocks_.begin());
+        blocks_.emplace(first, std::move(repacked));
+        removed += skip;
+    }
+
+    length_ -= removed;
+    return removed;
+}
+
+// ========== CONSUMER GROUPS ==========
+
+bool RedisStream::createGroup(const std::string& group, StreamID start) {
+    return groups_.emplace(group, ConsumerGroup{start, {}}).second;
+}
+
+std::optional<std::vector<StreamEntry>> RedisStream::readGroupNew(const std::string& group,
+                                                                  const std::string& consumer,
+                                                                  size_t count) {
+    auto git = groups_.find(group);
+    if (git == groups_.end()) return std::nullopt;
+    ConsumerGroup& cg = git->second;
+
+    auto entries = after(cg.last_delivered, count);
+    auto now = std::chrono::steady_clock::now();
+
+    for (const auto& entry : entries) {
+        cg.pending[entry.id] = PendingEntry{consumer, now, 1};
+        cg.last_delivered = entry.id;
+    }
+    return entries;
+}
+
+std::optional<std::vector<StreamEntry>> RedisStream::readGroupPending(const std::string& group,
+                                                                      const std::string& consumer,
+                                                                      StreamID id, size_t count) {
+    auto git = groups_.find(group);
+    if (git == groups_.end()) return std::nullopt;
+    ConsumerGroup& cg = git->second;
+
+    std::vector<StreamEntry> result;
+    auto now = std::chrono::steady_clock::now();
+
+    for (auto pit = cg.pending.upper_bound(id); pit != cg.pending.end(); ++pit) {
+        if (count > 0 && result.size() >= count) break;
+        if (pit->second.consumer != consumer) continue;
+
+        pit->second.delivered = now;
+        pit->second.delivery_count++;
+
+        // Trimmed entries stay pending but come back with no fields
+        auto entry = find(pit->first);
+        result.push_back(entry ? std::move(*entry) : StreamEntry{pit->first, {}});
+    }
+    return result;
+}
+
+size_t RedisStream::ack(const std::string& group, const std::vector<StreamID>& ids) {
+    auto git = groups_.find(group);
+    if (git == groups_.end()) return 0;
+
+    size_t acked = 0;
+    for (const auto& id : ids) {
+        acked += git->second.pending.erase(id);
+    }
+    return acked;
+}
+
+std::vector<StreamPendingInfo> RedisStream::pending(const std::string& group, size_t count) const {
+    std::vector<StreamPendingInfo> result;
+    auto git = groups_.find(group);
+    if (git == groups_.end()) return result;
+
+    auto now = std::chrono::steady_clock::now();
+    for (const auto& [id, pe] : git->second.pending) {
+        if (count > 0 && result.size() >= count) break;
+        auto idle = std::chrono::duration_cast<std::chrono::milliseconds>(now - pe.delivered).count();
+        result.push_back(StreamPendingInfo{id, pe.consumer, static_cast<int64_t>(idle), pe.delivery_count});
+    }
+    return result;
+}
@@ -0,0 +1,204 @@
+#include "../include/TDigestType.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace {
+
+constexpr size_t kBufferFactor = 4;  // Buffer capacity = factor * compression
+
+// k2 scale function and its inverse: centroid q-widths shrink
+// like q(1-q), so tail centroids hold only a handful of samples
+double normalizer(double compression, double total) {
+    return 4 * std::log(std::max(1.0, total / compression)) + 24;
+}
+
+double scaleK(double q, double compression, double norm) {
+    q = std::clamp(q, 1e-15, 1 - 1e-15);
+    return compression * std::log(q / (1 - q)) / norm;
+}
+
+double scaleQ(double k, double compression, double norm) {
+    double w = std::exp(k * norm / compression);
+    return w / (1 + w);
+}
+
+}  // namespace
+
+TDigest::TDigest(double compression)
+    : compression_(std::max(10.0, compression)),
+      min_(std::numeric_limits<double>::infinity()),
+      max_(-std::numeric_limits<double>::infinity()) {
+    buffer_.reserve(kBufferFactor * static_cast<size_t>(compression_));
+}
+
+void TDigest::add(double value) {
+    if (std::isnan(value)) return;
+
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+    buffer_.push_back(value);
+    if (buffer_.size() >= kBufferFactor * static_cast<size_t>(compression_)) compress();
+}
+
+void TDigest::add(const std::vector<double>& values) {
+    for (double value : values) add(value);
+}
+
+void TDigest::merge(const TDigest& other) {
+    if (other.totalWeight() == 0) return;
+
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+
+    std::vector<double> means = other.means_;
+    std::vector<double> weights = other.weights_;
+    means.insert(means.end(), other.buffer_.begin(), other.buffer_.end());
+    weights.resize(means.size(), 1.0);
+    compress(std::move(means), std::move(weights));
+}
+
+void TDigest::compress(std::vector<double> extra_means, std::vector<double> extra_weights) {
+    if (buffer_.empty() && extra_means.empty()) return;
+
+    // Gather everything as (mean, weight), sorted by mean
+    std::vector<double> in_means = std::move(means_);
+    std::vector<double> in_weights = std::move(weights_);
+    in_means.insert(in_means.end(), buffer_.begin(), buffer_.end());
+    in_weights.resize(in_means.size(), 1.0);
+    in_means.insert(in_means.end(), extra_means.begin(), extra_means.end());
+    in_weights.insert(in_weights.end(), extra_weights.begin(), extra_weights.end());
+    buffer_.clear();
+
+    std::vector<size_t> order(in_means.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return in_means[a] < in_means[b]; });
+
+    double total = std::accumulate(in_weights.begin(), in_weights.end(), 0.0);
+
+    // One pass: grow the current centroid while it stays within one
+    // unit of k; otherwise start a new one
+    means_.clear();
+    weights_.clear();
+
+    double mean = in_means[order[0]];
+    double weight = in_weights[order[0]];
+    double weight_so_far = 0;
+    // Like the reference merging digest, allow up to 2 x compression centroids
+    double scale = 2 * compression_;
+    double norm = normalizer(scale, total);
+    double weight_limit = total * scaleQ(scaleK(0, scale, norm) + 1, scale, norm);
+
+    for (size_t i = 1; i < order.size(); i++) {
+        double m = in_means[order[i]];
+        double w = in_weights[order[i]];
+
+        if (weight_so_far + weight + w <= weight_limit) {
+            weight += w;
+            mean += (m - mean) * w / weight;
+        } else {
+            means_.push_back(mean);
+            weights_.push_back(weight);
+            weight_so_far += weight;
+            weight_limit = total * scaleQ(scaleK(weight_so_far / total, scale, norm) + 1, scale, norm);
+            mean = m;
+            weight = w;
+        }
+    }
+    means_.push_back(mean);
+    weights_.push_back(weight);
+    total_weight_ = total;
+}
+
+double TDigest::quantile(double q) const {
+    return quantile(std::vector<double>{q}).front();
+}
+
+double TDigest::cdf(double value) const {
+    return cdf(std::vector<double>{value}).front();
+}
+
+std::vector<double> TDigest::quantile(const std::vector<double>& qs) const {
+    if (!buffer_.empty()) {
+        TDigest merged = *this;
+        merged.compress();
+        return merged.quantile(qs);
+    }
+
+    std::vector<double> result;
+    result.reserve(qs.size());
+    for (double q : qs) result.push_back(quantileMerged(q));
+    return result;
+}
+
+std::vector<double> TDigest::cdf(const std::vector<double>& values) const {
+    if (!buffer_.empty()) {
+        TDigest merged = *this;
+        merged.compress();
+        return merged.cdf(values);
+    }
+
+    std::vector<double> result;
+    result.reserve(values.size());
+    for (double value : values) result.push_back(cdfMerged(value));
+    return result;
+}
+
+double TDigest::quantileMerged(double q) const {
+    size_t n = means_.size();
+    if (n == 0 || std::isnan(q)) return std::numeric_limits<double>::quiet_NaN();
+    if (q <= 0) return min_;
+    if (q >= 1) return max_;
+    if (n == 1) return means_[0];
+
+    // Interpolate between centroid centers; each centroid's weight is
+    // centered on its mean, the ends interpolate towards min/max
+    double index = q * total_weight_;
+    if (index < weights_[0] / 2) {
+        return min_ + (means_[0] - min_) * index / (weights_[0] / 2);
+    }
+
+    double weight_so_far = weights_[0] / 2;
+    for (size_t i = 0; i + 1 < n; i++) {
+        double dw = (weights_[i] + weights_[i + 1]) / 2;
+        if (weight_so_far + dw > index) {
+            double t = (index - weight_so_far) / dw;
+            return means_[i] + (means_[i + 1] - means_[i]) * t;
+        }
+        weight_so_far += dw;
+    }
+
+    double tail = weights_[n - 1] / 2;
+    double t = std::min(1.0, (index - weight_so_far) / tail);
+    return means_[n - 1] + (max_ - means_[n - 1]) * t;
+}
+
+double TDigest::cdfMerged(double value) const {
+    size_t n = means_.size();
+    if (n == 0 || std::isnan(value)) return std::numeric_limits<double>::quiet_NaN();
+    if (value < min_) return 0;
+    if (value >= max_) return 1;
+    if (n == 1) return (value - min_) / (max_ - min_);
+
+    double total = total_weight_;
+    if (value < means_[0]) {
+        double span = means_[0] - min_;
+        return span > 0 ? (value - min_) / span * (weights_[0] / 2) / total : 0;
+    }
+
+    double weight_so_far = weights_[0] / 2;
+    for (size_t i = 0; i + 1 < n; i++) {
+        double dw = (weights_[i] + weights_[i + 1]) / 2;
+        if (value < means_[i + 1]) {
+            double span = means_[i + 1] - means_[i];
+            double t = span > 0 ? (value - means_[i]) / span : 0;
+            return (weight_so_far + dw * t) / total;
+        }
+        weight_so_far += dw;
+    }
+
+    double span = max_ - means_[n - 1];
+    double t = span > 0 ? (value - means_[n - 1]) / span : 1;
+    return (weight_so_far + weights_[n - 1] / 2 * t) / total;
+}
@@ -0,0 +1,115 @@
+#include "../include/TenantQuota.h"
+#include <random>
+
+// ========== TENANT QUOTAS ==========
+
+static std::mt19937_64& sampler() {
+    thread_local std::mt19937_64 rng(std::random_device{}());
+    return rng;
+}
+
+bool QuotaTable::define(const std::string& name, const std::string& prefix, size_t budget) {
+    for (auto& ns : namespaces_) {
+        if (ns->name == name) {
+            if (ns->prefix != prefix) return false;  // Re-prefixing would orphan the ledger
+            ns->budget = budget;
+            return true;
+        }
+        if (ns->prefix == prefix) return false;
+    }
+
+    auto ns = std::make_unique<Namespace>();
+    ns->name = name;
+    ns->prefix = prefix;
+    ns->budget = budget;
+    namespaces_.push_back(std::move(ns));
+    return true;
+}
+
+bool QuotaTable::drop(const std::string& name) {
+    for (auto it = namespaces_.begin(); it != namespaces_.end(); ++it) {
+        if ((*it)->name == name) {
+            namespaces_.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<NamespaceStats> QuotaTable::stats() const {
+    std::vector<NamespaceStats> result;
+    result.reserve(namespaces_.size());
+    for (const auto& ns : namespaces_) {
+        NamespaceStats stats;
+        stats.name = ns->name;
+        stats.prefix = ns->prefix;
+        stats.budget = ns->budget;
+        stats.used = ns->used;
+        stats.keys = ns->ledger.size();
+        stats.hits = ns->hits.load(std::memory_order_relaxed);
+        stats.misses = ns->misses.load(std::memory_order_relaxed);
+        stats.evictions = ns->evictions;
+        result.push_back(std::move(stats));
+    }
+    return result;
+}
+
+QuotaTable::Namespace* QuotaTable::owner(std::string_view key) const {
+    Namespace* best = nullptr;
+    for (const auto& ns : namespaces_) {
+        if (key.compare(0, ns->prefix.size(), ns->prefix) != 0) continue;
+        if (!best || ns->prefix.size() > best->prefix.size()) best = ns.get();
+    }
+    return best;
+}
+
+void QuotaTable::charge(Namespace& ns, const std::string& key, size_t bytes) {
+    if (bytes == 0) {
+        auto it = ns.ledger.find(key);
+        if (it == ns.ledger.end()) return;
+        ns.used -= it->second.bytes;
+        ns.ledger.erase(it);
+        return;
+    }
+
+    auto& entry = ns.ledger[key];
+    ns.used = ns.used - entry.bytes + bytes;
+    entry.bytes = bytes;
+    entry.last_access.value.store(clock_.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void QuotaTable::touch(std::string_view key, bool found, bool read) {
+    Namespace* ns = owner(key);
+    if (!ns) return;
+
+    if (read) (found ? ns->hits : ns->misses).fetch_add(1, std::memory_order_relaxed);
+    if (!found) return;
+
+    auto it = ns->ledger.find(key);
+    if (it != ns->ledger.end()) {
+        it->second.last_access.value.store(clock_.fetch_add(1, std::memory_order_relaxed) + 1,
+                                           std::memory_order_relaxed);
+    }
+}
+
+const std::string* QuotaTable::victim(const Namespace& ns) const {
+    if (ns.ledger.empty()) return nullptr;
+
+    std::uniform_int_distribution<size_t> pick(0, ns.ledger.size() - 1);
+    const std::pair<std::string, Charge>* oldest = nullptr;
+    for (size_t i = 0; i < kEvictionSamples; i++) {
+        const auto& entry = ns.ledger.at(pick(sampler()));
+        if (!oldest || entry.second.last_access.value.load(std::memory_order_relaxed) <
+                           oldest->second.last_access.value.load(std::memory_order_relaxed)) {
+            oldest = &entry;
+        }
+    }
+    return &oldest->first;
+}
+
+void QuotaTable::clearCharges() {
+    for (auto& ns : namespaces_) {
+        ns->ledger.clear();
+        ns->used = 0;
+    }
+}
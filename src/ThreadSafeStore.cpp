@@ -1,150 +1,934 @@
 #include "../include/ThreadSafeStore.h"
+#include <algorithm>
+#include <unordered_map>
+
+// Per-thread SELECT state: store id → selected database. A thread that
+// never selects stays on 0 without touching the map.
+static std::unordered_map<uint64_t, size_t>& selections() {
+    static thread_local std::unordered_map<uint64_t, size_t> table;
+    return table;
+}
+
+static uint64_t nextStoreId() {
+    static std::atomic<uint64_t> next{1};
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+ThreadSafeStore::ThreadSafeStore(const StorageOptions& options, size_t databases)
+    : id_(nextStoreId()) {
+    databases = std::max<size_t>(databases, 1);
+    dbs_.reserve(databases);
+    for (size_t i = 0; i < databases; i++) {
+        dbs_.push_back(std::make_unique<KeyValueStore>(options));
+        dbs_.back()->getStorage().setTracking(&tracking_);
+    }
+}
+
+ThreadSafeStore::~ThreadSafeStore() {
+    // Join background threads while the databases are still alive
+    stopActiveExpiry();
+    executor_.reset();
+}
 
 // ========== STRING COMMANDS ==========
 
 bool ThreadSafeStore::set(const std::string& key, const std::string& value, int ttl) {
     // Write operation - exclusive lock
     std::unique_lock<std::shared_mutex> lock(mutex_);
-    return store_.set(key, value, ttl);
+    return db().set(key, value, ttl);
+}
+
+SetResult ThreadSafeStore::set(const std::string& key, const std::string& value, const SetOptions& options) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().set(key, value, options);
 }
 
 std::optional<std::string> ThreadSafeStore::get(const std::string& key) const {
     // Read operation - shared lock (multiple readers allowed)
     std::shared_lock<std::shared_mutex> lock(mutex_);
-    return store_.get(key);
+    return db().get(key);
+}
+
+size_t ThreadSafeStore::append(const std::string& key, const std::string& value) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().append(key, value);
+}
+
+size_t ThreadSafeStore::setrange(const std::string& key, size_t offset, const std::string& value) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().setrange(key, offset, value);
+}
+
+std::string ThreadSafeStore::getrange(const std::string& key, long start, long end) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().getrange(key, start, end);
+}
+
+size_t ThreadSafeStore::strlen(const std::string& key) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().strlen(key);
+}
+
+std::optional<std::string> ThreadSafeStore::getex(const std::string& key, int ttl, bool persist) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().getex(key, ttl, persist);
+}
+
+std::optional<std::string> ThreadSafeStore::getdel(const std::string& key) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().getdel(key);
 }
 
 // ========== LIST COMMANDS ==========
 
 size_t ThreadSafeStore::lpush(const std::string& key, const std::vector<std::string>& values) {
     std::unique_lock<std::shared_mutex> lock(mutex_);
-    return store_.lpush(key, values);
+    return db().lpush(key, values);
 }
 
 size_t ThreadSafeStore::rpush(const std::string& key, const std::vector<std::string>& values) {
     std::unique_lock<std::shared_mutex> lock(mutex_);
-    return store_.rpush(key, values);
+    return db().rpush(key, values);
 }
 
 std::optional<std::string> ThreadSafeStore::lpop(const std::string& key) {
     std::unique_lock<std::shared_mutex> lock(mutex_);
-    return store_.lpop(key);
+    return db().lpop(key);
 }
 
 std::optional<std::string> ThreadSafeStore::rpop(const std::string& key) {
     std::unique_lock<std::shared_mutex> lock(mutex_);
-    return store_.rpop(key);
+    return db().rpop(key);
 }
 
 std::vector<std::string> ThreadSafeStore::lrange(const std::string& key, int start, int stop) const {
     std::shared_lock<std::shared_mutex> lock(mutex_);
-    return store_.lrange(key, start, stop);
+    return db().lrange(key, start, stop);
 }
 
 size_t ThreadSafeStore::llen(const std::string& key) const {
     std::shared_lock<std::shared_mutex> lock(mutex_);
-    return store_.llen(key);
+    return db().llen(key);
+}
+
+std::optional<std::string> ThreadSafeStore::lindex(const std::string& key, int index) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().lindex(key, index);
+}
+
+bool ThreadSafeStore::lset(const std::string& key, int index, const std::string& value) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().lset(key, index, value);
+}
+
+long ThreadSafeStore::linsert(const std::string& key, ListInsert where, const std::string& pivot, const std::string& value) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().linsert(key, where, pivot, value);
+}
+
+bool ThreadSafeStore::ltrim(const std::string& key, int start, int stop) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().ltrim(key, start, stop);
+}
+
+size_t ThreadSafeStore::lrem(const std::string& key, int count, const std::string& value) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().lrem(key, count, value);
+}
+
+std::vector<size_t> ThreadSafeStore::lpos(const std::string& key, const std::string& value, int rank, size_t count, size_t maxlen) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().lpos(key, value, rank, count, maxlen);
+}
+
+std::optional<std::string> ThreadSafeStore::lmove(const std::string& source, const std::string& destination, ListEnd from, ListEnd to) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().lmove(source, destination, from, to);
 }
 
 // ========== SET COMMANDS ==========
 
 size_t ThreadSafeStore::sadd(const std::string& key, const std::vector<std::string>& members) {
     std::unique_lock<std::shared_mutex> lock(mutex_);
-    return store_.sadd(key, members);
+    return db().sadd(key, members);
 }
 
 size_t ThreadSafeStore::srem(const std::string& key, const std::vector<std::string>& members) {
     std::unique_lock<std::shared_mutex> lock(mutex_);
-    return store_.srem(key, members);
+    return db().srem(key, members);
 }
 
 bool ThreadSafeStore::sismember(const std::string& key, const std::string& member) const {
     std::shared_lock<std::shared_mutex> lock(mutex_);
-    return store_.sismember(key, member);
+    return db().sismember(key, member);
 }
 
 std::vector<std::string> ThreadSafeStore::smembers(const std::string& key) const {
     std::shared_lock<std::shared_mutex> lock(mutex_);
-    return store_.smembers(key);
+    return db().smembers(key);
 }
 
 size_t ThreadSafeStore::scard(const std::string& key) const {
     std::shared_lock<std::shared_mutex> lock(mutex_);
-    return store_.scard(key);
+    return db().scard(key);
+}
+
+std::vector<bool> ThreadSafeStore::smismember(const std::string& key, const std::vector<std::string>& members) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().smismember(key, members);
+}
+
+std::vector<std::string> ThreadSafeStore::srandmember(const std::string& key, long count) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().srandmember(key, count);
+}
+
+std::vector<std::string> ThreadSafeStore::spop(const std::string& key, size_t count) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().spop(key, count);
 }
 
 // ========== HASH COMMANDS ==========
 
 bool ThreadSafeStore::hset(const std::string& key, const std::string& field, const std::string& value) {
     std::unique_lock<std::shared_mutex> lock(mutex_);
-    return store_.hset(key, field, value);
+    return db().hset(key, field, value);
 }
 
 std::optional<std::string> ThreadSafeStore::hget(const std::string& key, const std::string& field) const {
     std::shared_lock<std::shared_mutex> lock(mutex_);
-    return store_.hget(key, field);
+    return db().hget(key, field);
 }
 
 size_t ThreadSafeStore::hdel(const std::string& key, const std::vector<std::string>& fields) {
     std::unique_lock<std::shared_mutex> lock(mutex_);
-    return store_.hdel(key, fields);
+    return db().hdel(key, fields);
 }
 
 bool ThreadSafeStore::hexists(const std::string& key, const std::string& field) const {
     std::shared_lock<std::shared_mutex> lock(mutex_);
-    return store_.hexists(key, field);
+    return db().hexists(key, field);
 }
 
 std::unordered_map<std::string, std::string> ThreadSafeStore::hgetall(const std::string& key) const {
     std::shared_lock<std::shared_mutex> lock(mutex_);
-    return store_.hgetall(key);
+    return db().hgetall(key);
 }
 
 size_t ThreadSafeStore::hlen(const std::string& key) const {
     std::shared_lock<std::shared_mutex> lock(mutex_);
-    return store_.hlen(key);
+    return db().hlen(key);
+}
+
+std::vector<int> ThreadSafeStore::hexpire(const std::string& key, int seconds, const std::vector<std::string>& fields) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().hexpire(key, seconds, fields);
+}
+
+std::vector<int> ThreadSafeStore::httl(const std::string& key, const std::vector<std::string>& fields) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().httl(key, fields);
+}
+
+std::vector<int> ThreadSafeStore::hpersist(const std::string& key, const std::vector<std::string>& fields) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().hpersist(key, fields);
+}
+
+size_t ThreadSafeStore::hset(const std::string& key, const std::vector<std::pair<std::string, std::string>>& fields) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().hset(key, fields);
+}
+
+std::vector<std::optional<std::string>> ThreadSafeStore::hmget(const std::string& key, const std::vector<std::string>& fields) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().hmget(key, fields);
+}
+
+std::vector<std::pair<std::string, std::string>> ThreadSafeStore::hrandfield(const std::string& key, long count) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().hrandfield(key, count);
+}
+
+// ========== STREAM COMMANDS ==========
+
+std::optional<std::string> ThreadSafeStore::xadd(const std::string& key, const std::string& id,
+                                                 const StreamFields& fields, size_t maxlen) {
+    std::optional<std::string> added;
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        added = db().xadd(key, id, fields, maxlen);
+    }
+    if (added) stream_cv_.notify_all();  // Wake blocked XREADs
+    return added;
+}
+
+std::vector<StreamEntry> ThreadSafeStore::xrange(const std::string& key, const std::string& start,
+                                                 const std::string& end, size_t count) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().xrange(key, start, end, count);
+}
+
+std::vector<std::pair<std::string, std::vector<StreamEntry>>> ThreadSafeStore::xread(
+    const std::vector<std::pair<std::string, std::string>>& streams,
+    size_t count, int block_ms) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    
+    // Pin "$" to the current last ID so later XADDs are what we wait for
+    auto resolved = streams;
+    for (auto& [key, id] : resolved) {
+        if (id == "$") id = db().streamLastId(key);
+    }
+    
+    auto result = db().xread(resolved, count);
+    if (!result.empty() || block_ms < 0) return result;
+    
+    // condition_variable_any releases the shared lock while waiting
+    auto ready = [&] {
+        result = db().xread(resolved, count);
+        return !result.empty();
+    };
+    if (block_ms == 0) {
+        stream_cv_.wait(lock, ready);
+    } else {
+        stream_cv_.wait_for(lock, std::chrono::milliseconds(block_ms), ready);
+    }
+    return result;
+}
+
+size_t ThreadSafeStore::xlen(const std::string& key) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().xlen(key);
+}
+
+size_t ThreadSafeStore::xtrim(const std::string& key, size_t maxlen) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().xtrim(key, maxlen);
+}
+
+bool ThreadSafeStore::xgroupCreate(const std::string& key, const std::string& group,
+                                   const std::string& id, bool mkstream) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().xgroupCreate(key, group, id, mkstream);
+}
+
+std::optional<std::vector<StreamEntry>> ThreadSafeStore::xreadgroup(const std::string& key, const std::string& group,
+                                                                    const std::string& consumer,
+                                                                    const std::string& id, size_t count) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().xreadgroup(key, group, consumer, id, count);
+}
+
+size_t ThreadSafeStore::xack(const std::string& key, const std::string& group, const std::vector<std::string>& ids) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().xack(key, group, ids);
+}
+
+std::vector<StreamPendingInfo> ThreadSafeStore::xpending(const std::string& key, const std::string& group, size_t count) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().xpending(key, group, count);
+}
+
+// ========== GEO COMMANDS ==========
+
+size_t ThreadSafeStore::geoadd(const std::string& key, const std::vector<GeoMember>& members) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().geoadd(key, members);
+}
+
+std::vector<std::optional<std::pair<double, double>>> ThreadSafeStore::geopos(const std::string& key,
+                                                                              const std::vector<std::string>& members) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().geopos(key, members);
+}
+
+std::optional<double> ThreadSafeStore::geodist(const std::string& key, const std::string& member1,
+                                               const std::string& member2, const std::string& unit) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().geodist(key, member1, member2, unit);
+}
+
+std::vector<GeoResult> ThreadSafeStore::geosearch(const std::string& key, const GeoSearchQuery& query) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().geosearch(key, query);
+}
+
+// ========== BLOOM / CUCKOO FILTER COMMANDS ==========
+
+bool ThreadSafeStore::bfreserve(const std::string& key, double error_rate, size_t capacity, unsigned expansion) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().bfreserve(key, error_rate, capacity, expansion);
+}
+
+bool ThreadSafeStore::bfadd(const std::string& key, const std::string& item) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().bfadd(key, item);
+}
+
+std::vector<bool> ThreadSafeStore::bfmadd(const std::string& key, const std::vector<std::string>& items) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().bfmadd(key, items);
+}
+
+bool ThreadSafeStore::bfexists(const std::string& key, const std::string& item) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().bfexists(key, item);
+}
+
+std::vector<bool> ThreadSafeStore::bfmexists(const std::string& key, const std::vector<std::string>& items) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().bfmexists(key, items);
+}
+
+bool ThreadSafeStore::cfreserve(const std::string& key, size_t capacity, unsigned expansion) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().cfreserve(key, capacity, expansion);
+}
+
+bool ThreadSafeStore::cfadd(const std::string& key, const std::string& item) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().cfadd(key, item);
+}
+
+bool ThreadSafeStore::cfexists(const std::string& key, const std::string& item) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().cfexists(key, item);
+}
+
+std::vector<bool> ThreadSafeStore::cfmexists(const std::string& key, const std::vector<std::string>& items) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().cfmexists(key, items);
+}
+
+bool ThreadSafeStore::cfdel(const std::string& key, const std::string& item) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().cfdel(key, item);
+}
+
+// ========== COUNT-MIN / TOP-K SKETCH COMMANDS ==========
+
+bool ThreadSafeStore::cmsInitByDim(const std::string& key, size_t width, size_t depth) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().cmsInitByDim(key, width, depth);
+}
+
+bool ThreadSafeStore::cmsInitByProb(const std::string& key, double error, double probability) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().cmsInitByProb(key, error, probability);
+}
+
+std::vector<uint64_t> ThreadSafeStore::cmsIncrBy(const std::string& key, const std::vector<std::pair<std::string, uint64_t>>& increments) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().cmsIncrBy(key, increments);
+}
+
+std::vector<uint64_t> ThreadSafeStore::cmsQuery(const std::string& key, const std::vector<std::string>& items) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().cmsQuery(key, items);
+}
+
+bool ThreadSafeStore::cmsMerge(const std::string& dest, const std::vector<std::string>& sources, const std::vector<uint64_t>& weights) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().cmsMerge(dest, sources, weights);
+}
+
+bool ThreadSafeStore::topkReserve(const std::string& key, size_t k, size_t width, size_t depth, double decay) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().topkReserve(key, k, width, depth, decay);
+}
+
+std::vector<std::optional<std::string>> ThreadSafeStore::topkAdd(const std::string& key, const std::vector<std::string>& items) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().topkAdd(key, items);
+}
+
+std::vector<std::optional<std::string>> ThreadSafeStore::topkIncrBy(const std::string& key, const std::vector<std::pair<std::string, uint64_t>>& increments) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().topkIncrBy(key, increments);
+}
+
+std::vector<bool> ThreadSafeStore::topkQuery(const std::string& key, const std::vector<std::string>& items) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().topkQuery(key, items);
+}
+
+std::vector<std::pair<std::string, uint32_t>> ThreadSafeStore::topkList(const std::string& key) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().topkList(key);
+}
+
+bool ThreadSafeStore::topkMerge(const std::string& dest, const std::vector<std::string>& sources) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().topkMerge(dest, sources);
+}
+
+// ========== T-DIGEST COMMANDS ==========
+
+bool ThreadSafeStore::tdigestCreate(const std::string& key, double compression) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().tdigestCreate(key, compression);
+}
+
+bool ThreadSafeStore::tdigestAdd(const std::string& key, const std::vector<double>& values) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().tdigestAdd(key, values);
+}
+
+std::vector<double> ThreadSafeStore::tdigestQuantile(const std::string& key, const std::vector<double>& quantiles) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().tdigestQuantile(key, quantiles);
+}
+
+std::vector<double> ThreadSafeStore::tdigestCdf(const std::string& key, const std::vector<double>& values) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().tdigestCdf(key, values);
+}
+
+bool ThreadSafeStore::tdigestMerge(const std::string& dest, const std::vector<std::string>& sources, double compression) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().tdigestMerge(dest, sources, compression);
+}
+
+// ========== TIME SERIES COMMANDS ==========
+
+bool ThreadSafeStore::tsCreate(const std::string& key, int64_t retention_ms) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().tsCreate(key, retention_ms);
+}
+
+bool ThreadSafeStore::tsAdd(const std::string& key, int64_t timestamp, double value) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().tsAdd(key, timestamp, value);
+}
+
+size_t ThreadSafeStore::tsMadd(const std::string& key, const std::vector<TimeSeriesSample>& samples) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().tsMadd(key, samples);
+}
+
+std::optional<TimeSeriesSample> ThreadSafeStore::tsGet(const std::string& key) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().tsGet(key);
+}
+
+std::vector<TimeSeriesSample> ThreadSafeStore::tsRange(const std::string& key, int64_t from, int64_t to, TimeSeriesAggregation aggregation, int64_t bucket_ms) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().tsRange(key, from, to, aggregation, bucket_ms);
+}
+
+std::optional<TimeSeriesInfo> ThreadSafeStore::tsInfo(const std::string& key) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().tsInfo(key);
+}
+
+// ========== JSON COMMANDS ==========
+
+bool ThreadSafeStore::jsonSet(const std::string& key, const std::string& path, const std::string& json) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().jsonSet(key, path, json);
+}
+
+std::optional<std::string> ThreadSafeStore::jsonGet(const std::string& key, const std::string& path) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().jsonGet(key, path);
+}
+
+size_t ThreadSafeStore::jsonDel(const std::string& key, const std::string& path) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().jsonDel(key, path);
+}
+
+std::optional<std::string> ThreadSafeStore::jsonNumIncrBy(const std::string& key, const std::string& path, double increment) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().jsonNumIncrBy(key, path, increment);
+}
+
+std::optional<size_t> ThreadSafeStore::jsonArrAppend(const std::string& key, const std::string& path, const std::vector<std::string>& values) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().jsonArrAppend(key, path, values);
+}
+
+std::optional<std::string> ThreadSafeStore::jsonType(const std::string& key, const std::string& path) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().jsonType(key, path);
+}
+
+// ========== VECTOR SET COMMANDS ==========
+
+bool ThreadSafeStore::vadd(const std::string& key, const std::string& element, const std::vector<float>& vector, VectorQuant quant, size_t m, size_t ef_construction) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().vadd(key, element, vector, quant, m, ef_construction);
+}
+
+std::vector<VectorMatch> ThreadSafeStore::vsim(const std::string& key, const std::vector<float>& query, size_t k, size_t ef) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().vsim(key, query, k, ef);
+}
+
+std::vector<VectorMatch> ThreadSafeStore::vsimElement(const std::string& key, const std::string& element, size_t k, size_t ef) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().vsimElement(key, element, k, ef);
+}
+
+size_t ThreadSafeStore::vcard(const std::string& key) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().vcard(key);
+}
+
+size_t ThreadSafeStore::vdim(const std::string& key) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().vdim(key);
+}
+
+std::optional<std::vector<float>> ThreadSafeStore::vemb(const std::string& key, const std::string& element) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().vemb(key, element);
+}
+
+// ========== HASH INDEX COMMANDS ==========
+
+bool ThreadSafeStore::hindexCreate(const std::string& name, const std::string& prefix, const std::string& field, HashIndexKind kind) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().hindexCreate(name, prefix, field, kind);
+}
+
+bool ThreadSafeStore::hindexDrop(const std::string& name) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().hindexDrop(name);
+}
+
+std::vector<std::string> ThreadSafeStore::hindexLookup(const std::string& name, const std::string& value) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().hindexLookup(name, value);
+}
+
+std::vector<std::string> ThreadSafeStore::hindexRange(const std::string& name, double min, double max, size_t limit) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().hindexRange(name, min, max, limit);
+}
+
+std::vector<HashIndexInfo> ThreadSafeStore::hindexList() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().hindexList();
+}
+
+// ========== QUOTA COMMANDS ==========
+
+bool ThreadSafeStore::setQuota(const std::string& name, const std::string& prefix, size_t budget) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().setQuota(name, prefix, budget);
+}
+
+bool ThreadSafeStore::dropQuota(const std::string& name) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().dropQuota(name);
+}
+
+std::vector<NamespaceStats> ThreadSafeStore::quotaStats() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().quotaStats();
 }
 
 // ========== GENERAL COMMANDS ==========
 
 bool ThreadSafeStore::del(const std::string& key) {
     std::unique_lock<std::shared_mutex> lock(mutex_);
-    return store_.del(key);
+    return db().del(key);
+}
+
+bool ThreadSafeStore::unlink(const std::string& key) {
+    // Exclusive lock only for the O(1) detach; the free happens later
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().unlink(key);
+}
+
+bool ThreadSafeStore::rename(const std::string& key, const std::string& newkey) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().rename(key, newkey);
+}
+
+bool ThreadSafeStore::copy(const std::string& source, const std::string& destination, bool replace) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().copy(source, destination, replace);
 }
 
 bool ThreadSafeStore::exists(const std::string& key) const {
     std::shared_lock<std::shared_mutex> lock(mutex_);
-    return store_.exists(key);
+    return db().exists(key);
 }
 
 std::optional<ValueType> ThreadSafeStore::type(const std::string& key) const {
     std::shared_lock<std::shared_mutex> lock(mutex_);
-    return store_.type(key);
+    return db().type(key);
 }
 
 bool ThreadSafeStore::expire(const std::string& key, int seconds) {
     std::unique_lock<std::shared_mutex> lock(mutex_);
-    return store_.expire(key, seconds);
+    return db().expire(key, seconds);
 }
 
 int ThreadSafeStore::ttl(const std::string& key) const {
     std::shared_lock<std::shared_mutex> lock(mutex_);
-    return store_.ttl(key);
+    return db().ttl(key);
+}
+
+long long ThreadSafeStore::pttl(const std::string& key) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().pttl(key);
 }
 
 std::vector<std::string> ThreadSafeStore::keys() const {
     std::shared_lock<std::shared_mutex> lock(mutex_);
-    return store_.keys();
+    return db().keys();
 }
 
 size_t ThreadSafeStore::size() const {
     std::shared_lock<std::shared_mutex> lock(mutex_);
-    return store_.size();
+    return db().size();
 }
 
-void ThreadSafeStore::clear() {
+void ThreadSafeStore::clear(bool async) {
     std::unique_lock<std::shared_mutex> lock(mutex_);
-    store_.clear();
+    db().clear(async);
+}
+
+HugePageStats ThreadSafeStore::hugePageStats() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().hugePageStats();
+}
+
+LazyFreeStats ThreadSafeStore::lazyFreeStats() const {
+    // Shared lock only pins the database slot (swapdb); LazyFree
+    // synchronizes itself
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return db().lazyFreeStats();
+}
+
+// ========== DATABASE COMMANDS ==========
+
+size_t ThreadSafeStore::selected() const {
+    const auto& table = selections();
+    if (table.empty()) return 0;
+    auto it = table.find(id_);
+    return it == table.end() ? 0 : it->second;
+}
+
+bool ThreadSafeStore::select(size_t index) {
+    if (index >= dbs_.size()) return false;
+    if (index == 0) {
+        selections().erase(id_);
+    } else {
+        selections()[id_] = index;
+    }
+    return true;
+}
+
+bool ThreadSafeStore::swapdb(size_t a, size_t b) {
+    if (a >= dbs_.size() || b >= dbs_.size()) return false;
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        std::swap(dbs_[a], dbs_[b]);
+        tracking_.flushed();  // Every key may have a new value
+    }
+    stream_cv_.notify_all();  // Blocked XREADs re-check the swapped-in data
+    return true;
+}
+
+bool ThreadSafeStore::move(const std::string& key, size_t index) {
+    if (index >= dbs_.size() || index == selected()) return false;
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return db().move(key, *dbs_[index]);
+}
+
+void ThreadSafeStore::flushall(bool async) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    for (auto& store : dbs_) store->clear(async);
+}
+
+std::vector<KeyspaceStats> ThreadSafeStore::keyspaceStats() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    std::vector<KeyspaceStats> stats;
+    stats.reserve(dbs_.size());
+    for (const auto& store : dbs_) stats.push_back(store->keyspaceStats());
+    return stats;
+}
+
+// ========== CLIENT TRACKING ==========
+
+uint64_t ThreadSafeStore::trackingOn(TrackingOptions options, InvalidationCallback callback) {
+    // Exclusive: no command is mid-flight while tracking switches on
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return tracking_.enable(std::move(options), std::move(callback));
+}
+
+bool ThreadSafeStore::trackingOff(uint64_t client) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return tracking_.disable(client);
+}
+
+// ========== ACTIVE EXPIRY ==========
+
+void ThreadSafeStore::startActiveExpiry(std::chrono::milliseconds interval) {
+    std::lock_guard<std::mutex> guard(expiry_mutex_);
+    if (expiry_thread_.joinable()) return;  // Already running
+    
+    expiry_stop_ = false;
+    expiry_thread_ = std::thread([this, interval] {
+        std::unique_lock<std::mutex> wait_lock(expiry_mutex_);
+        while (!expiry_cv_.wait_for(wait_lock, interval, [this] { return expiry_stop_; })) {
+            wait_lock.unlock();
+            activeExpireCycle(interval / 4);
+            wait_lock.lock();
+        }
+    });
+}
+
+void ThreadSafeStore::activeExpireCycle(std::chrono::steady_clock::duration budget) {
+    auto deadline = std::chrono::steady_clock::now() + budget;
+    
+    for (size_t visited = 0; visited < dbs_.size(); visited++) {
+        while (true) {
+            ExpireSlice slice;
+            {
+                std::unique_lock<std::shared_mutex> lock(mutex_);
+                slice = dbs_[expiry_db_]->activeExpireSlice(kActiveExpireSamples);
+            }
+            
+            // Out of time: the next cycle resumes at this database
+            if (std::chrono::steady_clock::now() >= deadline) return;
+            if (slice.wrapped || slice.expired * 100 <= slice.sampled * kActiveExpireAcceptablePercent) break;
+        }
+        expiry_db_ = (expiry_db_ + 1) % dbs_.size();
+    }
+}
+
+void ThreadSafeStore::stopActiveExpiry() {
+    std::thread worker;
+    {
+        std::lock_guard<std::mutex> guard(expiry_mutex_);
+        expiry_stop_ = true;
+        worker = std::move(expiry_thread_);
+    }
+    expiry_cv_.notify_all();
+    if (worker.joinable()) worker.join();
+}
+
+// ========== ASYNC COMMANDS ==========
+
+AsyncExecutor& ThreadSafeStore::executor() {
+    std::call_once(executor_once_, [this] {
+        executor_ = std::make_unique<AsyncExecutor>(
+            [this](AsyncExecutor::Batch& batch) { runBatch(batch); });
+        executor_published_.store(executor_.get(), std::memory_order_release);
+    });
+    return *executor_;
+}
+
+void ThreadSafeStore::runBatch(AsyncExecutor::Batch& batch) {
+    // Batch may mix reads and writes - one exclusive lock covers all
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        for (auto& task : batch) {
+            task.apply();
+        }
+    }
+    // Batch may have contained XADDs (via submit)
+    stream_cv_.notify_all();
+}
+
+std::future<bool> ThreadSafeStore::set_async(const std::string& key, const std::string& value, int ttl) {
+    return submit([key, value, ttl](KeyValueStore& s) { return s.set(key, value, ttl); });
+}
+
+std::future<std::optional<std::string>> ThreadSafeStore::get_async(const std::string& key) {
+    return submit([key](KeyValueStore& s) { return s.get(key); });
+}
+
+std::future<bool> ThreadSafeStore::del_async(const std::string& key) {
+    return submit([key](KeyValueStore& s) { return s.del(key); });
+}
+
+void ThreadSafeStore::set_async(const std::string& key, const std::string& value, int ttl,
+                                std::function<void(bool)> done) {
+    auto result = std::make_shared<bool>(false);
+    size_t index = selected();
+    AsyncTask task;
+    // A throw must not escape onto the worker: a failed apply reports false,
+    // and a throwing callback is dropped
+    task.apply = [this, index, key, value, ttl, result] {
+        try {
+            *result = dbs_[index]->set(key, value, ttl);
+        } catch (...) {
+            *result = false;
+        }
+    };
+    task.complete = [done = std::move(done), result] {
+        try {
+            if (done) done(*result);
+        } catch (...) {
+        }
+    };
+    executor().submit(std::move(task));
+}
+
+void ThreadSafeStore::get_async(const std::string& key,
+                                std::function<void(std::optional<std::string>)> done) {
+    auto result = std::make_shared<std::optional<std::string>>();
+    size_t index = selected();
+    AsyncTask task;
+    task.apply = [this, index, key, result] {
+        try {
+            *result = dbs_[index]->get(key);
+        } catch (...) {
+            result->reset();
+        }
+    };
+    task.complete = [done = std::move(done), result] {
+        try {
+            if (done) done(std::move(*result));
+        } catch (...) {
+        }
+    };
+    executor().submit(std::move(task));
+}
+
+void ThreadSafeStore::del_async(const std::string& key, std::function<void(bool)> done) {
+    auto result = std::make_shared<bool>(false);
+    size_t index = selected();
+    AsyncTask task;
+    task.apply = [this, index, key, result] {
+        try {
+            *result = dbs_[index]->del(key);
+        } catch (...) {
+            *result = false;
+        }
+    };
+    task.complete = [done = std::move(done), result] {
+        try {
+            if (done) done(*result);
+        } catch (...) {
+        }
+    };
+    executor().submit(std::move(task));
+}
+
+size_t ThreadSafeStore::pendingAsync() const {
+    // Not executor(): this must not start the worker, and executor_ may be
+    // mid-assignment inside call_once on another thread
+    const AsyncExecutor* executor = executor_published_.load(std::memory_order_acquire);
+    return executor ? executor->pending() : 0;
+}
+
+// ========== NUMA PLACEMENT ==========
+
+std::future<bool> ThreadSafeStore::setNumaNode(std::shared_ptr<const NumaTopology> topology, size_t node) {
+    // Runs ON the worker thread, so it pins/binds the worker itself
+    return submit([this, topology = std::move(topology), node](KeyValueStore&) {
+        bool pinned = topology->pinThreadToNode(node);
+        bool bound = topology->bindThreadMemoryToNode(node);
+        if (pinned && bound) numa_node_.store(static_cast<int>(node), std::memory_order_relaxed);
+        return pinned && bound;
+    });
 }
 
 // ============================================================================
@@ -0,0 +1,342 @@
+#include "../include/TimeSeriesType.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+uint64_t doubleBits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double bitsDouble(uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+uint64_t lowMask(int n) {
+    return n >= 64 ? ~0ULL : (1ULL << n) - 1;
+}
+
+// Sign-extends the low n bits
+int64_t signExtend(uint64_t raw, int n) {
+    return static_cast<int64_t>(raw << (64 - n)) >> (64 - n);
+}
+
+// MSB-first reader over a chunk's bitstream
+class BitReader {
+public:
+    explicit BitReader(const std::vector<uint64_t>& words) : words_(words) {}
+
+    uint64_t read(int n) {
+        uint64_t result = 0;
+        while (n > 0) {
+            int used = static_cast<int>(pos_ % 64);
+            int take = std::min(64 - used, n);
+            uint64_t word = words_[pos_ / 64];
+            uint64_t part = (word >> (64 - used - take)) & lowMask(take);
+            result = (take == 64 ? 0 : result << take) | part;
+            pos_ += take;
+            n -= take;
+        }
+        return result;
+    }
+
+    bool bit() { return read(1) != 0; }
+
+private:
+    const std::vector<uint64_t>& words_;
+    size_t pos_ = 0;
+};
+
+// Bucket start, aligned to 0 (floor division for negative timestamps)
+int64_t bucketStart(int64_t timestamp, int64_t bucket_ms) {
+    int64_t rem = timestamp % bucket_ms;
+    return timestamp - (rem < 0 ? rem + bucket_ms : rem);
+}
+
+// Reductions with 4 independent accumulators: breaks the dependency
+// chain so the compiler can keep 4 lanes in SIMD registers (a single
+// accumulator can't be vectorized without -ffast-math)
+double sumOf(const double* v, size_t n) {
+    double acc[4] = {0, 0, 0, 0};
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        for (int lane = 0; lane < 4; lane++) acc[lane] += v[i + lane];
+    }
+    for (; i < n; i++) acc[0] += v[i];
+    return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+}
+
+double minOf(const double* v, size_t n) {
+    double inf = std::numeric_limits<double>::infinity();
+    double acc[4] = {inf, inf, inf, inf};
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        for (int lane = 0; lane < 4; lane++) acc[lane] = v[i + lane] < acc[lane] ? v[i + lane] : acc[lane];
+    }
+    for (; i < n; i++) acc[0] = v[i] < acc[0] ? v[i] : acc[0];
+    return std::min(std::min(acc[0], acc[1]), std::min(acc[2], acc[3]));
+}
+
+double maxOf(const double* v, size_t n) {
+    double inf = std::numeric_limits<double>::infinity();
+    double acc[4] = {-inf, -inf, -inf, -inf};
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        for (int lane = 0; lane < 4; lane++) acc[lane] = v[i + lane] > acc[lane] ? v[i + lane] : acc[lane];
+    }
+    for (; i < n; i++) acc[0] = v[i] > acc[0] ? v[i] : acc[0];
+    return std::max(std::max(acc[0], acc[1]), std::max(acc[2], acc[3]));
+}
+
+// Running state of the bucket being aggregated (buckets can span chunks)
+struct Bucket {
+    int64_t start = 0;
+    double sum = 0;
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    size_t count = 0;
+
+    void add(const double* values, size_t n, TimeSeriesAggregation aggregation) {
+        switch (aggregation) {
+            case TimeSeriesAggregation::AVG:
+            case TimeSeriesAggregation::SUM: sum += sumOf(values, n); break;
+            case TimeSeriesAggregation::MIN: min = std::min(min, minOf(values, n)); break;
+            case TimeSeriesAggregation::MAX: max = std::max(max, maxOf(values, n)); break;
+            default: break;
+        }
+        count += n;
+    }
+
+    double result(TimeSeriesAggregation aggregation) const {
+        switch (aggregation) {
+            case TimeSeriesAggregation::AVG: return sum / static_cast<double>(count);
+            case TimeSeriesAggregation::SUM: return sum;
+            case TimeSeriesAggregation::MIN: return min;
+            case TimeSeriesAggregation::MAX: return max;
+            default: return static_cast<double>(count);
+        }
+    }
+};
+
+}  // namespace
+
+// ========== GORILLA CHUNK ==========
+
+void RedisTimeSeries::Chunk::writeBits(uint64_t value, int n) {
+    while (n > 0) {
+        int used = static_cast<int>(bit_count % 64);
+        if (used == 0) words.push_back(0);
+        int take = std::min(64 - used, n);
+        uint64_t part = (value >> (n - take)) & lowMask(take);
+        words.back() |= part << (64 - used - take);
+        bit_count += take;
+        n -= take;
+    }
+}
+
+void RedisTimeSeries::Chunk::append(int64_t timestamp, double value) {
+    uint64_t bits = doubleBits(value);
+
+    if (count == 0) {
+        writeBits(static_cast<uint64_t>(timestamp), 64);
+        writeBits(bits, 64);
+        first_timestamp = timestamp;
+        last_timestamp = timestamp;
+        prev_bits = bits;
+        count = 1;
+        return;
+    }
+
+    // Timestamp: delta-of-delta
+    int64_t delta = timestamp - last_timestamp;
+    int64_t dod = delta - prev_delta;
+    if (dod == 0) {
+        writeBits(0, 1);
+    } else if (dod >= -64 && dod <= 63) {
+        writeBits(0b10, 2);
+        writeBits(static_cast<uint64_t>(dod), 7);
+    } else if (dod >= -256 && dod <= 255) {
+        writeBits(0b110, 3);
+        writeBits(static_cast<uint64_t>(dod), 9);
+    } else if (dod >= -2048 && dod <= 2047) {
+        writeBits(0b1110, 4);
+        writeBits(static_cast<uint64_t>(dod), 12);
+    } else {
+        writeBits(0b1111, 4);
+        writeBits(static_cast<uint64_t>(dod), 64);
+    }
+
+    // Value: XOR with the previous value
+    uint64_t x = bits ^ prev_bits;
+    if (x == 0) {
+        writeBits(0, 1);
+    } else {
+        int leading = std::min(__builtin_clzll(x), 31);  // Fits in 5 bits
+        int trailing = __builtin_ctzll(x);
+
+        if (prev_leading >= 0 && leading >= prev_leading && trailing >= prev_trailing) {
+            writeBits(0b10, 2);
+            writeBits(x >> prev_trailing, 64 - prev_leading - prev_trailing);
+        } else {
+            int length = 64 - leading - trailing;
+            writeBits(0b11, 2);
+            writeBits(static_cast<uint64_t>(leading), 5);
+            writeBits(static_cast<uint64_t>(length - 1), 6);
+            writeBits(x >> trailing, length);
+            prev_leading = leading;
+            prev_trailing = trailing;
+        }
+    }
+
+    prev_delta = delta;
+    prev_bits = bits;
+    last_timestamp = timestamp;
+    count++;
+}
+
+void RedisTimeSeries::Chunk::decode(std::vector<int64_t>& timestamps, std::vector<double>& values) const {
+    if (count == 0) return;
+
+    BitReader in(words);
+    auto timestamp = static_cast<int64_t>(in.read(64));
+    uint64_t bits = in.read(64);
+    timestamps.push_back(timestamp);
+    values.push_back(bitsDouble(bits));
+
+    int64_t delta = 0;
+    int leading = 0;
+    int trailing = 0;
+
+    for (size_t i = 1; i < count; i++) {
+        int64_t dod;
+        if (!in.bit()) dod = 0;
+        else if (!in.bit()) dod = signExtend(in.read(7), 7);
+        else if (!in.bit()) dod = signExtend(in.read(9), 9);
+        else if (!in.bit()) dod = signExtend(in.read(12), 12);
+        else dod = static_cast<int64_t>(in.read(64));
+
+        delta += dod;
+        timestamp += delta;
+
+        if (in.bit()) {
+            if (in.bit()) {
+                leading = static_cast<int>(in.read(5));
+                int length = static_cast<int>(in.read(6)) + 1;
+                trailing = 64 - leading - length;
+            }
+            bits ^= in.read(64 - leading - trailing) << trailing;
+        }
+
+        timestamps.push_back(timestamp);
+        values.push_back(bitsDouble(bits));
+    }
+}
+
+// ========== SERIES ==========
+
+int64_t RedisTimeSeries::oldestAllowed() const {
+    if (retention_ms_ <= 0 || chunks_.empty()) return std::numeric_limits<int64_t>::min();
+    return chunks_.back().last_timestamp - retention_ms_;
+}
+
+bool RedisTimeSeries::add(int64_t timestamp, double value) {
+    if (!chunks_.empty() && timestamp <= chunks_.back().last_timestamp) return false;
+
+    if (chunks_.empty() || chunks_.back().full()) {
+        chunks_.emplace_back();
+        chunks_.back().words.reserve(kChunkBytes / sizeof(uint64_t) + 1);
+    }
+    Chunk& chunk = chunks_.back();
+    size_t words = chunk.words.size();
+    chunk.append(timestamp, value);
+    words_ += chunk.words.size() - words;
+    samples_++;
+
+    expireChunks();
+    return true;
+}
+
+void RedisTimeSeries::expireChunks() {
+    int64_t oldest = oldestAllowed();
+    while (chunks_.size() > 1 && chunks_.front().last_timestamp < oldest) {
+        samples_ -= chunks_.front().count;
+        words_ -= chunks_.front().words.size();
+        chunks_.pop_front();
+    }
+}
+
+std::optional<TimeSeriesSample> RedisTimeSeries::last() const {
+    if (chunks_.empty()) return std::nullopt;
+
+    const Chunk& chunk = chunks_.back();
+    return TimeSeriesSample{chunk.last_timestamp, bitsDouble(chunk.prev_bits)};
+}
+
+std::vector<TimeSeriesSample> RedisTimeSeries::range(int64_t from, int64_t to,
+                                                     TimeSeriesAggregation aggregation,
+                                                     int64_t bucket_ms) const {
+    std::vector<TimeSeriesSample> result;
+    from = std::max(from, oldestAllowed());
+    if (from > to) return result;
+
+    bool aggregate = aggregation != TimeSeriesAggregation::NONE && bucket_ms > 0;
+    Bucket bucket;
+
+    // Reused decode buffers
+    std::vector<int64_t> timestamps;
+    std::vector<double> values;
+    timestamps.reserve(kChunkBytes);
+    values.reserve(kChunkBytes);
+
+    // First chunk that can hold `from` (chunks are ordered by time)
+    auto it = std::lower_bound(chunks_.begin(), chunks_.end(), from,
+                               [](const Chunk& chunk, int64_t t) { return chunk.last_timestamp < t; });
+
+    for (; it != chunks_.end() && it->first_timestamp <= to; ++it) {
+        timestamps.clear();
+        values.clear();
+        it->decode(timestamps, values);
+
+        size_t lo = std::lower_bound(timestamps.begin(), timestamps.end(), from) - timestamps.begin();
+        size_t hi = std::upper_bound(timestamps.begin(), timestamps.end(), to) - timestamps.begin();
+
+        if (!aggregate) {
+            for (size_t i = lo; i < hi; i++) result.push_back(TimeSeriesSample{timestamps[i], values[i]});
+            continue;
+        }
+
+        // Each bucket is a contiguous run [i, end) of the flat arrays
+        for (size_t i = lo; i < hi;) {
+            int64_t start = bucketStart(timestamps[i], bucket_ms);
+            size_t end = std::lower_bound(timestamps.begin() + i, timestamps.begin() + hi,
+                                          start + bucket_ms) - timestamps.begin();
+
+            if (bucket.count > 0 && bucket.start != start) {
+                result.push_back(TimeSeriesSample{bucket.start, bucket.result(aggregation)});
+                bucket = Bucket();
+            }
+            bucket.start = start;
+            bucket.add(values.data() + i, end - i, aggregation);
+            i = end;
+        }
+    }
+
+    if (aggregate && bucket.count > 0) {
+        result.push_back(TimeSeriesSample{bucket.start, bucket.result(aggregation)});
+    }
+    return result;
+}
+
+TimeSeriesInfo RedisTimeSeries::info() const {
+    TimeSeriesInfo info{samples_, chunks_.size(), bytes(), 0, 0, retention_ms_};
+    if (!chunks_.empty()) {
+        info.first_timestamp = chunks_.front().first_timestamp;
+        info.last_timestamp = chunks_.back().last_timestamp;
+    }
+    return info;
+}
@@ -0,0 +1,183 @@
+#include "../include/VectorKernels.h"
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define KV_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// ========== SCALAR ==========
+
+float dotF32Scalar(const float* a, const float* b, size_t n) {
+    float acc[4] = {0, 0, 0, 0};
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        for (int lane = 0; lane < 4; lane++) acc[lane] += a[i + lane] * b[i + lane];
+    }
+    for (; i < n; i++) acc[0] += a[i] * b[i];
+    return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+}
+
+int32_t dotI8Scalar(const int8_t* a, const int8_t* b, size_t n) {
+    int32_t acc = 0;
+    for (size_t i = 0; i < n; i++) acc += static_cast<int32_t>(a[i]) * b[i];
+    return acc;
+}
+
+#ifdef KV_X86_KERNELS
+
+// ========== AVX2 ==========
+
+__attribute__((target("avx2,fma")))
+float dotF32Avx2(const float* a, const float* b, size_t n) {
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), acc1);
+    }
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+    }
+
+    __m256 acc = _mm256_add_ps(acc0, acc1);
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    sum = _mm_hadd_ps(sum, sum);
+    sum = _mm_hadd_ps(sum, sum);
+
+    float result = _mm_cvtss_f32(sum);
+    for (; i < n; i++) result += a[i] * b[i];
+    return result;
+}
+
+__attribute__((target("avx2")))
+int32_t dotI8Avx2(const int8_t* a, const int8_t* b, size_t n) {
+    // Widen 16 x int8 → int16, then madd pairs into 8 x int32
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i va = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)));
+        __m256i vb = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+        acc = _mm256_add_epi32(acc, _mm256_madd_epi16(va, vb));
+    }
+
+    __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    sum = _mm_hadd_epi32(sum, sum);
+    sum = _mm_hadd_epi32(sum, sum);
+
+    int32_t result = _mm_cvtsi128_si32(sum);
+    for (; i < n; i++) result += static_cast<int32_t>(a[i]) * b[i];
+    return result;
+}
+
+// ========== AVX-512 ==========
+
+__attribute__((target("avx512f")))
+float dotF32Avx512(const float* a, const float* b, size_t n) {
+    __m512 acc0 = _mm512_setzero_ps();
+    __m512 acc1 = _mm512_setzero_ps();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), acc0);
+        acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16), acc1);
+    }
+    for (; i + 16 <= n; i += 16) {
+        acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), acc0);
+    }
+    if (i < n) {
+        // Masked tail: no scalar loop
+        __mmask16 mask = static_cast<__mmask16>((1u << (n - i)) - 1);
+        acc1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, a + i), _mm512_maskz_loadu_ps(mask, b + i), acc1);
+    }
+
+    // Fold 512 → 256 → 128 by hand. GCC 12's _mm512_reduce_add_*, casts and
+    // unmasked extracts all pass _mm256_undefined_*() and trip -Wuninitialized;
+    // the maskz forms take a zero source. extractf32x8 needs AVX512DQ, so the
+    // float halves go through the pd view.
+    __m512d acc = _mm512_castps_pd(_mm512_add_ps(acc0, acc1));
+    __m256 half = _mm256_add_ps(_mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xFF, acc, 0)),
+                                _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xFF, acc, 1)));
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(half), _mm256_extractf128_ps(half, 1));
+    sum = _mm_hadd_ps(sum, sum);
+    sum = _mm_hadd_ps(sum, sum);
+    return _mm_cvtss_f32(sum);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+int32_t dotI8Avx512(const int8_t* a, const int8_t* b, size_t n) {
+    __m512i acc = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m512i va = _mm512_cvtepi8_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)));
+        __m512i vb = _mm512_cvtepi8_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+        acc = _mm512_add_epi32(acc, _mm512_madd_epi16(va, vb));
+    }
+
+    // Manual fold, as in dotF32Avx512
+    __m256i half = _mm256_add_epi32(_mm512_maskz_extracti64x4_epi64(0xFF, acc, 0),
+                                    _mm512_maskz_extracti64x4_epi64(0xFF, acc, 1));
+    __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(half), _mm256_extracti128_si256(half, 1));
+    sum = _mm_hadd_epi32(sum, sum);
+    sum = _mm_hadd_epi32(sum, sum);
+
+    int32_t result = _mm_cvtsi128_si32(sum);
+    for (; i < n; i++) result += static_cast<int32_t>(a[i]) * b[i];
+    return result;
+}
+
+#endif  // KV_X86_KERNELS
+
+// ========== DISPATCH ==========
+
+struct Kernels {
+    float (*dot_f32)(const float*, const float*, size_t);
+    int32_t (*dot_i8)(const int8_t*, const int8_t*, size_t);
+    const char* name;
+};
+
+Kernels selectKernels() {
+    Kernels scalar{dotF32Scalar, dotI8Scalar, "scalar"};
+
+#ifdef KV_X86_KERNELS
+    __builtin_cpu_init();
+    bool has_avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    bool has_avx512 = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+
+    Kernels avx2{dotF32Avx2, dotI8Avx2, "avx2"};
+    Kernels avx512{dotF32Avx512, dotI8Avx512, "avx512"};
+
+    // Optional override, clamped to what the CPU supports
+    if (const char* forced = std::getenv("KV_VECTOR_KERNEL")) {
+        if (std::strcmp(forced, "scalar") == 0) return scalar;
+        if (std::strcmp(forced, "avx2") == 0 && has_avx2) return avx2;
+    }
+
+    if (has_avx512) return avx512;
+    if (has_avx2) return avx2;
+#endif
+    return scalar;
+}
+
+// Resolved on first use (safe even from other static initializers)
+const Kernels& kernels() {
+    static const Kernels selected = selectKernels();
+    return selected;
+}
+
+}  // namespace
+
+float dotF32(const float* a, const float* b, size_t n) {
+    return kernels().dot_f32(a, b, n);
+}
+
+int32_t dotI8(const int8_t* a, const int8_t* b, size_t n) {
+    return kernels().dot_i8(a, b, n);
+}
+
+const char* vectorKernelName() {
+    return kernels().name;
+}
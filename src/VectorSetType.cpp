@@ -0,0 +1,330 @@
+#include "../include/VectorSetType.h"
+#include "../include/VectorKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+
+namespace {
+
+// Visited marks for one search; an epoch bump clears it in O(1).
+// Thread-local so concurrent const searches never share state.
+struct VisitedTable {
+    std::vector<uint32_t> marks;
+    uint32_t epoch = 0;
+
+    void reset(size_t nodes) {
+        if (marks.size() < nodes) marks.resize(nodes, 0);
+        if (++epoch == 0) {
+            std::fill(marks.begin(), marks.end(), 0);
+            epoch = 1;
+        }
+    }
+
+    // True the first time a node is seen in this search
+    bool visit(uint32_t node) {
+        if (marks[node] == epoch) return false;
+        marks[node] = epoch;
+        return true;
+    }
+};
+
+VisitedTable& visitedTable() {
+    thread_local VisitedTable table;
+    return table;
+}
+
+}  // namespace
+
+RedisVectorSet::RedisVectorSet(size_t dim, VectorQuant quant, size_t m, size_t ef_construction)
+    : dim_(dim), quant_(quant), m_(std::max<size_t>(2, m)),
+      ef_construction_(std::max<size_t>(m_, ef_construction)),
+      level_mult_(1.0 / std::log(static_cast<double>(m_))) {}
+
+// ========== VECTORS ==========
+
+std::optional<RedisVectorSet::Query> RedisVectorSet::prepare(const std::vector<float>& vector) const {
+    if (vector.size() != dim_ || dim_ == 0) return std::nullopt;
+
+    double norm = 0;
+    for (float x : vector) norm += static_cast<double>(x) * x;
+    norm = std::sqrt(norm);
+    if (!(norm > 0) || !std::isfinite(norm)) return std::nullopt;
+
+    Query query;
+    query.f32.resize(dim_);
+    for (size_t i = 0; i < dim_; i++) query.f32[i] = static_cast<float>(vector[i] / norm);
+
+    if (quant_ == VectorQuant::Q8) {
+        float max_abs = 0;
+        for (float x : query.f32) max_abs = std::max(max_abs, std::fabs(x));
+        query.scale = max_abs / 127.0f;
+        query.q8.resize(dim_);
+        for (size_t i = 0; i < dim_; i++) {
+            query.q8[i] = static_cast<int8_t>(std::lround(query.f32[i] / query.scale));
+        }
+    }
+    return query;
+}
+
+RedisVectorSet::Query RedisVectorSet::nodeQuery(NodeId node) const {
+    Query query;
+    if (quant_ == VectorQuant::FP32) {
+        query.f32.assign(f32_.begin() + node * dim_, f32_.begin() + (node + 1) * dim_);
+    } else {
+        query.q8.assign(q8_.begin() + node * dim_, q8_.begin() + (node + 1) * dim_);
+        query.scale = scales_[node];
+    }
+    return query;
+}
+
+float RedisVectorSet::distance(const Query& query, NodeId node) const {
+    if (quant_ == VectorQuant::FP32) {
+        return 1.0f - dotF32(query.f32.data(), &f32_[node * dim_], dim_);
+    }
+    return 1.0f - query.scale * scales_[node] * static_cast<float>(dotI8(query.q8.data(), &q8_[node * dim_], dim_));
+}
+
+float RedisVectorSet::distance(NodeId a, NodeId b) const {
+    if (quant_ == VectorQuant::FP32) {
+        return 1.0f - dotF32(&f32_[a * dim_], &f32_[b * dim_], dim_);
+    }
+    return 1.0f - scales_[a] * scales_[b] * static_cast<float>(dotI8(&q8_[a * dim_], &q8_[b * dim_], dim_));
+}
+
+void RedisVectorSet::prefetch(NodeId node) const {
+    const char* p = quant_ == VectorQuant::FP32 ? reinterpret_cast<const char*>(&f32_[node * dim_])
+                                                 : reinterpret_cast<const char*>(&q8_[node * dim_]);
+    __builtin_prefetch(p);
+    __builtin_prefetch(p + 64);
+}
+
+// ========== GRAPH ==========
+
+const RedisVectorSet::NodeId* RedisVectorSet::links(NodeId node, int level, size_t& count) const {
+    if (level == 0) {
+        const NodeId* slot = &level0_[node * (2 * m_ + 1)];
+        count = slot[0];
+        return slot + 1;
+    }
+    const auto& list = upper_[node][level - 1];
+    count = list.size();
+    return list.data();
+}
+
+void RedisVectorSet::setLinks(NodeId node, int level, const std::vector<NodeId>& ids) {
+    if (level == 0) {
+        NodeId* slot = &level0_[node * (2 * m_ + 1)];
+        slot[0] = static_cast<NodeId>(ids.size());
+        std::copy(ids.begin(), ids.end(), slot + 1);
+    } else {
+        upper_[node][level - 1] = ids;
+    }
+}
+
+RedisVectorSet::NodeId RedisVectorSet::greedyClosest(const Query& query, NodeId start,
+                                                     int from_level, int to_level) const {
+    NodeId current = start;
+    float best = distance(query, current);
+
+    for (int level = from_level; level > to_level; level--) {
+        bool improved = true;
+        while (improved) {
+            improved = false;
+            size_t count;
+            const NodeId* neighbors = links(current, level, count);
+            for (size_t i = 0; i < count; i++) {
+                float d = distance(query, neighbors[i]);
+                if (d < best) {
+                    best = d;
+                    current = neighbors[i];
+                    improved = true;
+                }
+            }
+        }
+    }
+    return current;
+}
+
+std::vector<RedisVectorSet::Candidate> RedisVectorSet::searchLayer(const Query& query, NodeId entry,
+                                                                   size_t ef, int level) const {
+    VisitedTable& visited = visitedTable();
+    visited.reset(size());
+
+    // candidates: closest first; results: farthest first (bounded to ef)
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> candidates;
+    std::priority_queue<Candidate> results;
+
+    float d = distance(query, entry);
+    visited.visit(entry);
+    candidates.emplace(d, entry);
+    results.emplace(d, entry);
+
+    while (!candidates.empty()) {
+        auto [cd, current] = candidates.top();
+        if (results.size() >= ef && cd > results.top().first) break;
+        candidates.pop();
+
+        size_t count;
+        const NodeId* neighbors = links(current, level, count);
+        for (size_t i = 0; i < count; i++) prefetch(neighbors[i]);
+
+        for (size_t i = 0; i < count; i++) {
+            NodeId next = neighbors[i];
+            if (!visited.visit(next)) continue;
+
+            float dn = distance(query, next);
+            if (results.size() < ef || dn < results.top().first) {
+                candidates.emplace(dn, next);
+                results.emplace(dn, next);
+                if (results.size() > ef) results.pop();
+            }
+        }
+    }
+
+    std::vector<Candidate> found;
+    found.reserve(results.size());
+    while (!results.empty()) {
+        found.push_back(results.top());
+        results.pop();
+    }
+    return found;
+}
+
+std::vector<RedisVectorSet::NodeId> RedisVectorSet::selectNeighbors(std::vector<Candidate> candidates,
+                                                                    size_t m) const {
+    std::sort(candidates.begin(), candidates.end());
+
+    std::vector<NodeId> selected;
+    selected.reserve(m);
+    for (const auto& [d, node] : candidates) {
+        if (selected.size() >= m) break;
+
+        bool diverse = true;
+        for (NodeId kept : selected) {
+            if (distance(node, kept) < d) {
+                diverse = false;
+                break;
+            }
+        }
+        if (diverse) selected.push_back(node);
+    }
+    return selected;
+}
+
+// ========== COMMANDS ==========
+
+bool RedisVectorSet::add(const std::string& element, const std::vector<float>& vector) {
+    if (ids_.count(element)) return false;
+    auto query = prepare(vector);
+    if (!query) return false;
+
+    auto id = static_cast<NodeId>(names_.size());
+    if (quant_ == VectorQuant::FP32) {
+        f32_.insert(f32_.end(), query->f32.begin(), query->f32.end());
+    } else {
+        q8_.insert(q8_.end(), query->q8.begin(), query->q8.end());
+        scales_.push_back(query->scale);
+    }
+    names_.push_back(element);
+    ids_.emplace(element, id);
+
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    int level = static_cast<int>(-std::log(1.0 - uniform(rng_)) * level_mult_);
+    levels_.push_back(level);
+    level0_.resize(level0_.size() + 2 * m_ + 1, 0);
+    upper_.emplace_back(static_cast<size_t>(level));
+
+    if (max_level_ < 0) {
+        entry_ = id;
+        max_level_ = level;
+        return true;
+    }
+
+    // Query in stored form, so insert-time distances match search-time ones
+    Query stored = nodeQuery(id);
+    NodeId current = greedyClosest(stored, entry_, max_level_, level);
+
+    for (int l = std::min(level, max_level_); l >= 0; l--) {
+        auto found = searchLayer(stored, current, ef_construction_, l);
+        current = std::min_element(found.begin(), found.end())->second;
+
+        auto neighbors = selectNeighbors(found, m_);
+        setLinks(id, l, neighbors);
+
+        // Back-links; prune an overfull list with the same heuristic
+        for (NodeId neighbor : neighbors) {
+            size_t count;
+            const NodeId* existing = links(neighbor, l, count);
+            std::vector<NodeId> ids(existing, existing + count);
+
+            if (ids.size() < maxLinks(l)) {
+                ids.push_back(id);
+                setLinks(neighbor, l, ids);
+                continue;
+            }
+
+            std::vector<Candidate> candidates;
+            candidates.reserve(ids.size() + 1);
+            candidates.emplace_back(distance(neighbor, id), id);
+            for (NodeId other : ids) candidates.emplace_back(distance(neighbor, other), other);
+            setLinks(neighbor, l, selectNeighbors(std::move(candidates), maxLinks(l)));
+        }
+    }
+
+    if (level > max_level_) {
+        max_level_ = level;
+        entry_ = id;
+    }
+    return true;
+}
+
+std::vector<VectorMatch> RedisVectorSet::toMatches(std::vector<Candidate> found, size_t k,
+                                                   std::optional<NodeId> skip) const {
+    std::sort(found.begin(), found.end());
+
+    std::vector<VectorMatch> matches;
+    for (const auto& [d, node] : found) {
+        if (matches.size() >= k) break;
+        if (skip && node == *skip) continue;
+        double score = std::clamp(1.0 - d / 2.0, 0.0, 1.0);
+        matches.push_back(VectorMatch{names_[node], score});
+    }
+    return matches;
+}
+
+std::vector<VectorMatch> RedisVectorSet::search(const std::vector<float>& query, size_t k, size_t ef) const {
+    if (max_level_ < 0 || k == 0) return {};
+    auto prepared = prepare(query);
+    if (!prepared) return {};
+
+    ef = std::max(ef > 0 ? ef : kDefaultEfSearch, k);
+    NodeId start = greedyClosest(*prepared, entry_, max_level_, 0);
+    return toMatches(searchLayer(*prepared, start, ef, 0), k, std::nullopt);
+}
+
+std::optional<std::vector<VectorMatch>> RedisVectorSet::searchElement(const std::string& element, size_t k,
+                                                                      size_t ef) const {
+    auto it = ids_.find(element);
+    if (it == ids_.end()) return std::nullopt;
+    if (k == 0) return std::vector<VectorMatch>();
+
+    Query query = nodeQuery(it->second);
+    ef = std::max(ef > 0 ? ef : kDefaultEfSearch, k + 1);
+    NodeId start = greedyClosest(query, entry_, max_level_, 0);
+    return toMatches(searchLayer(query, start, ef, 0), k, it->second);
+}
+
+std::optional<std::vector<float>> RedisVectorSet::embedding(const std::string& element) const {
+    auto it = ids_.find(element);
+    if (it == ids_.end()) return std::nullopt;
+
+    NodeId node = it->second;
+    if (quant_ == VectorQuant::FP32) {
+        return std::vector<float>(f32_.begin() + node * dim_, f32_.begin() + (node + 1) * dim_);
+    }
+
+    std::vector<float> result(dim_);
+    for (size_t i = 0; i < dim_; i++) result[i] = q8_[node * dim_ + i] * scales_[node];
+    return result;
+}
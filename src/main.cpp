@@ -1,8 +1,16 @@
 #include "../include/ThreadSafeStore.h"
+#include "../include/ShardedStore.h"
+#include "../include/NearCache.h"
+#include "../include/NetServer.h"
+#include "../include/ShmTransport.h"
+#include "../include/VectorKernels.h"
+#include <fstream>
 #include <iostream>
 #include <thread>
 #include <chrono>
 #include <iomanip>
+#include <algorithm>
+#include <unistd.h>
 
 // ANSI colors for pretty output
 #define RESET   "\033[0m"
@@ -45,6 +53,48 @@ void testStrings(ThreadSafeStore& store) {
     std::cout << "\nEXISTS name: " << (store.exists("name") ? GREEN "1" : "0") << RESET << "\n";
     auto type = store.type("name");
     std::cout << "TYPE name: " << CYAN << (type ? typeToString(*type) : "unknown") << RESET << "\n";
+    
+    // APPEND / SETRANGE / GETRANGE / STRLEN - in-place mutation
+    store.append("bootlog", "boot ok;");
+    size_t len = store.append("bootlog", "db ready;");
+    std::cout << "\nAPPEND bootlog x2 -> STRLEN " << GREEN << len << RESET << "\n";
+    store.setrange("bootlog", 0, "BOOT");
+    std::cout << "SETRANGE bootlog 0 BOOT, GETRANGE bootlog 0 6: " << GREEN << store.getrange("bootlog", 0, 6) << RESET << "\n";
+    std::cout << "GETRANGE bootlog -9 -1: " << GREEN << store.getrange("bootlog", -9, -1) << RESET << "\n";
+    
+    // GETEX / GETDEL - read and update/delete in one lookup
+    auto token = store.getex("session", 60);
+    std::cout << "GETEX session EX 60: " << GREEN << (token ? *token : "(nil)") << RESET
+              << " (TTL " << store.ttl("session") << ")\n";
+    auto gone = store.getdel("session");
+    std::cout << "GETDEL session: " << GREEN << (gone ? *gone : "(nil)") << RESET
+              << " (EXISTS " << store.exists("session") << ")\n";
+    
+    // SET NX PX - distributed lock acquire in one call
+    SetOptions lock;
+    lock.condition = SetCondition::NX;
+    lock.expiry = SetExpiry::PX;
+    lock.expiry_value = 3000;
+    bool first = store.set("lock:orders", "worker-1", lock).written;
+    bool second = store.set("lock:orders", "worker-2", lock).written;
+    std::cout << "\nSET lock:orders NX PX 3000: worker-1 " << GREEN << first << RESET << ", worker-2 "
+              << GREEN << second << RESET << " (PTTL " << store.pttl("lock:orders") << " ms)\n";
+    
+    // SET GET KEEPTTL - swap the value, keep the lease
+    SetOptions swap;
+    swap.get = true;
+    swap.expiry = SetExpiry::KEEPTTL;
+    auto previous = store.set("lock:orders", "worker-1:renewed", swap).old_value;
+    std::cout << "SET lock:orders GET KEEPTTL: old " << GREEN << (previous ? *previous : "(nil)") << RESET
+              << " (PTTL " << store.pttl("lock:orders") << " ms)\n";
+}
+
+// Current resident set size in MB (Linux /proc)
+double residentMB() {
+    std::ifstream statm("/proc/self/statm");
+    size_t pages = 0, resident = 0;
+    statm >> pages >> resident;
+    return static_cast<double>(resident) * sysconf(_SC_PAGESIZE) / (1024.0 * 1024.0);
 }
 
 void testLists(ThreadSafeStore& store) {
@@ -71,6 +121,34 @@ void testLists(ThreadSafeStore& store) {
     auto first_task = store.lpop("tasks");
     std::cout << "\nLPOP tasks: " << GREEN << (first_task ? *first_task : "(nil)") << RESET << "\n";
     std::cout << "LLEN tasks: " << store.llen("tasks") << "\n";
+    
+    // Positional edits, done in place
+    store.linsert("tasks", ListInsert::BEFORE, "Deploy", "Run tests");
+    store.lset("tasks", -1, "Deploy to prod");
+    auto pos = store.lpos("tasks", "Run tests");
+    std::cout << "\nLINSERT tasks BEFORE Deploy \"Run tests\", LSET tasks -1 \"Deploy to prod\"\n";
+    std::cout << "LPOS tasks \"Run tests\": " << GREEN << (pos.empty() ? -1 : static_cast<long>(pos[0]))
+              << RESET << "\n";
+    std::cout << "LINDEX tasks -1: " << GREEN << store.lindex("tasks", -1).value_or("(nil)") << RESET << "\n";
+    
+    // Capped log: keep only the newest 3 entries
+    store.rpush("log", {"e1", "e2", "e3", "e4", "e5"});
+    store.ltrim("log", -3, -1);
+    auto moved = store.lmove("log", "archive", ListEnd::LEFT, ListEnd::RIGHT);
+    std::cout << "LTRIM log -3 -1, LMOVE log archive LEFT RIGHT: " << GREEN << moved.value_or("(nil)")
+              << RESET << " (log now " << store.llen("log") << ")\n";
+    
+    // Sliding window: a short list churned through RPUSH + LPOP reuses
+    // its chunk instead of growing it
+    for (int i = 0; i < 10; i++) store.rpush("window", {"tick:" + std::to_string(i)});
+    double rss_before = residentMB();
+    for (int i = 10; i < 2000000; i++) {
+        store.rpush("window", {"tick:" + std::to_string(i)});
+        store.lpop("window");
+    }
+    std::cout << "2M x (RPUSH window + LPOP window): LLEN " << store.llen("window") << ", RSS "
+              << std::fixed << std::setprecision(1) << rss_before << " -> " << GREEN << residentMB()
+              << " MB" << RESET << "\n";
 }
 
 void testSets(ThreadSafeStore& store) {
@@ -99,6 +177,18 @@ void testSets(ThreadSafeStore& store) {
     }
     
     std::cout << "SCARD skills: " << GREEN << store.scard("skills") << RESET << "\n";
+    
+    // SMISMEMBER - several members, one key lookup
+    auto flags = store.smismember("skills", {"cpp", "java", "redis"});
+    std::cout << "\nSMISMEMBER skills cpp java redis: " << GREEN;
+    for (bool flag : flags) std::cout << flag << " ";
+    std::cout << RESET << "\n";
+    
+    // SRANDMEMBER / SPOP - uniform random picks
+    auto sample = store.srandmember("skills", 2);
+    std::cout << "SRANDMEMBER skills 2: " << CYAN << sample[0] << ", " << sample[1] << RESET << "\n";
+    auto popped = store.spop("skills");
+    std::cout << "SPOP skills: " << CYAN << popped[0] << RESET << " (SCARD now " << store.scard("skills") << ")\n";
 }
 
 void testHashes(ThreadSafeStore& store) {
@@ -128,6 +218,269 @@ void testHashes(ThreadSafeStore& store) {
     }
     
     std::cout << "HLEN user:1001: " << GREEN << store.hlen("user:1001") << RESET << "\n";
+    
+    // Multi-field HSET / HMGET
+    size_t added = store.hset("user:1001", {{"city", "Berlin"}, {"age", "29"}});
+    std::cout << "\nHSET user:1001 city Berlin age 29: " << GREEN << added << " new field(s)" << RESET << "\n";
+    auto values = store.hmget("user:1001", {"name", "phone", "age"});
+    std::cout << "HMGET user:1001 name phone age:";
+    for (const auto& value : values) std::cout << " " << YELLOW << (value ? *value : "(nil)") << RESET;
+    std::cout << "\n";
+    
+    // HRANDFIELD WITHVALUES
+    auto [field, value] = store.hrandfield("user:1001").front();
+    std::cout << "HRANDFIELD user:1001 WITHVALUES: " << CYAN << field << RESET << " => " << YELLOW << value << RESET << "\n";
+}
+
+void testHashFieldTTL(ThreadSafeStore& store) {
+    printHeader("HASH Field TTL");
+    
+    store.hset("session:42", "user", "alice");
+    store.hset("session:42", "csrf", "t0k3n");
+    store.hset("session:42", "cart", "3 items");
+    
+    auto set = store.hexpire("session:42", 1, {"csrf", "missing"});
+    std::cout << "HEXPIRE session:42 1 FIELDS csrf missing: " << YELLOW
+              << set[0] << " " << set[1] << RESET << "\n";
+    store.hexpire("session:42", 60, {"cart"});
+    
+    auto ttls = store.httl("session:42", {"user", "csrf", "cart"});
+    std::cout << "HTTL user/csrf/cart: " << YELLOW << ttls[0] << " " << ttls[1] << " " << ttls[2] << RESET << "\n";
+    
+    auto persisted = store.hpersist("session:42", {"cart"});
+    std::cout << "HPERSIST cart: " << GREEN << persisted[0] << RESET << "\n";
+    
+    // Background cycle reclaims csrf without anyone touching the key
+    store.startActiveExpiry(std::chrono::milliseconds(200));
+    std::cout << "Waiting 1.5 seconds (active expiry running)...\n";
+    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+    store.stopActiveExpiry();
+    
+    std::cout << "HLEN session:42: " << GREEN << store.hlen("session:42") << RESET << "\n";
+    std::cout << "HEXISTS csrf: " << (store.hexists("session:42", "csrf") ? GREEN "1" : "0") << RESET << "\n";
+}
+
+void testStreams(ThreadSafeStore& store) {
+    printHeader("STREAM Operations");
+    
+    // XADD with explicit and auto-generated IDs
+    store.xadd("events", "1-1", {{"type", "login"}, {"user", "alice"}});
+    store.xadd("events", "2-*", {{"type", "click"}, {"user", "alice"}});
+    auto id = store.xadd("events", "*", {{"type", "logout"}, {"user", "bob"}});
+    std::cout << "XADD events * -> " << GREEN << (id ? *id : "(error)") << RESET << "\n";
+    std::cout << "XLEN events: " << GREEN << store.xlen("events") << RESET << "\n";
+    
+    auto entries = store.xrange("events", "-", "+");
+    std::cout << "XRANGE events - +:\n";
+    for (const auto& e : entries) {
+        std::cout << "  " << YELLOW << e.id.toString() << RESET;
+        for (const auto& [f, v] : e.fields) std::cout << " " << f << "=" << v;
+        std::cout << "\n";
+    }
+    
+    // Consumer group: deliver, then acknowledge
+    store.xgroupCreate("events", "workers", "0");
+    auto batch = store.xreadgroup("events", "workers", "w1", ">", 2);
+    std::cout << "\nXREADGROUP workers w1 COUNT 2: " << GREEN << (batch ? batch->size() : 0) << " entries" << RESET << "\n";
+    std::cout << "XPENDING events workers: " << YELLOW << store.xpending("events", "workers").size() << RESET << "\n";
+    if (batch && !batch->empty()) {
+        store.xack("events", "workers", {batch->front().id.toString()});
+    }
+    std::cout << "XPENDING after XACK: " << YELLOW << store.xpending("events", "workers").size() << RESET << "\n";
+    
+    // Blocking XREAD woken by a producer thread
+    std::thread producer([&store] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        store.xadd("events", "*", {{"type", "purchase"}, {"user", "carol"}});
+    });
+    auto read = store.xread({{"events", "$"}}, 0, 2000);
+    producer.join();
+    std::cout << "\nXREAD BLOCK 2000 STREAMS events $: " << GREEN
+              << (read.empty() ? 0 : read[0].second.size()) << " new entry" << RESET << "\n";
+    
+    store.xtrim("events", 2);
+    std::cout << "XTRIM events MAXLEN 2 -> XLEN " << GREEN << store.xlen("events") << RESET << "\n";
+}
+
+void testGeo(ThreadSafeStore& store) {
+    printHeader("GEO Operations");
+    
+    store.geoadd("drivers", {{13.361389, 38.115556, "palermo"},
+                             {15.087269, 37.502669, "catania"},
+                             {13.583333, 37.316667, "agrigento"}});
+    std::cout << "GEOADD drivers palermo catania agrigento\n";
+    
+    auto km = store.geodist("drivers", "palermo", "catania", "km");
+    std::cout << "GEODIST palermo catania km: " << GREEN << std::fixed << std::setprecision(2)
+              << (km ? *km : -1) << RESET << "\n";
+    
+    GeoSearchQuery query;
+    query.longitude = 15;
+    query.latitude = 37;
+    query.radius = 200;
+    query.unit = "km";
+    auto nearby = store.geosearch("drivers", query);
+    std::cout << "GEOSEARCH FROMLONLAT 15 37 BYRADIUS 200 km ASC:\n";
+    for (const auto& r : nearby) {
+        std::cout << "  " << CYAN << r.member << RESET << " " << YELLOW << r.distance << " km" << RESET << "\n";
+    }
+    std::cout << std::defaultfloat;
+}
+
+void testFilters(ThreadSafeStore& store) {
+    printHeader("BLOOM / CUCKOO Filters");
+    
+    // Bloom: 1% error, 10k capacity - grows with extra layers past that
+    store.bfreserve("seen", 0.01, 10000);
+    auto added = store.bfmadd("seen", {"alice", "bob", "carol"});
+    std::cout << "BF.MADD seen alice bob carol: " << GREEN << std::count(added.begin(), added.end(), true) << " added" << RESET << "\n";
+    
+    auto found = store.bfmexists("seen", {"alice", "mallory"});
+    std::cout << "BF.MEXISTS seen alice mallory: " << YELLOW << found[0] << " " << found[1] << RESET << "\n";
+    
+    // Cuckoo: like Bloom, but supports deletes
+    store.cfadd("sessions", "s1");
+    store.cfadd("sessions", "s2");
+    store.cfdel("sessions", "s1");
+    std::cout << "CF.EXISTS after CF.DEL s1: s1=" << YELLOW << store.cfexists("sessions", "s1")
+              << RESET << " s2=" << YELLOW << store.cfexists("sessions", "s2") << RESET << "\n";
+}
+
+void testSketches(ThreadSafeStore& store) {
+    printHeader("COUNT-MIN / TOP-K Sketches");
+    
+    // Count-min: fixed memory, never under-counts
+    store.cmsInitByProb("hits", 0.001, 0.01);
+    store.cmsIncrBy("hits", {{"/home", 120}, {"/login", 30}, {"/home", 5}});
+    auto counts = store.cmsQuery("hits", {"/home", "/login", "/never"});
+    std::cout << "CMS.QUERY hits /home /login /never: " << YELLOW << counts[0] << " "
+              << counts[1] << " " << counts[2] << RESET << "\n";
+    
+    // Top-k: heavy hitters in a stream of events
+    store.topkReserve("trending", 3);
+    for (int i = 0; i < 50; i++) {
+        store.topkAdd("trending", {"cats", "cats", "dogs", "tag" + std::to_string(i)});
+    }
+    std::cout << "TOPK.LIST trending WITHCOUNT:\n";
+    for (const auto& [item, count] : store.topkList("trending")) {
+        std::cout << "  " << CYAN << item << RESET << " " << YELLOW << count << RESET << "\n";
+    }
+}
+
+void testTDigest(ThreadSafeStore& store) {
+    printHeader("T-DIGEST Percentiles");
+    
+    // 10k latency samples: 1..10000 us, summarized in a few KB
+    store.tdigestCreate("latency");
+    std::vector<double> batch;
+    for (int i = 1; i <= 10000; i++) batch.push_back(i);
+    store.tdigestAdd("latency", batch);
+    
+    auto q = store.tdigestQuantile("latency", {0.5, 0.99, 0.999});
+    std::cout << "TDIGEST.QUANTILE latency 0.5 0.99 0.999: " << YELLOW << std::fixed << std::setprecision(1)
+              << q[0] << " " << q[1] << " " << q[2] << RESET << "\n";
+    
+    auto cdf = store.tdigestCdf("latency", {2500});
+    std::cout << "TDIGEST.CDF latency 2500: " << YELLOW << std::setprecision(3) << cdf[0] << RESET << "\n";
+    std::cout << std::defaultfloat;
+}
+
+void testTimeSeries(ThreadSafeStore& store) {
+    printHeader("TIMESERIES Operations");
+    
+    // One sample per second for an hour, 1 day retention
+    store.tsCreate("cpu", 24 * 3600 * 1000);
+    std::vector<TimeSeriesSample> samples;
+    for (int i = 0; i < 3600; i++) {
+        samples.push_back(TimeSeriesSample{1700000000000 + i * 1000LL, 40.0 + (i % 60)});
+    }
+    store.tsMadd("cpu", samples);
+    
+    auto info = store.tsInfo("cpu");
+    std::cout << "TS.INFO cpu: " << GREEN << info->samples << " samples in " << info->bytes
+              << " bytes" << RESET << " (" << YELLOW << std::fixed << std::setprecision(2)
+              << static_cast<double>(info->bytes) / info->samples << " bytes/sample" << RESET << ")\n";
+    
+    // 15-minute averages
+    auto avg = store.tsRange("cpu", 0, INT64_MAX, TimeSeriesAggregation::AVG, 15 * 60 * 1000);
+    std::cout << "TS.RANGE cpu - + AGGREGATION avg 900000:\n";
+    for (const auto& sample : avg) {
+        std::cout << "  " << CYAN << sample.timestamp << RESET << " " << YELLOW << sample.value << RESET << "\n";
+    }
+    std::cout << std::defaultfloat;
+}
+
+void testJson(ThreadSafeStore& store) {
+    printHeader("JSON Operations");
+    
+    store.jsonSet("user:1", "$", R"({"name":"alice","visits":1,"tags":["admin"]})");
+    std::cout << "JSON.SET user:1 $ {...}\n";
+    
+    // In-place updates: no read-modify-write of the whole document
+    store.jsonSet("user:1", "$.name", R"("bob")");
+    auto visits = store.jsonNumIncrBy("user:1", "$.visits", 5);
+    auto tags = store.jsonArrAppend("user:1", "$.tags", {R"("ops")"});
+    std::cout << "JSON.NUMINCRBY user:1 $.visits 5: " << GREEN << visits.value_or("nil") << RESET << "\n";
+    std::cout << "JSON.ARRAPPEND user:1 $.tags \"ops\": " << GREEN << tags.value_or(0) << RESET << "\n";
+    
+    std::cout << "JSON.GET user:1: " << YELLOW << store.jsonGet("user:1").value_or("nil") << RESET << "\n";
+    std::cout << "JSON.GET user:1 $.tags[-1]: " << YELLOW << store.jsonGet("user:1", "$.tags[-1]").value_or("nil")
+              << RESET << "\n";
+}
+
+void testVectorSet(ThreadSafeStore& store) {
+    printHeader("Vector Set Operations");
+    
+    // Tiny 4-d "embeddings": two themes (fruit, vehicles)
+    store.vadd("items", "apple",  {0.9f, 0.1f, 0.0f, 0.1f});
+    store.vadd("items", "banana", {0.8f, 0.2f, 0.1f, 0.0f});
+    store.vadd("items", "cherry", {0.9f, 0.0f, 0.2f, 0.1f});
+    store.vadd("items", "car",    {0.0f, 0.1f, 0.9f, 0.8f});
+    store.vadd("items", "truck",  {0.1f, 0.0f, 0.8f, 0.9f});
+    std::cout << "VADD items x5 (dim " << store.vdim("items") << ", card " << store.vcard("items") << ")\n";
+    
+    std::cout << "VSIM items VALUES 4 1 0 0 0 COUNT 3:";
+    for (const auto& match : store.vsim("items", {1.0f, 0.0f, 0.0f, 0.0f}, 3)) {
+        std::cout << " " << GREEN << match.element << RESET << "(" << match.score << ")";
+    }
+    std::cout << "\n";
+    
+    std::cout << "VSIM items ELE car COUNT 2:";
+    for (const auto& match : store.vsimElement("items", "car", 2)) {
+        std::cout << " " << GREEN << match.element << RESET << "(" << match.score << ")";
+    }
+    std::cout << "\n";
+    std::cout << "Distance kernel: " << YELLOW << vectorKernelName() << RESET << "\n";
+}
+
+void testHashIndex(ThreadSafeStore& store) {
+    printHeader("Hash Secondary Indexes");
+    
+    // user:1001 (from the hash demo) is picked up by the backfill
+    store.hindexCreate("users_by_email", "user:", "email", HashIndexKind::EXACT);
+    store.hindexCreate("users_by_age", "user:", "age", HashIndexKind::NUMERIC);
+    std::cout << "HINDEX.CREATE users_by_email / users_by_age ON user:*\n";
+    
+    store.hset("user:1002", "email", "bob@example.com");
+    store.hset("user:1002", "age", "35");
+    store.hset("user:1003", "email", "carol@example.com");
+    store.hset("user:1003", "age", "22");
+    
+    auto print_keys = [](const std::vector<std::string>& keys) {
+        for (const auto& key : keys) std::cout << " " << GREEN << key << RESET;
+        std::cout << "\n";
+    };
+    
+    std::cout << "HINDEX.LOOKUP users_by_email bob@example.com:";
+    print_keys(store.hindexLookup("users_by_email", "bob@example.com"));
+    std::cout << "HINDEX.RANGE users_by_age 20 30:";
+    print_keys(store.hindexRange("users_by_age", 20, 30));
+    
+    // Index follows writes: no separate index keys to keep in sync
+    store.hset("user:1003", "age", "41");
+    store.del("user:1002");
+    std::cout << "After HSET user:1003 age 41 + DEL user:1002, RANGE 20 50:";
+    print_keys(store.hindexRange("users_by_age", 20, 50));
 }
 
 void testThreadSafety(ThreadSafeStore& store) {
@@ -195,6 +548,228 @@ void testMixedOperations(ThreadSafeStore& store) {
     }
     
     std::cout << "\nDBSIZE: " << GREEN << store.size() << " keys" << RESET << "\n";
+    
+    // COPY shares the payload copy-on-write; RENAME relinks the key
+    store.copy("data:hash", "data:hash:v2");
+    store.hset("data:hash:v2", "field1", "value2");
+    auto v1 = store.hget("data:hash", "field1");
+    auto v2 = store.hget("data:hash:v2", "field1");
+    std::cout << "\nCOPY data:hash data:hash:v2, then HSET on the copy: original " << GREEN << *v1 << RESET
+              << ", copy " << GREEN << *v2 << RESET << "\n";
+    store.rename("data:hash:v2", "data:hash:live");
+    std::cout << "RENAME data:hash:v2 data:hash:live: EXISTS " << store.exists("data:hash:live") << "\n";
+}
+
+void testLazyFree(ThreadSafeStore& store) {
+    printHeader("Lazy Free (UNLINK / FLUSHDB ASYNC)");
+    
+    std::vector<std::string> members;
+    for (int i = 0; i < 500000; i++) members.push_back("member:" + std::to_string(i));
+    store.sadd("big:set", members);
+    
+    // UNLINK - O(1) detach under the lock, destruction in the background
+    auto start = std::chrono::steady_clock::now();
+    store.unlink("big:set");
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "UNLINK big:set (500k members): " << GREEN << us << " us" << RESET
+              << " (free queue depth " << store.lazyFreeStats().pending << ")\n";
+    
+    // FLUSHDB ASYNC on a separate store - the whole table leaves in O(1)
+    KeyValueStore scratch;
+    for (int i = 0; i < 100000; i++) scratch.set("key:" + std::to_string(i), "value");
+    start = std::chrono::steady_clock::now();
+    scratch.clear(true);
+    us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "FLUSHDB ASYNC (100k keys): " << GREEN << us << " us" << RESET
+              << " (DBSIZE " << scratch.size() << ")\n";
+}
+
+void testDatabases(ThreadSafeStore& store) {
+    printHeader("Logical Databases (SELECT / SWAPDB / MOVE)");
+    
+    // Rebuild a dataset offline in db 1, then swap it live in O(1)
+    store.select(1);
+    for (int i = 0; i < 3; i++) store.set("catalog:" + std::to_string(i), "v2", 3600);
+    store.set("session:tmp", "x");
+    store.move("session:tmp", 2);
+    std::cout << "SELECT 1, 3 keys loaded; MOVE session:tmp 2\n";
+    store.select(0);
+    
+    store.set("catalog:0", "v1");
+    store.swapdb(0, 1);
+    auto v = store.get("catalog:0");
+    std::cout << "SWAPDB 0 1 → GET catalog:0: " << GREEN << (v ? *v : "(nil)") << RESET << "\n";
+    
+    auto stats = store.keyspaceStats();
+    for (size_t i = 0; i < stats.size(); i++) {
+        if (stats[i].keys == 0) continue;
+        std::cout << "db" << i << ": keys=" << GREEN << stats[i].keys << RESET << " expires="
+                  << stats[i].expires << " avg_ttl=" << stats[i].avg_ttl_ms << "ms\n";
+    }
+    
+    // Restore the original db 0 for the remaining demos
+    store.swapdb(0, 1);
+    store.select(1);
+    store.clear();
+    store.select(2);
+    store.clear();
+    store.select(0);
+}
+
+void testQuotas(ThreadSafeStore& store) {
+    printHeader("Per-Tenant Quotas");
+    
+    // Two tenants share db 3; only the noisy one pays for its writes
+    store.select(3);
+    store.setQuota("noisy", "noisy:", 64 * 1024);
+    store.setQuota("quiet", "quiet:", 64 * 1024);
+    for (int i = 0; i < 10; i++) store.set("quiet:" + std::to_string(i), "hot");
+    for (int i = 0; i < 1000; i++) store.set("noisy:" + std::to_string(i), std::string(256, 'x'));
+    for (int i = 0; i < 10; i++) store.get("quiet:" + std::to_string(i));
+    store.get("quiet:missing");
+    
+    for (const auto& ns : store.quotaStats()) {
+        std::cout << ns.name << ": " << GREEN << ns.keys << " keys, " << ns.used / 1024 << "/"
+                  << ns.budget / 1024 << " KB" << RESET << " hits=" << ns.hits << " misses=" << ns.misses
+                  << " evictions=" << ns.evictions << "\n";
+    }
+    
+    store.clear();
+    store.dropQuota("noisy");
+    store.dropQuota("quiet");
+    store.select(0);
+}
+
+void testTracking(ThreadSafeStore& store) {
+    printHeader("Client Tracking (client-side caching)");
+    
+    // This thread caches config locally; the store says when to drop it
+    std::unordered_map<std::string, std::string> local;
+    uint64_t client = store.trackingOn(TrackingOptions(), [&local](const std::string* key) {
+        if (key) {
+            std::cout << "  invalidate " << YELLOW << *key << RESET << "\n";
+            local.erase(*key);
+        } else {
+            local.clear();
+        }
+    });
+    
+    store.set("config:flags", "beta=off");
+    if (auto v = store.get("config:flags")) local["config:flags"] = *v;
+    std::cout << "Client " << client << " cached config:flags = " << GREEN << local["config:flags"] << RESET << "\n";
+    
+    std::thread writer([&store] { store.set("config:flags", "beta=on"); });
+    writer.join();
+    std::cout << "After another client's SET, cached: " << GREEN << local.count("config:flags") << RESET
+              << " (tracking table: " << store.trackingStats().keys << " keys)\n";
+    
+    store.trackingOff(client);
+}
+
+void testNearCache(ThreadSafeStore& store) {
+    printHeader("Near Cache (L1 in front of the store)");
+    
+    store.set("config:timeout", "30");
+    NearCache cache(store);
+    for (int i = 0; i < 1000; i++) cache.get("config:timeout");
+    
+    std::thread writer([&store] { store.set("config:timeout", "45"); });
+    writer.join();
+    auto v = cache.get("config:timeout");
+    
+    auto stats = cache.stats();
+    std::cout << "GET config:timeout after update: " << GREEN << (v ? *v : "(nil)") << RESET << "\n";
+    std::cout << "Hit rate: " << GREEN << std::fixed << std::setprecision(1) << stats.hitRate() * 100 << "%"
+              << RESET << std::defaultfloat << " (" << stats.hits << " hits, " << stats.misses << " misses, "
+              << stats.invalidations << " invalidation)\n";
+}
+
+void testSharedMemory(ThreadSafeStore& store) {
+    printHeader("Shared-Memory Transport");
+    
+    ShmServer server(store);
+    ShmClient client(server.fd());
+    if (!client.connected()) {
+        std::cout << "Shared memory transport unavailable on this platform\n";
+        return;
+    }
+    
+    client.set("shm:greeting", "hello over memfd");
+    auto v = client.get("shm:greeting");
+    std::cout << "PING: " << GREEN << (client.ping() ? "PONG" : "(failed)") << RESET << "\n";
+    std::cout << "GET shm:greeting: " << GREEN << (v ? *v : "(nil)") << RESET << "\n";
+    std::cout << "Visible to the store directly: " << GREEN << store.exists("shm:greeting") << RESET << "\n";
+    
+    auto stats = server.stats();
+    std::cout << "Clients: " << stats.clients << ", requests: " << stats.requests << "\n";
+}
+
+void testNetServer(ThreadSafeStore& store) {
+    printHeader("Network Server (epoll / io_uring)");
+    
+    NetServer server(store);
+    for (NetBackend backend : {NetBackend::EPOLL, NetBackend::IO_URING}) {
+        server.setBackend(backend);
+        if (!server.start()) {
+            std::cout << "Network server unavailable on this platform\n";
+            return;
+        }
+        std::cout << "Listening on 127.0.0.1:" << server.port() << " with " << GREEN
+                  << (server.backend() == NetBackend::IO_URING ? "io_uring" : "epoll") << RESET << "\n";
+        server.stop();
+    }
+    std::cout << "io_uring supported: " << GREEN << NetServer::ioUringSupported() << RESET << "\n";
+}
+
+void testAsync(ThreadSafeStore& store) {
+    printHeader("Async Operations");
+    
+    // Futures: submit now, collect later (caller never takes the lock)
+    std::vector<std::future<bool>> writes;
+    for (int i = 0; i < 100; i++) {
+        writes.push_back(store.set_async("async:" + std::to_string(i), std::to_string(i * i)));
+    }
+    for (auto& w : writes) w.get();
+    std::cout << "SET async:0..99 via set_async\n";
+    
+    auto value = store.get_async("async:12").get();
+    std::cout << "GET async:12: " << GREEN << (value ? *value : "(nil)") << RESET << "\n";
+    
+    // Any command via submit()
+    auto len = store.submit([](KeyValueStore& s) { return s.llen("tasks"); }).get();
+    std::cout << "LLEN tasks (submit): " << GREEN << len << RESET << "\n";
+    
+    // Callback form - runs on the worker after the batch lock is released
+    std::promise<void> done;
+    store.del_async("async:12", [&done](bool removed) {
+        std::cout << "DEL async:12 (callback): " << GREEN << removed << RESET << "\n";
+        done.set_value();
+    });
+    done.get_future().wait();
+}
+
+void testNumaSharding() {
+    printHeader("NUMA Sharding (emulated 2 nodes)");
+    
+    ShardedStore sharded(NumaTopology::emulated(2));
+    std::cout << "Topology: " << CYAN << sharded.topology().describe() << RESET << "\n";
+    
+    // Writes go through each shard's node-pinned worker
+    std::vector<std::future<bool>> writes;
+    for (int i = 0; i < 1000; i++) {
+        std::string key = "numa:" + std::to_string(i);
+        writes.push_back(sharded.shardFor(key).set_async(key, std::to_string(i)));
+    }
+    for (auto& w : writes) w.get();
+    
+    for (size_t i = 0; i < sharded.shardCount(); i++) {
+        std::cout << "Shard " << i << " (node " << sharded.nodeOfShard(i) << ", pinned="
+                  << (sharded.shard(i).numaNode() >= 0 ? "yes" : "no") << "): "
+                  << GREEN << sharded.shard(i).size() << " keys" << RESET << "\n";
+    }
+    
+    auto v = sharded.shardFor("numa:42").get("numa:42");
+    std::cout << "GET numa:42: " << GREEN << (v ? *v : "(nil)") << RESET << "\n";
 }
 
 int main() {
@@ -213,7 +788,26 @@ int main() {
     testLists(store);
     testSets(store);
     testHashes(store);
+    testHashFieldTTL(store);
+    testStreams(store);
+    testGeo(store);
+    testFilters(store);
+    testSketches(store);
+    testTDigest(store);
+    testTimeSeries(store);
+    testJson(store);
+    testVectorSet(store);
+    testHashIndex(store);
     testMixedOperations(store);
+    testLazyFree(store);
+    testDatabases(store);
+    testQuotas(store);
+    testTracking(store);
+    testNearCache(store);
+    testSharedMemory(store);
+    testNetServer(store);
+    testAsync(store);
+    testNumaSharding();
     testThreadSafety(store);
     
     printHeader("Summary");
@@ -0,0 +1,38 @@
+#ifndef TESTSUPPORT_H
+#define TESTSUPPORT_H
+
+/*
+TestSupport.h - Minimal checks for the ctest targets in tests/
+
+Each test is a plain executable: CHECK records a failure (with file and
+line) and keeps going, so one run reports every broken expectation;
+main() returns testResult(), which ctest reads as pass / fail.
+
+Not assert(): the default build is Release, where NDEBUG compiles
+asserts away.
+*/
+
+#include <cstdio>
+
+inline int& testFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+// Variadic so braced initializers (commas) need no extra parentheses
+#define CHECK(...)                                                              \
+    do {                                                                        \
+        if (!(__VA_ARGS__)) {                                                   \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, \
+                         #__VA_ARGS__);                                         \
+            testFailures()++;                                                   \
+        }                                                                       \
+    } while (0)
+
+inline int testResult() {
+    if (testFailures() == 0) return 0;
+    std::fprintf(stderr, "%d check(s) failed\n", testFailures());
+    return 1;
+}
+
+#endif // TESTSUPPORT_H
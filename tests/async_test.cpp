@@ -0,0 +1,96 @@
+// Batched async API: futures, callbacks and submit()
+
+#include "ThreadSafeStore.h"
+#include "TestSupport.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+static void testFutures() {
+    ThreadSafeStore store;
+    CHECK(store.pendingAsync() == 0);  // Nothing queued, no worker started
+
+    auto set = store.set_async("k", "v");
+    auto get = store.get_async("k");  // Queued after the set: sees it
+    CHECK(set.get());
+    CHECK(get.get() == "v");
+    CHECK(store.get("k") == "v");
+
+    CHECK(store.del_async("k").get());
+    CHECK(!store.del_async("k").get());
+    CHECK(!store.get_async("k").get());
+}
+
+static void testCallbacks() {
+    ThreadSafeStore store;
+    std::atomic<int> done{0};
+    std::atomic<bool> all_ok{true};
+    std::thread::id caller = std::this_thread::get_id();
+
+    for (int i = 0; i < 1000; i++) {
+        store.set_async("k" + std::to_string(i), std::to_string(i), 0, [&, caller](bool ok) {
+            if (!ok || std::this_thread::get_id() == caller) all_ok = false;
+            done++;
+        });
+    }
+    auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (done < 1000 && std::chrono::steady_clock::now() < deadline) std::this_thread::sleep_for(1ms);
+    CHECK(done == 1000);
+    CHECK(all_ok);
+    CHECK(store.size() == 1000);
+
+    std::promise<std::optional<std::string>> value;
+    store.get_async("k7", [&value](std::optional<std::string> v) { value.set_value(std::move(v)); });
+    CHECK(value.get_future().get() == "7");
+
+    std::promise<bool> deleted;
+    store.del_async("k7", [&deleted](bool ok) { deleted.set_value(ok); });
+    CHECK(deleted.get_future().get());
+    CHECK(!store.exists("k7"));
+}
+
+static void testSubmit() {
+    ThreadSafeStore store;
+    store.rpush("q", {"a", "b"});
+
+    auto length = store.submit([](KeyValueStore& s) { return s.llen("q"); });
+    CHECK(length.get() == 2);
+
+    auto none = store.submit([](KeyValueStore& s) { s.rpush("q", {"c"}); });
+    none.get();
+    CHECK(store.llen("q") == 3);
+
+    // An exception reaches the future instead of the worker
+    auto thrown = store.submit([](KeyValueStore&) -> int { throw std::runtime_error("boom"); });
+    bool caught = false;
+    try {
+        thrown.get();
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    CHECK(caught);
+
+    // The worker survived it
+    CHECK(store.get_async("missing").get() == std::nullopt);
+}
+
+static void testSelectedDatabase() {
+    ThreadSafeStore store;
+    CHECK(store.select(3));
+    auto set = store.set_async("k", "db3");
+    CHECK(store.select(0));  // The op keeps the database it was submitted on
+    CHECK(set.get());
+    CHECK(!store.get("k"));
+    store.select(3);
+    CHECK(store.get("k") == "db3");
+}
+
+int main() {
+    testFutures();
+    testCallbacks();
+    testSubmit();
+    testSelectedDatabase();
+    return testResult();
+}
@@ -0,0 +1,60 @@
+// co_await forms of the async commands (built as C++20 when available)
+
+#include "ThreadSafeStore.h"
+#include "TestSupport.h"
+
+#if defined(__cpp_impl_coroutine)
+#include <coroutine>
+#include <exception>
+#include <future>
+#include <thread>
+
+// Fire-and-forget coroutine; the test waits on `finished` instead
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+struct Observed {
+    bool set = false;
+    std::optional<std::string> value;
+    bool deleted = false;
+    std::optional<std::string> after_delete;
+    std::thread::id resumed_on;
+};
+
+static Detached roundTrip(ThreadSafeStore& store, Observed& seen, std::promise<void>& finished) {
+    seen.set = co_await co_set(store, "k", "v");
+    seen.value = co_await co_get(store, "k");
+    seen.resumed_on = std::this_thread::get_id();
+    seen.deleted = co_await co_del(store, "k");
+    seen.after_delete = co_await co_get(store, "k");
+    finished.set_value();
+}
+
+int main() {
+    ThreadSafeStore store;
+    Observed seen;
+    std::promise<void> finished;
+    roundTrip(store, seen, finished);
+    finished.get_future().get();
+
+    CHECK(seen.set);
+    CHECK(seen.value == "v");
+    CHECK(seen.deleted);
+    CHECK(!seen.after_delete);
+    CHECK(seen.resumed_on != std::this_thread::get_id());  // Resumed by the async worker
+    CHECK(!store.exists("k"));
+    return testResult();
+}
+#else
+int main() {
+    std::fprintf(stderr, "coroutines not supported by this compiler\n");
+    return 77;  // ctest SKIP_RETURN_CODE
+}
+#endif
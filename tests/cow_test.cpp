@@ -0,0 +1,89 @@
+// Copy-on-write payloads: RedisValue::share() / own() and COPY / RENAME
+
+#include "ThreadSafeStore.h"
+#include "TestSupport.h"
+
+static void testShareOwn() {
+    const std::string payload(1000, 'p');  // Past SSO: moves keep the buffer
+    RedisValue original{RedisData(RedisString(payload))};
+    RedisValue copy = original.share();
+
+    // One payload, two owners; neither holds a private copy
+    CHECK(original.shared && original.shared == copy.shared);
+    CHECK(original.shared.use_count() == 2);
+    CHECK(&original.view() == &copy.view());
+    CHECK(std::get<RedisString>(copy.view()) == payload);
+
+    // A writer unshares: the other owner keeps the old payload
+    std::get<RedisString>(copy.own()) = "changed";
+    CHECK(!copy.shared);
+    CHECK(original.shared.use_count() == 1);
+    CHECK(std::get<RedisString>(original.view()) == payload);
+    CHECK(std::get<RedisString>(copy.view()) == "changed");
+
+    // The last owner takes the payload back without copying
+    const char* buffer = std::get<RedisString>(original.view()).data();
+    RedisData& owned = original.own();
+    CHECK(!original.shared);
+    CHECK(std::get<RedisString>(owned).data() == buffer);
+    CHECK(std::get<RedisString>(original.view()) == payload);
+}
+
+static void testSharedCopyIsDeep() {
+    RedisHash hash;
+    hash.try_emplace("f", "v");
+    RedisValue a{RedisData(std::move(hash))};
+    RedisValue b = a.share();
+    RedisValue c(b);  // Copying a shared value just adds a reference
+    CHECK(a.shared.use_count() == 3);
+
+    std::get<RedisHash>(c.own()).try_emplace("g", "w");
+    CHECK(std::get<RedisHash>(c.view()).size() == 2);
+    CHECK(std::get<RedisHash>(a.view()).size() == 1);
+    CHECK(std::get<RedisHash>(b.view()).size() == 1);
+}
+
+static void testCopyCommand() {
+    ThreadSafeStore store;
+    store.rpush("src", {"a", "b", "c"});
+    store.hset("hsrc", "f", "1");
+
+    CHECK(store.copy("src", "dst"));
+    CHECK(!store.copy("src", "dst"));        // Exists, no REPLACE
+    CHECK(store.copy("hsrc", "dst", true));  // REPLACE, any type
+    CHECK(store.copy("src", "dst", true));
+    CHECK(!store.copy("missing", "x"));
+    CHECK(!store.copy("src", "src"));
+
+    // Writes to either side stay on that side
+    store.rpush("dst", {"d"});
+    store.lpop("src");
+    CHECK(store.lrange("src", 0, -1) == std::vector<std::string>({"b", "c"}));
+    CHECK(store.lrange("dst", 0, -1) == std::vector<std::string>({"a", "b", "c", "d"}));
+
+    CHECK(store.copy("hsrc", "hdst"));
+    store.hset("hsrc", "f", "2");
+    CHECK(store.hget("hdst", "f") == "1");
+    CHECK(store.hget("hsrc", "f") == "2");
+}
+
+static void testRename() {
+    ThreadSafeStore store;
+    store.set("a", "1", 100);
+    store.set("b", "2");
+
+    CHECK(store.rename("a", "b"));  // Overwrites b, keeps a's TTL
+    CHECK(!store.exists("a"));
+    CHECK(store.get("b") == "1");
+    CHECK(store.ttl("b") > 90);
+    CHECK(!store.rename("a", "c"));
+    CHECK(store.rename("b", "b"));
+}
+
+int main() {
+    testShareOwn();
+    testSharedCopyIsDeep();
+    testCopyCommand();
+    testRename();
+    return testResult();
+}
@@ -0,0 +1,117 @@
+// Key TTLs (lazy and active expiry) and per-field hash TTLs
+
+#include "ThreadSafeStore.h"
+#include "TestSupport.h"
+#include <chrono>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+static SetOptions px(int64_t ms) {
+    SetOptions options;
+    options.expiry = SetExpiry::PX;
+    options.expiry_value = ms;
+    return options;
+}
+
+static void testKeyTtl() {
+    ThreadSafeStore store;
+    CHECK(store.set("plain", "v"));
+    CHECK(store.ttl("plain") == -1);
+    CHECK(store.ttl("missing") == -2);
+
+    CHECK(store.set("k", "v", 100));
+    CHECK(store.ttl("k") > 90);
+    CHECK(store.expire("k", 0));  // 0 clears the TTL
+    CHECK(store.ttl("k") == -1);
+    CHECK(!store.expire("missing", 10));
+
+    CHECK(store.set("short", "v", px(30)).written);
+    long long pttl = store.pttl("short");
+    CHECK(pttl > 0 && pttl <= 30);
+    std::this_thread::sleep_for(60ms);
+
+    // Expired: gone for every reader before anything reclaims it
+    CHECK(!store.get("short"));
+    CHECK(!store.exists("short"));
+    CHECK(store.ttl("short") == -2);
+    CHECK(store.pttl("short") == -2);
+
+    // SET NX sees the expired key as absent
+    SetOptions nx = px(30);
+    nx.condition = SetCondition::NX;
+    CHECK(store.set("short", "again", nx).written);
+    CHECK(store.get("short") == "again");
+}
+
+static void testKeepTtl() {
+    ThreadSafeStore store;
+    CHECK(store.set("k", "v", 100));
+
+    SetOptions keep;
+    keep.expiry = SetExpiry::KEEPTTL;
+    CHECK(store.set("k", "w", keep).written);
+    CHECK(store.ttl("k") > 90);
+
+    CHECK(store.set("k", "x"));  // Plain SET clears it
+    CHECK(store.ttl("k") == -1);
+}
+
+static void testActiveExpiry() {
+    ThreadSafeStore store;
+    for (int i = 0; i < 200; i++) store.set("tmp:" + std::to_string(i), "v", px(20));
+    store.set("keep", "v");
+
+    store.startActiveExpiry(10ms);
+    auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (store.keyspaceStats()[0].expired < 200 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(10ms);
+    }
+    store.stopActiveExpiry();
+
+    // Reclaimed without any reader touching them
+    auto stats = store.keyspaceStats()[0];
+    CHECK(stats.keys == 1);
+    CHECK(stats.expired == 200);
+    CHECK(store.get("keep") == "v");
+}
+
+static void testFieldTtl() {
+    ThreadSafeStore store;
+    store.hset("h", {{"a", "1"}, {"b", "2"}, {"c", "3"}});
+
+    auto set = store.hexpire("h", 1, {"a", "b", "nope"});
+    CHECK(set.size() == 3 && set[0] == 1 && set[1] == 1 && set[2] == -2);
+
+    auto ttls = store.httl("h", {"a", "c", "nope"});
+    CHECK(ttls.size() == 3 && ttls[0] >= 0 && ttls[0] <= 1 && ttls[1] == -1 && ttls[2] == -2);
+
+    auto persisted = store.hpersist("h", {"b", "c"});
+    CHECK(persisted.size() == 2 && persisted[0] == 1 && persisted[1] == -1);
+    CHECK(store.httl("h", {"b"})[0] == -1);
+
+    // Expiring "now" deletes the field on the spot
+    auto now = store.hexpire("h", 0, {"c"});
+    CHECK(now.size() == 1 && now[0] == 2);
+    CHECK(!store.hexists("h", "c"));
+
+    std::this_thread::sleep_for(1100ms);
+    CHECK(!store.hget("h", "a"));
+    CHECK(store.hget("h", "b") == "2");
+    CHECK(store.hlen("h") == 1);
+    CHECK(store.hgetall("h").count("a") == 0);
+
+    // The last field expiring takes the key with it
+    store.hexpire("h", 1, {"b"});
+    std::this_thread::sleep_for(1100ms);
+    CHECK(store.hlen("h") == 0);
+    CHECK(!store.exists("h"));
+}
+
+int main() {
+    testKeyTtl();
+    testKeepTtl();
+    testActiveExpiry();
+    testFieldTtl();
+    return testResult();
+}
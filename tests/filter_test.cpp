@@ -0,0 +1,58 @@
+// Bloom (scalable) and cuckoo filters
+
+#include "ThreadSafeStore.h"
+#include "TestSupport.h"
+#include <algorithm>
+
+static void testBloom() {
+    ThreadSafeStore store;
+    CHECK(store.bfreserve("bf", 0.01, 1000));
+    CHECK(!store.bfreserve("bf", 0.01, 1000));  // Exists
+    CHECK(!store.bfreserve("bad", 1.5, 1000));
+
+    CHECK(store.bfadd("bf", "alice"));
+    CHECK(!store.bfadd("bf", "alice"));
+    CHECK(store.bfexists("bf", "alice"));
+
+    // Grows past its capacity without false negatives; stays near the error rate
+    std::vector<std::string> items;
+    for (int i = 0; i < 5000; i++) items.push_back("item" + std::to_string(i));
+    store.bfmadd("bf", items);
+    auto present = store.bfmexists("bf", items);
+    CHECK(std::count(present.begin(), present.end(), true) == 5000);
+
+    size_t false_positives = 0;
+    for (int i = 0; i < 10000; i++) false_positives += store.bfexists("bf", "other" + std::to_string(i));
+    CHECK(false_positives < 300);
+
+    // BF.ADD on a missing key creates a default filter
+    CHECK(store.bfadd("auto", "x"));
+    CHECK(store.type("auto") == ValueType::BLOOM);
+    CHECK(!store.bfexists("missing", "x"));
+}
+
+static void testCuckoo() {
+    ThreadSafeStore store;
+    CHECK(store.cfreserve("cf", 1000));
+    CHECK(!store.cfreserve("cf", 1000));
+
+    for (int i = 0; i < 2000; i++) CHECK(store.cfadd("cf", "item" + std::to_string(i)));
+    CHECK(store.cfexists("cf", "item0"));
+    CHECK(store.cfexists("cf", "item1999"));
+
+    // Unlike a Bloom filter, items can be deleted
+    CHECK(store.cfdel("cf", "item0"));
+    CHECK(!store.cfexists("cf", "item0"));
+    CHECK(!store.cfdel("cf", "item0"));
+    CHECK(store.cfexists("cf", "item1"));
+
+    auto many = store.cfmexists("cf", {"item2", "nope"});
+    CHECK(many.size() == 2 && many[0]);
+    CHECK(!store.cfdel("missing", "x"));
+}
+
+int main() {
+    testBloom();
+    testCuckoo();
+    return testResult();
+}
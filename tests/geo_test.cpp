@@ -0,0 +1,56 @@
+// GEO: GEOADD / GEOPOS / GEODIST / GEOSEARCH
+
+#include "ThreadSafeStore.h"
+#include "TestSupport.h"
+#include <cmath>
+
+static bool near(double a, double b, double tolerance) {
+    return std::fabs(a - b) <= tolerance;
+}
+
+int main() {
+    ThreadSafeStore store;
+    CHECK(store.geoadd("sicily", {{13.361389, 38.115556, "palermo"},
+                                  {15.087269, 37.502669, "catania"},
+                                  {13.583333, 37.316667, "agrigento"},
+                                  {200, 0, "invalid"}}) == 3);
+    CHECK(store.geoadd("sicily", {{13.361389, 38.115556, "palermo"}}) == 0);  // Update, not add
+
+    auto pos = store.geopos("sicily", {"palermo", "nowhere"});
+    CHECK(pos.size() == 2 && pos[0] && !pos[1]);
+    CHECK(near(pos[0]->first, 13.361389, 1e-5) && near(pos[0]->second, 38.115556, 1e-5));
+
+    auto km = store.geodist("sicily", "palermo", "catania", "km");
+    CHECK(km && near(*km, 166.27, 0.01));
+    CHECK(!store.geodist("sicily", "palermo", "nowhere"));
+    CHECK(!store.geodist("sicily", "palermo", "catania", "parsec"));
+
+    GeoSearchQuery radius;
+    radius.longitude = 15;
+    radius.latitude = 37;
+    radius.radius = 200;
+    radius.unit = "km";
+    auto found = store.geosearch("sicily", radius);
+    CHECK(found.size() == 3);
+    CHECK(found.size() == 3 && found[0].member == "catania" && found[2].member == "palermo");
+    CHECK(found.size() == 3 && near(found[0].distance, 56.44, 0.01));
+
+    radius.radius = 100;
+    CHECK(store.geosearch("sicily", radius).size() == 1);
+
+    radius.radius = 200;
+    radius.count = 2;
+    radius.ascending = false;
+    found = store.geosearch("sicily", radius);
+    CHECK(found.size() == 2 && found[0].member == "palermo");
+
+    GeoSearchQuery box;
+    box.from_member = "agrigento";
+    box.width = 50;
+    box.height = 200;
+    box.unit = "km";
+    found = store.geosearch("sicily", box);
+    CHECK(found.size() == 2);  // Palermo is ~89 km north, ~20 km east; Catania 130 km east
+
+    return testResult();
+}
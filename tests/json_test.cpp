@@ -0,0 +1,45 @@
+// JSON: parse / serialize, path reads and in-place updates
+
+#include "ThreadSafeStore.h"
+#include "TestSupport.h"
+
+int main() {
+    ThreadSafeStore store;
+    CHECK(store.jsonSet("u", "$", R"({"name":"bob","visits":1,"tags":["admin"],"addr":{"city":"Rome"}})"));
+    CHECK(store.jsonGet("u") == R"({"name":"bob","visits":1,"tags":["admin"],"addr":{"city":"Rome"}})");
+    CHECK(!store.jsonSet("bad", "$", "{not json"));
+    CHECK(!store.jsonSet("new", "$.x", "1"));  // A new key needs the root path
+    CHECK(!store.exists("bad") && !store.exists("new"));
+
+    CHECK(store.jsonGet("u", "$.addr.city") == "\"Rome\"");
+    CHECK(store.jsonType("u", "$.tags") == "array");
+    CHECK(store.jsonType("u", "$.visits") == "integer");
+    CHECK(!store.jsonGet("u", "$.nope"));
+
+    CHECK(store.jsonNumIncrBy("u", "$.visits", 5) == "6");
+    CHECK(!store.jsonNumIncrBy("u", "$.name", 1));
+    CHECK(store.jsonArrAppend("u", "$.tags", {"\"ops\"", "3"}) == 3u);
+    CHECK(!store.jsonArrAppend("u", "$.tags", {"\"ok\"", "{bad"}));  // Appends nothing
+    CHECK(store.jsonGet("u", "$.tags") == R"(["admin","ops",3])");
+    CHECK(store.jsonGet("u", "$.tags[-1]") == "3");
+
+    CHECK(store.jsonSet("u", "$.addr.zip", "\"00100\""));  // New member
+    CHECK(store.jsonSet("u", "$.name", "\"alice\""));      // Replace
+    CHECK(store.jsonGet("u", "$.addr") == R"({"city":"Rome","zip":"00100"})");
+    CHECK(store.jsonGet("u", "$.name") == "\"alice\"");
+
+    CHECK(store.jsonDel("u", "$.addr.zip") == 1);
+    CHECK(store.jsonDel("u", "$.addr.zip") == 0);
+    CHECK(store.jsonDel("u", "$.tags[0]") == 1);
+    CHECK(store.jsonGet("u", "$.tags") == R"(["ops",3])");
+
+    // Deleting the root deletes the key
+    CHECK(store.jsonDel("u") == 1);
+    CHECK(!store.exists("u"));
+
+    CHECK(store.jsonSet("esc", "$", R"({"s":"a\"b\\c\n","n":-1.5e3,"t":true,"z":null})"));
+    auto round_trip = store.jsonGet("esc");
+    CHECK(round_trip && store.jsonSet("esc2", "$", *round_trip) && store.jsonGet("esc2") == round_trip);
+    CHECK(store.jsonType("esc", "$.z") == "null");
+    return testResult();
+}
@@ -0,0 +1,102 @@
+// Lazy free: background destruction of big values (UNLINK, FLUSH ASYNC)
+
+#include "LazyFree.h"
+#include "ThreadSafeStore.h"
+#include "TestSupport.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+// Records which thread ran its destructor
+struct Tracer {
+    std::atomic<int>* destroyed;
+    std::thread::id* destroyed_on;
+
+    Tracer(std::atomic<int>* d, std::thread::id* on) : destroyed(d), destroyed_on(on) {}
+    Tracer(Tracer&& other) noexcept : destroyed(other.destroyed), destroyed_on(other.destroyed_on) {
+        other.destroyed = nullptr;
+    }
+    ~Tracer() {
+        if (!destroyed) return;
+        *destroyed_on = std::this_thread::get_id();
+        (*destroyed)++;
+    }
+};
+
+// Stats are updated by the background thread: wait for them to settle
+static LazyFreeStats waitFreed(const ThreadSafeStore& store, size_t freed) {
+    auto deadline = std::chrono::steady_clock::now() + 5s;
+    auto stats = store.lazyFreeStats();
+    while (stats.freed < freed && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+        stats = store.lazyFreeStats();
+    }
+    return stats;
+}
+
+static void testRelease() {
+    std::atomic<int> destroyed{0};
+    std::thread::id destroyed_on;
+    {
+        LazyFree lazy_free;
+        lazy_free.release(Tracer(&destroyed, &destroyed_on));
+        lazy_free.drain();
+        CHECK(destroyed == 1);
+        CHECK(destroyed_on != std::this_thread::get_id());
+        CHECK(lazy_free.stats().freed == 1);
+        CHECK(lazy_free.stats().pending == 0);
+    }
+
+    // Whatever is still queued dies with the LazyFree
+    {
+        LazyFree lazy_free;
+        for (int i = 0; i < 100; i++) lazy_free.release(Tracer(&destroyed, &destroyed_on));
+    }
+    CHECK(destroyed == 101);
+}
+
+static void testUnlink() {
+    ThreadSafeStore store;
+    std::vector<std::string> members;
+    for (int i = 0; i < 10000; i++) members.push_back("m" + std::to_string(i));
+    store.sadd("big", members);
+    store.sadd("small", {"a", "b"});
+
+    // Small values are freed inline, big ones on the background thread
+    CHECK(store.unlink("small"));
+    CHECK(store.lazyFreeStats().freed == 0);
+    CHECK(store.unlink("big"));
+    CHECK(!store.exists("big"));
+    CHECK(!store.unlink("big"));
+    CHECK(waitFreed(store, 1).freed == 1);
+
+    // So is the value a SET overwrites
+    store.sadd("big", members);
+    CHECK(store.set("big", "small now"));
+    CHECK(store.get("big") == "small now");
+    CHECK(waitFreed(store, 2).freed == 2);
+}
+
+static void testFlushAsync() {
+    ThreadSafeStore store;
+    for (int i = 0; i < 1000; i++) store.set("k" + std::to_string(i), "v");
+    store.clear(true);
+    CHECK(store.size() == 0);
+    CHECK(!store.get("k1"));
+
+    // The old table is one object on the queue
+    CHECK(waitFreed(store, 1).freed == 1);
+    CHECK(store.lazyFreeStats().pending == 0);
+
+    store.set("k1", "again");
+    CHECK(store.get("k1") == "again");
+}
+
+int main() {
+    testRelease();
+    testUnlink();
+    testFlushAsync();
+    return testResult();
+}
@@ -0,0 +1,148 @@
+// QuickList against a std::deque model, and the list commands on top
+
+#include "ListType.h"
+#include "ThreadSafeStore.h"
+#include "TestSupport.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <random>
+
+static bool same(const QuickList& list, const std::deque<std::string>& model) {
+    if (list.size() != model.size()) return false;
+    if (model.empty()) return list.empty();
+    auto all = list.range(0, list.size() - 1);
+    return std::equal(all.begin(), all.end(), model.begin(), model.end());
+}
+
+static void testRandomOps() {
+    QuickList list;
+    std::deque<std::string> model;
+    std::mt19937 rng(42);
+
+    // Values of mixed sizes so chunks split on bytes as well as entries
+    auto value = [&rng] {
+        size_t length = rng() % 8 == 0 ? 2000 : rng() % 16;
+        return std::string(length, static_cast<char>('a' + rng() % 4));
+    };
+
+    for (int step = 0; step < 20000; step++) {
+        size_t n = model.size();
+        switch (rng() % 9) {
+        case 0: { auto v = value(); list.pushFront(v); model.push_front(v); break; }
+        case 1: { auto v = value(); list.pushBack(v); model.push_back(v); break; }
+        case 2:
+            CHECK(list.popFront() == (n ? std::optional<std::string>(model.front()) : std::nullopt));
+            if (n) model.pop_front();
+            break;
+        case 3:
+            CHECK(list.popBack() == (n ? std::optional<std::string>(model.back()) : std::nullopt));
+            if (n) model.pop_back();
+            break;
+        case 4: {
+            size_t i = rng() % (n + 1);
+            auto v = value();
+            list.insert(i, v);
+            model.insert(model.begin() + i, v);
+            break;
+        }
+        case 5:
+            if (n) {
+                size_t i = rng() % n;
+                auto v = value();
+                list.set(i, v);
+                model[i] = v;
+                CHECK(list.at(i) == v);
+            }
+            break;
+        case 6: {
+            auto v = value();
+            long count = static_cast<long>(rng() % 5) - 2;
+            size_t removed = list.remove(v, count);
+
+            // Reference LREM
+            size_t expected = 0;
+            size_t limit = count == 0 ? SIZE_MAX : static_cast<size_t>(std::abs(count));
+            if (count >= 0) {
+                for (auto it = model.begin(); it != model.end() && expected < limit;) {
+                    if (*it == v) { it = model.erase(it); expected++; } else { ++it; }
+                }
+            } else {
+                for (size_t i = model.size(); i-- > 0 && expected < limit;) {
+                    if (model[i] == v) { model.erase(model.begin() + i); expected++; }
+                }
+            }
+            CHECK(removed == expected);
+            break;
+        }
+        case 7:
+            if (n && rng() % 50 == 0) {
+                size_t start = rng() % n, stop = rng() % n;
+                list.trim(start, stop);
+                if (start > stop) {
+                    model.clear();
+                } else {
+                    model.erase(model.begin() + stop + 1, model.end());
+                    model.erase(model.begin(), model.begin() + start);
+                }
+            }
+            break;
+        case 8:
+            if (n) {
+                auto v = model[rng() % n];
+                auto found = list.find(v);
+                auto expected = std::find(model.begin(), model.end(), v) - model.begin();
+                CHECK(found && *found == static_cast<size_t>(expected));
+            }
+            break;
+        }
+        if (step % 1000 == 0) CHECK(same(list, model));
+    }
+    CHECK(same(list, model));
+}
+
+static void testQueueMemoryIsFlat() {
+    // A push-back / pop-front queue must not keep dead chunks around
+    QuickList list;
+    for (int i = 0; i < 1000; i++) list.pushBack(std::string(100, 'x'));
+    size_t chunks = list.chunkCount();
+    for (int round = 0; round < 100000; round++) {
+        list.pushBack(std::string(100, 'x'));
+        list.popFront();
+    }
+    CHECK(list.size() == 1000);
+    CHECK(list.chunkCount() <= chunks + 1);
+}
+
+static void testCommands() {
+    ThreadSafeStore store;
+    CHECK(store.rpush("l", {"a", "b", "c"}) == 3);
+    CHECK(store.lpush("l", {"z"}) == 4);
+    CHECK(store.lrange("l", 0, -1) == std::vector<std::string>({"z", "a", "b", "c"}));
+    CHECK(store.lindex("l", -1) == "c");
+    CHECK(store.lset("l", 1, "A"));
+    CHECK(!store.lset("l", 10, "x"));
+    CHECK(store.linsert("l", ListInsert::BEFORE, "b", "B") == 5);
+    CHECK(store.linsert("l", ListInsert::AFTER, "nope", "x") == -1);
+    CHECK(store.lpos("l", "b") == std::vector<size_t>({3}));
+    CHECK(store.lrem("l", 0, "B") == 1);
+    CHECK(store.ltrim("l", 1, -1));
+    CHECK(store.lrange("l", 0, -1) == std::vector<std::string>({"A", "b", "c"}));
+
+    CHECK(store.lmove("l", "m", ListEnd::RIGHT, ListEnd::LEFT) == "c");
+    CHECK(store.lrange("m", 0, -1) == std::vector<std::string>({"c"}));
+    CHECK(!store.lmove("missing", "m", ListEnd::LEFT, ListEnd::LEFT));
+
+    CHECK(store.lpop("l") == "A");
+    CHECK(store.rpop("l") == "b");
+    CHECK(store.llen("l") == 0);
+    CHECK(!store.exists("l"));  // Emptied lists are deleted
+}
+
+int main() {
+    testRandomOps();
+    testQueueMemoryIsFlat();
+    testCommands();
+    return testResult();
+}
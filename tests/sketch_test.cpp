@@ -0,0 +1,70 @@
+// Count-min sketch and HeavyKeeper top-k
+
+#include "ThreadSafeStore.h"
+#include "TestSupport.h"
+#include <cstdint>
+
+static void testCountMin() {
+    ThreadSafeStore store;
+    CHECK(store.cmsInitByDim("a", 2000, 5));
+    CHECK(!store.cmsInitByDim("a", 2000, 5));
+    CHECK(store.cmsInitByProb("p", 0.001, 0.01));
+    CHECK(!store.cmsInitByDim("bad", 0, 5));
+
+    auto counts = store.cmsIncrBy("a", {{"x", 3}, {"y", 10}, {"x", 2}});
+    CHECK(counts == std::vector<uint64_t>({3, 10, 5}));
+    CHECK(store.cmsQuery("a", {"x", "y", "never"}) == std::vector<uint64_t>({5, 10, 0}));
+    CHECK(store.cmsIncrBy("missing", {{"x", 1}}).empty());
+
+    // Never under-counts
+    for (int i = 0; i < 1000; i++) store.cmsIncrBy("a", {{"k" + std::to_string(i), 1}});
+    CHECK(store.cmsQuery("a", {"x"})[0] >= 5);
+
+    CHECK(store.cmsInitByDim("b", 2000, 5));
+    CHECK(store.cmsInitByDim("merged", 2000, 5));
+    store.cmsIncrBy("b", {{"x", 7}});
+    CHECK(store.cmsMerge("merged", {"a", "b"}, {1, 2}));
+    CHECK(store.cmsQuery("merged", {"x"})[0] >= 5 + 14);
+    CHECK(!store.cmsMerge("merged", {"p"}));  // Dimensions differ
+    CHECK(!store.cmsMerge("merged", {"a"}, {1, 2}));
+
+    // Saturates instead of wrapping to a small count
+    CHECK(store.cmsInitByDim("big", 10, 2));
+    store.cmsIncrBy("big", {{"x", UINT64_MAX / 2}});
+    CHECK(store.cmsMerge("big", {"big", "big"}, {3, 3}));
+    CHECK(store.cmsQuery("big", {"x"})[0] == UINT64_MAX);
+    store.cmsIncrBy("big", {{"x", 1}});
+    CHECK(store.cmsQuery("big", {"x"})[0] == UINT64_MAX);
+}
+
+static void testTopK() {
+    ThreadSafeStore store;
+    CHECK(store.topkReserve("t", 3));
+    CHECK(!store.topkReserve("t", 3));
+    CHECK(!store.topkReserve("bad", 0));
+
+    store.topkIncrBy("t", {{"cats", 100}, {"dogs", 50}, {"fish", 20}});
+    for (int i = 0; i < 50; i++) store.topkAdd("t", {"noise" + std::to_string(i)});
+
+    auto list = store.topkList("t");
+    CHECK(list.size() == 3);
+    CHECK(list.size() == 3 && list[0].first == "cats" && list[1].first == "dogs");
+    CHECK(store.topkQuery("t", {"cats", "noise7"}) == std::vector<bool>({true, false}));
+
+    // A new heavy hitter expels the smallest member
+    auto expelled = store.topkIncrBy("t", {{"birds", 500}});
+    CHECK(expelled.size() == 1 && expelled[0]);
+    CHECK(store.topkList("t")[0].first == "birds");
+
+    CHECK(store.topkReserve("u", 3));
+    store.topkIncrBy("u", {{"lions", 1000}});
+    CHECK(store.topkMerge("u", {"t"}));
+    CHECK(store.topkQuery("u", {"lions", "birds"}) == std::vector<bool>({true, true}));
+    CHECK(!store.topkMerge("u", {"missing"}));
+}
+
+int main() {
+    testCountMin();
+    testTopK();
+    return testResult();
+}
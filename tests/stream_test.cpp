@@ -0,0 +1,91 @@
+// STREAM: IDs, XADD / XRANGE / XTRIM, consumer groups, blocking XREAD
+
+#include "ThreadSafeStore.h"
+#include "TestSupport.h"
+#include <chrono>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+static void testIdParsing() {
+    CHECK(StreamID::parse("5-3") && StreamID::parse("5-3")->toString() == "5-3");
+    CHECK(StreamID::parse("5", 7)->toString() == "5-7");
+    CHECK(!StreamID::parse(""));
+    CHECK(!StreamID::parse("-5-0"));
+    CHECK(!StreamID::parse("5--3"));
+    CHECK(!StreamID::parse("+5"));
+    CHECK(!StreamID::parse(" 5"));
+    CHECK(!StreamID::parse("5-"));
+    CHECK(!StreamID::parse("18446744073709551616"));
+}
+
+static void testAddRange() {
+    ThreadSafeStore store;
+    CHECK(store.xadd("s", "1-1", {{"f", "a"}}) == "1-1");
+    CHECK(store.xadd("s", "2-0", {{"f", "b"}, {"g", "c"}}) == "2-0");
+    CHECK(!store.xadd("s", "2-0", {{"f", "x"}}));  // IDs must increase
+    CHECK(!store.xadd("s", "0-0", {{"f", "x"}}));
+    CHECK(!store.xadd("fresh", "bad", {{"f", "x"}}));
+    CHECK(!store.exists("fresh"));  // A rejected XADD leaves no key
+
+    auto auto_id = store.xadd("s", "*", {{"f", "d"}});
+    CHECK(auto_id && StreamID::parse(*auto_id) && *StreamID::parse(*auto_id) > StreamID{2, 0});
+    CHECK(store.xlen("s") == 3);
+
+    auto all = store.xrange("s", "-", "+");
+    CHECK(all.size() == 3);
+    CHECK(all[1].id.toString() == "2-0");
+    CHECK(all[1].fields == StreamFields({{"f", "b"}, {"g", "c"}}));
+    CHECK(store.xrange("s", "2", "+", 1).size() == 1);
+
+    CHECK(store.xtrim("s", 1) == 2);
+    CHECK(store.xlen("s") == 1);
+    CHECK(store.xtrim("s", 1) == 0);
+}
+
+static void testGroups() {
+    ThreadSafeStore store;
+    for (int i = 1; i <= 3; i++) store.xadd("s", std::to_string(i) + "-0", {{"n", std::to_string(i)}});
+
+    CHECK(store.xgroupCreate("s", "g", "0"));
+    CHECK(!store.xgroupCreate("s", "g", "0"));  // Exists
+    CHECK(!store.xgroupCreate("missing", "g", "0"));
+    CHECK(store.xgroupCreate("made", "g", "$", true));
+    CHECK(store.exists("made"));
+
+    auto first = store.xreadgroup("s", "g", "c1", ">", 2);
+    CHECK(first && first->size() == 2);
+    auto rest = store.xreadgroup("s", "g", "c2", ">");
+    CHECK(rest && rest->size() == 1 && rest->front().id.toString() == "3-0");
+    CHECK(store.xpending("s", "g").size() == 3);
+
+    CHECK(store.xack("s", "g", {"1-0", "3-0", "9-0"}) == 2);
+    auto pending = store.xpending("s", "g");
+    CHECK(pending.size() == 1 && pending[0].id.toString() == "2-0" && pending[0].consumer == "c1");
+
+    CHECK(!store.xreadgroup("s", "nogroup", "c", ">"));
+}
+
+static void testBlockingRead() {
+    ThreadSafeStore store;
+    store.xadd("s", "1-0", {{"f", "old"}});
+
+    std::thread writer([&store] {
+        std::this_thread::sleep_for(50ms);
+        store.xadd("s", "2-0", {{"f", "new"}});
+    });
+    auto got = store.xread({{"s", "$"}}, 0, 5000);  // Only entries added after the call
+    writer.join();
+    CHECK(got.size() == 1 && got[0].second.size() == 1 && got[0].second[0].id.toString() == "2-0");
+
+    auto timed_out = store.xread({{"s", "$"}}, 0, 20);
+    CHECK(timed_out.empty());
+}
+
+int main() {
+    testIdParsing();
+    testAddRange();
+    testGroups();
+    testBlockingRead();
+    return testResult();
+}
@@ -0,0 +1,44 @@
+// t-digest: streaming quantiles and CDF
+
+#include "ThreadSafeStore.h"
+#include "TestSupport.h"
+#include <cmath>
+
+static bool near(double a, double b, double tolerance) {
+    return std::fabs(a - b) <= tolerance;
+}
+
+int main() {
+    ThreadSafeStore store;
+    CHECK(store.tdigestCreate("lat"));
+    CHECK(!store.tdigestCreate("lat"));
+    CHECK(!store.tdigestCreate("bad", 0));
+    CHECK(!store.tdigestAdd("missing", {1}));
+
+    std::vector<double> values;
+    for (int i = 1; i <= 10000; i++) values.push_back(i);
+    CHECK(store.tdigestAdd("lat", values));
+
+    auto q = store.tdigestQuantile("lat", {0, 0.5, 0.99, 1});
+    CHECK(q.size() == 4);
+    CHECK(q.size() == 4 && q[0] == 1 && q[3] == 10000);
+    CHECK(q.size() == 4 && near(q[1], 5000, 50) && near(q[2], 9900, 20));
+
+    auto cdf = store.tdigestCdf("lat", {0, 2500, 20000});
+    CHECK(cdf.size() == 3 && cdf[0] == 0 && near(cdf[1], 0.25, 0.01) && cdf[2] == 1);
+
+    // Merging two halves matches the digest of the whole
+    std::vector<double> low(values.begin(), values.begin() + 5000);
+    std::vector<double> high(values.begin() + 5000, values.end());
+    store.tdigestCreate("low");
+    store.tdigestCreate("high");
+    store.tdigestAdd("low", low);
+    store.tdigestAdd("high", high);
+    CHECK(store.tdigestMerge("all", {"low", "high"}));
+    auto merged = store.tdigestQuantile("all", {0.5});
+    CHECK(merged.size() == 1 && near(merged[0], 5000, 50));
+    CHECK(!store.tdigestMerge("all", {"missing"}));
+
+    CHECK(store.tdigestQuantile("missing", {0.5}).empty());
+    return testResult();
+}
@@ -0,0 +1,60 @@
+// TIMESERIES: Gorilla-compressed samples, ranges, aggregation, retention
+
+#include "ThreadSafeStore.h"
+#include "TestSupport.h"
+#include <cmath>
+#include <cstdint>
+
+int main() {
+    ThreadSafeStore store;
+    CHECK(store.tsCreate("cpu"));
+    CHECK(!store.tsCreate("cpu"));
+    CHECK(!store.tsCreate("bad", -1));
+
+    // Round-trips exactly through the compressed chunks
+    const int64_t start = 1700000000000;
+    std::vector<TimeSeriesSample> samples;
+    for (int i = 0; i < 5000; i++) samples.push_back({start + i * 1000, 50 + std::sin(i / 10.0) * 20});
+    CHECK(store.tsMadd("cpu", samples) == 5000);
+
+    auto all = store.tsRange("cpu", 0, INT64_MAX);
+    CHECK(all.size() == 5000);
+    bool exact = all.size() == samples.size();
+    for (size_t i = 0; exact && i < all.size(); i++) {
+        exact = all[i].timestamp == samples[i].timestamp && all[i].value == samples[i].value;
+    }
+    CHECK(exact);
+
+    auto info = store.tsInfo("cpu");
+    CHECK(info && info->samples == 5000 && info->first_timestamp == start);
+    CHECK(info && info->bytes < 5000 * 16);  // Smaller than raw (timestamp, value) pairs
+
+    // Out-of-order samples are rejected
+    CHECK(!store.tsAdd("cpu", start, 1));
+    CHECK(store.tsAdd("cpu", start + 5000 * 1000, 1));
+    CHECK(store.tsGet("cpu") && store.tsGet("cpu")->value == 1);
+
+    auto avg = store.tsRange("cpu", start, start + 9999, TimeSeriesAggregation::COUNT, 5000);
+    CHECK(avg.size() == 2 || avg.size() == 3);  // Buckets are aligned to 0, not `start`
+    double counted = 0;
+    for (const auto& bucket : avg) counted += bucket.value;
+    CHECK(counted == 10);
+
+    auto max = store.tsRange("cpu", start, start + 4999999, TimeSeriesAggregation::MAX, 10000000);
+    CHECK(max.size() <= 2);
+    CHECK(!max.empty() && max[0].value <= 70.0001);
+
+    // TS.MADD / TS.ADD create the key only once a sample is appended
+    CHECK(store.tsMadd("fresh", {}) == 0);
+    CHECK(!store.exists("fresh"));
+    CHECK(store.tsAdd("fresh", 5, 1.5));
+    CHECK(store.type("fresh") == ValueType::TIMESERIES);
+
+    // Retention drops samples older than the newest minus the window
+    CHECK(store.tsCreate("short", 1000));
+    for (int i = 0; i < 10; i++) store.tsAdd("short", i * 500, i);
+    auto kept = store.tsRange("short", 0, INT64_MAX);
+    CHECK(!kept.empty() && kept.front().timestamp >= 4500 - 1000);
+    CHECK(store.tsRange("missing", 0, INT64_MAX).empty());
+    return testResult();
+}
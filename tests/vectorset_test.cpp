@@ -0,0 +1,80 @@
+// Vector sets: HNSW search (FP32 and Q8) against brute force
+
+#include "ThreadSafeStore.h"
+#include "TestSupport.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+static double cosine(const std::vector<float>& a, const std::vector<float>& b) {
+    double dot = 0, na = 0, nb = 0;
+    for (size_t i = 0; i < a.size(); i++) {
+        dot += a[i] * b[i];
+        na += a[i] * a[i];
+        nb += b[i] * b[i];
+    }
+    return dot / std::sqrt(na * nb);
+}
+
+static void testSmall() {
+    ThreadSafeStore store;
+    CHECK(store.vadd("v", "x", {1, 0, 0}, VectorQuant::FP32));
+    CHECK(store.vadd("v", "y", {0, 1, 0}, VectorQuant::FP32));
+    CHECK(store.vadd("v", "xy", {1, 1, 0}, VectorQuant::FP32));
+    CHECK(!store.vadd("v", "bad", {1, 0}));  // Wrong dimension
+    CHECK(!store.vadd("v", "empty", {}));
+    CHECK(store.vcard("v") == 3 && store.vdim("v") == 3);
+
+    auto hits = store.vsim("v", {1, 0.1f, 0}, 2);
+    CHECK(hits.size() == 2 && hits[0].element == "x" && hits[1].element == "xy");
+    CHECK(hits.size() == 2 && hits[0].score > hits[1].score && hits[0].score <= 1.0001);
+
+    // Neighbours of an element, not the element itself
+    auto by_element = store.vsimElement("v", "y", 1);
+    CHECK(by_element.size() == 1 && by_element[0].element == "xy");
+    CHECK(store.vsimElement("v", "nope").empty());
+
+    auto emb = store.vemb("v", "xy");
+    CHECK(emb && emb->size() == 3 && std::fabs((*emb)[0] - (*emb)[1]) < 1e-6);
+    CHECK(!store.vemb("v", "nope"));
+}
+
+static void testRecall(VectorQuant quant) {
+    ThreadSafeStore store;
+    std::mt19937 rng(7);
+    std::normal_distribution<float> gauss;
+    const size_t dim = 32, n = 2000;
+
+    std::vector<std::vector<float>> vectors(n, std::vector<float>(dim));
+    for (size_t i = 0; i < n; i++) {
+        for (auto& x : vectors[i]) x = gauss(rng);
+        store.vadd("v", "e" + std::to_string(i), vectors[i], quant);
+    }
+    CHECK(store.vcard("v") == n);
+
+    // Top-10 overlap with exact search, over a few queries
+    size_t found = 0, total = 0;
+    for (int q = 0; q < 20; q++) {
+        std::vector<float> query(dim);
+        for (auto& x : query) x = gauss(rng);
+
+        std::vector<std::pair<double, size_t>> exact;
+        for (size_t i = 0; i < n; i++) exact.push_back({cosine(query, vectors[i]), i});
+        std::partial_sort(exact.begin(), exact.begin() + 10, exact.end(), std::greater<>());
+
+        auto hits = store.vsim("v", query, 10, 100);
+        for (size_t i = 0; i < 10; i++) {
+            std::string name = "e" + std::to_string(exact[i].second);
+            found += std::any_of(hits.begin(), hits.end(), [&](const VectorMatch& m) { return m.element == name; });
+        }
+        total += 10;
+    }
+    CHECK(found >= total * 8 / 10);
+}
+
+int main() {
+    testSmall();
+    testRecall(VectorQuant::FP32);
+    testRecall(VectorQuant::Q8);
+    return testResult();
+}